@@ -0,0 +1,151 @@
+/**
+ * @file flat_bench.cc
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Benchmark of building, looking up and the memory per entry of a
+ * read-mostly table in the flat, B-tree and red-black tree maps
+ * @version 1.0
+ * @date 2024-08-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "./../s21_containers.h"
+
+namespace {
+
+constexpr std::size_t kElements = 1000000;
+
+std::size_t allocated{};  ///< Bytes currently held by counting_allocator
+
+/**
+ * @brief An allocator that counts the bytes it hands out.
+ *
+ * @tparam T The type of the allocated objects.
+ */
+template <typename T>
+struct counting_allocator {
+  using value_type = T;
+
+  counting_allocator() = default;
+  template <typename U>
+  counting_allocator(const counting_allocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    allocated += n * sizeof(T);
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T *ptr, std::size_t n) noexcept {
+    allocated -= n * sizeof(T);
+    std::allocator<T>{}.deallocate(ptr, n);
+  }
+
+  friend bool operator==(const counting_allocator &,
+                         const counting_allocator &) noexcept {
+    return true;
+  }
+
+  friend bool operator!=(const counting_allocator &,
+                         const counting_allocator &) noexcept {
+    return false;
+  }
+};
+
+using flat_map = s21::flat_map<int, int, std::less<int>,
+                               counting_allocator<std::pair<int, int>>>;
+
+/**
+ * @brief Runs the given callable and returns the average time of one
+ * operation in nanoseconds.
+ *
+ * @param[in] ops Number of operations performed by the callable.
+ * @param[in] func Callable to measure.
+ * @return double - nanoseconds per operation.
+ */
+template <typename Func>
+double measure(std::size_t ops, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto finish = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(finish - start).count() / ops;
+}
+
+/**
+ * @brief Builds a map from a range of pairs, then measures hits and misses
+ * and reports the bytes the map holds per entry.
+ *
+ * @details
+ * The flat map is built with one range insert, the node based maps with
+ * one insert per element, which is how each of them is meant to be filled.
+ *
+ * @tparam Map Map type to benchmark.
+ * @param[in] name Name printed in the report.
+ * @param[in] items Elements to build the map from.
+ * @param[in] misses Keys to look up, never present in the map.
+ */
+template <typename Map>
+void run(const char *name, const std::vector<std::pair<int, int>> &items,
+         const std::vector<int> &misses) {
+  std::size_t found{};
+  Map map;
+
+  double build = measure(items.size(), [&] {
+    if constexpr (std::is_same_v<Map, flat_map>) {
+      map.insert(items.begin(), items.end());
+    } else {
+      for (const auto &item : items) map.insert(item);
+    }
+  });
+  double hit = measure(items.size(), [&] {
+    for (const auto &item : items) found += map.count(item.first);
+  });
+  double miss = measure(misses.size(), [&] {
+    for (int key : misses) found += map.count(key);
+  });
+  double bytes = static_cast<double>(allocated) / map.size();
+
+  std::printf(
+      "%-12s build %7.1f   hit %7.1f   miss %7.1f ns/op   %5.1f bytes/entry"
+      "   (%zu)\n",
+      name, build, hit, miss, bytes, found);
+}
+
+}  // namespace
+
+int main() {
+  using value = std::pair<int, int>;
+  using alloc = counting_allocator<value>;
+  using std_alloc = counting_allocator<std::pair<const int, int>>;
+
+  std::mt19937 gen{42};
+  std::vector<value> items(kElements);
+  std::vector<int> misses(kElements);
+
+  for (std::size_t i = 0; i < kElements; i++) {
+    items[i] = {static_cast<int>(i) * 2, static_cast<int>(i)};
+    misses[i] = static_cast<int>(i) * 2 + 1;
+  }
+
+  std::shuffle(items.begin(), items.end(), gen);
+  std::shuffle(misses.begin(), misses.end(), gen);
+
+  run<flat_map>("s21 flat", items, misses);
+  run<s21::btree_map<int, int, std::less<int>, alloc>>("s21 btree", items,
+                                                        misses);
+  run<s21::map<int, int, std::less<int>, alloc>>("s21::map", items, misses);
+  run<std::map<int, int, std::less<int>, std_alloc>>("std::map", items,
+                                                     misses);
+
+  return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file hash_bench.cc
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Benchmark of inserting, looking up and erasing int and string keys in
+ * the open addressing hash map, s21::map and std::unordered_map
+ * @version 1.0
+ * @date 2024-08-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "./../s21_containers.h"
+
+namespace {
+
+constexpr std::size_t kElements = 1000000;
+
+/**
+ * @brief Runs the given callable and returns the average time of one
+ * operation in nanoseconds.
+ *
+ * @param[in] ops Number of operations performed by the callable.
+ * @param[in] func Callable to measure.
+ * @return double - nanoseconds per operation.
+ */
+template <typename Func>
+double measure(std::size_t ops, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto finish = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(finish - start).count() / ops;
+}
+
+/**
+ * @brief Inserts the keys, looks up every key and as many missing ones, then
+ * erases every key.
+ *
+ * @tparam Map Map type to benchmark.
+ * @tparam Key Key type of the map.
+ * @param[in] name Name printed in the report.
+ * @param[in] keys Keys to insert, in random order.
+ * @param[in] misses Keys to look up, never present in the map.
+ */
+template <typename Map, typename Key>
+void run(const char *name, const std::vector<Key> &keys,
+         const std::vector<Key> &misses) {
+  std::size_t found{};
+  Map map;
+
+  double insert = measure(keys.size(), [&] {
+    for (const Key &key : keys) map.insert({key, 0});
+  });
+  double hit = measure(keys.size(), [&] {
+    for (const Key &key : keys) found += map.count(key);
+  });
+  double miss = measure(misses.size(), [&] {
+    for (const Key &key : misses) found += map.count(key);
+  });
+  double erase = measure(keys.size(), [&] {
+    for (const Key &key : keys) found += map.erase(key);
+  });
+
+  std::printf(
+      "%-22s insert %7.1f   hit %7.1f   miss %7.1f   erase %7.1f ns/op"
+      "   (%zu)\n",
+      name, insert, hit, miss, erase, found);
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 gen{42};
+  std::vector<int> keys(kElements);
+  std::vector<int> misses(kElements);
+  std::vector<std::string> str_keys(kElements);
+  std::vector<std::string> str_misses(kElements);
+
+  for (std::size_t i = 0; i < kElements; i++) {
+    keys[i] = static_cast<int>(i) * 2;
+    misses[i] = static_cast<int>(i) * 2 + 1;
+    str_keys[i] = "key_" + std::to_string(keys[i]);
+    str_misses[i] = "key_" + std::to_string(misses[i]);
+  }
+
+  std::shuffle(keys.begin(), keys.end(), gen);
+  std::shuffle(misses.begin(), misses.end(), gen);
+  std::shuffle(str_keys.begin(), str_keys.end(), gen);
+  std::shuffle(str_misses.begin(), str_misses.end(), gen);
+
+  run<s21::unordered_map<int, int>>("s21::unordered_map", keys, misses);
+  run<s21::map<int, int>>("s21::map", keys, misses);
+  run<std::unordered_map<int, int>>("std::unordered_map", keys, misses);
+  run<s21::unordered_map<std::string, int>>("s21::unordered_map str",
+                                            str_keys, str_misses);
+  run<s21::map<std::string, int>>("s21::map str", str_keys, str_misses);
+  run<std::unordered_map<std::string, int>>("std::unordered_map str",
+                                            str_keys, str_misses);
+
+  return 0;
+}
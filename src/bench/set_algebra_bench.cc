@@ -0,0 +1,103 @@
+/**
+ * @file set_algebra_bench.cc
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Benchmark of the union, intersection and difference of large sets
+ * @version 1.0
+ * @date 2024-08-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <set>
+#include <thread>
+
+#include "./../s21_containers.h"
+
+namespace {
+
+constexpr int kElements = 2000000;
+
+/**
+ * @brief Runs the given callable and returns its time in milliseconds.
+ *
+ * @param[in] func Callable to measure.
+ * @return double - milliseconds.
+ */
+template <typename Func>
+double measure(Func func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto finish = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+/**
+ * @brief Measures one set operation of s21::set against the std algorithm
+ * writing into a std::set.
+ *
+ * @tparam S21Op Callable returning the s21::set result.
+ * @tparam StdOp Callable running the std algorithm on two ranges and an
+ * output iterator.
+ * @param[in] name Name printed in the report.
+ * @param[in] s21_op The s21 operation.
+ * @param[in] std_op The std algorithm.
+ * @param[in] first The first std operand.
+ * @param[in] second The second std operand.
+ */
+template <typename S21Op, typename StdOp>
+void run(const char *name, S21Op s21_op, StdOp std_op,
+         const std::set<int> &first, const std::set<int> &second) {
+  std::size_t s21_size{};
+  std::size_t std_size{};
+
+  double s21_time = measure([&] { s21_size = s21_op().size(); });
+  double std_time = measure([&] {
+    std::set<int> result;
+    std_op(first.begin(), first.end(), second.begin(), second.end(),
+           std::inserter(result, result.end()));
+    std_size = result.size();
+  });
+
+  std::printf("%-13s s21 %8.1f ms   std %8.1f ms   (%zu, %zu)\n", name,
+              s21_time, std_time, s21_size, std_size);
+}
+
+}  // namespace
+
+int main() {
+  s21::set<int> s21_first;
+  s21::set<int> s21_second;
+  std::set<int> std_first;
+  std::set<int> std_second;
+
+  for (int i = 0; i < kElements; ++i) {
+    s21_first.insert(i * 2);
+    std_first.insert(i * 2);
+    s21_second.insert(i * 3);
+    std_second.insert(i * 3);
+  }
+
+  std::printf("%d + %d keys, %u hardware threads\n", kElements, kElements,
+              std::thread::hardware_concurrency());
+
+  run(
+      "union", [&] { return s21::set_union(s21_first, s21_second); },
+      [](auto... args) { std::set_union(args...); }, std_first, std_second);
+  run(
+      "intersection",
+      [&] { return s21::set_intersection(s21_first, s21_second); },
+      [](auto... args) { std::set_intersection(args...); }, std_first,
+      std_second);
+  run(
+      "difference", [&] { return s21::set_difference(s21_first, s21_second); },
+      [](auto... args) { std::set_difference(args...); }, std_first,
+      std_second);
+
+  return 0;
+}
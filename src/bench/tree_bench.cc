@@ -0,0 +1,217 @@
+/**
+ * @file tree_bench.cc
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Benchmark of the red-black tree and B-tree insert and lookup paths on
+ * int and string keys
+ * @version 1.0
+ * @date 2024-08-12
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "./../s21_containers.h"
+
+namespace {
+
+constexpr std::size_t kElements = 1000000;
+
+/**
+ * @brief Runs the given callable and returns the average time of one
+ * operation in nanoseconds.
+ *
+ * @param[in] ops Number of operations performed by the callable.
+ * @param[in] func Callable to measure.
+ * @return double - nanoseconds per operation.
+ */
+template <typename Func>
+double measure(std::size_t ops, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto finish = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(finish - start).count() / ops;
+}
+
+/**
+ * @brief Measures insertion, lookups, copying, merging and clearing for one
+ * map implementation.
+ *
+ * @tparam Map Map type to benchmark.
+ * @tparam Key Key type of the map.
+ * @param[in] name Name printed in the report.
+ * @param[in] keys Keys to insert.
+ * @param[in] misses Keys to look up, never present in the map. The first
+ * half of them is merged into the map afterwards.
+ */
+template <typename Map, typename Key>
+void run(const char *name, const std::vector<Key> &keys,
+         const std::vector<Key> &misses) {
+  Map map;
+  std::size_t found{};
+
+  double insert = measure(keys.size(), [&] {
+    for (const Key &key : keys) map.insert({key, 0});
+  });
+  double hit = measure(keys.size(), [&] {
+    for (const Key &key : keys) found += map.count(key);
+  });
+  double miss = measure(misses.size(), [&] {
+    for (const Key &key : misses) found += map.count(key);
+  });
+  double copy = measure(keys.size(), [&] {
+    Map snapshot{map};
+    found += snapshot.size();
+  });
+  Map extra;
+
+  for (std::size_t i = 0; i < misses.size() / 2; ++i) {
+    extra.insert({misses[i], 0});
+  }
+
+  double merge = measure(extra.size(), [&] { map.merge(extra); });
+  double clear = measure(keys.size(), [&] { map.clear(); });
+
+  std::printf(
+      "%-12s insert %7.1f   hit %7.1f   miss %7.1f   copy %6.1f   "
+      "merge %6.1f   clear %5.1f ns/op   (%zu)\n",
+      name, insert, hit, miss, copy, merge, clear, found);
+}
+
+/**
+ * @brief Measures appending keys in increasing order, first without a hint
+ * and then with end() as the hint.
+ *
+ * @tparam Map Map type to benchmark.
+ * @tparam Key Key type of the map.
+ * @param[in] name Name printed in the report.
+ * @param[in] sorted Keys to append, in increasing order.
+ */
+template <typename Map, typename Key>
+void runAppend(const char *name, const std::vector<Key> &sorted) {
+  Map plain;
+  Map hinted;
+
+  double insert = measure(sorted.size(), [&] {
+    for (const Key &key : sorted) plain.insert({key, 0});
+  });
+  double hint = measure(sorted.size(), [&] {
+    for (const Key &key : sorted) hinted.insert(hinted.end(), {key, 0});
+  });
+
+  std::printf("%-12s append %7.1f   append with hint %7.1f ns/op   (%zu)\n",
+              name, insert, hint, plain.size() + hinted.size());
+}
+
+/**
+ * @brief Measures looking up keys in batches, first with a loop of find()
+ * calls and then with find_many().
+ *
+ * @tparam Map Map type to benchmark.
+ * @tparam Key Key type of the map.
+ * @param[in] name Name printed in the report.
+ * @param[in] keys Keys to insert and look up, in random order.
+ * @param[in] batch Number of keys looked up at once.
+ */
+template <typename Map, typename Key>
+void runBatch(const char *name, const std::vector<Key> &keys,
+              std::size_t batch) {
+  Map map;
+  std::size_t found{};
+  std::vector<typename Map::iterator> out(batch);
+
+  for (const Key &key : keys) map.insert({key, 0});
+
+  std::size_t ops = keys.size() / batch * batch;
+  double single = measure(ops, [&] {
+    for (std::size_t i = 0; i < ops; i += batch) {
+      for (std::size_t j = 0; j < batch; ++j) out[j] = map.find(keys[i + j]);
+      found += (out[batch - 1] != map.end());
+    }
+  });
+  double many = measure(ops, [&] {
+    for (std::size_t i = 0; i < ops; i += batch) {
+      map.find_many(keys.begin() + i, keys.begin() + i + batch, out.begin());
+      found += (out[batch - 1] != map.end());
+    }
+  });
+
+  std::printf("%-12s batch %3zu   find %7.1f   find_many %7.1f ns/op   (%zu)\n",
+              name, batch, single, many, found);
+}
+
+/**
+ * @brief Builds a string key sharing a long prefix with all other keys, so
+ * that every comparison has to look past it.
+ *
+ * @param[in] value The number encoded in the key.
+ * @return std::string - the key.
+ */
+std::string makeKey(int value) {
+  std::string digits = std::to_string(value);
+
+  return "container/key/" + std::string(10 - digits.size(), '0') + digits;
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 gen{42};
+  std::vector<int> keys(kElements);
+  std::vector<int> misses(kElements);
+
+  for (std::size_t i = 0; i < kElements; i++) {
+    keys[i] = static_cast<int>(i) * 2;
+    misses[i] = static_cast<int>(i) * 2 + 1;
+  }
+
+  std::shuffle(keys.begin(), keys.end(), gen);
+  std::shuffle(misses.begin(), misses.end(), gen);
+
+  std::vector<std::string> str_keys(kElements);
+  std::vector<std::string> str_misses(kElements);
+
+  for (std::size_t i = 0; i < kElements; i++) {
+    str_keys[i] = makeKey(keys[i]);
+    str_misses[i] = makeKey(misses[i]);
+  }
+
+  using pool_map = s21::map<int, int, std::less<int>,
+                            s21::pool_allocator<std::pair<int, int>>>;
+
+  std::printf("int keys\n");
+  run<s21::map<int, int>>("s21::map", keys, misses);
+  run<pool_map>("s21 pool", keys, misses);
+  run<s21::btree_map<int, int>>("s21 btree", keys, misses);
+  run<std::map<int, int>>("std::map", keys, misses);
+
+  std::printf("string keys\n");
+  run<s21::map<std::string, int>>("s21::map", str_keys, str_misses);
+  run<s21::btree_map<std::string, int>>("s21 btree", str_keys, str_misses);
+  run<std::map<std::string, int>>("std::map", str_keys, str_misses);
+
+  std::printf("batched lookup\n");
+  runBatch<s21::map<int, int>>("s21::map", keys, 32);
+  runBatch<s21::map<int, int>>("s21::map", keys, 256);
+  runBatch<s21::map<std::string, int>>("s21::map str", str_keys, 32);
+  runBatch<s21::map<std::string, int>>("s21::map str", str_keys, 256);
+
+  std::sort(keys.begin(), keys.end());
+  std::sort(str_keys.begin(), str_keys.end());
+
+  std::printf("sorted append\n");
+  runAppend<s21::map<int, int>>("s21::map", keys);
+  runAppend<std::map<int, int>>("std::map", keys);
+  runAppend<s21::map<std::string, int>>("s21::map str", str_keys);
+  runAppend<std::map<std::string, int>>("std::map str", str_keys);
+
+  return 0;
+}
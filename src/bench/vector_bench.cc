@@ -0,0 +1,175 @@
+/**
+ * @file vector_bench.cc
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Benchmark of growing a vector, of inserting and erasing in the
+ * middle of a 1M-element vector, for trivially copyable, relocatable and
+ * ordinary element types, of appending a range and of sizing a byte buffer
+ * @version 1.0
+ * @date 2024-08-26
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "./../s21_containers.h"
+
+namespace {
+
+constexpr std::size_t kElements = 1000000;
+constexpr std::size_t kMiddleOps = 200;
+
+/**
+ * @brief Runs the given callable and returns the average time of one
+ * operation in nanoseconds.
+ *
+ * @param[in] ops Number of operations performed by the callable.
+ * @param[in] func Callable to measure.
+ * @return double - nanoseconds per operation.
+ */
+template <typename Func>
+double measure(std::size_t ops, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto finish = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(finish - start).count() / ops;
+}
+
+/// @brief A record of plain fields and an owning pointer.
+struct record {
+  explicit record(int id_ = 0) : id{id_} {}
+
+  int id;
+  double weight{};
+  std::unique_ptr<int> payload{};
+};
+
+/// @brief The same record, moved to other storage by copying its bytes.
+struct relocatable_record : record {
+  using record::record;
+};
+
+}  // namespace
+
+template <>
+struct s21::is_trivially_relocatable<relocatable_record> : std::true_type {};
+
+namespace {
+
+/**
+ * @brief Measures push_back growth and inserts and erases in the middle.
+ *
+ * @tparam Vector Vector type to benchmark.
+ * @param[in] name Name printed in the report.
+ */
+template <typename Vector>
+void run(const char *name) {
+  using value_type = typename Vector::value_type;
+  Vector vec;
+  std::size_t check{};
+
+  double grow = measure(kElements, [&] {
+    for (std::size_t i = 0; i < kElements; ++i) {
+      vec.emplace_back(static_cast<int>(i));
+    }
+  });
+  double insert = measure(kMiddleOps, [&] {
+    for (std::size_t i = 0; i < kMiddleOps; ++i) {
+      vec.emplace(vec.begin() + vec.size() / 2, static_cast<int>(i));
+    }
+  });
+  double erase = measure(kMiddleOps, [&] {
+    for (std::size_t i = 0; i < kMiddleOps; ++i) {
+      vec.erase(vec.begin() + vec.size() / 2);
+    }
+  });
+
+  for (const value_type &item : vec) check += sizeof(item);
+
+  std::printf(
+      "%-20s push_back %6.1f ns/op   middle insert %8.0f   erase %8.0f ns/op"
+      "   (%zu)\n",
+      name, grow, insert, erase, check / sizeof(value_type));
+}
+
+/**
+ * @brief Measures appending a 1M-element vector to small vectors element by
+ * element and as one range.
+ *
+ * @tparam Vector Vector type to benchmark.
+ * @param[in] name Name printed in the report.
+ */
+template <typename Vector>
+void runAppend(const char *name) {
+  std::vector<int> items(kElements, 1);
+  std::size_t check{};
+
+  double one_by_one = measure(kElements, [&] {
+    Vector vec{1, 2, 3};
+    for (int item : items) vec.push_back(item);
+    check += vec.size();
+  });
+  double range = measure(kElements, [&] {
+    Vector vec{1, 2, 3};
+    vec.insert(vec.end(), items.begin(), items.end());
+    check += vec.size();
+  });
+
+  std::printf("%-20s push_back loop %5.2f   range insert %5.2f ns/op   (%zu)\n",
+              name, one_by_one, range, check);
+}
+
+/**
+ * @brief Measures sizing a 64 MiB byte buffer that is overwritten right away.
+ *
+ * @tparam Vector Vector type to benchmark.
+ * @tparam Resize Callable sizing the buffer.
+ * @param[in] name Name printed in the report.
+ * @param[in] resize Callable sizing the buffer.
+ */
+template <typename Vector, typename Resize>
+void runBuffer(const char *name, Resize resize) {
+  constexpr std::size_t kBytes = std::size_t{64} << 20;
+  constexpr std::size_t kRounds = 20;
+  std::size_t check{};
+
+  double sizing = measure(kRounds, [&] {
+    for (std::size_t i = 0; i < kRounds; ++i) {
+      Vector buffer;
+      resize(buffer, kBytes);
+      buffer[i] = static_cast<char>(i);
+      check += static_cast<std::size_t>(buffer[i]) + buffer.size();
+    }
+  });
+
+  std::printf("%-20s buffer resize %10.0f ns/op   (%zu)\n", name, sizing,
+              check / kRounds);
+}
+
+}  // namespace
+
+int main() {
+  run<s21::vector<int>>("s21 int");
+  run<std::vector<int>>("std int");
+  run<s21::vector<relocatable_record>>("s21 relocatable rec");
+  run<s21::vector<record>>("s21 record");
+  run<std::vector<record>>("std record");
+  runAppend<s21::vector<int>>("s21 int");
+  runAppend<std::vector<int>>("std int");
+
+  auto resize = [](auto &buffer, std::size_t n) { buffer.resize(n); };
+  auto uninitialized = [](auto &buffer, std::size_t n) {
+    buffer.resize_uninitialized(n);
+  };
+
+  runBuffer<s21::vector<char>>("s21 resize", resize);
+  runBuffer<s21::vector<char>>("s21 uninitialized", uninitialized);
+  runBuffer<std::vector<char>>("std resize", resize);
+
+  return 0;
+}
@@ -38,7 +38,7 @@ struct array {
   using reference = T &;
   using const_reference = const T &;
   using iterator = typename vector<T>::iterator;
-  using const_iterator = typename vector<const T>::const_iterator;
+  using const_iterator = typename vector<T>::const_iterator;
   using size_type = std::size_t;
 
   // Array Element access
@@ -0,0 +1,1984 @@
+/**
+ * @file btree.h
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Header for the B-tree container
+ * @version 1.0
+ * @date 2024-08-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_CONTAINERS_BTREE_H_
+#define SRC_CONTAINERS_BTREE_H_
+
+#include <algorithm>         // for min(), max(), swap()
+#include <cstdint>           // for uint16_t
+#include <cstring>           // for memmove()
+#include <functional>        // for less
+#include <initializer_list>  // for init_list type
+#include <iterator>          // for bidirectional_iterator_tag
+#include <limits>            // for max()
+#include <memory>            // for allocator, allocator_traits
+#include <new>               // for launder()
+#include <type_traits>       // for conditional_t, is_trivially_copyable
+#include <utility>           // for pair, move(), forward(), exchange()
+
+#include "./tree.h"
+
+/// @brief Namespace for working with containers
+namespace s21 {
+
+/**
+ * @brief A B-tree container template class.
+ *
+ * @details
+ * This template class btree keeps its elements sorted in a B-tree whose nodes
+ * hold arrays of elements. A node takes about kNodeBytes of memory, four
+ * cache lines, so a lookup touches about log_B(n) nodes for B elements per
+ * node instead of the 2 * log2(n) nodes of a red-black tree, and the elements
+ * need no per-element links. It is the common base of btree_map, btree_set
+ * and btree_multiset.
+ *
+ * Unlike with the node based containers, inserting and erasing elements moves
+ * other elements inside the nodes, so those operations invalidate all
+ * iterators.
+ *
+ * @tparam K The type of keys.
+ * @tparam V The type of elements, containing or being the key.
+ * @tparam KeyOf The callable returning the key of an element.
+ * @tparam Compare The strict weak ordering of the keys.
+ * @tparam Allocator The allocator type, rebound to the node types.
+ * @tparam Multi Whether equivalent keys are allowed.
+ */
+template <typename K, typename V, typename KeyOf,
+          typename Compare = std::less<K>,
+          typename Allocator = std::allocator<V>, bool Multi = false>
+class btree {
+ public:
+  // Container types
+
+  template <bool Const>
+  class BTreeIterator;
+
+  // Type aliases
+
+  using key_type = K;                          ///< Type of keys
+  using value_type = V;                        ///< Type of elements
+  using reference = value_type &;              ///< Reference to element
+  using const_reference = const value_type &;  ///< Const reference to element
+  using size_type = std::size_t;               ///< Containers size type
+  using difference_type = std::ptrdiff_t;      ///< Distance between elements
+  using allocator_type = Allocator;            ///< Allocator of elements
+  using key_compare = Compare;                 ///< Ordering of keys
+  using iterator = BTreeIterator<false>;       ///< For read/write elements
+  using const_iterator = BTreeIterator<true>;  ///< For read elements
+  using iterator_range = std::pair<iterator, iterator>;  ///< Pair of bounds
+  using insert_return =                                  ///< Result of insert
+      std::conditional_t<Multi, iterator, std::pair<iterator, bool>>;
+
+  // Constructors/assignment operators/destructor
+
+  btree() = default;
+  explicit btree(const allocator_type &alloc);
+  explicit btree(const key_compare &comp,
+                 const allocator_type &alloc = allocator_type{});
+  btree(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  btree(InputIt first, InputIt last);
+  btree(const btree &other);
+  btree(const btree &other, const allocator_type &alloc);
+  btree(btree &&other) noexcept;
+  btree &operator=(const btree &other);
+  btree &operator=(btree &&other);
+  ~btree();
+  allocator_type get_allocator() const noexcept;
+  key_compare key_comp() const;
+
+  // Iterators
+
+  iterator begin() const noexcept;
+  iterator end() const noexcept;
+  const_iterator cbegin() const noexcept;
+  const_iterator cend() const noexcept;
+
+  // Capacity
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+
+  // Modifiers
+
+  void clear() noexcept;
+  insert_return insert(const value_type &value);
+  insert_return insert(value_type &&value);
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+  template <typename... Args>
+  insert_return emplace(Args &&...args);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key);
+  void swap(btree &other) noexcept;
+  void merge(btree &other);
+
+  // Lookup
+
+  iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  iterator_range equal_range(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+
+  // Heterogeneous lookup
+
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator find(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  bool contains(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  size_type count(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator_range equal_range(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator lower_bound(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator upper_bound(const Key &key) const;
+
+ protected:
+  // Add elements
+
+  template <typename Key, typename... Args>
+  insert_return emplaceKey(const Key &key, Args &&...args);
+
+ private:
+  // Container types
+
+  struct Node;
+  struct InternalNode;
+
+  // Type aliases
+
+  using slot_type = std::remove_const_t<value_type>;
+  using leaf_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using internal_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<InternalNode>;
+  using leaf_traits = std::allocator_traits<leaf_allocator>;
+  using internal_traits = std::allocator_traits<internal_allocator>;
+
+  // Node geometry
+
+  static constexpr size_type kNodeBytes{256};  ///< Target size of a node
+  static constexpr size_type kHeaderBytes{sizeof(void *) + 8};
+  static constexpr size_type kSlots{std::max<size_type>(
+      3, (kNodeBytes - kHeaderBytes) / sizeof(slot_type))};  ///< Node capacity
+  static constexpr size_type kMinSlots{(kSlots - 1) / 2};  ///< Least fill
+
+  // Fields
+
+  Node *root_{};       ///< Root node, nullptr for an empty tree
+  Node *leftmost_{};   ///< Leaf with the smallest element
+  Node *rightmost_{};  ///< Leaf with the largest element
+  size_type size_{};   ///< Number of elements
+  Compare comp_{};     ///< Ordering of keys
+  leaf_allocator leaf_alloc_{};          ///< Allocator of leaf nodes
+  internal_allocator internal_alloc_{};  ///< Allocator of internal nodes
+
+  // Nodes
+
+  Node *newLeaf();
+  Node *newInternal();
+  void deleteNode(Node *node) noexcept;
+  void destroySubtree(Node *node) noexcept;
+  Node *cloneSubtree(const Node *node, Node *parent);
+  void copyFrom(const btree &other);
+  static Node *&childOf(Node *node, size_type index) noexcept;
+  static void setChild(Node *node, size_type index, Node *child) noexcept;
+  static void moveSlots(Node *from, size_type first, size_type last, Node *to,
+                        size_type dest) noexcept;
+
+  // Searching
+
+  template <typename Key>
+  size_type lowerIndex(const Node *node, const Key &key) const;
+  template <typename Key>
+  size_type upperIndex(const Node *node, const Key &key) const;
+  template <typename Key>
+  iterator lowerBound(const Key &key) const;
+  template <typename Key>
+  iterator upperBound(const Key &key) const;
+  template <typename Key>
+  iterator findKey(const Key &key) const;
+  template <typename Key>
+  size_type countKey(const Key &key) const;
+
+  // Inserting
+
+  template <typename... Args>
+  iterator insertAt(Node *node, size_type pos, Args &&...args);
+  void makeRoom(Node *&node, size_type &pos);
+  void splitNode(Node *node);
+
+  // Erasing
+
+  iterator eraseAt(iterator pos) noexcept;
+  void rebalance(Node *node, iterator &tracked) noexcept;
+  void borrowLeft(Node *node, Node *left, iterator &tracked) noexcept;
+  void borrowRight(Node *node, Node *right) noexcept;
+  void mergeNodes(Node *left, Node *right, iterator &tracked) noexcept;
+};
+
+/**
+ * @brief A node of the B-tree.
+ *
+ * @details
+ * The elements live in raw storage, only the first count slots hold
+ * constructed elements. Leaves are allocated as Node, internal nodes as
+ * InternalNode, which adds the array of sons.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+struct btree<K, V, KeyOf, Compare, Allocator, Multi>::Node {
+  Node *parent{};               ///< Parent node, nullptr for the root
+  std::uint16_t position{};     ///< Index of the node among the parent sons
+  std::uint16_t count{};        ///< Number of elements in the node
+  bool leaf{true};              ///< Whether the node has no sons
+  alignas(slot_type) unsigned char storage[sizeof(slot_type) * kSlots];
+
+  /**
+   * @brief Returns the slot with the given index.
+   *
+   * @param[in] index The index of the slot.
+   * @return slot_type* - a pointer to the slot.
+   */
+  slot_type *slot(size_type index) noexcept {
+    return std::launder(
+        reinterpret_cast<slot_type *>(storage + index * sizeof(slot_type)));
+  }
+};
+
+/// @brief An internal node of the B-tree, with count + 1 sons.
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+struct btree<K, V, KeyOf, Compare, Allocator, Multi>::InternalNode : Node {
+  Node *children[kSlots + 1];  ///< Sons of the node
+};
+
+/**
+ * @brief An iterator for the B-tree.
+ *
+ * @details
+ * The iterator holds a node and the index of an element in it. The end
+ * iterator points past the last element of the rightmost leaf.
+ *
+ * @tparam Const Whether the elements are read-only.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <bool Const>
+class btree<K, V, KeyOf, Compare, Allocator, Multi>::BTreeIterator {
+ public:
+  // Type aliases
+
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = std::remove_const_t<V>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::conditional_t<Const, const V *, V *>;
+  using reference = std::conditional_t<Const, const V &, V &>;
+
+  // Constructors
+
+  BTreeIterator() noexcept = default;
+  BTreeIterator(Node *node, size_type position) noexcept;
+  template <bool Other, typename = std::enable_if_t<Const && !Other>>
+  BTreeIterator(const BTreeIterator<Other> &other) noexcept;
+
+  // Operators
+
+  reference operator*() const noexcept;
+  pointer operator->() const noexcept;
+  BTreeIterator &operator++() noexcept;
+  BTreeIterator operator++(int) noexcept;
+  BTreeIterator &operator--() noexcept;
+  BTreeIterator operator--(int) noexcept;
+
+  /**
+   * @brief Equality comparison operator for the B-tree iterator.
+   *
+   * @param[in] a The first iterator.
+   * @param[in] b The second iterator.
+   * @return true if both iterators point to the same position.
+   */
+  friend bool operator==(const BTreeIterator &a,
+                         const BTreeIterator &b) noexcept {
+    return a.node_ == b.node_ && a.position_ == b.position_;
+  }
+
+  /**
+   * @brief Inequality comparison operator for the B-tree iterator.
+   *
+   * @param[in] a The first iterator.
+   * @param[in] b The second iterator.
+   * @return true if the iterators point to different positions.
+   */
+  friend bool operator!=(const BTreeIterator &a,
+                         const BTreeIterator &b) noexcept {
+    return !(a == b);
+  }
+
+ private:
+  friend class btree;
+  template <bool>
+  friend class BTreeIterator;
+
+  // Fields
+
+  Node *node_{};         ///< Node of the element
+  size_type position_{};  ///< Index of the element in the node
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//                             BTREE CONSTRUCTORS                             //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Constructs an empty B-tree that uses the given allocator.
+ *
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+btree<K, V, KeyOf, Compare, Allocator, Multi>::btree(
+    const allocator_type &alloc)
+    : leaf_alloc_{alloc}, internal_alloc_{alloc} {}
+
+/**
+ * @brief Constructs an empty B-tree that orders the keys with comp.
+ *
+ * @param[in] comp The comparator of the keys.
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+btree<K, V, KeyOf, Compare, Allocator, Multi>::btree(
+    const key_compare &comp, const allocator_type &alloc)
+    : comp_{comp}, leaf_alloc_{alloc}, internal_alloc_{alloc} {}
+
+/**
+ * @brief Constructs a B-tree with the elements of an initializer list.
+ *
+ * @param[in] items The elements to insert.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+btree<K, V, KeyOf, Compare, Allocator, Multi>::btree(
+    std::initializer_list<value_type> const &items)
+    : btree(items.begin(), items.end()) {}
+
+/**
+ * @brief Constructs a B-tree with the elements of a range.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename InputIt>
+btree<K, V, KeyOf, Compare, Allocator, Multi>::btree(InputIt first,
+                                                     InputIt last)
+    : btree{} {
+  insert(first, last);
+}
+
+/**
+ * @brief Copy constructor for the B-tree.
+ *
+ * @details
+ * The nodes are cloned one by one in O(n), keeping the shape of other. The
+ * allocator is obtained through select_on_container_copy_construction().
+ *
+ * @param[in] other The B-tree to copy from.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+btree<K, V, KeyOf, Compare, Allocator, Multi>::btree(const btree &other)
+    : btree{other, allocator_type{
+                       leaf_traits::select_on_container_copy_construction(
+                           other.leaf_alloc_)}} {}
+
+/**
+ * @brief Copy constructor that takes the nodes from the given allocator.
+ *
+ * @param[in] other The B-tree to copy from.
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+btree<K, V, KeyOf, Compare, Allocator, Multi>::btree(
+    const btree &other, const allocator_type &alloc)
+    : comp_{other.comp_}, leaf_alloc_{alloc}, internal_alloc_{alloc} {
+  copyFrom(other);
+}
+
+/**
+ * @brief Move constructor for the B-tree.
+ *
+ * @details
+ * The nodes of other are adopted, and other is left empty.
+ *
+ * @param[in] other The B-tree to move from.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+btree<K, V, KeyOf, Compare, Allocator, Multi>::btree(btree &&other) noexcept
+    : root_{std::exchange(other.root_, nullptr)},
+      leftmost_{std::exchange(other.leftmost_, nullptr)},
+      rightmost_{std::exchange(other.rightmost_, nullptr)},
+      size_{std::exchange(other.size_, 0)},
+      comp_{other.comp_},
+      leaf_alloc_{other.leaf_alloc_},
+      internal_alloc_{other.internal_alloc_} {}
+
+/**
+ * @brief Copy assignment operator for the B-tree.
+ *
+ * @details
+ * The current elements are destroyed and the elements of other are cloned.
+ * The current allocator is kept.
+ *
+ * @param[in] other The B-tree to copy from.
+ * @return btree& - reference to the assigned B-tree.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::operator=(
+    const btree &other) -> btree & {
+  if (this != &other) {
+    clear();
+    comp_ = other.comp_;
+    copyFrom(other);
+  }
+
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator for the B-tree.
+ *
+ * @details
+ * The nodes of other are adopted when the allocator propagates on move
+ * assignment or both allocators are equal. Otherwise the elements are copied
+ * and other is cleared.
+ *
+ * @param[in] other The B-tree to move from.
+ * @return btree& - reference to the assigned B-tree.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::operator=(btree &&other)
+    -> btree & {
+  if (this == &other) {
+    return *this;
+  }
+
+  if (leaf_traits::propagate_on_container_move_assignment::value ||
+      leaf_alloc_ == other.leaf_alloc_) {
+    clear();
+    leaf_alloc_ = other.leaf_alloc_;
+    internal_alloc_ = other.internal_alloc_;
+    comp_ = other.comp_;
+    root_ = std::exchange(other.root_, nullptr);
+    leftmost_ = std::exchange(other.leftmost_, nullptr);
+    rightmost_ = std::exchange(other.rightmost_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  } else {
+    *this = other;
+    other.clear();
+  }
+
+  return *this;
+}
+
+/**
+ * @brief Destructor.
+ *
+ * @details
+ * Destroys all elements and frees the nodes.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+btree<K, V, KeyOf, Compare, Allocator, Multi>::~btree() {
+  clear();
+}
+
+/**
+ * @brief Returns a copy of the allocator of the B-tree.
+ *
+ * @return allocator_type - the allocator.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::get_allocator()
+    const noexcept -> allocator_type {
+  return allocator_type{leaf_alloc_};
+}
+
+/**
+ * @brief Returns the comparator of the keys.
+ *
+ * @return key_compare - the comparator.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::key_comp() const
+    -> key_compare {
+  return comp_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                              BTREE ITERATORS                               //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Returns an iterator to the smallest element.
+ *
+ * @return iterator - an iterator to the first element, or end() if the
+ * B-tree is empty.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::begin() const noexcept
+    -> iterator {
+  return iterator{leftmost_, 0};
+}
+
+/**
+ * @brief Returns an iterator past the largest element.
+ *
+ * @return iterator - an iterator to the end of the B-tree.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::end() const noexcept
+    -> iterator {
+  return iterator{rightmost_, (rightmost_) ? rightmost_->count : size_type{}};
+}
+
+/**
+ * @brief Returns a const iterator to the smallest element.
+ *
+ * @return const_iterator - an iterator to the first element.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::cbegin() const noexcept
+    -> const_iterator {
+  return begin();
+}
+
+/**
+ * @brief Returns a const iterator past the largest element.
+ *
+ * @return const_iterator - an iterator to the end of the B-tree.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::cend() const noexcept
+    -> const_iterator {
+  return end();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                               BTREE CAPACITY                               //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Checks whether the B-tree is empty.
+ *
+ * @return true if the B-tree has no elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+bool btree<K, V, KeyOf, Compare, Allocator, Multi>::empty() const noexcept {
+  return !size_;
+}
+
+/**
+ * @brief Returns the number of elements.
+ *
+ * @return size_type - the number of elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::size() const noexcept
+    -> size_type {
+  return size_;
+}
+
+/**
+ * @brief Returns the maximum number of elements the B-tree can hold.
+ *
+ * @return size_type - the maximum number of elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::max_size() const noexcept
+    -> size_type {
+  return std::numeric_limits<difference_type>::max() / sizeof(slot_type);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                              BTREE MODIFIERS                               //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Destroys all elements and frees all nodes.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::clear() noexcept {
+  destroySubtree(root_);
+  root_ = leftmost_ = rightmost_ = nullptr;
+  size_ = 0;
+}
+
+/**
+ * @brief Inserts a copy of the element.
+ *
+ * @details
+ * For a B-tree of unique keys nothing is inserted if an element with an
+ * equivalent key exists. Equivalent elements of a multi B-tree are inserted
+ * after the existing ones.
+ *
+ * @param[in] value The element to insert.
+ * @return insert_return - an iterator to the inserted element, paired with
+ * whether it was inserted for unique keys.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::insert(
+    const value_type &value) -> insert_return {
+  if constexpr (Multi) {
+    return emplace(value);
+  } else {
+    return emplaceKey(KeyOf{}(value), value);
+  }
+}
+
+/**
+ * @brief Inserts the element by moving it.
+ *
+ * @param[in] value The element to insert.
+ * @return insert_return - an iterator to the inserted element, paired with
+ * whether it was inserted for unique keys.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::insert(value_type &&value)
+    -> insert_return {
+  if constexpr (Multi) {
+    return emplace(std::move(value));
+  } else {
+    return emplaceKey(KeyOf{}(value), std::move(value));
+  }
+}
+
+/**
+ * @brief Inserts the elements of a range.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename InputIt>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::insert(InputIt first,
+                                                           InputIt last) {
+  for (; first != last; ++first) {
+    insert(*first);
+  }
+}
+
+/**
+ * @brief Constructs an element from the arguments and inserts it.
+ *
+ * @details
+ * The element is built first, because its key is needed to find its place.
+ *
+ * @tparam Args The types of the arguments.
+ * @param[in] args The arguments forwarded to the element constructor.
+ * @return insert_return - an iterator to the inserted element, paired with
+ * whether it was inserted for unique keys.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename... Args>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::emplace(Args &&...args)
+    -> insert_return {
+  slot_type value(std::forward<Args>(args)...);
+
+  if constexpr (Multi) {
+    if (!root_) {
+      root_ = leftmost_ = rightmost_ = newLeaf();
+    }
+
+    Node *node = root_;
+    size_type pos = upperIndex(node, KeyOf{}(value));
+
+    while (!node->leaf) {
+      node = childOf(node, pos);
+      pos = upperIndex(node, KeyOf{}(value));
+    }
+
+    return insertAt(node, pos, std::move(value));
+  } else {
+    return emplaceKey(KeyOf{}(value), std::move(value));
+  }
+}
+
+/**
+ * @brief Erases the element at the given position.
+ *
+ * @param[in] pos The position of the element to erase.
+ * @return iterator - an iterator to the element following the erased one.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::erase(const_iterator pos)
+    -> iterator {
+  return eraseAt(iterator{pos.node_, pos.position_});
+}
+
+/**
+ * @brief Erases the elements in the range [first, last).
+ *
+ * @details
+ * Erasing moves elements between nodes, so last is not used after the first
+ * erase; the elements are counted beforehand instead.
+ *
+ * @param[in] first The position of the first element to erase.
+ * @param[in] last The position following the last element to erase.
+ * @return iterator - an iterator to the element following the erased ones.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::erase(const_iterator first,
+                                                          const_iterator last)
+    -> iterator {
+  iterator it{first.node_, first.position_};
+
+  if (first == cbegin() && last == cend()) {
+    clear();
+    return end();
+  }
+
+  for (size_type count = std::distance(first, last); count; --count) {
+    it = eraseAt(it);
+  }
+
+  return it;
+}
+
+/**
+ * @brief Erases all elements with a key equivalent to the given one.
+ *
+ * @param[in] key The key of the elements to erase.
+ * @return size_type - the number of erased elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::erase(const key_type &key)
+    -> size_type {
+  iterator it = lowerBound(key);
+  size_type erased{};
+
+  while (it != end() && !comp_(key, KeyOf{}(*it))) {
+    it = eraseAt(it);
+    ++erased;
+  }
+
+  return erased;
+}
+
+/**
+ * @brief Exchanges the contents of the B-tree with those of other.
+ *
+ * @param[in,out] other The B-tree to exchange with.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::swap(
+    btree &other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(leftmost_, other.leftmost_);
+  std::swap(rightmost_, other.rightmost_);
+  std::swap(size_, other.size_);
+  std::swap(comp_, other.comp_);
+  std::swap(leaf_alloc_, other.leaf_alloc_);
+  std::swap(internal_alloc_, other.internal_alloc_);
+}
+
+/**
+ * @brief Moves the elements of other into the B-tree.
+ *
+ * @details
+ * For unique keys, the elements whose key already exists stay in other.
+ * Elements are moved one by one, because nodes of a B-tree can not be
+ * relinked individually.
+ *
+ * @param[in,out] other The B-tree to merge from.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::merge(btree &other) {
+  if (this == &other) {
+    return;
+  }
+
+  for (iterator it = other.begin(); it != other.end();) {
+    if (!Multi && contains(KeyOf{}(*it))) {
+      ++it;
+    } else {
+      insert(std::move(*it));
+      it = other.eraseAt(it);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                BTREE LOOKUP                                //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Finds an element with a key equivalent to the given one.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end() if there is none.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::find(
+    const key_type &key) const -> iterator {
+  return findKey(key);
+}
+
+/**
+ * @brief Checks whether an element with an equivalent key exists.
+ *
+ * @param[in] key The key to search for.
+ * @return true if there is such an element.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+bool btree<K, V, KeyOf, Compare, Allocator, Multi>::contains(
+    const key_type &key) const {
+  return findKey(key) != end();
+}
+
+/**
+ * @brief Counts the elements with a key equivalent to the given one.
+ *
+ * @param[in] key The key to search for.
+ * @return size_type - the number of such elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::count(
+    const key_type &key) const -> size_type {
+  return countKey(key);
+}
+
+/**
+ * @brief Returns the range of elements with an equivalent key.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator_range - the lower and the upper bound of the key.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::equal_range(
+    const key_type &key) const -> iterator_range {
+  return {lowerBound(key), upperBound(key)};
+}
+
+/**
+ * @brief Returns the first element whose key is not less than the given one.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::lower_bound(
+    const key_type &key) const -> iterator {
+  return lowerBound(key);
+}
+
+/**
+ * @brief Returns the first element whose key is greater than the given one.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::upper_bound(
+    const key_type &key) const -> iterator {
+  return upperBound(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                         HETEROGENEOUS BTREE LOOKUP                         //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Finds an element with a key equivalent to a key of another type.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end() if there is none.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::find(const Key &key) const
+    -> iterator {
+  return findKey(key);
+}
+
+/**
+ * @brief Checks whether an element with a key equivalent to a key of another
+ * type exists.
+ *
+ * @param[in] key The key to search for.
+ * @return true if there is such an element.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename>
+bool btree<K, V, KeyOf, Compare, Allocator, Multi>::contains(
+    const Key &key) const {
+  return findKey(key) != end();
+}
+
+/**
+ * @brief Counts the elements with a key equivalent to a key of another type.
+ *
+ * @param[in] key The key to search for.
+ * @return size_type - the number of such elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::count(const Key &key) const
+    -> size_type {
+  return countKey(key);
+}
+
+/**
+ * @brief Returns the range of elements with a key equivalent to a key of
+ * another type.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator_range - the lower and the upper bound of the key.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::equal_range(
+    const Key &key) const -> iterator_range {
+  return {lowerBound(key), upperBound(key)};
+}
+
+/**
+ * @brief Returns the first element whose key is not less than a key of
+ * another type.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::lower_bound(
+    const Key &key) const -> iterator {
+  return lowerBound(key);
+}
+
+/**
+ * @brief Returns the first element whose key is greater than a key of another
+ * type.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::upper_bound(
+    const Key &key) const -> iterator {
+  return upperBound(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                               ADD ELEMENTS                                 //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Inserts an element with the given key unless the key exists.
+ *
+ * @details
+ * A single descent looks for the key in every node on the way to a leaf. The
+ * element is only constructed, from args, when the key is new.
+ *
+ * @tparam Key The type of the key.
+ * @tparam Args The types of the arguments for the element constructor.
+ * @param[in] key The key of the new element.
+ * @param[in] args The arguments forwarded to the element constructor.
+ * @return insert_return - an iterator to the element with the key and
+ * whether it was inserted.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename... Args>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::emplaceKey(
+    const Key &key, Args &&...args) -> insert_return {
+  static_assert(!Multi, "emplaceKey() is only for unique keys");
+
+  if (!root_) {
+    root_ = leftmost_ = rightmost_ = newLeaf();
+  }
+
+  Node *node = root_;
+
+  while (true) {
+    size_type pos = lowerIndex(node, key);
+
+    if (pos < node->count && !comp_(key, KeyOf{}(*node->slot(pos)))) {
+      return {iterator{node, pos}, false};
+    } else if (node->leaf) {
+      return {insertAt(node, pos, std::forward<Args>(args)...), true};
+    }
+
+    node = childOf(node, pos);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   NODES                                    //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Allocates an empty leaf node.
+ *
+ * @return Node* - the new node.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::newLeaf() -> Node * {
+  Node *node = leaf_traits::allocate(leaf_alloc_, 1);
+
+  return ::new (static_cast<void *>(node)) Node;
+}
+
+/**
+ * @brief Allocates an empty internal node.
+ *
+ * @return Node* - the new node.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::newInternal() -> Node * {
+  InternalNode *node = internal_traits::allocate(internal_alloc_, 1);
+
+  ::new (static_cast<void *>(node)) InternalNode;
+  node->leaf = false;
+
+  return node;
+}
+
+/**
+ * @brief Frees a node without touching its elements.
+ *
+ * @param[in] node The node to free.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::deleteNode(
+    Node *node) noexcept {
+  if (node->leaf) {
+    leaf_traits::deallocate(leaf_alloc_, node, 1);
+  } else {
+    internal_traits::deallocate(internal_alloc_,
+                                static_cast<InternalNode *>(node), 1);
+  }
+}
+
+/**
+ * @brief Destroys the elements of a subtree and frees its nodes.
+ *
+ * @param[in] node The root of the subtree, may be nullptr.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::destroySubtree(
+    Node *node) noexcept {
+  if (!node) {
+    return;
+  }
+
+  if (!node->leaf) {
+    for (size_type i = 0; i <= node->count; ++i) {
+      destroySubtree(childOf(node, i));
+    }
+  }
+
+  if constexpr (!std::is_trivially_destructible_v<slot_type>) {
+    for (size_type i = 0; i < node->count; ++i) {
+      node->slot(i)->~slot_type();
+    }
+  }
+
+  deleteNode(node);
+}
+
+/**
+ * @brief Clones a subtree node by node.
+ *
+ * @details
+ * Each copy is linked to its parent as soon as it is created, so a partially
+ * built tree can be destroyed if copying an element throws.
+ *
+ * @param[in] node The root of the subtree to clone.
+ * @param[in] parent The parent of the copy.
+ * @return Node* - the root of the copy.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::cloneSubtree(
+    const Node *node, Node *parent) -> Node * {
+  Node *copy = (node->leaf) ? newLeaf() : newInternal();
+
+  copy->parent = parent;
+  copy->position = node->position;
+
+  if (parent) {
+    childOf(parent, node->position) = copy;
+  } else {
+    root_ = copy;
+  }
+
+  Node *source = const_cast<Node *>(node);
+
+  for (; copy->count < node->count; ++copy->count) {
+    ::new (static_cast<void *>(copy->slot(copy->count)))
+        slot_type(*source->slot(copy->count));
+    ++size_;
+  }
+
+  if (!node->leaf) {
+    for (size_type i = 0; i <= node->count; ++i) {
+      childOf(copy, i) = nullptr;
+    }
+
+    for (size_type i = 0; i <= node->count; ++i) {
+      cloneSubtree(childOf(source, i), copy);
+    }
+  }
+
+  return copy;
+}
+
+/**
+ * @brief Copies the elements of other into the empty B-tree.
+ *
+ * @param[in] other The B-tree to copy from.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::copyFrom(
+    const btree &other) {
+  if (!other.root_) {
+    return;
+  }
+
+  try {
+    cloneSubtree(other.root_, nullptr);
+  } catch (...) {
+    clear();
+    throw;
+  }
+
+  for (leftmost_ = root_; !leftmost_->leaf;) {
+    leftmost_ = childOf(leftmost_, 0);
+  }
+
+  for (rightmost_ = root_; !rightmost_->leaf;) {
+    rightmost_ = childOf(rightmost_, rightmost_->count);
+  }
+}
+
+/**
+ * @brief Returns the son of an internal node.
+ *
+ * @param[in] node The internal node.
+ * @param[in] index The index of the son.
+ * @return Node*& - a reference to the son pointer.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::childOf(
+    Node *node, size_type index) noexcept -> Node *& {
+  return static_cast<InternalNode *>(node)->children[index];
+}
+
+/**
+ * @brief Places a son into an internal node and updates its back links.
+ *
+ * @param[in] node The internal node.
+ * @param[in] index The index of the son.
+ * @param[in] child The son.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::setChild(
+    Node *node, size_type index, Node *child) noexcept {
+  childOf(node, index) = child;
+  child->parent = node;
+  child->position = static_cast<std::uint16_t>(index);
+}
+
+/**
+ * @brief Moves the elements [first, last) of a node to dest of another one.
+ *
+ * @details
+ * The source slots are left destroyed. Overlapping ranges of one node are
+ * handled. Trivially copyable elements are moved with a single memmove().
+ *
+ * @param[in] from The source node.
+ * @param[in] first The first slot to move.
+ * @param[in] last The slot after the last one to move.
+ * @param[in] to The destination node.
+ * @param[in] dest The first destination slot.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::moveSlots(
+    Node *from, size_type first, size_type last, Node *to,
+    size_type dest) noexcept {
+  if constexpr (std::is_trivially_copyable_v<slot_type>) {
+    if (first < last) {
+      std::memmove(to->storage + dest * sizeof(slot_type),
+                   from->storage + first * sizeof(slot_type),
+                   (last - first) * sizeof(slot_type));
+    }
+  } else if (from == to && dest > first) {
+    for (size_type i = last; i > first; --i) {
+      ::new (static_cast<void *>(to->slot(dest + i - 1 - first)))
+          slot_type(std::move(*from->slot(i - 1)));
+      from->slot(i - 1)->~slot_type();
+    }
+  } else {
+    for (size_type i = first; i < last; ++i) {
+      ::new (static_cast<void *>(to->slot(dest + i - first)))
+          slot_type(std::move(*from->slot(i)));
+      from->slot(i)->~slot_type();
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                 SEARCHING                                  //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Returns the index of the first element of a node not less than key.
+ *
+ * @param[in] node The node to search.
+ * @param[in] key The key to search for.
+ * @return size_type - the index, node->count if there is none.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::lowerIndex(
+    const Node *node, const Key &key) const -> size_type {
+  Node *source = const_cast<Node *>(node);
+  size_type low{};
+  size_type high = node->count;
+
+  while (low < high) {
+    size_type mid = (low + high) / 2;
+
+    if (comp_(KeyOf{}(*source->slot(mid)), key)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+/**
+ * @brief Returns the index of the first element of a node greater than key.
+ *
+ * @param[in] node The node to search.
+ * @param[in] key The key to search for.
+ * @return size_type - the index, node->count if there is none.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::upperIndex(
+    const Node *node, const Key &key) const -> size_type {
+  Node *source = const_cast<Node *>(node);
+  size_type low{};
+  size_type high = node->count;
+
+  while (low < high) {
+    size_type mid = (low + high) / 2;
+
+    if (comp_(key, KeyOf{}(*source->slot(mid)))) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+
+  return low;
+}
+
+/**
+ * @brief Finds the first element whose key is not less than the given one.
+ *
+ * @details
+ * The candidate found on a deeper level is always smaller than the one above
+ * it, so the last candidate on the path to a leaf is the answer.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::lowerBound(
+    const Key &key) const -> iterator {
+  iterator result = end();
+
+  for (Node *node = root_; node;) {
+    size_type pos = lowerIndex(node, key);
+
+    if (pos < node->count) {
+      result = iterator{node, pos};
+    }
+
+    node = (node->leaf) ? nullptr : childOf(node, pos);
+  }
+
+  return result;
+}
+
+/**
+ * @brief Finds the first element whose key is greater than the given one.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::upperBound(
+    const Key &key) const -> iterator {
+  iterator result = end();
+
+  for (Node *node = root_; node;) {
+    size_type pos = upperIndex(node, key);
+
+    if (pos < node->count) {
+      result = iterator{node, pos};
+    }
+
+    node = (node->leaf) ? nullptr : childOf(node, pos);
+  }
+
+  return result;
+}
+
+/**
+ * @brief Finds an element with an equivalent key.
+ *
+ * @details
+ * For unique keys the descent stops at the first node that holds the key.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::findKey(
+    const Key &key) const -> iterator {
+  if constexpr (Multi) {
+    iterator it = lowerBound(key);
+
+    return (it != end() && !comp_(key, KeyOf{}(*it))) ? it : end();
+  } else {
+    for (Node *node = root_; node;) {
+      size_type pos = lowerIndex(node, key);
+
+      if (pos < node->count && !comp_(key, KeyOf{}(*node->slot(pos)))) {
+        return iterator{node, pos};
+      }
+
+      node = (node->leaf) ? nullptr : childOf(node, pos);
+    }
+
+    return end();
+  }
+}
+
+/**
+ * @brief Counts the elements with an equivalent key.
+ *
+ * @param[in] key The key to search for.
+ * @return size_type - the number of such elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::countKey(
+    const Key &key) const -> size_type {
+  if constexpr (Multi) {
+    return std::distance(lowerBound(key), upperBound(key));
+  } else {
+    return findKey(key) != end();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                 INSERTING                                  //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Constructs an element at the given position of a leaf.
+ *
+ * @details
+ * A full leaf is split first (see makeRoom()). The elements after the
+ * position are shifted right and the new element is constructed in the
+ * freed slot; if that throws, they are shifted back.
+ *
+ * @tparam Args The types of the arguments for the element constructor.
+ * @param[in] node The leaf to insert into.
+ * @param[in] pos The index of the new element in the leaf.
+ * @param[in] args The arguments forwarded to the element constructor.
+ * @return iterator - an iterator to the new element.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename... Args>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::insertAt(Node *node,
+                                                             size_type pos,
+                                                             Args &&...args)
+    -> iterator {
+  makeRoom(node, pos);
+  moveSlots(node, pos, node->count, node, pos + 1);
+
+  try {
+    ::new (static_cast<void *>(node->slot(pos)))
+        slot_type(std::forward<Args>(args)...);
+  } catch (...) {
+    moveSlots(node, pos + 1, node->count + 1, node, pos);
+    throw;
+  }
+
+  ++node->count;
+  ++size_;
+
+  return iterator{node, pos};
+}
+
+/**
+ * @brief Makes sure a node has a free slot.
+ *
+ * @details
+ * A full node is split in two halves around its middle element, which moves
+ * up to the parent. The parent gets room first, and a full root grows a new
+ * root above it, so the tree only becomes higher at the top. The node and the
+ * position are moved to the half that gets the new element.
+ *
+ * @param[in,out] node The node that needs a free slot.
+ * @param[in,out] pos The position of the new element in the node.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::makeRoom(Node *&node,
+                                                             size_type &pos) {
+  if (node->count < kSlots) {
+    return;
+  }
+
+  if (node == root_) {
+    Node *root = newInternal();
+
+    setChild(root, 0, node);
+    root_ = root;
+  } else {
+    Node *parent = node->parent;
+    size_type parent_pos = node->position;
+
+    makeRoom(parent, parent_pos);
+  }
+
+  splitNode(node);
+
+  if (pos > kSlots / 2) {
+    pos -= kSlots / 2 + 1;
+    node = childOf(node->parent, node->position + 1);
+  }
+}
+
+/**
+ * @brief Splits a full node whose parent has a free slot.
+ *
+ * @details
+ * The upper half of the elements (and sons) moves to a new right sibling and
+ * the middle element is inserted into the parent between the two halves.
+ *
+ * @param[in] node The full node to split.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::splitNode(Node *node) {
+  constexpr size_type mid = kSlots / 2;
+  Node *sibling = (node->leaf) ? newLeaf() : newInternal();
+  Node *parent = node->parent;
+  size_type at = node->position;
+
+  moveSlots(node, mid + 1, kSlots, sibling, 0);
+  sibling->count = static_cast<std::uint16_t>(kSlots - mid - 1);
+
+  if (!node->leaf) {
+    for (size_type i = 0; i <= sibling->count; ++i) {
+      setChild(sibling, i, childOf(node, mid + 1 + i));
+    }
+  }
+
+  moveSlots(parent, at, parent->count, parent, at + 1);
+
+  for (size_type i = parent->count + 1; i > at + 1; --i) {
+    setChild(parent, i, childOf(parent, i - 1));
+  }
+
+  moveSlots(node, mid, mid + 1, parent, at);
+  setChild(parent, at + 1, sibling);
+  ++parent->count;
+  node->count = static_cast<std::uint16_t>(mid);
+
+  if (rightmost_ == node) {
+    rightmost_ = sibling;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                  ERASING                                   //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Erases the element at the given position.
+ *
+ * @details
+ * An element of an internal node is replaced by its predecessor, which is
+ * the last element of a leaf, so elements are only ever removed from leaves.
+ * The leaf is then rebalanced (see rebalance()) while an iterator keeps track
+ * of the position following the removed element.
+ *
+ * @param[in] pos The position of the element to erase.
+ * @return iterator - an iterator to the element following the erased one.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::eraseAt(
+    iterator pos) noexcept -> iterator {
+  Node *node = pos.node_;
+  size_type index = pos.position_;
+  bool internal = !node->leaf;
+
+  node->slot(index)->~slot_type();
+
+  if (internal) {
+    iterator prev = pos;
+    --prev;
+    moveSlots(prev.node_, prev.position_, prev.position_ + 1, node, index);
+    node = prev.node_;
+    index = prev.position_;
+  } else {
+    moveSlots(node, index + 1, node->count, node, index);
+  }
+
+  --node->count;
+  --size_;
+
+  if (!size_) {
+    clear();
+    return end();
+  }
+
+  iterator tracked{node, index};
+
+  rebalance(node, tracked);
+
+  if (tracked.position_ == tracked.node_->count) {
+    Node *up = tracked.node_;
+    size_type up_pos = tracked.position_;
+
+    while (up->parent && up_pos == up->count) {
+      up_pos = up->position;
+      up = up->parent;
+    }
+
+    tracked = (up_pos < up->count) ? iterator{up, up_pos} : end();
+  }
+
+  return (internal) ? ++tracked : tracked;
+}
+
+/**
+ * @brief Restores the minimum fill of a node after an element was removed.
+ *
+ * @details
+ * A node below kMinSlots elements borrows one from a sibling that has more
+ * than kMinSlots, or is merged with a sibling otherwise, which removes an
+ * element from the parent and may underfill it in turn. A root without
+ * elements is replaced by its only son.
+ *
+ * @param[in] node The node that lost an element.
+ * @param[in,out] tracked The position to keep track of; it is moved along
+ * with the elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::rebalance(
+    Node *node, iterator &tracked) noexcept {
+  while (node != root_ && node->count < kMinSlots) {
+    Node *parent = node->parent;
+    size_type at = node->position;
+    Node *left = (at > 0) ? childOf(parent, at - 1) : nullptr;
+    Node *right = (at < parent->count) ? childOf(parent, at + 1) : nullptr;
+
+    if (left && left->count > kMinSlots) {
+      borrowLeft(node, left, tracked);
+      return;
+    } else if (right && right->count > kMinSlots) {
+      borrowRight(node, right);
+      return;
+    }
+
+    if (left) {
+      mergeNodes(left, node, tracked);
+    } else {
+      mergeNodes(node, right, tracked);
+    }
+
+    node = parent;
+  }
+
+  if (!root_->count && !root_->leaf) {
+    Node *old_root = root_;
+
+    root_ = childOf(old_root, 0);
+    root_->parent = nullptr;
+    root_->position = 0;
+    deleteNode(old_root);
+  }
+}
+
+/**
+ * @brief Moves the last element of the left sibling through the parent into
+ * the node.
+ *
+ * @param[in] node The underfilled node.
+ * @param[in] left The left sibling of the node.
+ * @param[in,out] tracked The position to keep track of.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::borrowLeft(
+    Node *node, Node *left, iterator &tracked) noexcept {
+  Node *parent = node->parent;
+  size_type at = node->position;
+
+  moveSlots(node, 0, node->count, node, 1);
+  moveSlots(parent, at - 1, at, node, 0);
+  moveSlots(left, left->count - 1, left->count, parent, at - 1);
+
+  if (!node->leaf) {
+    for (size_type i = node->count + 1; i > 0; --i) {
+      setChild(node, i, childOf(node, i - 1));
+    }
+
+    setChild(node, 0, childOf(left, left->count));
+  }
+
+  --left->count;
+  ++node->count;
+
+  if (tracked.node_ == node) {
+    ++tracked.position_;
+  }
+}
+
+/**
+ * @brief Moves the first element of the right sibling through the parent
+ * into the node.
+ *
+ * @param[in] node The underfilled node.
+ * @param[in] right The right sibling of the node.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::borrowRight(
+    Node *node, Node *right) noexcept {
+  Node *parent = node->parent;
+  size_type at = node->position;
+
+  moveSlots(parent, at, at + 1, node, node->count);
+  moveSlots(right, 0, 1, parent, at);
+  moveSlots(right, 1, right->count, right, 0);
+
+  if (!node->leaf) {
+    setChild(node, node->count + 1, childOf(right, 0));
+
+    for (size_type i = 0; i < right->count; ++i) {
+      setChild(right, i, childOf(right, i + 1));
+    }
+  }
+
+  --right->count;
+  ++node->count;
+}
+
+/**
+ * @brief Merges a node with its right sibling and the element between them.
+ *
+ * @param[in] left The node that receives the elements.
+ * @param[in] right The right sibling, freed afterwards.
+ * @param[in,out] tracked The position to keep track of.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void btree<K, V, KeyOf, Compare, Allocator, Multi>::mergeNodes(
+    Node *left, Node *right, iterator &tracked) noexcept {
+  Node *parent = left->parent;
+  size_type at = left->position;
+  size_type base = left->count;
+
+  moveSlots(parent, at, at + 1, left, base);
+  moveSlots(right, 0, right->count, left, base + 1);
+
+  if (!left->leaf) {
+    for (size_type i = 0; i <= right->count; ++i) {
+      setChild(left, base + 1 + i, childOf(right, i));
+    }
+  }
+
+  left->count = static_cast<std::uint16_t>(base + 1 + right->count);
+  moveSlots(parent, at + 1, parent->count, parent, at);
+
+  for (size_type i = at + 1; i < parent->count; ++i) {
+    setChild(parent, i, childOf(parent, i + 1));
+  }
+
+  --parent->count;
+
+  if (tracked.node_ == right) {
+    tracked = iterator{left, base + 1 + tracked.position_};
+  }
+
+  if (rightmost_ == right) {
+    rightmost_ = left;
+  }
+
+  deleteNode(right);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                          BTREE ITERATOR OPERATORS                          //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Constructs an iterator to the element of a node.
+ *
+ * @param[in] node The node of the element.
+ * @param[in] position The index of the element in the node.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <bool Const>
+btree<K, V, KeyOf, Compare, Allocator, Multi>::BTreeIterator<
+    Const>::BTreeIterator(Node *node, size_type position) noexcept
+    : node_{node}, position_{position} {}
+
+/**
+ * @brief Converts an iterator to a const iterator.
+ *
+ * @param[in] other The iterator to convert.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <bool Const>
+template <bool Other, typename>
+btree<K, V, KeyOf, Compare, Allocator, Multi>::BTreeIterator<
+    Const>::BTreeIterator(const BTreeIterator<Other> &other) noexcept
+    : node_{other.node_}, position_{other.position_} {}
+
+/**
+ * @brief Dereference operator for the B-tree iterator.
+ *
+ * @return reference - reference to the element.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <bool Const>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::BTreeIterator<
+    Const>::operator*() const noexcept -> reference {
+  return *node_->slot(position_);
+}
+
+/**
+ * @brief Member access operator for the B-tree iterator.
+ *
+ * @return pointer - pointer to the element.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <bool Const>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::BTreeIterator<
+    Const>::operator->() const noexcept -> pointer {
+  return node_->slot(position_);
+}
+
+/**
+ * @brief Moves the iterator to the next element.
+ *
+ * @details
+ * From an internal node the next element is the first one of the leftmost
+ * leaf of the next son. From the end of a leaf the iterator climbs up to the
+ * first ancestor that has an element to the right. Past the last element the
+ * iterator stays at the end of the rightmost leaf, which is end().
+ *
+ * @return BTreeIterator& - reference to the iterator.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <bool Const>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::BTreeIterator<
+    Const>::operator++() noexcept -> BTreeIterator & {
+  if (!node_->leaf) {
+    node_ = childOf(node_, position_ + 1);
+
+    while (!node_->leaf) {
+      node_ = childOf(node_, 0);
+    }
+
+    position_ = 0;
+  } else if (++position_ == node_->count) {
+    Node *node = node_;
+    size_type position = position_;
+
+    while (node->parent && position == node->count) {
+      position = node->position;
+      node = node->parent;
+    }
+
+    if (position < node->count) {
+      node_ = node;
+      position_ = position;
+    }
+  }
+
+  return *this;
+}
+
+/**
+ * @brief Post-increment operator for the B-tree iterator.
+ *
+ * @return BTreeIterator - the iterator before the increment.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <bool Const>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::BTreeIterator<
+    Const>::operator++(int) noexcept -> BTreeIterator {
+  BTreeIterator copy{*this};
+
+  ++*this;
+
+  return copy;
+}
+
+/**
+ * @brief Moves the iterator to the previous element.
+ *
+ * @details
+ * Mirrors operator++(). Decrementing end() gives the last element.
+ *
+ * @return BTreeIterator& - reference to the iterator.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <bool Const>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::BTreeIterator<
+    Const>::operator--() noexcept -> BTreeIterator & {
+  if (!node_->leaf) {
+    node_ = childOf(node_, position_);
+
+    while (!node_->leaf) {
+      node_ = childOf(node_, node_->count);
+    }
+
+    position_ = node_->count - 1;
+  } else if (position_) {
+    --position_;
+  } else {
+    Node *node = node_;
+    size_type position = position_;
+
+    while (node->parent && !position) {
+      position = node->position;
+      node = node->parent;
+    }
+
+    if (position) {
+      node_ = node;
+      position_ = position - 1;
+    }
+  }
+
+  return *this;
+}
+
+/**
+ * @brief Post-decrement operator for the B-tree iterator.
+ *
+ * @return BTreeIterator - the iterator before the decrement.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <bool Const>
+auto btree<K, V, KeyOf, Compare, Allocator, Multi>::BTreeIterator<
+    Const>::operator--(int) noexcept -> BTreeIterator {
+  BTreeIterator copy{*this};
+
+  --*this;
+
+  return copy;
+}
+
+}  // namespace s21
+
+#endif  // SRC_CONTAINERS_BTREE_H_
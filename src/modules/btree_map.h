@@ -0,0 +1,155 @@
+/**
+ * @file btree_map.h
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Header for the B-tree based map container.
+ * @version 1.0
+ * @date 2024-08-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_CONTAINERS_BTREE_MAP_H_
+#define SRC_CONTAINERS_BTREE_MAP_H_
+
+#include <stdexcept>  // for out_of_range
+#include <tuple>      // for forward_as_tuple()
+#include <utility>    // for pair, piecewise_construct
+
+#include "./btree.h"
+
+/// @brief Namespace for working with containers
+namespace s21 {
+
+/**
+ * @brief A B-tree based map container template class.
+ *
+ * @details
+ * This template class btree_map provides the interface of map, but keeps its
+ * elements in the cache-friendly nodes of a btree instead of a red-black
+ * tree. Lookups and in-order traversals touch far fewer cache lines, at the
+ * cost of invalidating iterators on every insert and erase.
+ *
+ * @tparam K The type of keys stored in the map.
+ * @tparam M The type of values stored in the map.
+ * @tparam Compare The strict weak ordering of the keys.
+ * @tparam Allocator The allocator type used for the nodes of the map.
+ */
+template <typename K, typename M, typename Compare = std::less<K>,
+          typename Allocator = std::allocator<std::pair<K, M>>>
+class btree_map : public btree<K, std::pair<K, M>, select_first, Compare,
+                               Allocator, false> {
+  using base = btree<K, std::pair<K, M>, select_first, Compare, Allocator,
+                     false>;  ///< Underlying B-tree
+
+ public:
+  // Type aliases
+
+  using mapped_type = M;                          ///< Type of values
+  using key_type = typename base::key_type;       ///< Type of keys
+  using iterator = typename base::iterator;       ///< For read/write elements
+  using iterator_bool = std::pair<iterator, bool>;  ///< Pair iterator-bool
+
+  // Constructors
+
+  using base::base;
+  btree_map() = default;
+
+  // Element access
+
+  mapped_type &at(const key_type &key) const;
+  mapped_type &operator[](const key_type &key);
+
+  // Modifiers
+
+  using base::insert;
+  iterator_bool insert(const key_type &key, const mapped_type &obj);
+  iterator_bool insert_or_assign(const key_type &key, const mapped_type &obj);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//                          BTREE MAP ELEMENT ACCESS                          //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Accesses the value associated with a given key.
+ *
+ * @param[in] key The key to search for.
+ * @return mapped_type& - reference to the value associated with the key.
+ * @throws std::out_of_range if the key is not found.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto btree_map<K, M, Compare, Allocator>::at(const key_type &key) const
+    -> mapped_type & {
+  auto it = this->find(key);
+
+  if (it == this->end()) {
+    throw std::out_of_range("btree_map::at() - missing element");
+  }
+
+  return (*it).second;
+}
+
+/**
+ * @brief Accesses or inserts a value associated with a given key.
+ *
+ * @details
+ * The key is searched and, if missing, inserted in one descent. The element
+ * is built piecewise in its slot, so the value is only value-initialized when
+ * the element is new and a hit constructs nothing.
+ *
+ * @param[in] key The key to search for.
+ * @return mapped_type& - reference to the value associated with the key.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto btree_map<K, M, Compare, Allocator>::operator[](const key_type &key)
+    -> mapped_type & {
+  iterator_bool result =
+      this->emplaceKey(key, std::piecewise_construct,
+                       std::forward_as_tuple(key), std::forward_as_tuple());
+
+  return (*result.first).second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                            BTREE MAP MODIFIERS                             //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Inserts an element with the given key and value.
+ *
+ * @param[in] key The key of the element to insert.
+ * @param[in] obj The value of the element to insert.
+ * @return iterator_bool - an iterator to the element with the key and whether
+ * the insertion took place.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto btree_map<K, M, Compare, Allocator>::insert(const key_type &key,
+                                                 const mapped_type &obj)
+    -> iterator_bool {
+  return this->emplaceKey(key, key, obj);
+}
+
+/**
+ * @brief Inserts an element or assigns the value of an existing one.
+ *
+ * @param[in] key The key of the element to insert or assign.
+ * @param[in] obj The value of the element to insert or assign.
+ * @return iterator_bool - an iterator to the element with the key and whether
+ * the insertion took place.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto btree_map<K, M, Compare, Allocator>::insert_or_assign(
+    const key_type &key, const mapped_type &obj) -> iterator_bool {
+  iterator_bool result = this->emplaceKey(key, key, obj);
+
+  if (!result.second) {
+    (*result.first).second = obj;
+  }
+
+  return result;
+}
+
+}  // namespace s21
+
+#endif  // SRC_CONTAINERS_BTREE_MAP_H_
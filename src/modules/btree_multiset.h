@@ -0,0 +1,48 @@
+/**
+ * @file btree_multiset.h
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Header for the B-tree based multiset container.
+ * @version 1.0
+ * @date 2024-08-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_CONTAINERS_BTREE_MULTISET_H_
+#define SRC_CONTAINERS_BTREE_MULTISET_H_
+
+#include "./btree.h"
+
+/// @brief Namespace for working with containers
+namespace s21 {
+
+/**
+ * @brief A B-tree based multiset container template class.
+ *
+ * @details
+ * This template class btree_multiset provides the interface of multiset,
+ * keeping its keys in the cache-friendly nodes of a btree. Equivalent keys
+ * are kept in the order of insertion.
+ *
+ * @tparam K The type of keys stored in the multiset.
+ * @tparam Compare The strict weak ordering of the keys.
+ * @tparam Allocator The allocator type used for the nodes of the multiset.
+ */
+template <typename K, typename Compare = std::less<K>,
+          typename Allocator = std::allocator<K>>
+class btree_multiset
+    : public btree<K, const K, select_self, Compare, Allocator, true> {
+  using base = btree<K, const K, select_self, Compare, Allocator,
+                     true>;  ///< Underlying B-tree
+
+ public:
+  // Constructors
+
+  using base::base;
+  btree_multiset() = default;
+};
+
+}  // namespace s21
+
+#endif  // SRC_CONTAINERS_BTREE_MULTISET_H_
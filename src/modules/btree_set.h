@@ -0,0 +1,48 @@
+/**
+ * @file btree_set.h
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Header for the B-tree based set container.
+ * @version 1.0
+ * @date 2024-08-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_CONTAINERS_BTREE_SET_H_
+#define SRC_CONTAINERS_BTREE_SET_H_
+
+#include "./btree.h"
+
+/// @brief Namespace for working with containers
+namespace s21 {
+
+/**
+ * @brief A B-tree based set container template class.
+ *
+ * @details
+ * This template class btree_set provides the interface of set, keeping its
+ * unique keys in the cache-friendly nodes of a btree. The elements are
+ * read-only through every iterator.
+ *
+ * @tparam K The type of keys stored in the set.
+ * @tparam Compare The strict weak ordering of the keys.
+ * @tparam Allocator The allocator type used for the nodes of the set.
+ */
+template <typename K, typename Compare = std::less<K>,
+          typename Allocator = std::allocator<K>>
+class btree_set
+    : public btree<K, const K, select_self, Compare, Allocator, false> {
+  using base = btree<K, const K, select_self, Compare, Allocator,
+                     false>;  ///< Underlying B-tree
+
+ public:
+  // Constructors
+
+  using base::base;
+  btree_set() = default;
+};
+
+}  // namespace s21
+
+#endif  // SRC_CONTAINERS_BTREE_SET_H_
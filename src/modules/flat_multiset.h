@@ -0,0 +1,48 @@
+/**
+ * @file flat_multiset.h
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Header for the sorted vector based multiset container.
+ * @version 1.0
+ * @date 2024-08-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_CONTAINERS_FLAT_MULTISET_H_
+#define SRC_CONTAINERS_FLAT_MULTISET_H_
+
+#include "./flat_tree.h"
+
+/// @brief Namespace for working with containers
+namespace s21 {
+
+/**
+ * @brief A sorted vector based multiset container template class.
+ *
+ * @details
+ * This template class flat_multiset provides the interface of multiset,
+ * keeping its keys sorted in one contiguous flat_tree. Equivalent keys
+ * are kept in the order of insertion.
+ *
+ * @tparam K The type of keys stored in the multiset.
+ * @tparam Compare The strict weak ordering of the keys.
+ * @tparam Allocator The allocator type used for the storage of the multiset.
+ */
+template <typename K, typename Compare = std::less<K>,
+          typename Allocator = std::allocator<K>>
+class flat_multiset
+    : public flat_tree<K, const K, select_self, Compare, Allocator, true> {
+  using base = flat_tree<K, const K, select_self, Compare, Allocator,
+                         true>;  ///< Underlying flat tree
+
+ public:
+  // Constructors
+
+  using base::base;
+  flat_multiset() = default;
+};
+
+}  // namespace s21
+
+#endif  // SRC_CONTAINERS_FLAT_MULTISET_H_
@@ -0,0 +1,48 @@
+/**
+ * @file flat_set.h
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Header for the sorted vector based set container.
+ * @version 1.0
+ * @date 2024-08-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_CONTAINERS_FLAT_SET_H_
+#define SRC_CONTAINERS_FLAT_SET_H_
+
+#include "./flat_tree.h"
+
+/// @brief Namespace for working with containers
+namespace s21 {
+
+/**
+ * @brief A sorted vector based set container template class.
+ *
+ * @details
+ * This template class flat_set provides the interface of set, keeping its
+ * unique keys sorted in one contiguous flat_tree. The elements are
+ * read-only through every iterator.
+ *
+ * @tparam K The type of keys stored in the set.
+ * @tparam Compare The strict weak ordering of the keys.
+ * @tparam Allocator The allocator type used for the storage of the set.
+ */
+template <typename K, typename Compare = std::less<K>,
+          typename Allocator = std::allocator<K>>
+class flat_set
+    : public flat_tree<K, const K, select_self, Compare, Allocator, false> {
+  using base = flat_tree<K, const K, select_self, Compare, Allocator,
+                         false>;  ///< Underlying flat tree
+
+ public:
+  // Constructors
+
+  using base::base;
+  flat_set() = default;
+};
+
+}  // namespace s21
+
+#endif  // SRC_CONTAINERS_FLAT_SET_H_
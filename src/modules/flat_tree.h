@@ -0,0 +1,892 @@
+/**
+ * @file flat_tree.h
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Header for the sorted vector container
+ * @version 1.0
+ * @date 2024-08-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_CONTAINERS_FLAT_TREE_H_
+#define SRC_CONTAINERS_FLAT_TREE_H_
+
+#include <algorithm>         // for lower_bound(), stable_sort(), unique()
+#include <functional>        // for less
+#include <initializer_list>  // for init_list type
+#include <iterator>          // for distance()
+#include <memory>            // for allocator, allocator_traits
+#include <type_traits>       // for conditional_t, remove_const_t
+#include <utility>           // for pair, move(), forward()
+
+#include "./tree.h"
+#include "./vector.h"
+
+/// @brief Namespace for working with containers
+namespace s21 {
+
+/**
+ * @brief A sorted vector container template class.
+ *
+ * @details
+ * This template class flat_tree keeps its elements sorted in one contiguous
+ * s21::vector and finds them by binary search. There are no nodes, so an
+ * element takes exactly sizeof(value_type) bytes plus the spare capacity, and
+ * lookups and traversals only touch the elements themselves. It is the common
+ * base of flat_map, flat_set and flat_multiset.
+ *
+ * Inserting or erasing a single element shifts the elements after it, O(n);
+ * a range of elements is inserted in one pass (see insert()). Every insert
+ * and erase invalidates the iterators.
+ *
+ * @tparam K The type of keys.
+ * @tparam V The type of elements, containing or being the key.
+ * @tparam KeyOf The callable returning the key of an element.
+ * @tparam Compare The strict weak ordering of the keys.
+ * @tparam Allocator The allocator type, rebound to the stored element type.
+ * @tparam Multi Whether equivalent keys are allowed.
+ */
+template <typename K, typename V, typename KeyOf,
+          typename Compare = std::less<K>,
+          typename Allocator = std::allocator<V>, bool Multi = false>
+class flat_tree {
+  // Type aliases
+
+  using slot_type = std::remove_const_t<V>;
+  using storage_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<slot_type>;
+  using storage_type = vector<slot_type, storage_allocator>;
+
+ public:
+  // Type aliases
+
+  using key_type = K;                          ///< Type of keys
+  using value_type = V;                        ///< Type of elements
+  using reference = value_type &;              ///< Reference to element
+  using const_reference = const value_type &;  ///< Const reference to element
+  using size_type = std::size_t;               ///< Containers size type
+  using allocator_type = Allocator;            ///< Allocator of elements
+  using key_compare = Compare;                 ///< Ordering of keys
+  using iterator = value_type *;               ///< For read/write elements
+  using const_iterator = const value_type *;   ///< For read elements
+  using iterator_range = std::pair<iterator, iterator>;  ///< Pair of bounds
+  using insert_return =                                  ///< Result of insert
+      std::conditional_t<Multi, iterator, std::pair<iterator, bool>>;
+
+  // Constructors/assignment operators/destructor
+
+  flat_tree() = default;
+  explicit flat_tree(const allocator_type &alloc);
+  explicit flat_tree(const key_compare &comp,
+                     const allocator_type &alloc = allocator_type{});
+  flat_tree(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  flat_tree(InputIt first, InputIt last);
+  allocator_type get_allocator() const noexcept;
+  key_compare key_comp() const;
+
+  // Iterators
+
+  iterator begin() const noexcept;
+  iterator end() const noexcept;
+  const_iterator cbegin() const noexcept;
+  const_iterator cend() const noexcept;
+
+  // Capacity
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  void reserve(size_type size);
+  size_type capacity() const noexcept;
+  void shrink_to_fit();
+
+  // Modifiers
+
+  void clear() noexcept;
+  insert_return insert(const value_type &value);
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+  template <typename... Args>
+  insert_return emplace(Args &&...args);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key);
+  void swap(flat_tree &other) noexcept;
+  void merge(flat_tree &other);
+
+  // Lookup
+
+  iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  iterator_range equal_range(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+
+  // Heterogeneous lookup
+
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator find(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  bool contains(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  size_type count(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator_range equal_range(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator lower_bound(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator upper_bound(const Key &key) const;
+
+ protected:
+  // Add elements
+
+  template <typename Key, typename... Args>
+  insert_return emplaceKey(const Key &key, Args &&...args);
+
+ private:
+  // Fields
+
+  storage_type items_{};  ///< Sorted elements
+  Compare comp_{};        ///< Ordering of keys
+
+  // Searching
+
+  template <typename Key>
+  iterator lowerBound(const Key &key) const;
+  template <typename Key>
+  iterator upperBound(const Key &key) const;
+  template <typename Key>
+  iterator findKey(const Key &key) const;
+
+  // Inserting
+
+  void mergeTail(size_type sorted, bool sort_tail);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//                           FLAT TREE CONSTRUCTORS                           //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Constructs an empty flat tree that uses the given allocator.
+ *
+ * @param[in] alloc The allocator of the storage.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::flat_tree(
+    const allocator_type &alloc)
+    : items_(storage_allocator{alloc}) {}
+
+/**
+ * @brief Constructs an empty flat tree that orders the keys with comp.
+ *
+ * @param[in] comp The comparator of the keys.
+ * @param[in] alloc The allocator of the storage.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::flat_tree(
+    const key_compare &comp, const allocator_type &alloc)
+    : items_(storage_allocator{alloc}), comp_{comp} {}
+
+/**
+ * @brief Constructs a flat tree with the elements of an initializer list.
+ *
+ * @param[in] items The elements to insert.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::flat_tree(
+    std::initializer_list<value_type> const &items)
+    : flat_tree(items.begin(), items.end()) {}
+
+/**
+ * @brief Constructs a flat tree with the elements of a range.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename InputIt>
+flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::flat_tree(InputIt first,
+                                                             InputIt last)
+    : flat_tree{} {
+  insert(first, last);
+}
+
+/**
+ * @brief Returns a copy of the allocator of the flat tree.
+ *
+ * @return allocator_type - the allocator.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::get_allocator()
+    const noexcept -> allocator_type {
+  return allocator_type{items_.get_allocator()};
+}
+
+/**
+ * @brief Returns the comparator of the keys.
+ *
+ * @return key_compare - the comparator.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::key_comp() const
+    -> key_compare {
+  return comp_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                            FLAT TREE ITERATORS                             //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Returns an iterator to the smallest element.
+ *
+ * @return iterator - a pointer to the first element.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::begin() const noexcept
+    -> iterator {
+  return items_.data();
+}
+
+/**
+ * @brief Returns an iterator past the largest element.
+ *
+ * @return iterator - a pointer past the last element.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::end() const noexcept
+    -> iterator {
+  return items_.data() + items_.size();
+}
+
+/**
+ * @brief Returns a const iterator to the smallest element.
+ *
+ * @return const_iterator - a pointer to the first element.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::cbegin()
+    const noexcept -> const_iterator {
+  return begin();
+}
+
+/**
+ * @brief Returns a const iterator past the largest element.
+ *
+ * @return const_iterator - a pointer past the last element.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::cend() const noexcept
+    -> const_iterator {
+  return end();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                             FLAT TREE CAPACITY                             //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Checks whether the flat tree is empty.
+ *
+ * @return true if the flat tree has no elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+bool flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::empty()
+    const noexcept {
+  return items_.empty();
+}
+
+/**
+ * @brief Returns the number of elements.
+ *
+ * @return size_type - the number of elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::size() const noexcept
+    -> size_type {
+  return items_.size();
+}
+
+/**
+ * @brief Returns the maximum number of elements the flat tree can hold.
+ *
+ * @return size_type - the maximum number of elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::max_size()
+    const noexcept -> size_type {
+  return items_.max_size();
+}
+
+/**
+ * @brief Reserves storage for at least size elements.
+ *
+ * @param[in] size The number of elements to reserve storage for.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::reserve(
+    size_type size) {
+  items_.reserve(size);
+}
+
+/**
+ * @brief Returns the number of elements the storage can hold.
+ *
+ * @return size_type - the capacity of the storage.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::capacity()
+    const noexcept -> size_type {
+  return items_.capacity();
+}
+
+/**
+ * @brief Frees the spare capacity of the storage.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::shrink_to_fit() {
+  items_.shrink_to_fit();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                            FLAT TREE MODIFIERS                             //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Removes all elements, keeping the capacity.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::clear() noexcept {
+  items_.clear();
+}
+
+/**
+ * @brief Inserts a copy of the element.
+ *
+ * @details
+ * For unique keys nothing is inserted if an element with an equivalent key
+ * exists. Equivalent elements of a multi flat tree are inserted after the
+ * existing ones.
+ *
+ * @param[in] value The element to insert.
+ * @return insert_return - an iterator to the inserted element, paired with
+ * whether it was inserted for unique keys.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::insert(
+    const value_type &value) -> insert_return {
+  if constexpr (Multi) {
+    return emplace(value);
+  } else {
+    return emplaceKey(KeyOf{}(value), value);
+  }
+}
+
+/**
+ * @brief Inserts the elements of a range in one pass.
+ *
+ * @details
+ * The elements are appended to the storage, the appended tail is sorted and
+ * merged with the sorted head (see mergeTail()), so inserting m elements
+ * into n costs O(m log m + n) instead of m shifts of O(n) each.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename InputIt>
+void flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::insert(InputIt first,
+                                                               InputIt last) {
+  size_type sorted = items_.size();
+
+  for (; first != last; ++first) {
+    items_.emplace_back(*first);
+  }
+
+  mergeTail(sorted, true);
+}
+
+/**
+ * @brief Constructs an element from the arguments and inserts it.
+ *
+ * @tparam Args The types of the arguments.
+ * @param[in] args The arguments forwarded to the element constructor.
+ * @return insert_return - an iterator to the inserted element, paired with
+ * whether it was inserted for unique keys.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename... Args>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::emplace(
+    Args &&...args) -> insert_return {
+  slot_type value(std::forward<Args>(args)...);
+
+  if constexpr (Multi) {
+    iterator pos = upperBound(KeyOf{}(value));
+
+    return items_
+        .emplace(typename storage_type::const_iterator{
+                     const_cast<slot_type *>(pos)},
+                 std::move(value))
+        .base();
+  } else {
+    return emplaceKey(KeyOf{}(value), std::move(value));
+  }
+}
+
+/**
+ * @brief Erases the element at the given position.
+ *
+ * @param[in] pos The position of the element to erase.
+ * @return iterator - an iterator to the element following the erased one.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::erase(
+    const_iterator pos) -> iterator {
+  return erase(pos, pos + 1);
+}
+
+/**
+ * @brief Erases the elements in the range [first, last).
+ *
+ * @param[in] first The position of the first element to erase.
+ * @param[in] last The position following the last element to erase.
+ * @return iterator - an iterator to the element following the erased ones.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::erase(
+    const_iterator first, const_iterator last) -> iterator {
+  using storage_iterator = typename storage_type::const_iterator;
+
+  if (first == last) {
+    return const_cast<iterator>(first);
+  }
+
+  return items_
+      .erase(storage_iterator{const_cast<slot_type *>(first)},
+             storage_iterator{const_cast<slot_type *>(last)})
+      .base();
+}
+
+/**
+ * @brief Erases all elements with a key equivalent to the given one.
+ *
+ * @param[in] key The key of the elements to erase.
+ * @return size_type - the number of erased elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::erase(
+    const key_type &key) -> size_type {
+  iterator_range range = equal_range(key);
+
+  erase(range.first, range.second);
+
+  return range.second - range.first;
+}
+
+/**
+ * @brief Exchanges the contents of the flat tree with those of other.
+ *
+ * @param[in,out] other The flat tree to exchange with.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::swap(
+    flat_tree &other) noexcept {
+  items_.swap(other.items_);
+  std::swap(comp_, other.comp_);
+}
+
+/**
+ * @brief Moves the elements of other into the flat tree.
+ *
+ * @details
+ * For unique keys, the elements whose key already exists stay in other. The
+ * moved elements are already sorted, so they are appended and merged with
+ * the current elements in one pass.
+ *
+ * @param[in,out] other The flat tree to merge from.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::merge(
+    flat_tree &other) {
+  if (this == &other) {
+    return;
+  }
+
+  size_type sorted = items_.size();
+  slot_type *kept = other.items_.data();
+
+  items_.reserve(sorted + other.size());
+
+  for (slot_type &item : other.items_) {
+    slot_type *head = items_.data();
+    slot_type *pos = std::lower_bound(
+        head, head + sorted, KeyOf{}(item),
+        [this](const slot_type &x, const key_type &y) {
+          return comp_(KeyOf{}(x), y);
+        });
+    bool exists = pos != head + sorted && !comp_(KeyOf{}(item), KeyOf{}(*pos));
+
+    if (Multi || !exists) {
+      items_.emplace_back(std::move(item));
+    } else if (kept++ != &item) {
+      *(kept - 1) = std::move(item);
+    }
+  }
+
+  other.erase(kept, other.end());
+  mergeTail(sorted, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                              FLAT TREE LOOKUP                              //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Finds an element with a key equivalent to the given one.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end() if there is none.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::find(
+    const key_type &key) const -> iterator {
+  return findKey(key);
+}
+
+/**
+ * @brief Checks whether an element with an equivalent key exists.
+ *
+ * @param[in] key The key to search for.
+ * @return true if there is such an element.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+bool flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::contains(
+    const key_type &key) const {
+  return findKey(key) != end();
+}
+
+/**
+ * @brief Counts the elements with a key equivalent to the given one.
+ *
+ * @param[in] key The key to search for.
+ * @return size_type - the number of such elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::count(
+    const key_type &key) const -> size_type {
+  if constexpr (Multi) {
+    return upperBound(key) - lowerBound(key);
+  } else {
+    return findKey(key) != end();
+  }
+}
+
+/**
+ * @brief Returns the range of elements with an equivalent key.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator_range - the lower and the upper bound of the key.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::equal_range(
+    const key_type &key) const -> iterator_range {
+  return {lowerBound(key), upperBound(key)};
+}
+
+/**
+ * @brief Returns the first element whose key is not less than the given one.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::lower_bound(
+    const key_type &key) const -> iterator {
+  return lowerBound(key);
+}
+
+/**
+ * @brief Returns the first element whose key is greater than the given one.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::upper_bound(
+    const key_type &key) const -> iterator {
+  return upperBound(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                       HETEROGENEOUS FLAT TREE LOOKUP                       //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Finds an element with a key equivalent to a key of another type.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end() if there is none.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::find(
+    const Key &key) const -> iterator {
+  return findKey(key);
+}
+
+/**
+ * @brief Checks whether an element with a key equivalent to a key of another
+ * type exists.
+ *
+ * @param[in] key The key to search for.
+ * @return true if there is such an element.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename>
+bool flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::contains(
+    const Key &key) const {
+  return findKey(key) != end();
+}
+
+/**
+ * @brief Counts the elements with a key equivalent to a key of another type.
+ *
+ * @param[in] key The key to search for.
+ * @return size_type - the number of such elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::count(
+    const Key &key) const -> size_type {
+  if constexpr (Multi) {
+    return upperBound(key) - lowerBound(key);
+  } else {
+    return findKey(key) != end();
+  }
+}
+
+/**
+ * @brief Returns the range of elements with a key equivalent to a key of
+ * another type.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator_range - the lower and the upper bound of the key.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::equal_range(
+    const Key &key) const -> iterator_range {
+  return {lowerBound(key), upperBound(key)};
+}
+
+/**
+ * @brief Returns the first element whose key is not less than a key of
+ * another type.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::lower_bound(
+    const Key &key) const -> iterator {
+  return lowerBound(key);
+}
+
+/**
+ * @brief Returns the first element whose key is greater than a key of another
+ * type.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::upper_bound(
+    const Key &key) const -> iterator {
+  return upperBound(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                               ADD ELEMENTS                                 //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Inserts an element with the given key unless the key exists.
+ *
+ * @details
+ * The element is only constructed, from args, when the key is new.
+ *
+ * @tparam Key The type of the key.
+ * @tparam Args The types of the arguments for the element constructor.
+ * @param[in] key The key of the new element.
+ * @param[in] args The arguments forwarded to the element constructor.
+ * @return insert_return - an iterator to the element with the key and
+ * whether it was inserted.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key, typename... Args>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::emplaceKey(
+    const Key &key, Args &&...args) -> insert_return {
+  static_assert(!Multi, "emplaceKey() is only for unique keys");
+
+  iterator pos = lowerBound(key);
+
+  if (pos != end() && !comp_(key, KeyOf{}(*pos))) {
+    return {pos, false};
+  }
+
+  pos = items_
+            .emplace(typename storage_type::const_iterator{
+                         const_cast<slot_type *>(pos)},
+                     std::forward<Args>(args)...)
+            .base();
+
+  return {pos, true};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                 SEARCHING                                  //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Finds the first element whose key is not less than the given one.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::lowerBound(
+    const Key &key) const -> iterator {
+  return std::lower_bound(begin(), end(), key,
+                          [this](const value_type &item, const Key &value) {
+                            return comp_(KeyOf{}(item), value);
+                          });
+}
+
+/**
+ * @brief Finds the first element whose key is greater than the given one.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::upperBound(
+    const Key &key) const -> iterator {
+  return std::upper_bound(begin(), end(), key,
+                          [this](const Key &value, const value_type &item) {
+                            return comp_(value, KeyOf{}(item));
+                          });
+}
+
+/**
+ * @brief Finds an element with an equivalent key.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+template <typename Key>
+auto flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::findKey(
+    const Key &key) const -> iterator {
+  iterator pos = lowerBound(key);
+
+  return (pos != end() && !comp_(key, KeyOf{}(*pos))) ? pos : end();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                 INSERTING                                  //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Merges the appended elements into the sorted head of the storage.
+ *
+ * @details
+ * The tail is stable sorted and merged with std::inplace_merge(), which keeps
+ * the existing elements before equivalent new ones. For unique keys the
+ * later duplicates are then dropped, so the first inserted element of every
+ * key wins, as with one by one insertion.
+ *
+ * @param[in] sorted The number of sorted elements at the head.
+ * @param[in] sort_tail Whether the tail has to be sorted first.
+ */
+template <typename K, typename V, typename KeyOf, typename Compare,
+          typename Allocator, bool Multi>
+void flat_tree<K, V, KeyOf, Compare, Allocator, Multi>::mergeTail(
+    size_type sorted, bool sort_tail) {
+  slot_type *head = items_.data();
+  slot_type *middle = head + sorted;
+  slot_type *tail = head + items_.size();
+  auto less = [this](const slot_type &x, const slot_type &y) {
+    return comp_(KeyOf{}(x), KeyOf{}(y));
+  };
+
+  if (sort_tail) {
+    std::stable_sort(middle, tail, less);
+  }
+
+  if (sorted && middle != tail && less(*middle, *(middle - 1))) {
+    std::inplace_merge(head, middle, tail, less);
+  }
+
+  if constexpr (!Multi) {
+    auto equivalent = [&less](const slot_type &x, const slot_type &y) {
+      return !less(x, y);
+    };
+
+    erase(std::unique(head, tail, equivalent), tail);
+  }
+}
+
+}  // namespace s21
+
+#endif  // SRC_CONTAINERS_FLAT_TREE_H_
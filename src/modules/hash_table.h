@@ -0,0 +1,1602 @@
+/**
+ * @file hash_table.h
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Header for the open addressing hash table
+ * @version 1.0
+ * @date 2024-08-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_CONTAINERS_HASH_TABLE_H_
+#define SRC_CONTAINERS_HASH_TABLE_H_
+
+#include <algorithm>         // for max(), min(), swap()
+#include <cstdint>           // for int8_t, uint32_t, uint64_t
+#include <cstring>           // for memcpy(), memset()
+#include <functional>        // for hash, equal_to
+#include <initializer_list>  // for init_list type
+#include <iterator>          // for forward_iterator_tag
+#include <limits>            // for max()
+#include <memory>            // for allocator, allocator_traits
+#include <new>               // for placement new
+#include <type_traits>       // for conditional_t, remove_const_t
+#include <utility>           // for pair, move(), forward(), exchange()
+
+#if defined(__SSE2__)
+#include <emmintrin.h>  // for _mm_cmpeq_epi8(), _mm_movemask_epi8()
+#endif
+
+#include "./tree.h"
+
+/// @brief Namespace for working with containers
+namespace s21 {
+
+/// @brief Enables a heterogeneous lookup overload when both the hasher and
+/// the key equality are transparent.
+template <typename Hash, typename KeyEqual, typename Key>
+using transparent_hash_key_t =
+    std::enable_if_t<is_transparent<Hash, Key>::value &&
+                         is_transparent<KeyEqual, Key>::value,
+                     Key>;
+
+/**
+ * @brief An open addressing hash table template class.
+ *
+ * @details
+ * This template class hash_table stores its elements directly in one array
+ * of slots, next to an array of one control byte per slot. A control byte
+ * says whether its slot is empty, deleted, or full, and for a full slot it
+ * holds the low 7 bits of the hash of the element (H2). The remaining bits
+ * (H1) choose where probing starts.
+ *
+ * Probing checks a group of 16 control bytes at once: with SSE2 one compare
+ * finds all slots of the group whose H2 matches, so the keys themselves are
+ * compared about once per lookup. The capacity is always a power of two
+ * minus one. The first 15 control bytes are mirrored past the end, so a
+ * group can start at any slot. It is the common base of unordered_map and
+ * unordered_set.
+ *
+ * The table grows when it would be fuller than max_load_factor(). Erasing
+ * does not move elements, but growing does, so insertions invalidate the
+ * iterators.
+ *
+ * @tparam K The type of keys.
+ * @tparam V The type of elements, containing or being the key.
+ * @tparam KeyOf The callable returning the key of an element.
+ * @tparam Hash The hasher of the keys.
+ * @tparam KeyEqual The equality of the keys.
+ * @tparam Allocator The allocator type, rebound to the slot and control types.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>,
+          typename Allocator = std::allocator<V>>
+class hash_table {
+ public:
+  // Container types
+
+  template <bool Const>
+  class HashIterator;
+
+  // Type aliases
+
+  using key_type = K;                          ///< Type of keys
+  using value_type = V;                        ///< Type of elements
+  using reference = value_type &;              ///< Reference to element
+  using const_reference = const value_type &;  ///< Const reference to element
+  using size_type = std::size_t;               ///< Containers size type
+  using difference_type = std::ptrdiff_t;      ///< Distance between elements
+  using hasher = Hash;                         ///< Hasher of keys
+  using key_equal = KeyEqual;                  ///< Equality of keys
+  using allocator_type = Allocator;            ///< Allocator of elements
+  using iterator = HashIterator<false>;        ///< For read/write elements
+  using const_iterator = HashIterator<true>;   ///< For read elements
+  using iterator_bool = std::pair<iterator, bool>;  ///< Pair iterator-bool
+  using iterator_range = std::pair<iterator, iterator>;  ///< Pair of bounds
+
+  // Constructors/assignment operators/destructor
+
+  hash_table() = default;
+  explicit hash_table(size_type bucket_count, const hasher &hash = hasher{},
+                      const key_equal &equal = key_equal{},
+                      const allocator_type &alloc = allocator_type{});
+  explicit hash_table(const allocator_type &alloc);
+  hash_table(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  hash_table(InputIt first, InputIt last);
+  hash_table(const hash_table &other);
+  hash_table(hash_table &&other) noexcept;
+  hash_table &operator=(const hash_table &other);
+  hash_table &operator=(hash_table &&other);
+  ~hash_table();
+  allocator_type get_allocator() const noexcept;
+  hasher hash_function() const;
+  key_equal key_eq() const;
+
+  // Iterators
+
+  iterator begin() const noexcept;
+  iterator end() const noexcept;
+  const_iterator cbegin() const noexcept;
+  const_iterator cend() const noexcept;
+
+  // Capacity
+
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+
+  // Modifiers
+
+  void clear() noexcept;
+  iterator_bool insert(const value_type &value);
+  iterator_bool insert(value_type &&value);
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last);
+  template <typename... Args>
+  iterator_bool emplace(Args &&...args);
+  iterator erase(const_iterator pos) noexcept;
+  iterator erase(const_iterator first, const_iterator last) noexcept;
+  size_type erase(const key_type &key);
+  void swap(hash_table &other) noexcept;
+  void merge(hash_table &other);
+
+  // Lookup
+
+  iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  iterator_range equal_range(const key_type &key) const;
+
+  // Heterogeneous lookup
+
+  template <typename Key,
+            typename = transparent_hash_key_t<Hash, KeyEqual, Key>>
+  iterator find(const Key &key) const;
+  template <typename Key,
+            typename = transparent_hash_key_t<Hash, KeyEqual, Key>>
+  bool contains(const Key &key) const;
+  template <typename Key,
+            typename = transparent_hash_key_t<Hash, KeyEqual, Key>>
+  size_type count(const Key &key) const;
+  template <typename Key,
+            typename = transparent_hash_key_t<Hash, KeyEqual, Key>>
+  iterator_range equal_range(const Key &key) const;
+
+  // Hash policy
+
+  size_type bucket_count() const noexcept;
+  float load_factor() const noexcept;
+  float max_load_factor() const noexcept;
+  void max_load_factor(float ml);
+  void rehash(size_type count);
+  void reserve(size_type count);
+
+ protected:
+  // Add elements
+
+  template <typename Key, typename... Args>
+  iterator_bool emplaceKey(const Key &key, Args &&...args);
+
+ private:
+  // Type aliases
+
+  using ctrl_t = std::int8_t;
+  using slot_type = std::remove_const_t<value_type>;
+  using slot_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<slot_type>;
+  using ctrl_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<ctrl_t>;
+  using slot_traits = std::allocator_traits<slot_allocator>;
+  using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+
+  // Container types
+
+  struct Group;
+
+  // Control bytes
+
+  static constexpr ctrl_t kEmpty{-128};    ///< Never used slot
+  static constexpr ctrl_t kDeleted{-2};    ///< Slot of an erased element
+  static constexpr ctrl_t kSentinel{-1};   ///< Marks the end of the slots
+  static constexpr size_type kWidth{16};   ///< Control bytes in a group
+  static constexpr size_type kCloned{kWidth - 1};  ///< Mirrored bytes
+
+  // Fields
+
+  ctrl_t *ctrl_{};           ///< Control bytes, nullptr without slots
+  slot_type *slots_{};       ///< Slots of the elements
+  size_type capacity_{};     ///< Number of slots, 2^k - 1 or 0
+  size_type size_{};         ///< Number of elements
+  size_type growth_left_{};  ///< Empty slots that may still be filled
+  float max_load_{0.875f};   ///< Maximum ratio of size to capacity
+  Hash hash_{};              ///< Hasher of keys
+  KeyEqual equal_{};         ///< Equality of keys
+  slot_allocator slot_alloc_{};  ///< Allocator of the slots
+  ctrl_allocator ctrl_alloc_{};  ///< Allocator of the control bytes
+
+  // Hashing
+
+  template <typename Key>
+  size_type hashOf(const Key &key) const;
+  static size_type lowestBit(std::uint32_t mask) noexcept;
+  static size_type highestBit(std::uint32_t mask) noexcept;
+
+  // Searching
+
+  template <typename Key>
+  iterator findKey(const Key &key, size_type hash) const;
+  size_type findFirstNonFull(size_type hash) const noexcept;
+
+  // Slots
+
+  void setCtrl(size_type index, ctrl_t value) noexcept;
+  size_type growthFor(size_type capacity) const noexcept;
+  size_type capacityFor(size_type count) const noexcept;
+  void resize(size_type capacity);
+  void destroySlots() noexcept;
+  void copyFrom(const hash_table &other);
+  void adopt(hash_table &other) noexcept;
+};
+
+/**
+ * @brief A group of kWidth control bytes probed at once.
+ *
+ * @details
+ * Every match returns a bit mask with bit i set for the byte i of the group.
+ * With SSE2 a mask takes one compare and one movemask; otherwise the bytes
+ * are checked one by one.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+struct hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::Group {
+#if defined(__SSE2__)
+  __m128i ctrl;  ///< The control bytes of the group
+
+  /// @brief Loads the group that starts at pos.
+  explicit Group(const ctrl_t *pos) noexcept
+      : ctrl{_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))} {}
+
+  /// @brief Returns the bytes equal to the given H2.
+  std::uint32_t match(ctrl_t h2) const noexcept {
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+  }
+
+  /// @brief Returns the empty bytes.
+  std::uint32_t matchEmpty() const noexcept { return match(kEmpty); }
+
+  /// @brief Returns the empty and the deleted bytes, which are the only ones
+  /// below kSentinel.
+  std::uint32_t matchEmptyOrDeleted() const noexcept {
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl)));
+  }
+#else
+  ctrl_t ctrl[kWidth];  ///< The control bytes of the group
+
+  /// @brief Loads the group that starts at pos.
+  explicit Group(const ctrl_t *pos) noexcept {
+    std::memcpy(ctrl, pos, kWidth);
+  }
+
+  /// @brief Returns the bytes equal to the given H2.
+  std::uint32_t match(ctrl_t h2) const noexcept {
+    std::uint32_t mask{};
+
+    for (size_type i = 0; i < kWidth; ++i) {
+      mask |= static_cast<std::uint32_t>(ctrl[i] == h2) << i;
+    }
+
+    return mask;
+  }
+
+  /// @brief Returns the empty bytes.
+  std::uint32_t matchEmpty() const noexcept { return match(kEmpty); }
+
+  /// @brief Returns the empty and the deleted bytes, which are the only ones
+  /// below kSentinel.
+  std::uint32_t matchEmptyOrDeleted() const noexcept {
+    std::uint32_t mask{};
+
+    for (size_type i = 0; i < kWidth; ++i) {
+      mask |= static_cast<std::uint32_t>(ctrl[i] < kSentinel) << i;
+    }
+
+    return mask;
+  }
+#endif
+};
+
+/**
+ * @brief An iterator for the hash table.
+ *
+ * @details
+ * The iterator walks the control bytes and stops at full slots only. The
+ * sentinel after the last slot is not empty or deleted, so the walk always
+ * ends there, at end().
+ *
+ * @tparam Const Whether the elements are read-only.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <bool Const>
+class hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::HashIterator {
+ public:
+  // Type aliases
+
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::remove_const_t<V>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::conditional_t<Const, const V *, V *>;
+  using reference = std::conditional_t<Const, const V &, V &>;
+
+  // Constructors
+
+  HashIterator() noexcept = default;
+  HashIterator(const ctrl_t *ctrl, slot_type *slot) noexcept;
+  template <bool Other, typename = std::enable_if_t<Const && !Other>>
+  HashIterator(const HashIterator<Other> &other) noexcept;
+
+  // Operators
+
+  reference operator*() const noexcept;
+  pointer operator->() const noexcept;
+  HashIterator &operator++() noexcept;
+  HashIterator operator++(int) noexcept;
+
+  /**
+   * @brief Equality comparison operator for the hash table iterator.
+   *
+   * @param[in] a The first iterator.
+   * @param[in] b The second iterator.
+   * @return true if both iterators point to the same slot.
+   */
+  friend bool operator==(const HashIterator &a,
+                         const HashIterator &b) noexcept {
+    return a.ctrl_ == b.ctrl_;
+  }
+
+  /**
+   * @brief Inequality comparison operator for the hash table iterator.
+   *
+   * @param[in] a The first iterator.
+   * @param[in] b The second iterator.
+   * @return true if the iterators point to different slots.
+   */
+  friend bool operator!=(const HashIterator &a,
+                         const HashIterator &b) noexcept {
+    return !(a == b);
+  }
+
+ private:
+  friend class hash_table;
+  template <bool>
+  friend class HashIterator;
+
+  // Fields
+
+  const ctrl_t *ctrl_{};  ///< Control byte of the slot
+  slot_type *slot_{};     ///< Slot of the element
+
+  // Moving
+
+  void skipEmptyOrDeleted() noexcept;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//                          HASH TABLE CONSTRUCTORS                           //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Constructs an empty hash table with room for bucket_count elements.
+ *
+ * @param[in] bucket_count The number of elements to reserve room for.
+ * @param[in] hash The hasher of the keys.
+ * @param[in] equal The equality of the keys.
+ * @param[in] alloc The allocator of the slots.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::hash_table(
+    size_type bucket_count, const hasher &hash, const key_equal &equal,
+    const allocator_type &alloc)
+    : hash_{hash}, equal_{equal}, slot_alloc_{alloc}, ctrl_alloc_{alloc} {
+  reserve(bucket_count);
+}
+
+/**
+ * @brief Constructs an empty hash table that uses the given allocator.
+ *
+ * @param[in] alloc The allocator of the slots.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::hash_table(
+    const allocator_type &alloc)
+    : slot_alloc_{alloc}, ctrl_alloc_{alloc} {}
+
+/**
+ * @brief Constructs a hash table with the elements of an initializer list.
+ *
+ * @param[in] items The elements to insert.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::hash_table(
+    std::initializer_list<value_type> const &items)
+    : hash_table(items.begin(), items.end()) {}
+
+/**
+ * @brief Constructs a hash table with the elements of a range.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename InputIt>
+hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::hash_table(InputIt first,
+                                                               InputIt last)
+    : hash_table{} {
+  insert(first, last);
+}
+
+/**
+ * @brief Copy constructor for the hash table.
+ *
+ * @details
+ * The slots and control bytes are copied index by index, so no element is
+ * hashed again. The allocator is obtained through
+ * select_on_container_copy_construction().
+ *
+ * @param[in] other The hash table to copy from.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::hash_table(
+    const hash_table &other)
+    : max_load_{other.max_load_},
+      hash_{other.hash_},
+      equal_{other.equal_},
+      slot_alloc_{slot_traits::select_on_container_copy_construction(
+          other.slot_alloc_)},
+      ctrl_alloc_{ctrl_traits::select_on_container_copy_construction(
+          other.ctrl_alloc_)} {
+  copyFrom(other);
+}
+
+/**
+ * @brief Move constructor for the hash table.
+ *
+ * @param[in] other The hash table to move from, left empty.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::hash_table(
+    hash_table &&other) noexcept
+    : max_load_{other.max_load_},
+      hash_{other.hash_},
+      equal_{other.equal_},
+      slot_alloc_{other.slot_alloc_},
+      ctrl_alloc_{other.ctrl_alloc_} {
+  adopt(other);
+}
+
+/**
+ * @brief Copy assignment operator for the hash table.
+ *
+ * @param[in] other The hash table to copy from.
+ * @return hash_table& - reference to the assigned hash table.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::operator=(
+    const hash_table &other) -> hash_table & {
+  if (this != &other) {
+    destroySlots();
+    max_load_ = other.max_load_;
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+    copyFrom(other);
+  }
+
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator for the hash table.
+ *
+ * @details
+ * The slots of other are adopted when the allocator propagates on move
+ * assignment or both allocators are equal. Otherwise the elements are copied
+ * and other is cleared.
+ *
+ * @param[in] other The hash table to move from.
+ * @return hash_table& - reference to the assigned hash table.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::operator=(
+    hash_table &&other) -> hash_table & {
+  if (this == &other) {
+    return *this;
+  }
+
+  if (slot_traits::propagate_on_container_move_assignment::value ||
+      slot_alloc_ == other.slot_alloc_) {
+    destroySlots();
+    slot_alloc_ = other.slot_alloc_;
+    ctrl_alloc_ = other.ctrl_alloc_;
+    max_load_ = other.max_load_;
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+    adopt(other);
+  } else {
+    *this = other;
+    other.clear();
+  }
+
+  return *this;
+}
+
+/**
+ * @brief Destructor.
+ *
+ * @details
+ * Destroys all elements and frees the slots.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::~hash_table() {
+  destroySlots();
+}
+
+/**
+ * @brief Returns a copy of the allocator of the hash table.
+ *
+ * @return allocator_type - the allocator.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::get_allocator()
+    const noexcept -> allocator_type {
+  return allocator_type{slot_alloc_};
+}
+
+/**
+ * @brief Returns the hasher of the keys.
+ *
+ * @return hasher - the hasher.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::hash_function() const
+    -> hasher {
+  return hash_;
+}
+
+/**
+ * @brief Returns the equality of the keys.
+ *
+ * @return key_equal - the equality.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::key_eq() const
+    -> key_equal {
+  return equal_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                            HASH TABLE ITERATORS                            //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Returns an iterator to the first element.
+ *
+ * @return iterator - an iterator to the first full slot, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::begin()
+    const noexcept -> iterator {
+  if (!size_) {
+    return end();
+  }
+
+  iterator it{ctrl_, slots_};
+
+  it.skipEmptyOrDeleted();
+
+  return it;
+}
+
+/**
+ * @brief Returns an iterator past the last element.
+ *
+ * @return iterator - an iterator to the sentinel.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::end() const noexcept
+    -> iterator {
+  return iterator{ctrl_ + capacity_, slots_ + capacity_};
+}
+
+/**
+ * @brief Returns a const iterator to the first element.
+ *
+ * @return const_iterator - an iterator to the first full slot, or cend().
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::cbegin()
+    const noexcept -> const_iterator {
+  return begin();
+}
+
+/**
+ * @brief Returns a const iterator past the last element.
+ *
+ * @return const_iterator - an iterator to the sentinel.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::cend()
+    const noexcept -> const_iterator {
+  return end();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                            HASH TABLE CAPACITY                             //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Checks whether the hash table is empty.
+ *
+ * @return true if the hash table has no elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+bool hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::empty()
+    const noexcept {
+  return !size_;
+}
+
+/**
+ * @brief Returns the number of elements.
+ *
+ * @return size_type - the number of elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::size() const noexcept
+    -> size_type {
+  return size_;
+}
+
+/**
+ * @brief Returns the maximum number of elements the hash table can hold.
+ *
+ * @return size_type - the maximum number of elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::max_size()
+    const noexcept -> size_type {
+  return std::numeric_limits<difference_type>::max() /
+         (sizeof(slot_type) + sizeof(ctrl_t));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                            HASH TABLE MODIFIERS                            //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Destroys all elements, keeping the slots.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::clear() noexcept {
+  if (!capacity_) {
+    return;
+  }
+
+  if constexpr (!std::is_trivially_destructible_v<slot_type>) {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] >= 0) {
+        slots_[i].~slot_type();
+      }
+    }
+  }
+
+  std::memset(ctrl_, kEmpty, capacity_ + 1 + kCloned);
+  ctrl_[capacity_] = kSentinel;
+  size_ = 0;
+  growth_left_ = growthFor(capacity_);
+}
+
+/**
+ * @brief Inserts a copy of the element unless its key exists.
+ *
+ * @param[in] value The element to insert.
+ * @return iterator_bool - an iterator to the element with the key and whether
+ * the insertion took place.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::insert(
+    const value_type &value) -> iterator_bool {
+  return emplaceKey(KeyOf{}(value), value);
+}
+
+/**
+ * @brief Inserts the element by moving it, unless its key exists.
+ *
+ * @param[in] value The element to insert.
+ * @return iterator_bool - an iterator to the element with the key and whether
+ * the insertion took place.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::insert(
+    value_type &&value) -> iterator_bool {
+  return emplaceKey(KeyOf{}(value), std::move(value));
+}
+
+/**
+ * @brief Inserts the elements of a range.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename InputIt>
+void hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::insert(InputIt first,
+                                                                InputIt last) {
+  for (; first != last; ++first) {
+    insert(*first);
+  }
+}
+
+/**
+ * @brief Constructs an element from the arguments and inserts it unless its
+ * key exists.
+ *
+ * @tparam Args The types of the arguments.
+ * @param[in] args The arguments forwarded to the element constructor.
+ * @return iterator_bool - an iterator to the element with the key and whether
+ * the insertion took place.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename... Args>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::emplace(
+    Args &&...args) -> iterator_bool {
+  slot_type value(std::forward<Args>(args)...);
+
+  return emplaceKey(KeyOf{}(value), std::move(value));
+}
+
+/**
+ * @brief Erases the element at the given position.
+ *
+ * @details
+ * The slot is marked empty if no probe can have passed it, which is when
+ * the run of full or deleted slots around it is shorter than a group.
+ * Otherwise it is marked deleted, so that later probes keep going.
+ *
+ * @param[in] pos The position of the element to erase.
+ * @return iterator - an iterator to the next element.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::erase(
+    const_iterator pos) noexcept -> iterator {
+  size_type index = pos.slot_ - slots_;
+  size_type before = (index - kWidth) & capacity_;
+  std::uint32_t empty_after = Group{ctrl_ + index}.matchEmpty();
+  std::uint32_t empty_before = Group{ctrl_ + before}.matchEmpty();
+  bool was_never_full = empty_before && empty_after &&
+                        lowestBit(empty_after) + kWidth - 1 -
+                                highestBit(empty_before) <
+                            kWidth;
+
+  slots_[index].~slot_type();
+  setCtrl(index, (was_never_full) ? kEmpty : kDeleted);
+  growth_left_ += was_never_full;
+  --size_;
+
+  iterator next{ctrl_ + index, slots_ + index};
+
+  ++next;
+
+  return next;
+}
+
+/**
+ * @brief Erases the elements in the range [first, last).
+ *
+ * @param[in] first The position of the first element to erase.
+ * @param[in] last The position following the last element to erase.
+ * @return iterator - an iterator to last.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::erase(
+    const_iterator first, const_iterator last) noexcept -> iterator {
+  if (first == cbegin() && last == cend()) {
+    clear();
+    return end();
+  }
+
+  while (first != last) {
+    first = erase(first);
+  }
+
+  return iterator{last.ctrl_, last.slot_};
+}
+
+/**
+ * @brief Erases the element with the given key.
+ *
+ * @param[in] key The key of the element to erase.
+ * @return size_type - the number of erased elements, 0 or 1.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::erase(
+    const key_type &key) -> size_type {
+  iterator it = findKey(key, hashOf(key));
+
+  if (it == end()) {
+    return 0;
+  }
+
+  erase(it);
+
+  return 1;
+}
+
+/**
+ * @brief Exchanges the contents of the hash table with those of other.
+ *
+ * @param[in,out] other The hash table to exchange with.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::swap(
+    hash_table &other) noexcept {
+  std::swap(ctrl_, other.ctrl_);
+  std::swap(slots_, other.slots_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(growth_left_, other.growth_left_);
+  std::swap(max_load_, other.max_load_);
+  std::swap(hash_, other.hash_);
+  std::swap(equal_, other.equal_);
+  std::swap(slot_alloc_, other.slot_alloc_);
+  std::swap(ctrl_alloc_, other.ctrl_alloc_);
+}
+
+/**
+ * @brief Moves the elements of other whose key is missing into the table.
+ *
+ * @param[in,out] other The hash table to merge from; keeps the elements whose
+ * key already exists.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::merge(
+    hash_table &other) {
+  if (this == &other) {
+    return;
+  }
+
+  for (iterator it = other.begin(); it != other.end();) {
+    if (emplaceKey(KeyOf{}(*it), std::move(*it)).second) {
+      it = other.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                             HASH TABLE LOOKUP                              //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Finds the element with the given key.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end() if there is none.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::find(
+    const key_type &key) const -> iterator {
+  return findKey(key, hashOf(key));
+}
+
+/**
+ * @brief Checks whether an element with the given key exists.
+ *
+ * @param[in] key The key to search for.
+ * @return true if there is such an element.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+bool hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::contains(
+    const key_type &key) const {
+  return find(key) != end();
+}
+
+/**
+ * @brief Counts the elements with the given key.
+ *
+ * @param[in] key The key to search for.
+ * @return size_type - the number of such elements, 0 or 1.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::count(
+    const key_type &key) const -> size_type {
+  return find(key) != end();
+}
+
+/**
+ * @brief Returns the range of elements with the given key.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator_range - the element and the next one, or two end().
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::equal_range(
+    const key_type &key) const -> iterator_range {
+  iterator it = find(key);
+
+  return {it, (it == end()) ? it : std::next(it)};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                       HETEROGENEOUS HASH TABLE LOOKUP                      //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Finds the element with a key equal to a key of another type.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element, or end() if there is none.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Key, typename>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::find(
+    const Key &key) const -> iterator {
+  return findKey(key, hashOf(key));
+}
+
+/**
+ * @brief Checks whether an element with a key equal to a key of another type
+ * exists.
+ *
+ * @param[in] key The key to search for.
+ * @return true if there is such an element.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Key, typename>
+bool hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::contains(
+    const Key &key) const {
+  return findKey(key, hashOf(key)) != end();
+}
+
+/**
+ * @brief Counts the elements with a key equal to a key of another type.
+ *
+ * @param[in] key The key to search for.
+ * @return size_type - the number of such elements, 0 or 1.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Key, typename>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::count(
+    const Key &key) const -> size_type {
+  return findKey(key, hashOf(key)) != end();
+}
+
+/**
+ * @brief Returns the range of elements with a key equal to a key of another
+ * type.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator_range - the element and the next one, or two end().
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Key, typename>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::equal_range(
+    const Key &key) const -> iterator_range {
+  iterator it = findKey(key, hashOf(key));
+
+  return {it, (it == end()) ? it : std::next(it)};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                             HASH TABLE POLICY                              //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Returns the number of slots.
+ *
+ * @return size_type - the capacity of the table.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::bucket_count()
+    const noexcept -> size_type {
+  return capacity_;
+}
+
+/**
+ * @brief Returns the ratio of elements to slots.
+ *
+ * @return float - the load factor, 0 for a table without slots.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+float hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::load_factor()
+    const noexcept {
+  return (capacity_) ? static_cast<float>(size_) / capacity_ : 0.0f;
+}
+
+/**
+ * @brief Returns the load factor above which the table grows.
+ *
+ * @return float - the maximum load factor.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+float hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::max_load_factor()
+    const noexcept {
+  return max_load_;
+}
+
+/**
+ * @brief Sets the load factor above which the table grows.
+ *
+ * @details
+ * The factor is clamped to [0.125, 0.875]: lower values only waste memory,
+ * and higher values make probes for missing keys long. The table is rebuilt
+ * for the new factor.
+ *
+ * @param[in] ml The new maximum load factor.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::max_load_factor(
+    float ml) {
+  max_load_ = std::min(std::max(ml, 0.125f), 0.875f);
+  rehash(0);
+}
+
+/**
+ * @brief Rebuilds the table with room for at least count elements.
+ *
+ * @details
+ * The table is never made too small for its elements, so rehash(0) shrinks
+ * it to fit and drops the deleted slots.
+ *
+ * @param[in] count The number of elements to make room for.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::rehash(
+    size_type count) {
+  if (!count && !size_) {
+    destroySlots();
+  } else {
+    resize(capacityFor(std::max(count, size_)));
+  }
+}
+
+/**
+ * @brief Makes room for count elements without further growing.
+ *
+ * @param[in] count The number of elements to make room for.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::reserve(
+    size_type count) {
+  if (count > size_ + growth_left_) {
+    resize(capacityFor(count));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                               ADD ELEMENTS                                 //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Inserts an element with the given key unless the key exists.
+ *
+ * @details
+ * The element is only constructed, from args, when the key is new. The
+ * table grows when the element would take the last allowed empty slot;
+ * reusing a deleted slot does not count against the growth.
+ *
+ * @tparam Key The type of the key.
+ * @tparam Args The types of the arguments for the element constructor.
+ * @param[in] key The key of the new element.
+ * @param[in] args The arguments forwarded to the element constructor.
+ * @return iterator_bool - an iterator to the element with the key and
+ * whether it was inserted.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Key, typename... Args>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::emplaceKey(
+    const Key &key, Args &&...args) -> iterator_bool {
+  size_type hash = hashOf(key);
+  iterator it = findKey(key, hash);
+
+  if (it != end()) {
+    return {it, false};
+  }
+
+  size_type index = (capacity_) ? findFirstNonFull(hash) : 0;
+
+  if (!growth_left_ && (!capacity_ || ctrl_[index] != kDeleted)) {
+    resize(capacityFor(size_ + 1));
+    index = findFirstNonFull(hash);
+  }
+
+  ::new (static_cast<void *>(slots_ + index))
+      slot_type(std::forward<Args>(args)...);
+  growth_left_ -= (ctrl_[index] == kEmpty);
+  setCtrl(index, static_cast<ctrl_t>(hash & 0x7F));
+  ++size_;
+
+  return {iterator{ctrl_ + index, slots_ + index}, true};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                  HASHING                                   //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Hashes a key and mixes the bits of the hash.
+ *
+ * @details
+ * Hashers like std::hash<int> return the key itself, whose low bits, used
+ * for H2, and high bits, used for H1, are poorly spread. A multiply and a
+ * shift spread every input bit over the whole hash.
+ *
+ * @param[in] key The key to hash.
+ * @return size_type - the mixed hash.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Key>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::hashOf(
+    const Key &key) const -> size_type {
+  std::uint64_t hash = static_cast<std::uint64_t>(hash_(key));
+
+  hash *= 0x9E3779B97F4A7C15ull;
+  hash ^= hash >> 32;
+
+  return static_cast<size_type>(hash);
+}
+
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero mask.
+ *
+ * @param[in] mask The mask.
+ * @return size_type - the index of the bit.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::lowestBit(
+    std::uint32_t mask) noexcept -> size_type {
+#if defined(__GNUC__)
+  return static_cast<size_type>(__builtin_ctz(mask));
+#else
+  size_type bit{};
+
+  for (; !(mask & 1); mask >>= 1) ++bit;
+
+  return bit;
+#endif
+}
+
+/**
+ * @brief Returns the index of the highest set bit of a non-zero mask.
+ *
+ * @param[in] mask The mask.
+ * @return size_type - the index of the bit.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::highestBit(
+    std::uint32_t mask) noexcept -> size_type {
+#if defined(__GNUC__)
+  return static_cast<size_type>(31 - __builtin_clz(mask));
+#else
+  size_type bit{};
+
+  while (mask >>= 1) ++bit;
+
+  return bit;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                 SEARCHING                                  //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Finds the element with the given key and hash.
+ *
+ * @details
+ * Probing starts at the group chosen by H1 and moves by 1, 2, 3... groups,
+ * which visits every group of a table of 2^k - 1 slots. Only the slots whose
+ * H2 matches have their keys compared, and the first group with an empty
+ * slot ends the search.
+ *
+ * @param[in] key The key to search for.
+ * @param[in] hash The mixed hash of the key.
+ * @return iterator - an iterator to the element, or end().
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Key>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::findKey(
+    const Key &key, size_type hash) const -> iterator {
+  if (!size_) {
+    return end();
+  }
+
+  ctrl_t h2 = static_cast<ctrl_t>(hash & 0x7F);
+  size_type offset = (hash >> 7) & capacity_;
+
+  for (size_type step = kWidth;; step += kWidth) {
+    Group group{ctrl_ + offset};
+
+    for (std::uint32_t mask = group.match(h2); mask; mask &= mask - 1) {
+      size_type index = (offset + lowestBit(mask)) & capacity_;
+
+      if (equal_(KeyOf{}(slots_[index]), key)) {
+        return iterator{ctrl_ + index, slots_ + index};
+      }
+    }
+
+    if (group.matchEmpty()) {
+      return end();
+    }
+
+    offset = (offset + step) & capacity_;
+  }
+}
+
+/**
+ * @brief Finds the first empty or deleted slot on the probe sequence of hash.
+ *
+ * @param[in] hash The mixed hash of the key to insert.
+ * @return size_type - the index of the slot.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::findFirstNonFull(
+    size_type hash) const noexcept -> size_type {
+  size_type offset = (hash >> 7) & capacity_;
+
+  for (size_type step = kWidth;; step += kWidth) {
+    std::uint32_t mask = Group{ctrl_ + offset}.matchEmptyOrDeleted();
+
+    if (mask) {
+      return (offset + lowestBit(mask)) & capacity_;
+    }
+
+    offset = (offset + step) & capacity_;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   SLOTS                                    //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Sets a control byte and its mirror past the end.
+ *
+ * @details
+ * For index >= kCloned the mirror is the byte itself.
+ *
+ * @param[in] index The index of the slot.
+ * @param[in] value The new control byte.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::setCtrl(
+    size_type index, ctrl_t value) noexcept {
+  ctrl_[index] = value;
+  ctrl_[((index - kCloned) & capacity_) + (kCloned & capacity_)] = value;
+}
+
+/**
+ * @brief Returns how many elements a table of the given capacity may hold.
+ *
+ * @details
+ * A table of at least kCloned slots keeps one slot empty, so every probe
+ * meets an empty slot. Smaller tables fit in one group, whose bytes past the
+ * mirrors are always empty.
+ *
+ * @param[in] capacity The number of slots.
+ * @return size_type - the number of elements.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::growthFor(
+    size_type capacity) const noexcept -> size_type {
+  size_type growth = static_cast<size_type>(capacity * max_load_);
+
+  if (capacity >= kCloned) {
+    growth = std::min(growth, capacity - 1);
+  }
+
+  return std::max<size_type>(growth, (capacity) ? 1 : 0);
+}
+
+/**
+ * @brief Returns the smallest capacity that holds count elements.
+ *
+ * @param[in] count The number of elements.
+ * @return size_type - the capacity, 2^k - 1.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::capacityFor(
+    size_type count) const noexcept -> size_type {
+  size_type capacity{1};
+
+  while (growthFor(capacity) < count) {
+    capacity = capacity * 2 + 1;
+  }
+
+  return capacity;
+}
+
+/**
+ * @brief Moves the elements into new slots of the given capacity.
+ *
+ * @details
+ * Every element is placed at the first free slot of its probe sequence in
+ * the new table; the deleted slots are dropped on the way.
+ *
+ * @param[in] capacity The new number of slots, 2^k - 1.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::resize(
+    size_type capacity) {
+  ctrl_t *old_ctrl = ctrl_;
+  slot_type *old_slots = slots_;
+  size_type old_capacity = capacity_;
+
+  ctrl_ = ctrl_traits::allocate(ctrl_alloc_, capacity + 1 + kCloned);
+
+  try {
+    slots_ = slot_traits::allocate(slot_alloc_, capacity);
+  } catch (...) {
+    ctrl_traits::deallocate(ctrl_alloc_, ctrl_, capacity + 1 + kCloned);
+    ctrl_ = old_ctrl;
+    throw;
+  }
+
+  std::memset(ctrl_, kEmpty, capacity + 1 + kCloned);
+  ctrl_[capacity] = kSentinel;
+  capacity_ = capacity;
+  growth_left_ = growthFor(capacity) - size_;
+
+  for (size_type i = 0; i < old_capacity; ++i) {
+    if (old_ctrl[i] >= 0) {
+      size_type hash = hashOf(KeyOf{}(old_slots[i]));
+      size_type index = findFirstNonFull(hash);
+
+      ::new (static_cast<void *>(slots_ + index))
+          slot_type(std::move(old_slots[i]));
+      old_slots[i].~slot_type();
+      setCtrl(index, static_cast<ctrl_t>(hash & 0x7F));
+    }
+  }
+
+  if (old_capacity) {
+    slot_traits::deallocate(slot_alloc_, old_slots, old_capacity);
+    ctrl_traits::deallocate(ctrl_alloc_, old_ctrl, old_capacity + 1 + kCloned);
+  }
+}
+
+/**
+ * @brief Destroys all elements and frees the slots.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void hash_table<K, V, KeyOf, Hash, KeyEqual,
+                Allocator>::destroySlots() noexcept {
+  if (!capacity_) {
+    return;
+  }
+
+  clear();
+  slot_traits::deallocate(slot_alloc_, slots_, capacity_);
+  ctrl_traits::deallocate(ctrl_alloc_, ctrl_, capacity_ + 1 + kCloned);
+  ctrl_ = nullptr;
+  slots_ = nullptr;
+  capacity_ = growth_left_ = 0;
+}
+
+/**
+ * @brief Copies the elements of other into the table without slots.
+ *
+ * @param[in] other The hash table to copy from.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::copyFrom(
+    const hash_table &other) {
+  if (!other.size_) {
+    return;
+  }
+
+  resize(other.capacity_);
+
+  try {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (other.ctrl_[i] >= 0) {
+        ::new (static_cast<void *>(slots_ + i)) slot_type(other.slots_[i]);
+        setCtrl(i, other.ctrl_[i]);
+        ++size_;
+      }
+    }
+  } catch (...) {
+    destroySlots();
+    throw;
+  }
+
+  growth_left_ = other.growth_left_;
+  std::memcpy(ctrl_, other.ctrl_, capacity_ + 1 + kCloned);
+}
+
+/**
+ * @brief Takes over the slots of other, leaving it without slots.
+ *
+ * @param[in,out] other The hash table to take the slots from.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+void hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::adopt(
+    hash_table &other) noexcept {
+  ctrl_ = std::exchange(other.ctrl_, nullptr);
+  slots_ = std::exchange(other.slots_, nullptr);
+  capacity_ = std::exchange(other.capacity_, 0);
+  size_ = std::exchange(other.size_, 0);
+  growth_left_ = std::exchange(other.growth_left_, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                       HASH TABLE ITERATOR OPERATORS                        //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Constructs an iterator to a slot.
+ *
+ * @param[in] ctrl The control byte of the slot.
+ * @param[in] slot The slot.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <bool Const>
+hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::HashIterator<
+    Const>::HashIterator(const ctrl_t *ctrl, slot_type *slot) noexcept
+    : ctrl_{ctrl}, slot_{slot} {}
+
+/**
+ * @brief Converts an iterator to a const iterator.
+ *
+ * @param[in] other The iterator to convert.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <bool Const>
+template <bool Other, typename>
+hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::HashIterator<
+    Const>::HashIterator(const HashIterator<Other> &other) noexcept
+    : ctrl_{other.ctrl_}, slot_{other.slot_} {}
+
+/**
+ * @brief Dereference operator for the hash table iterator.
+ *
+ * @return reference - reference to the element.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <bool Const>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::HashIterator<
+    Const>::operator*() const noexcept -> reference {
+  return *slot_;
+}
+
+/**
+ * @brief Member access operator for the hash table iterator.
+ *
+ * @return pointer - pointer to the element.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <bool Const>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::HashIterator<
+    Const>::operator->() const noexcept -> pointer {
+  return slot_;
+}
+
+/**
+ * @brief Moves the iterator to the next element.
+ *
+ * @return HashIterator& - reference to the iterator.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <bool Const>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::HashIterator<
+    Const>::operator++() noexcept -> HashIterator & {
+  ++ctrl_;
+  ++slot_;
+  skipEmptyOrDeleted();
+
+  return *this;
+}
+
+/**
+ * @brief Post-increment operator for the hash table iterator.
+ *
+ * @return HashIterator - the iterator before the increment.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <bool Const>
+auto hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::HashIterator<
+    Const>::operator++(int) noexcept -> HashIterator {
+  HashIterator copy{*this};
+
+  ++*this;
+
+  return copy;
+}
+
+/**
+ * @brief Skips the empty and deleted slots a group at a time.
+ */
+template <typename K, typename V, typename KeyOf, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <bool Const>
+void hash_table<K, V, KeyOf, Hash, KeyEqual, Allocator>::HashIterator<
+    Const>::skipEmptyOrDeleted() noexcept {
+  while (*ctrl_ < kSentinel) {
+    std::uint32_t full = ~Group{ctrl_}.matchEmptyOrDeleted() & 0xFFFF;
+    size_type shift = (full) ? lowestBit(full) : kWidth;
+
+    ctrl_ += shift;
+    slot_ += shift;
+  }
+}
+
+}  // namespace s21
+
+#endif  // SRC_CONTAINERS_HASH_TABLE_H_
@@ -12,8 +12,13 @@
 #ifndef SRC_CONTAINERS_LIST_H_
 #define SRC_CONTAINERS_LIST_H_
 
+#include <cstddef>          // for std::ptrdiff_t
 #include <iostream>
-#include <limits>  // for std::numeric_limits
+#include <iterator>         // for std::begin, std::bidirectional_iterator_tag
+#include <limits>           // for std::numeric_limits
+#include <memory>           // for std::allocator, std::allocator_traits
+#include <memory_resource>  // for std::pmr::polymorphic_allocator
+#include <utility>          // for std::forward, std::move
 
 namespace s21 {
 /**
@@ -29,8 +34,9 @@ namespace s21 {
  * more user-friendly.
  *
  * @tparam value_type The type of the value stored in the node.
+ * @tparam Allocator The allocator used to obtain memory for the nodes.
  */
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class list {
   class ListIterator;
   class ListConstIterator;
@@ -50,13 +56,17 @@ class list {
       T *;  ///< Alias for a pointer to the type of values stored in the list.
   using const_pointer = const T *;  ///< Alias for a constant pointer to the
                                     ///< type of values stored in the list.
+  using allocator_type = Allocator;  ///< Alias for the allocator type.
 
   // List Functions
 
   list() noexcept = default;
-  explicit list(size_type n);
-  list(std::initializer_list<value_type> const &items);
+  explicit list(const allocator_type &alloc) noexcept;
+  explicit list(size_type n, const allocator_type &alloc = allocator_type{});
+  list(std::initializer_list<value_type> const &items,
+       const allocator_type &alloc = allocator_type{});
   list(const list &l);
+  list(const list &l, const allocator_type &alloc);
   list &operator=(const list &l);
   list(list &&l);
   list &operator=(list &&l);
@@ -82,10 +92,21 @@ class list {
 
   void clear() noexcept;
   iterator insert(const_iterator pos, const_reference value);
+  iterator insert(const_iterator pos, value_type &&value);
+  template <typename InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last);
+  iterator insert(const_iterator pos, std::initializer_list<value_type> items);
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last);
+  void assign(std::initializer_list<value_type> items);
+  template <typename Range>
+  void append_range(Range &&range);
   iterator erase(const_iterator pos);
   void push_back(const_reference value) noexcept;
+  void push_back(value_type &&value);
   void pop_back() noexcept;
   void push_front(const_reference value);
+  void push_front(value_type &&value);
   void pop_front();
   void swap(list &other);
   void merge(list &other);
@@ -107,18 +128,29 @@ class list {
 
   bool operator==(const list &l) const;
   void print() const;
+  allocator_type get_allocator() const noexcept;
 
  private:
   struct Node;
 
+  /// Allocator of the nodes, rebound from Allocator.
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;  ///< Node traits.
+
   Node *head_{nullptr};  ///< Pointer to the first node in the list. If the list
                          ///< is empty, this is `nullptr`.
   Node *tail_{nullptr};  ///< Pointer to the last node in the list. If the list
                          ///< is empty, this is `nullptr`.
   size_type size_{0};    ///< Number of elements in the list. Initialized to `0`
                          ///< and updated as elements are added or removed.
+  node_allocator alloc_{};  ///< Allocator that provides memory for the nodes.
 
+  template <typename... Args>
+  Node *create_node(Args &&...args);
+  void destroy_node(Node *node) noexcept;
   void copy_from(const list &l);
+  void move_from(list &l);
   void quick_sort(Node *left, Node *right);
   Node *partition(Node *left, Node *right);
 };
@@ -127,8 +159,8 @@ class list {
  * @brief A node in the doubly linked list.
  * @tparam value_type The type of the value stored in the node.
  */
-template <typename value_type>
-struct list<value_type>::Node {
+template <typename value_type, typename Allocator>
+struct list<value_type, Allocator>::Node {
   friend class list;
 
   value_type value;  ///< The value stored in the node. Represents the actual
@@ -138,19 +170,26 @@ struct list<value_type>::Node {
   Node *next;  ///< Pointer to the next node in the list. Points to `nullptr` if
                ///< this node is the tail of the list.
 
-  explicit Node(const_reference val)
-      : value{val}, prev{nullptr}, next{nullptr} {}
+  template <typename... Args>
+  explicit Node(Args &&...args)
+      : value(std::forward<Args>(args)...), prev{nullptr}, next{nullptr} {}
 };
 
 /**
  * @brief Iterator class for iterating over a doubly linked list.
  * @tparam value_type The type of elements stored in the list.
  */
-template <typename value_type>
-class list<value_type>::ListIterator {
+template <typename T, typename Allocator>
+class list<T, Allocator>::ListIterator {
  public:
   friend class list;
 
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T *;
+  using reference = T &;
+
   ListIterator() noexcept = default;
   explicit ListIterator(Node *node) noexcept : node_{node} {}
 
@@ -174,11 +213,17 @@ class list<value_type>::ListIterator {
  * @brief Iterator class for iterating through a constant list.
  * @tparam value_type The type of elements stored in the list.
  */
-template <typename value_type>
-class list<value_type>::ListConstIterator {
+template <typename T, typename Allocator>
+class list<T, Allocator>::ListConstIterator {
  public:
   friend class list;
 
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const T *;
+  using reference = const T &;
+
   ListConstIterator() noexcept = default;
   explicit ListConstIterator(Node *node) : node_{node} {}
 
@@ -203,8 +248,8 @@ class list<value_type>::ListConstIterator {
  * @brief Dereference operator.
  * @return Reference to the value stored in the current node.
  */
-template <typename value_type>
-auto list<value_type>::ListIterator::operator*() -> reference {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::ListIterator::operator*() -> reference {
   static value_type default_value{};
   return node_ ? node_->value : default_value;
 }
@@ -213,8 +258,8 @@ auto list<value_type>::ListIterator::operator*() -> reference {
  * @brief Arrow operator.
  * @return Pointer to the value stored in the current node.
  */
-template <typename value_type>
-auto list<value_type>::ListIterator::operator->() -> pointer {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::ListIterator::operator->() -> pointer {
   return &(node_->value);
 }
 
@@ -222,8 +267,8 @@ auto list<value_type>::ListIterator::operator->() -> pointer {
  * @brief Pre-increment operator (++i).
  * @return Reference to the updated iterator.
  */
-template <typename value_type>
-auto list<value_type>::ListIterator::operator++() -> ListIterator & {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::ListIterator::operator++() -> ListIterator & {
   node_ = node_->next;
 
   return *this;
@@ -233,8 +278,9 @@ auto list<value_type>::ListIterator::operator++() -> ListIterator & {
  * @brief Post-increment operator (i++).
  * @return A copy of the iterator before the increment.
  */
-template <typename value_type>
-auto list<value_type>::ListIterator::operator++(int) -> ListIterator {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::ListIterator::operator++(int)
+    -> ListIterator {
   ListIterator tmp{*this};
   ++(*this);
 
@@ -245,8 +291,8 @@ auto list<value_type>::ListIterator::operator++(int) -> ListIterator {
  * @brief Pre-decrement operator (--i).
  * @return Reference to the updated iterator.
  */
-template <typename value_type>
-auto list<value_type>::ListIterator::operator--() -> ListIterator & {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::ListIterator::operator--() -> ListIterator & {
   node_ = node_->prev;
 
   return *this;
@@ -256,8 +302,9 @@ auto list<value_type>::ListIterator::operator--() -> ListIterator & {
  * @brief Post-decrement operator (i--).
  * @return A copy of the iterator before decrementing.
  */
-template <typename value_type>
-auto list<value_type>::ListIterator::operator--(int) -> ListIterator {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::ListIterator::operator--(int)
+    -> ListIterator {
   ListIterator tmp{*this};
   --(*this);
 
@@ -269,8 +316,8 @@ auto list<value_type>::ListIterator::operator--(int) -> ListIterator {
  * @param other The iterator to compare against.
  * @return true if both iterators point to the same node, false otherwise.
  */
-template <typename value_type>
-bool list<value_type>::ListIterator::operator==(
+template <typename value_type, typename Allocator>
+bool list<value_type, Allocator>::ListIterator::operator==(
     const ListIterator &other) const {
   return node_ == other.node_;
 }
@@ -280,8 +327,8 @@ bool list<value_type>::ListIterator::operator==(
  * @param other The iterator to compare against.
  * @return true if the iterators point to different nodes, false otherwise.
  */
-template <typename value_type>
-bool list<value_type>::ListIterator::operator!=(
+template <typename value_type, typename Allocator>
+bool list<value_type, Allocator>::ListIterator::operator!=(
     const ListIterator &other) const {
   return !(*this == other);
 }
@@ -292,8 +339,9 @@ bool list<value_type>::ListIterator::operator!=(
  * @brief Dereference operator.
  * @return const_reference A reference to the value of the current node.
  */
-template <typename value_type>
-auto list<value_type>::ListConstIterator::operator*() const -> const_reference {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::ListConstIterator::operator*() const
+    -> const_reference {
   static value_type default_value{};
   return node_ ? node_->value : default_value;
 }
@@ -302,8 +350,9 @@ auto list<value_type>::ListConstIterator::operator*() const -> const_reference {
  * @brief Member access operator.
  * @return const_pointer A pointer to the value of the current node.
  */
-template <typename value_type>
-auto list<value_type>::ListConstIterator::operator->() const -> const_pointer {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::ListConstIterator::operator->() const
+    -> const_pointer {
   return &(node_->value);
 }
 
@@ -311,8 +360,9 @@ auto list<value_type>::ListConstIterator::operator->() const -> const_pointer {
  * @brief Pre-increment operator (++i).
  * @return Reference to the updated iterator.
  */
-template <typename value_type>
-auto list<value_type>::ListConstIterator::operator++() -> ListConstIterator & {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::ListConstIterator::operator++()
+    -> ListConstIterator & {
   node_ = node_->next;
 
   return (*this);
@@ -322,8 +372,9 @@ auto list<value_type>::ListConstIterator::operator++() -> ListConstIterator & {
  * @brief Post-increment operator (i++).
  * @return A copy of the iterator before the increment.
  */
-template <typename value_type>
-auto list<value_type>::ListConstIterator::operator++(int) -> ListConstIterator {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::ListConstIterator::operator++(int)
+    -> ListConstIterator {
   ListConstIterator tmp{*this};
   ++(*this);
 
@@ -334,8 +385,9 @@ auto list<value_type>::ListConstIterator::operator++(int) -> ListConstIterator {
  * @brief Pre-decrement operator (--i).
  * @return Reference to the updated iterator.
  */
-template <typename value_type>
-auto list<value_type>::ListConstIterator::operator--() -> ListConstIterator & {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::ListConstIterator::operator--()
+    -> ListConstIterator & {
   node_ = node_->prev;
 
   return (*this);
@@ -345,8 +397,9 @@ auto list<value_type>::ListConstIterator::operator--() -> ListConstIterator & {
  * @brief Post-decrement operator (i--).
  * @return A copy of the iterator before decrementing.
  */
-template <typename value_type>
-auto list<value_type>::ListConstIterator::operator--(int) -> ListConstIterator {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::ListConstIterator::operator--(int)
+    -> ListConstIterator {
   ListConstIterator tmp{*this};
   --(*this);
 
@@ -358,8 +411,8 @@ auto list<value_type>::ListConstIterator::operator--(int) -> ListConstIterator {
  * @param other The iterator to compare against.
  * @return true if both iterators point to the same node, false otherwise.
  */
-template <typename value_type>
-bool list<value_type>::ListConstIterator::operator==(
+template <typename value_type, typename Allocator>
+bool list<value_type, Allocator>::ListConstIterator::operator==(
     const ListConstIterator &other) const {
   return node_ == other.node_;
 }
@@ -369,14 +422,24 @@ bool list<value_type>::ListConstIterator::operator==(
  * @param other The iterator to compare against.
  * @return true if the iterators point to different nodes, false otherwise.
  */
-template <typename value_type>
-bool list<value_type>::ListConstIterator::operator!=(
+template <typename value_type, typename Allocator>
+bool list<value_type, Allocator>::ListConstIterator::operator!=(
     const ListConstIterator &other) const {
   return !(*this == other);
 }
 
 // List ########################################################################
 
+/**
+ * @brief Constructs an empty list that takes its nodes from the given
+ * allocator.
+ *
+ * @param alloc The allocator to use for all memory allocations.
+ */
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::list(const allocator_type &alloc) noexcept
+    : alloc_{alloc} {}
+
 /**
  * @brief Constructs a new list with a specified number of default-initialized
  * elements.
@@ -391,11 +454,13 @@ bool list<value_type>::ListConstIterator::operator!=(
  * case.
  *
  * @param n The number of elements to add to the list.
+ * @param alloc The allocator to use for all memory allocations.
  */
-template <typename value_type>
-list<value_type>::list(size_type n) {
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::list(size_type n, const allocator_type &alloc)
+    : alloc_{alloc} {
   for (size_type i = 0; i < n; i++) {
-    push_back(value_type());
+    emplace_back();
   }
 }
 
@@ -408,9 +473,12 @@ list<value_type>::list(size_type n) {
  * from the given initializer list to the end of the list.
  *
  * @param items An initializer list of values to populate the list.
+ * @param alloc The allocator to use for all memory allocations.
  */
-template <typename value_type>
-list<value_type>::list(std::initializer_list<value_type> const &items) {
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::list(
+    std::initializer_list<value_type> const &items, const allocator_type &alloc)
+    : alloc_{alloc} {
   for (const value_type &item : items) {
     push_back(item);
   }
@@ -423,13 +491,26 @@ list<value_type>::list(std::initializer_list<value_type> const &items) {
  *
  * This constructor initializes a new list as a copy of the provided list `l`.
  * It initializes the head, tail, and size of the new list and then copies all
- * elements from `l` to the new list using the `copy_from` method.
+ * elements from `l` to the new list using the `copy_from` method. The
+ * allocator is obtained from the allocator of `l` through
+ * select_on_container_copy_construction().
  *
  * @param l The list to be copied.
  */
-template <typename value_type>
-list<value_type>::list(const list &l)
-    : head_{nullptr}, tail_{nullptr}, size_{0} {
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::list(const list &l)
+    : list{l, node_traits::select_on_container_copy_construction(l.alloc_)} {}
+
+/**
+ * @brief Copy constructor that takes the nodes of the new list from the given
+ * allocator.
+ *
+ * @param l The list to be copied.
+ * @param alloc The allocator to use for all memory allocations.
+ */
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::list(const list &l, const allocator_type &alloc)
+    : alloc_{alloc} {
   copy_from(l);
 }
 
@@ -443,9 +524,9 @@ list<value_type>::list(const list &l)
  * @param l The list to copy from.
  * @return Reference to the current list object after copying.
  */
-template <typename value_type>
-auto list<value_type>::operator=(const list &l) -> list & {
-  if (this != l) {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::operator=(const list &l) -> list & {
+  if (this != &l) {
     clear();
     copy_from(l);
   }
@@ -460,13 +541,13 @@ auto list<value_type>::operator=(const list &l) -> list & {
  *
  * Constructs a new list by transferring ownership of the data from the
  * specified list `l` to this list. The source list `l` is left in an
- * empty state.
+ * empty state. The allocator is copied, so both lists can still use it.
  *
  * @param l The list to move from.
  */
-template <typename value_type>
-list<value_type>::list(list &&l)
-    : head_{l.head_}, tail_{l.tail_}, size_{l.size_} {
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::list(list &&l)
+    : head_{l.head_}, tail_{l.tail_}, size_{l.size_}, alloc_{l.alloc_} {
   l.head_ = nullptr;
   l.tail_ = nullptr;
   l.size_ = 0;
@@ -478,14 +559,32 @@ list<value_type>::list(list &&l)
  * @details
  *
  * Moves the contents of the list l into the current list and returns a
- * reference to the modified list.
+ * reference to the modified list. The nodes of l are taken over only if they
+ * can be freed through the allocator of this list; otherwise the elements are
+ * moved into new nodes and l is cleared. That branch is compiled only for
+ * allocators that neither propagate nor always compare equal.
  * @param l The list to move from.
  * @return list reference
  */
-template <typename value_type>
-auto list<value_type>::operator=(list &&l) -> list & {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::operator=(list &&l) -> list & {
   if (this != &l) {
     clear();
+
+    if constexpr (!node_traits::propagate_on_container_move_assignment::value &&
+                  !node_traits::is_always_equal::value) {
+      if (alloc_ != l.alloc_) {
+        move_from(l);
+        l.clear();
+
+        return *this;
+      }
+    }
+
+    if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+      alloc_ = l.alloc_;
+    }
+
     head_ = l.head_;
     tail_ = l.tail_;
     size_ = l.size_;
@@ -495,14 +594,14 @@ auto list<value_type>::operator=(list &&l) -> list & {
     l.size_ = 0;
   }
 
-  return std::move(*this);
+  return *this;
 }
 
 /**
  * @brief Destructor for the list class.
  */
-template <typename value_type>
-list<value_type>::~list() noexcept {
+template <typename value_type, typename Allocator>
+list<value_type, Allocator>::~list() noexcept {
   clear();
 }
 
@@ -511,8 +610,8 @@ list<value_type>::~list() noexcept {
  * @return const_reference A reference to the first element in the list.
  * @throw std::out_of_range if the list is empty.
  */
-template <typename value_type>
-auto list<value_type>::front() const -> const_reference {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::front() const -> const_reference {
   if (empty()) {
     throw std::out_of_range("list is empty");
   }
@@ -525,8 +624,8 @@ auto list<value_type>::front() const -> const_reference {
  * @return const_reference A reference to the last element in the list.
  * @throw std::out_of_range if the list is empty.
  */
-template <typename value_type>
-auto list<value_type>::back() const -> const_reference {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::back() const -> const_reference {
   if (empty()) {
     throw std::out_of_range("list is empty");
   }
@@ -538,8 +637,8 @@ auto list<value_type>::back() const -> const_reference {
  * @brief Returns an iterator to the beginning of the list.
  * @return iterator An iterator to the first element in the list.
  */
-template <typename value_type>
-auto list<value_type>::begin() -> iterator {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::begin() -> iterator {
   return empty() ? iterator{nullptr} : iterator{head_};
 }
 
@@ -548,8 +647,8 @@ auto list<value_type>::begin() -> iterator {
  * @return iterator An iterator to the element following the last element in the
  * list.
  */
-template <typename value_type>
-auto list<value_type>::end() -> iterator {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::end() -> iterator {
   return iterator{nullptr};
 }
 
@@ -558,8 +657,8 @@ auto list<value_type>::end() -> iterator {
  * @return A constant iterator to the beginning of the list or `nullptr` if the
  * list is empty.
  */
-template <typename value_type>
-auto list<value_type>::cbegin() const -> const_iterator {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::cbegin() const -> const_iterator {
   return empty() ? const_iterator{nullptr} : const_iterator{head_};
 }
 
@@ -572,16 +671,16 @@ auto list<value_type>::cbegin() const -> const_iterator {
  *
  * @return A constant iterator to the end of the list.
  */
-template <typename value_type>
-auto list<value_type>::cend() const -> const_iterator {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::cend() const -> const_iterator {
   return const_iterator{nullptr};
 }
 
 /**
  * @brief Checks whether the container is empty.
  */
-template <typename value_type>
-bool list<value_type>::empty() const noexcept {
+template <typename value_type, typename Allocator>
+bool list<value_type, Allocator>::empty() const noexcept {
   return size_ == 0;
 }
 
@@ -589,8 +688,8 @@ bool list<value_type>::empty() const noexcept {
  * @brief Returns the number of elements in the list.
  * @return size_type The number of elements in the list.
  */
-template <typename value_type>
-auto list<value_type>::size() const -> size_type {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::size() const -> size_type {
   return size_;
 }
 
@@ -603,16 +702,16 @@ auto list<value_type>::size() const -> size_type {
  *
  * @return The maximum possible number of elements the list can hold.
  */
-template <typename value_type>
-auto list<value_type>::max_size() const -> size_type {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::max_size() const -> size_type {
   return std::numeric_limits<size_type>::max();
 }
 
 /**
  * @brief Clear the contents of the list.
  */
-template <typename value_type>
-void list<value_type>::clear() noexcept {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::clear() noexcept {
   while (!empty()) {
     pop_back();
   }
@@ -634,38 +733,179 @@ void list<value_type>::clear() noexcept {
  * @param value The value to be inserted into the list.
  * @return An iterator pointing to the newly inserted element.
  */
-template <typename value_type>
-auto list<value_type>::insert(const_iterator pos, const_reference value)
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::insert(const_iterator pos,
+                                         const_reference value) -> iterator {
+  return emplace(pos, value);
+}
+
+/**
+ * @brief Moves a value into a new element before the specified position.
+ *
+ * @details
+ *
+ * Works like the copying insert, but the value is moved into the new node, so
+ * the resources of a heavy object are taken over instead of copied.
+ *
+ * @param pos An iterator pointing to the position before which the new element
+ * will be inserted.
+ * @param value The value to be moved into the list.
+ * @return An iterator pointing to the newly inserted element.
+ */
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::insert(const_iterator pos, value_type &&value)
     -> iterator {
-  Node *new_node = new Node(value);
+  return emplace(pos, std::move(value));
+}
 
-  if (!pos.node_) {
-    new_node->prev = tail_;
+/**
+ * @brief Inserts the elements of a range before the specified position.
+ *
+ * @details
+ *
+ * The new nodes are first linked into a separate chain in a single pass over
+ * the range, so any input iterators will do. If creating a node throws, the
+ * chain is destroyed and the list is left unchanged. Otherwise the whole chain
+ * is linked in before `pos` at once.
+ *
+ * @param pos An iterator pointing to the position before which the new
+ * elements will be inserted.
+ * @param first The beginning of the range of values to insert.
+ * @param last The end of the range of values to insert.
+ * @return An iterator pointing to the first inserted element, or `pos` if the
+ * range is empty.
+ */
+template <typename value_type, typename Allocator>
+template <typename InputIt>
+auto list<value_type, Allocator>::insert(const_iterator pos, InputIt first,
+                                         InputIt last) -> iterator {
+  Node *first_node = nullptr;
+  Node *last_node = nullptr;
+  size_type count = 0;
+
+  try {
+    for (; first != last; ++first, ++count) {
+      Node *new_node = create_node(*first);
+
+      new_node->prev = last_node;
+
+      if (last_node) {
+        last_node->next = new_node;
+      } else {
+        first_node = new_node;
+      }
 
-    if (tail_) {
-      tail_->next = new_node;
-    } else {
-      head_ = new_node;
+      last_node = new_node;
+    }
+  } catch (...) {
+    while (first_node) {
+      Node *next = first_node->next;
+      destroy_node(first_node);
+      first_node = next;
     }
 
-    tail_ = new_node;
+    throw;
+  }
+
+  if (!first_node) {
+    return iterator(pos.node_);
+  }
+
+  Node *next = pos.node_;
+  Node *prev = next ? next->prev : tail_;
+
+  first_node->prev = prev;
+  last_node->next = next;
 
+  if (prev) {
+    prev->next = first_node;
   } else {
-    new_node->prev = pos.node_->prev;
-    new_node->next = pos.node_;
+    head_ = first_node;
+  }
 
-    if (pos.node_->prev) {
-      pos.node_->prev->next = new_node;
-    } else {
-      head_ = new_node;
-    }
+  if (next) {
+    next->prev = last_node;
+  } else {
+    tail_ = last_node;
+  }
+
+  size_ += count;
 
-    pos.node_->prev = new_node;
+  return iterator(first_node);
+}
+
+/**
+ * @brief Inserts the elements of an initializer list before the specified
+ * position.
+ *
+ * @param pos An iterator pointing to the position before which the new
+ * elements will be inserted.
+ * @param items An initializer list of values to insert.
+ * @return An iterator pointing to the first inserted element, or `pos` if the
+ * list of values is empty.
+ */
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::insert(
+    const_iterator pos, std::initializer_list<value_type> items) -> iterator {
+  return insert(pos, items.begin(), items.end());
+}
+
+/**
+ * @brief Replaces the contents of the list with the elements of a range.
+ *
+ * @details
+ *
+ * The values of the range are assigned to the existing nodes first. The nodes
+ * left over are destroyed, and the values left over are appended as one chain
+ * (see the range insert), so no node is freed and allocated again.
+ *
+ * @param first The beginning of the range of values to assign.
+ * @param last The end of the range of values to assign.
+ */
+template <typename value_type, typename Allocator>
+template <typename InputIt>
+void list<value_type, Allocator>::assign(InputIt first, InputIt last) {
+  Node *current = head_;
+  size_type assigned = 0;
+
+  for (; first != last && current; ++first, ++assigned) {
+    current->value = *first;
+    current = current->next;
   }
 
-  ++size_;
+  while (size_ > assigned) {
+    pop_back();
+  }
 
-  return iterator(new_node);
+  insert(cend(), first, last);
+}
+
+/**
+ * @brief Replaces the contents of the list with the elements of an
+ * initializer list.
+ *
+ * @param items An initializer list of values to assign.
+ */
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::assign(
+    std::initializer_list<value_type> items) {
+  assign(items.begin(), items.end());
+}
+
+/**
+ * @brief Appends the elements of a range to the end of the list.
+ *
+ * @details
+ *
+ * The range is anything `std::begin` and `std::end` accept, such as another
+ * container or an array.
+ *
+ * @param range The range whose elements are copied.
+ */
+template <typename value_type, typename Allocator>
+template <typename Range>
+void list<value_type, Allocator>::append_range(Range &&range) {
+  insert(cend(), std::begin(range), std::end(range));
 }
 
 /**
@@ -694,8 +934,8 @@ auto list<value_type>::insert(const_iterator pos, const_reference value)
  * or the end iterator if the list is empty or `pos` is the end
  * iterator.
  */
-template <typename value_type>
-auto list<value_type>::erase(const_iterator pos) -> iterator {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::erase(const_iterator pos) -> iterator {
   if ((pos != end()) && (!empty())) {
     Node *node_to_remove = pos.node_;
     iterator next_it = iterator(node_to_remove->next);
@@ -710,7 +950,7 @@ auto list<value_type>::erase(const_iterator pos) -> iterator {
       node_to_remove->prev->next = node_to_remove->next;
     }
 
-    delete node_to_remove;
+    destroy_node(node_to_remove);
     --size_;
 
     return next_it;
@@ -730,37 +970,36 @@ auto list<value_type>::erase(const_iterator pos) -> iterator {
  *
  * @param value The value to be added to the list.
  */
-template <typename value_type>
-void list<value_type>::push_back(const_reference value) noexcept {
-  Node *new_node = new Node{value};
-
-  if (!head_) {
-    head_ = new_node;
-    tail_ = new_node;
-  } else {
-    tail_->next = new_node;
-    new_node->prev = tail_;
-    tail_ = new_node;
-  }
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::push_back(const_reference value) noexcept {
+  emplace_back(value);
+}
 
-  ++size_;
+/**
+ * @brief Moves the given value into a new node at the end of the list.
+ *
+ * @param value The value to be moved to the end of the list.
+ */
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::push_back(value_type &&value) {
+  emplace_back(std::move(value));
 }
 
 /**
  * @brief Removes the last element of the list.
  */
-template <typename value_type>
-void list<value_type>::pop_back() noexcept {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::pop_back() noexcept {
   if (empty()) {
     std::cerr << "list is empty" << std::endl;
   } else {
     if (size_ == 1) {
-      delete head_;
+      destroy_node(head_);
       head_ = nullptr;
       tail_ = nullptr;
     } else {
       Node *prev = tail_->prev;
-      delete tail_;
+      destroy_node(tail_);
       tail_ = prev;
       tail_->next = nullptr;
     }
@@ -782,20 +1021,19 @@ void list<value_type>::pop_back() noexcept {
  *
  * @param value The value to be inserted at the beginning of the list.
  */
-template <typename value_type>
-void list<value_type>::push_front(const_reference value) {
-  Node *new_node = new Node(value);
-
-  if (empty()) {
-    head_ = new_node;
-    tail_ = new_node;
-  } else {
-    new_node->next = head_;
-    head_->prev = new_node;
-    head_ = new_node;
-  }
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::push_front(const_reference value) {
+  emplace_front(value);
+}
 
-  ++size_;
+/**
+ * @brief Moves the given value into a new node at the beginning of the list.
+ *
+ * @param value The value to be moved to the beginning of the list.
+ */
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::push_front(value_type &&value) {
+  emplace_front(std::move(value));
 }
 
 /**
@@ -814,8 +1052,8 @@ void list<value_type>::push_front(const_reference value) {
  * is empty before calling this function to avoid unexpected behavior.
  *
  */
-template <typename value_type>
-void list<value_type>::pop_front() {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::pop_front() {
   if (head_) {
     Node *old_head = head_;
     head_ = head_->next;
@@ -826,7 +1064,7 @@ void list<value_type>::pop_front() {
       tail_ = nullptr;
     }
 
-    delete old_head;
+    destroy_node(old_head);
     --size_;
   }
 }
@@ -839,14 +1077,19 @@ void list<value_type>::pop_front() {
  * This function exchanges the elements and internal state of this list with
  * another list of the same type. After the swap, the two lists will contain
  * the elements that were originally in the other list and vice versa. This
- * function operates in constant time.
+ * function operates in constant time. The allocators are exchanged too if
+ * the allocator type asks for it.
  *
  * @param other The list to swap contents with. It must be of the same type as
  * this list.
 
  */
-template <typename value_type>
-void list<value_type>::swap(list &other) {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::swap(list &other) {
+  if constexpr (node_traits::propagate_on_container_swap::value) {
+    std::swap(alloc_, other.alloc_);
+  }
+
   std::swap(head_, other.head_);
   std::swap(tail_, other.tail_);
   std::swap(size_, other.size_);
@@ -864,8 +1107,8 @@ void list<value_type>::swap(list &other) {
  * @param other The list to merge with this list. It must be of the same type as
  * this list and must be sorted.
  */
-template <typename value_type>
-void list<value_type>::merge(list &other) {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::merge(list &other) {
   auto this_it = begin();
   auto other_it = other.begin();
 
@@ -902,8 +1145,8 @@ void list<value_type>::merge(list &other) {
  * @param other The list whose elements are to be spliced into this list. It
  * must be of the same type as this list.
  */
-template <typename value_type>
-void list<value_type>::splice(const_iterator pos, list &other) {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::splice(const_iterator pos, list &other) {
   if (this == &other || other.empty()) {
     return;
   }
@@ -945,8 +1188,8 @@ void list<value_type>::splice(const_iterator pos, list &other) {
  * function returns without making any changes.
  *
  */
-template <typename value_type>
-void list<value_type>::reverse() {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::reverse() {
   if (size_ < 2) {
     return;
   }
@@ -977,8 +1220,8 @@ void list<value_type>::reverse() {
  * are removed, and the list is modified in place. If the list is empty or has
  * fewer than two elements, the function returns without making any changes.
  */
-template <typename value_type>
-void list<value_type>::unique() {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::unique() {
   if (empty() || !head_->next) {
     return;
   }
@@ -996,7 +1239,7 @@ void list<value_type>::unique() {
         tail_ = current;
       }
 
-      delete node_to_remove;
+      destroy_node(node_to_remove);
       --size_;
     } else {
       current = current->next;
@@ -1013,8 +1256,8 @@ void list<value_type>::unique() {
  * It will only perform sorting if the list contains more than one element. If
  * the list is empty or contains a single element, no action is taken.
  */
-template <typename value_type>
-void list<value_type>::sort() {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::sort() {
   if (size_ > 1) {
     quick_sort(head_, tail_);
   }
@@ -1032,10 +1275,11 @@ void list<value_type>::sort() {
  * @param args The arguments used to construct the new element.
  * @return A reference to the newly added element in the list.
  */
-template <typename value_type>
+template <typename value_type, typename Allocator>
 template <typename... Args>
-auto list<value_type>::emplace(const_iterator pos, Args &&...args) -> iterator {
-  Node *new_node = new Node(value_type{std::forward<Args>(args)...});
+auto list<value_type, Allocator>::emplace(const_iterator pos, Args &&...args)
+    -> iterator {
+  Node *new_node = create_node(std::forward<Args>(args)...);
 
   Node *current = pos.node_;
 
@@ -1076,10 +1320,10 @@ auto list<value_type>::emplace(const_iterator pos, Args &&...args) -> iterator {
  * @param args The arguments used to construct the new element.
  * @return A reference to the newly added element at the front of the list.
  */
-template <typename value_type>
+template <typename value_type, typename Allocator>
 template <typename... Args>
-auto list<value_type>::emplace_front(Args &&...args) -> reference {
-  Node *new_node = new Node{value_type{std::forward<Args>(args)...}};
+auto list<value_type, Allocator>::emplace_front(Args &&...args) -> reference {
+  Node *new_node = create_node(std::forward<Args>(args)...);
 
   if (!head_) {
     head_ = tail_ = new_node;
@@ -1106,10 +1350,10 @@ auto list<value_type>::emplace_front(Args &&...args) -> reference {
  * @param args The arguments used to construct the new element.
  * @return A reference to the newly added element at the end of the list.
  */
-template <typename value_type>
+template <typename value_type, typename Allocator>
 template <typename... Args>
-auto list<value_type>::emplace_back(Args &&...args) -> reference {
-  Node *new_node = new Node{value_type{std::forward<Args>(args)...}};
+auto list<value_type, Allocator>::emplace_back(Args &&...args) -> reference {
+  Node *new_node = create_node(std::forward<Args>(args)...);
 
   if (!tail_) {
     head_ = tail_ = new_node;
@@ -1124,6 +1368,45 @@ auto list<value_type>::emplace_back(Args &&...args) -> reference {
   return new_node->value;
 }
 
+/**
+ * @brief Allocates a new node and constructs its value from the arguments.
+ *
+ * @details
+ *
+ * The value is constructed in place inside the node, so a value passed as an
+ * rvalue is moved and no temporary is copied. The memory is obtained from the
+ * node allocator. If the construction of the value throws, the memory is
+ * returned to the allocator before the exception is propagated.
+ *
+ * @param args The arguments forwarded to the constructor of the value.
+ * @return Pointer to the new node.
+ */
+template <typename value_type, typename Allocator>
+template <typename... Args>
+auto list<value_type, Allocator>::create_node(Args &&...args) -> Node * {
+  Node *node = node_traits::allocate(alloc_, 1);
+
+  try {
+    node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+
+  return node;
+}
+
+/**
+ * @brief Destroys a node and returns its memory to the node allocator.
+ *
+ * @param node The node to be destroyed.
+ */
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::destroy_node(Node *node) noexcept {
+  node_traits::destroy(alloc_, node);
+  node_traits::deallocate(alloc_, node, 1);
+}
+
 /**
  * @brief Copies elements from another list to the current list.
  *
@@ -1135,8 +1418,8 @@ auto list<value_type>::emplace_back(Args &&...args) -> reference {
  *
  * @param l The list from which elements will be copied.
  */
-template <typename value_type>
-void list<value_type>::copy_from(const list &l) {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::copy_from(const list &l) {
   Node *current = l.head_;
 
   while (current) {
@@ -1145,6 +1428,27 @@ void list<value_type>::copy_from(const list &l) {
   }
 }
 
+/**
+ * @brief Moves elements from another list to the current list.
+ *
+ * @details
+ *
+ * This method moves all elements of the provided list `l` into new nodes
+ * appended to the current list. The nodes of `l` keep their moved-from
+ * elements.
+ *
+ * @param l The list from which elements will be moved.
+ */
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::move_from(list &l) {
+  Node *current = l.head_;
+
+  while (current) {
+    push_back(std::move(current->value));
+    current = current->next;
+  }
+}
+
 /**
  * @brief Recursively sorts the elements in the list using the quicksort
  * algorithm.
@@ -1159,8 +1463,8 @@ void list<value_type>::copy_from(const list &l) {
  * @param left Pointer to the starting node of the segment to be sorted.
  * @param right Pointer to the ending node of the segment to be sorted.
  */
-template <typename value_type>
-void list<value_type>::quick_sort(Node *left, Node *right) {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::quick_sort(Node *left, Node *right) {
   if (!left || !right) return;
   if (left != right && left != right->next) {
     Node *pivot = partition(left, right);
@@ -1185,8 +1489,8 @@ void list<value_type>::quick_sort(Node *left, Node *right) {
  * partitioned.
  * @return Pointer to the node that holds the pivot element after partitioning.
  */
-template <typename value_type>
-auto list<value_type>::partition(Node *left, Node *right) -> Node * {
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::partition(Node *left, Node *right) -> Node * {
   value_type pivot_value = right->value;
   Node *i = left->prev;
 
@@ -1212,8 +1516,8 @@ auto list<value_type>::partition(Node *left, Node *right) -> Node * {
  * @retval false if the sizes of the lists are different or if at least one
  * element differs.
  */
-template <typename value_type>
-bool list<value_type>::operator==(const list &l) const {
+template <typename value_type, typename Allocator>
+bool list<value_type, Allocator>::operator==(const list &l) const {
   if (size_ != l.size_) {
     return false;
   }
@@ -1242,14 +1546,35 @@ bool list<value_type>::operator==(const list &l) const {
  * beginning and ending at the end, and prints each element followed by a space.
  * After printing all elements, it outputs a newline character.
  */
-template <typename value_type>
-void list<value_type>::print() const {
+template <typename value_type, typename Allocator>
+void list<value_type, Allocator>::print() const {
   for (auto it = cbegin(); it != cend(); ++it) {
     std::cout << *it << " ";
   }
   std::cout << std::endl;
 }
 
+/**
+ * @brief Returns the allocator associated with the list.
+ * @return allocator_type A copy of the allocator of the list.
+ */
+template <typename value_type, typename Allocator>
+auto list<value_type, Allocator>::get_allocator() const noexcept
+    -> allocator_type {
+  return allocator_type{alloc_};
+}
+
+namespace pmr {
+
+/**
+ * @brief List whose nodes are taken from a std::pmr::memory_resource.
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+using list = s21::list<T, std::pmr::polymorphic_allocator<T>>;
+
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif  // SRC_CONTAINERS_LIST_H_
@@ -14,7 +14,10 @@
 
 #include <initializer_list>  // for init_list type
 #include <limits>            // for max()
+#include <memory_resource>   // for pmr::polymorphic_allocator
 #include <string>            // for string type
+#include <tuple>             // for forward_as_tuple()
+#include <utility>           // for piecewise_construct, move(), forward()
 
 #include "./tree.h"
 
@@ -32,37 +35,57 @@ namespace s21 {
  *
  * @tparam K The type of keys stored in the map.
  * @tparam M The type of values stored in the map.
+ * @tparam Compare The strict weak ordering of the keys.
+ * @tparam Allocator The allocator type used for the nodes of the map.
  */
-template <typename K, typename M>
+template <typename K, typename M, typename Compare = std::less<K>,
+          typename Allocator = std::allocator<std::pair<K, M>>>
 class map {
  public:
   // Type aliases
 
-  typedef typename tree<K, M>::const_iterator MapConstIterator;
-  typedef typename tree<K, M>::iterator MapIterator;
+  typedef
+      typename tree<K, M, Compare, Allocator>::const_iterator MapConstIterator;
+  typedef typename tree<K, M, Compare, Allocator>::iterator MapIterator;
   using key_type = K;                               ///< Type of pairs key
   using mapped_type = M;                            ///< Type of keys value
   using value_type = std::pair<K, M>;               ///< Pair key-value
   using reference = value_type &;                   ///< Reference to pair
   using const_reference = const value_type &;       ///< Const reference to pair
   using size_type = std::size_t;                    ///< Containers size type
+  using allocator_type = Allocator;                 ///< Allocator of elements
+  using key_compare = Compare;                      ///< Ordering of keys
   using iterator = MapIterator;                     ///< For read/write elements
   using const_iterator = MapConstIterator;          ///< For read elements
   using iterator_bool = std::pair<iterator, bool>;  ///< Pair iterator-bool
+  using iterator_range = std::pair<iterator, iterator>;  ///< Pair of bounds
+  using node_type =
+      typename tree<K, M, Compare, Allocator>::node_type;  ///< Node owner
+  using insert_return_type =
+      node_insert_return<iterator, node_type>;  ///< Result of node insert
 
   // Constructors/assignment operators/destructor
 
   map() noexcept = default;
+  explicit map(const allocator_type &alloc) noexcept;
+  explicit map(const key_compare &comp,
+               const allocator_type &alloc = allocator_type{});
   map(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  static map from_sorted(InputIt first, InputIt last);
   map(const map &m);
+  map(const map &m, const allocator_type &alloc);
   map(map &&m);
   map &operator=(map &&m);
   map &operator=(const map &m);
+  allocator_type get_allocator() const noexcept;
+  key_compare key_comp() const;
 
   // Map Element access
 
   mapped_type &at(const key_type &key) const;
-  mapped_type &operator[](const key_type &key) noexcept;
+  mapped_type &operator[](const key_type &key);
+  mapped_type &operator[](key_type &&key);
   const mapped_type &operator[](const key_type &key) const noexcept;
 
   // Map Iterators
@@ -82,25 +105,87 @@ class map {
 
   void clear();
   iterator_bool insert(const_reference value);
+  iterator insert(const_iterator hint, const_reference value);
   iterator_bool insert(const key_type &key, const mapped_type &obj);
   iterator_bool insert_or_assign(const key_type &key, const mapped_type &obj);
+  template <typename... Args>
+  iterator_bool try_emplace(const key_type &key, Args &&...args);
+  template <typename... Args>
+  iterator_bool try_emplace(key_type &&key, Args &&...args);
   iterator erase(const_iterator pos);
   iterator erase(const_iterator first, const_iterator last);
   size_type erase(const key_type &key);
   void swap(map &other);
   void merge(map &other);
+  node_type extract(const_iterator pos);
+  node_type extract(const key_type &key);
+  insert_return_type insert(node_type &&node);
 
   template <typename... Args>
   std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last);
+  template <typename InputIt>
+  void assign_sorted_checked(InputIt first, InputIt last);
 
   // Map Lookup
 
+  iterator find(const key_type &key) const noexcept;
   bool conatains(const key_type &key) const noexcept;
+  bool contains(const key_type &key) const noexcept;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  size_type count(const key_type &key) const noexcept;
+  iterator_range equal_range(const key_type &key) const noexcept;
+  iterator lower_bound(const key_type &key) const noexcept;
+  iterator upper_bound(const key_type &key) const noexcept;
+  size_type rank(const key_type &key) const;
+  iterator nth(size_type index) const noexcept;
+
+  // Heterogeneous lookup
+
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator find(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  bool contains(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  size_type count(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator_range equal_range(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator lower_bound(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator upper_bound(const Key &key) const noexcept;
+
+  // Map algebra
+
+  template <typename Key, typename T, typename Comp, typename Alloc>
+  friend map<Key, T, Comp, Alloc> set_union(
+      const map<Key, T, Comp, Alloc> &first,
+      const map<Key, T, Comp, Alloc> &second);
+
+  template <typename Key, typename T, typename Comp, typename Alloc>
+  friend map<Key, T, Comp, Alloc> set_intersection(
+      const map<Key, T, Comp, Alloc> &first,
+      const map<Key, T, Comp, Alloc> &second);
+
+  template <typename Key, typename T, typename Comp, typename Alloc>
+  friend map<Key, T, Comp, Alloc> set_difference(
+      const map<Key, T, Comp, Alloc> &first,
+      const map<Key, T, Comp, Alloc> &second);
 
  private:
+  // Type aliases
+
+  using tree_type = tree<key_type, mapped_type, Compare, Allocator>;
+
   // Fields
 
-  tree<key_type, mapped_type> tree_{};  ///< Tree of elements
+  tree_type tree_{};  ///< Tree of elements
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -118,8 +203,34 @@ class map {
  * @param[in] items The initializer list of key-value pairs to insert into the
  * map.
  */
-template <typename K, typename M>
-map<K, M>::map(std::initializer_list<value_type> const &items) : tree_{items} {}
+template <typename K, typename M, typename Compare, typename Allocator>
+map<K, M, Compare, Allocator>::map(
+    std::initializer_list<value_type> const &items)
+    : tree_{items} {}
+
+/**
+ * @brief Creates a map from a range of key-value pairs sorted by key_compare.
+ *
+ * @details
+ * The balanced tree is built bottom-up in O(n), without comparisons or
+ * rebalancing. The keys of the range must be strictly increasing; use
+ * assign_sorted_checked() for input that may not be sorted.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ * @return map - the new map.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename InputIt>
+auto map<K, M, Compare, Allocator>::from_sorted(InputIt first,
+                                                InputIt last) -> map {
+  map result;
+
+  result.assign_sorted(first, last);
+
+  return result;
+}
 
 /**
  * @brief Copy constructor for the map.
@@ -130,8 +241,38 @@ map<K, M>::map(std::initializer_list<value_type> const &items) : tree_{items} {}
  *
  * @param[in] m The map to copy from.
  */
-template <typename K, typename M>
-map<K, M>::map(const map &m) : tree_{m.tree_} {}
+template <typename K, typename M, typename Compare, typename Allocator>
+map<K, M, Compare, Allocator>::map(const map &m) : tree_{m.tree_} {}
+
+/**
+ * @brief Constructs an empty map that uses the given allocator.
+ *
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+map<K, M, Compare, Allocator>::map(const allocator_type &alloc) noexcept
+    : tree_{alloc} {}
+
+/**
+ * @brief Constructs an empty map that orders the keys with comp.
+ *
+ * @param[in] comp The comparator of the keys.
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+map<K, M, Compare, Allocator>::map(const key_compare &comp,
+                                   const allocator_type &alloc)
+    : tree_{comp, alloc} {}
+
+/**
+ * @brief Copy constructor that takes the nodes from the given allocator.
+ *
+ * @param[in] m The map to copy from.
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+map<K, M, Compare, Allocator>::map(const map &m, const allocator_type &alloc)
+    : tree_{m.tree_, alloc} {}
 
 /**
  * @brief Move constructor for the map.
@@ -143,8 +284,8 @@ map<K, M>::map(const map &m) : tree_{m.tree_} {}
  *
  * @param[in] m The map to move from.
  */
-template <typename K, typename M>
-map<K, M>::map(map &&m) : tree_{std::move(m.tree_)} {}
+template <typename K, typename M, typename Compare, typename Allocator>
+map<K, M, Compare, Allocator>::map(map &&m) : tree_{std::move(m.tree_)} {}
 
 /**
  * @brief Move assignment operator for the map.
@@ -155,13 +296,12 @@ map<K, M>::map(map &&m) : tree_{std::move(m.tree_)} {}
  * source map.
  *
  * @param[in] m The map to move from.
- * @return map<K, M>& - reference to the assigned map.
+ * @return map<K, M, Compare, Allocator>& - reference to the assigned map.
  */
-template <typename K, typename M>
-auto map<K, M>::operator=(map &&m) -> map & {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::operator=(map &&m) -> map & {
   if (this != &m) {
-    tree_.clear();
-    new (this) map{std::move(m)};
+    tree_ = std::move(m.tree_);
   }
 
   return *this;
@@ -176,18 +316,38 @@ auto map<K, M>::operator=(map &&m) -> map & {
  * source map.
  *
  * @param[in] m The map to copy from.
- * @return map<K, M>& - reference to the assigned map.
+ * @return map<K, M, Compare, Allocator>& - reference to the assigned map.
  */
-template <typename K, typename M>
-auto map<K, M>::operator=(const map &m) -> map & {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::operator=(const map &m) -> map & {
   if (this != &m) {
-    tree_.clear();
-    new (this) map{m};
+    tree_ = m.tree_;
   }
 
   return *this;
 }
 
+/**
+ * @brief Returns the allocator associated with the map.
+ *
+ * @return allocator_type - a copy of the allocator of the map.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::get_allocator() const noexcept
+    -> allocator_type {
+  return tree_.get_allocator();
+}
+
+/**
+ * @brief Returns the comparator that orders the keys.
+ *
+ * @return key_compare - a copy of the comparator of the map.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::key_comp() const -> key_compare {
+  return tree_.key_comp();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                              MAP ELEMENT ACCESS                            //
 ////////////////////////////////////////////////////////////////////////////////
@@ -203,8 +363,9 @@ auto map<K, M>::operator=(const map &m) -> map & {
  * @return mapped_type& - reference to the value associated with the key.
  * @throws std::out_of_range if the key is not found.
  */
-template <typename K, typename M>
-auto map<K, M>::at(const key_type &key) const -> mapped_type & {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::at(const key_type &key) const
+    -> mapped_type & {
   auto it = tree_.find(key);
 
   if (it == tree_.end()) {
@@ -220,20 +381,29 @@ auto map<K, M>::at(const key_type &key) const -> mapped_type & {
  * @details
  * This method returns a reference to the value associated with the given key.
  * If the key is not found, it inserts a new element with the given key and a
- * default-constructed value.
+ * value-initialized value. The key is searched and inserted in one descent
+ * (see try_emplace()), so a hit constructs nothing.
  *
  * @param[in] key The key to search for.
  * @return mapped_type& - reference to the value associated with the key.
  */
-template <typename K, typename M>
-auto map<K, M>::operator[](const key_type &key) noexcept -> mapped_type & {
-  auto it = tree_.find(key);
-
-  if (it == tree_.end()) {
-    it = tree_.insert({key, mapped_type{}});
-  }
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::operator[](const key_type &key)
+    -> mapped_type & {
+  return (*try_emplace(key).first).second;
+}
 
-  return (*it).second;
+/**
+ * @brief Accesses or inserts a value associated with a given key, moving the
+ * key into a new element.
+ *
+ * @param[in] key The key to search for.
+ * @return mapped_type& - reference to the value associated with the key.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::operator[](key_type &&key)
+    -> mapped_type & {
+  return (*try_emplace(std::move(key)).first).second;
 }
 
 /**
@@ -248,9 +418,9 @@ auto map<K, M>::operator[](const key_type &key) noexcept -> mapped_type & {
  * key.
  * @throws std::out_of_range if the key is not found.
  */
-template <typename K, typename M>
-auto map<K, M>::operator[](const key_type &key) const noexcept
-    -> const mapped_type & {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::operator[](
+    const key_type &key) const noexcept -> const mapped_type & {
   return (*tree_.find(key)).second;
 }
 
@@ -266,8 +436,8 @@ auto map<K, M>::operator[](const key_type &key) const noexcept
  *
  * @return iterator - an iterator to the beginning of the map.
  */
-template <typename K, typename M>
-auto map<K, M>::begin() const noexcept -> iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::begin() const noexcept -> iterator {
   return tree_.begin();
 }
 
@@ -280,8 +450,8 @@ auto map<K, M>::begin() const noexcept -> iterator {
  *
  * @return iterator - an iterator to the end of the map.
  */
-template <typename K, typename M>
-auto map<K, M>::end() const noexcept -> iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::end() const noexcept -> iterator {
   return tree_.end();
 }
 
@@ -293,8 +463,8 @@ auto map<K, M>::end() const noexcept -> iterator {
  *
  * @return const_iterator - a const iterator to the beginning of the map.
  */
-template <typename K, typename M>
-auto map<K, M>::cbegin() const noexcept -> const_iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::cbegin() const noexcept -> const_iterator {
   return tree_.cbegin();
 }
 
@@ -307,8 +477,8 @@ auto map<K, M>::cbegin() const noexcept -> const_iterator {
  *
  * @return const_iterator - a const iterator to the end of the map.
  */
-template <typename K, typename M>
-auto map<K, M>::cend() const noexcept -> const_iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::cend() const noexcept -> const_iterator {
   return tree_.cend();
 }
 
@@ -325,8 +495,8 @@ auto map<K, M>::cend() const noexcept -> const_iterator {
  *
  * @return bool - true if the map is empty, false otherwise.
  */
-template <typename K, typename M>
-bool map<K, M>::empty() const noexcept {
+template <typename K, typename M, typename Compare, typename Allocator>
+bool map<K, M, Compare, Allocator>::empty() const noexcept {
   return (!tree_.size()) ? true : false;
 }
 
@@ -338,8 +508,8 @@ bool map<K, M>::empty() const noexcept {
  *
  * @return size_type - the number of elements in the map.
  */
-template <typename K, typename M>
-auto map<K, M>::size() const noexcept -> size_type {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::size() const noexcept -> size_type {
   return tree_.size();
 }
 
@@ -348,8 +518,8 @@ auto map<K, M>::size() const noexcept -> size_type {
  *
  * @return size_type - the maximum number of elements.
  */
-template <typename K, typename M>
-auto map<K, M>::max_size() const noexcept -> size_type {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::max_size() const noexcept -> size_type {
   return tree_.max_size();
 }
 
@@ -364,8 +534,8 @@ auto map<K, M>::max_size() const noexcept -> size_type {
  * This method removes all elements from the map, leaving it empty.
  *
  */
-template <typename K, typename M>
-void map<K, M>::clear() {
+template <typename K, typename M, typename Compare, typename Allocator>
+void map<K, M, Compare, Allocator>::clear() {
   tree_.clear();
 }
 
@@ -381,12 +551,31 @@ void map<K, M>::clear() {
  * @return iterator_bool - a pair containing an iterator to the inserted element
  * and a bool indicating whether the insertion took place.
  */
-template <typename K, typename M>
-auto map<K, M>::insert(const_reference value) -> iterator_bool {
-  auto it = tree_.insert(value);
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::insert(const_reference value)
+    -> iterator_bool {
+  return tree_.try_emplace(value.first, value);
+}
 
-  return (it != tree_.end()) ? iterator_bool{it, true}
-                             : iterator_bool{tree_.find(value.first), false};
+/**
+ * @brief Inserts a new element as close as possible before hint.
+ *
+ * @details
+ * When the key belongs right before hint, the element is linked in next to
+ * it without searching from the root; appending keys in increasing order
+ * with end() as the hint costs O(1) plus the rebalancing. A wrong hint only
+ * costs the usual search.
+ *
+ * @param[in] hint The position before which the element should be inserted.
+ * @param[in] value The value to insert.
+ * @return iterator - an iterator to the inserted element, or to the element
+ * that prevented the insertion.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::insert(const_iterator hint,
+                                           const_reference value)
+    -> iterator {
+  return tree_.insert(hint, value);
 }
 
 /**
@@ -402,13 +591,11 @@ auto map<K, M>::insert(const_reference value) -> iterator_bool {
  * @return iterator_bool - a pair containing an iterator to the inserted element
  * and a bool indicating whether the insertion took place.
  */
-template <typename K, typename M>
-auto map<K, M>::insert(const key_type &key, const mapped_type &obj)
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::insert(const key_type &key,
+                                           const mapped_type &obj)
     -> iterator_bool {
-  auto it = tree_.insert({key, obj});
-
-  return (it != end()) ? iterator_bool{it, true}
-                       : iterator_bool{tree_.find(key), false};
+  return try_emplace(key, obj);
 }
 
 /**
@@ -425,20 +612,65 @@ auto map<K, M>::insert(const key_type &key, const mapped_type &obj)
  * @return iterator_bool - a pair containing an iterator to the inserted or
  * assigned element and a bool indicating whether the insertion took place.
  */
-template <typename K, typename M>
-auto map<K, M>::insert_or_assign(const key_type &key, const mapped_type &obj)
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::insert_or_assign(const key_type &key,
+                                                     const mapped_type &obj)
     -> iterator_bool {
-  auto it = tree_.find(key);
-  bool obj_exists{false};
+  iterator_bool result = try_emplace(key, obj);
 
-  if (it == tree_.end()) {
-    it = tree_.insert({key, obj});
-    obj_exists = true;
-  } else {
-    (*it).second = obj;
+  if (!result.second) {
+    (*result.first).second = obj;
   }
 
-  return iterator_bool{it, obj_exists};
+  return result;
+}
+
+/**
+ * @brief Inserts an element with the given key and a value built from args,
+ * unless the key exists.
+ *
+ * @details
+ * The place of the key is found by a single descent of the tree, which then
+ * links the new node in. When the key already exists, neither the node nor
+ * the value is constructed and args are left untouched.
+ *
+ * @tparam Args The types of the arguments for the value constructor.
+ * @param[in] key The key of the element to insert.
+ * @param[in] args The arguments forwarded to the value constructor.
+ * @return iterator_bool - an iterator to the element with the key and whether
+ * the insertion took place.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename... Args>
+auto map<K, M, Compare, Allocator>::try_emplace(const key_type &key,
+                                                Args &&...args)
+    -> iterator_bool {
+  return tree_.try_emplace(key, std::piecewise_construct,
+                           std::forward_as_tuple(key),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Inserts an element with the given key, moved into it, and a value
+ * built from args, unless the key exists.
+ *
+ * @details
+ * The key is only moved from when the element is inserted.
+ *
+ * @tparam Args The types of the arguments for the value constructor.
+ * @param[in] key The key of the element to insert.
+ * @param[in] args The arguments forwarded to the value constructor.
+ * @return iterator_bool - an iterator to the element with the key and whether
+ * the insertion took place.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename... Args>
+auto map<K, M, Compare, Allocator>::try_emplace(key_type &&key,
+                                                Args &&...args)
+    -> iterator_bool {
+  return tree_.try_emplace(key, std::piecewise_construct,
+                           std::forward_as_tuple(std::move(key)),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
 }
 
 /**
@@ -451,8 +683,8 @@ auto map<K, M>::insert_or_assign(const key_type &key, const mapped_type &obj)
  * @return iterator - an iterator to the element following the erased element,
  * or end() if the erased element was the last element.
  */
-template <typename K, typename M>
-auto map<K, M>::erase(const_iterator pos) -> iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::erase(const_iterator pos) -> iterator {
   return tree_.erase((*pos).first);
 }
 
@@ -468,8 +700,9 @@ auto map<K, M>::erase(const_iterator pos) -> iterator {
  * element, or end() if the last erased element was the last element.
  * @throws std::range_error if the range is invalid.
  */
-template <typename K, typename M>
-auto map<K, M>::erase(const_iterator first, const_iterator last) -> iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::erase(const_iterator first,
+                                          const_iterator last) -> iterator {
   return tree_.erase(first, last);
 }
 
@@ -482,8 +715,8 @@ auto map<K, M>::erase(const_iterator first, const_iterator last) -> iterator {
  * @param[in] key The key of the elements to erase.
  * @return size_type - the number of elements erased.
  */
-template <typename K, typename M>
-auto map<K, M>::erase(const key_type &key) -> size_type {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::erase(const key_type &key) -> size_type {
   return (tree_.erase(key) != tree_.end()) ? true : false;
 }
 
@@ -495,8 +728,8 @@ auto map<K, M>::erase(const key_type &key) -> size_type {
  *
  * @param[in,out] other The map to swap with.
  */
-template <typename K, typename M>
-void map<K, M>::swap(map &other) {
+template <typename K, typename M, typename Compare, typename Allocator>
+void map<K, M, Compare, Allocator>::swap(map &other) {
   std::swap(tree_, other.tree_);
 }
 
@@ -509,11 +742,56 @@ void map<K, M>::swap(map &other) {
  *
  * @param[in,out] other The map to merge with.
  */
-template <typename K, typename M>
-void map<K, M>::merge(map &other) {
+template <typename K, typename M, typename Compare, typename Allocator>
+void map<K, M, Compare, Allocator>::merge(map &other) {
   tree_.merge(other.tree_);
 }
 
+/**
+ * @brief Unlinks the element at the given position from the map.
+ *
+ * @details
+ * The node is handed over as it is: nothing is copied, allocated or freed.
+ *
+ * @param[in] pos The position of the element to extract.
+ * @return node_type - a handle owning the element, empty for end().
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::extract(const_iterator pos) -> node_type {
+  return tree_.extract(pos);
+}
+
+/**
+ * @brief Unlinks the element with the given key from the map.
+ *
+ * @param[in] key The key of the element to extract.
+ * @return node_type - a handle owning the element, empty if there is none.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::extract(const key_type &key) -> node_type {
+  return tree_.extract(key);
+}
+
+/**
+ * @brief Inserts the element owned by a node handle.
+ *
+ * @details
+ * The node is linked in without allocating. If the key already exists, the
+ * node stays in the returned handle. The node must come from a map with an
+ * equal allocator.
+ *
+ * @param[in,out] node The handle to take the element from.
+ * @return insert_return_type - the position of the element with the key,
+ * whether the node was inserted, and the node if it was not.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::insert(node_type &&node)
+    -> insert_return_type {
+  auto [it, inserted] = tree_.insert(std::move(node));
+
+  return {it, inserted, std::move(node)};
+}
+
 /**
  * @brief Inserts a new element into the map, constructed in place.
  *
@@ -531,12 +809,79 @@ void map<K, M>::merge(map &other) {
  * element that prevented the insertion) and a bool denoting whether the
  * insertion took place.
  */
-template <typename K, typename M>
+template <typename K, typename M, typename Compare, typename Allocator>
 template <typename... Args>
-auto map<K, M>::emplace(Args &&...args) -> std::pair<iterator, bool> {
+auto map<K, M, Compare, Allocator>::emplace(Args &&...args)
+    -> std::pair<iterator, bool> {
   return tree_.emplace(std::forward<Args>(args)...);
 }
 
+/**
+ * @brief Inserts a new element, constructed in place, as close as possible
+ * before hint.
+ *
+ * @details
+ * The element is placed like by insert() with a hint. It is constructed
+ * before its key is known, so it is destroyed again if the key exists.
+ *
+ * @tparam Args The types of the arguments to forward to the constructor of the
+ * element.
+ * @param[in] hint The position before which the element should be inserted.
+ * @param[in] args The arguments to forward to the constructor of the element.
+ * @return iterator - an iterator to the inserted element, or to the element
+ * that prevented the insertion.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename... Args>
+auto map<K, M, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                 Args &&...args) -> iterator {
+  return tree_.emplace_hint(hint, std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Replaces the contents with a range of key-value pairs sorted by
+ * key_compare.
+ *
+ * @details
+ * The balanced tree is built bottom-up in O(n), without comparisons or
+ * rebalancing. The keys of the range must be strictly increasing.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename InputIt>
+void map<K, M, Compare, Allocator>::assign_sorted(InputIt first, InputIt last) {
+  tree_.assign_sorted(
+      first, last,
+      [](const value_type &value) -> const value_type & { return value; });
+}
+
+/**
+ * @brief Replaces the contents with a range of key-value pairs that is
+ * expected to be sorted.
+ *
+ * @details
+ * The order of the range is verified while it is read. A sorted range is
+ * built in O(n) as by assign_sorted(); otherwise the elements are inserted
+ * one by one, with the same result as clear() followed by insert() for every
+ * element.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename InputIt>
+void map<K, M, Compare, Allocator>::assign_sorted_checked(
+    InputIt first, InputIt last) {
+  tree_.assign_sorted(
+      first, last,
+      [](const value_type &value) -> const value_type & { return value; },
+      true);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                  MAP LOOKUP                                //
 ////////////////////////////////////////////////////////////////////////////////
@@ -552,11 +897,367 @@ auto map<K, M>::emplace(Args &&...args) -> std::pair<iterator, bool> {
  * @return bool - true if the map contains an element with the specified key,
  * false otherwise.
  */
-template <typename K, typename M>
-bool map<K, M>::conatains(const key_type &key) const noexcept {
+template <typename K, typename M, typename Compare, typename Allocator>
+bool map<K, M, Compare, Allocator>::conatains(
+    const key_type &key) const noexcept {
   return (tree_.find(key) != tree_.end()) ? true : false;
 }
 
+/**
+ * @brief Checks if the map contains an element with the specified key.
+ *
+ * @param[in] key The key to search for.
+ * @return bool - true if the map contains an element with the specified key,
+ * false otherwise.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+bool map<K, M, Compare, Allocator>::contains(
+    const key_type &key) const noexcept {
+  return tree_.contains(key);
+}
+
+/**
+ * @brief Searches for many keys at once.
+ *
+ * @details
+ * The lookups are interleaved so that their cache misses overlap, which is
+ * faster than a loop of find() calls on a large map.
+ *
+ * @tparam ForwardIt The iterator type of the keys.
+ * @tparam OutputIt The iterator type receiving the results.
+ * @param[in] first The first key to search for.
+ * @param[in] last The end of the keys.
+ * @param[in] out The beginning of the destination for one iterator per key,
+ * `end()` for a missing key.
+ * @return OutputIt - the iterator past the last result written.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt map<K, M, Compare, Allocator>::find_many(ForwardIt first,
+                                                  ForwardIt last,
+                                                  OutputIt out) const {
+  return tree_.find_many(first, last, out);
+}
+
+/**
+ * @brief Checks for many keys at once whether the map contains them.
+ *
+ * @tparam ForwardIt The iterator type of the keys.
+ * @tparam OutputIt The iterator type receiving the results.
+ * @param[in] first The first key to search for.
+ * @param[in] last The end of the keys.
+ * @param[in] out The beginning of the destination for one bool per key.
+ * @return OutputIt - the iterator past the last result written.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt map<K, M, Compare, Allocator>::contains_many(ForwardIt first,
+                                                      ForwardIt last,
+                                                      OutputIt out) const {
+  return tree_.contains_many(first, last, out);
+}
+
+/**
+ * @brief Searches for an element with the specified key.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the element with the specified key, or
+ * `end()` if the key is not found.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::find(const key_type &key) const noexcept
+    -> iterator {
+  return tree_.find(key);
+}
+
+/**
+ * @brief Counts the number of elements with the specified key.
+ *
+ * @details
+ * Since the keys of the map are unique, the result is either 0 or 1.
+ *
+ * @param[in] key The key to search for.
+ * @return size_type - the number of elements with the specified key.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::count(const key_type &key) const noexcept
+    -> size_type {
+  return tree_.count(key);
+}
+
+/**
+ * @brief Returns a range containing all elements with the specified key.
+ *
+ * @details
+ * This method returns a pair of iterators representing the range of elements
+ * with the specified key. Both bounds are found by a single O(log n) descent
+ * of the tree.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator_range - a pair of iterators representing the range of
+ * elements with the specified key.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::equal_range(
+    const key_type &key) const noexcept -> iterator_range {
+  return tree_.equal_range(key);
+}
+
+/**
+ * @brief Returns an iterator to the first element not less than the specified
+ * key.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the first element not less than the
+ * specified key, or `end()` if no such element is found.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::lower_bound(
+    const key_type &key) const noexcept -> iterator {
+  return tree_.lower_bound(key);
+}
+
+/**
+ * @brief Returns an iterator to the first element greater than the specified
+ * key.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the first element greater than the
+ * specified key, or `end()` if no such element is found.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::upper_bound(
+    const key_type &key) const noexcept -> iterator {
+  return tree_.upper_bound(key);
+}
+
+/**
+ * @brief Returns the number of elements whose keys are less than the
+ * specified key.
+ *
+ * @details
+ * This is the position at which lower_bound(key) lies, found in O(log n). It
+ * is useful for percentile queries.
+ *
+ * @param[in] key The key to compare the elements to.
+ * @return size_type - the number of elements less than key.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::rank(const key_type &key) const
+    -> size_type {
+  return tree_.rank(key);
+}
+
+/**
+ * @brief Returns an iterator to the element at the specified position.
+ *
+ * @details
+ * Elements are numbered from zero in sorted order. The element is found in
+ * O(log n), which makes the method suitable for pagination.
+ *
+ * @param[in] index The position of the element.
+ * @return iterator - an iterator to the element, or `end()` if index is not
+ * less than size().
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto map<K, M, Compare, Allocator>::nth(size_type index) const noexcept
+    -> iterator {
+  return tree_.nth(index);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                          HETEROGENEOUS MAP LOOKUP                          //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Searches for an element whose key is equivalent to key.
+ *
+ * @details
+ * Takes part in overload resolution only if Compare is transparent, so a key
+ * of another type (e.g. a string_view for string keys) is compared with the
+ * stored keys directly, without building a temporary key_type.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator - an iterator to the found element, or `end()`.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto map<K, M, Compare, Allocator>::find(const Key &key) const noexcept
+    -> iterator {
+  return tree_.find(key);
+}
+
+/**
+ * @brief Checks if the map contains an element equivalent to key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return bool - true if such an element exists, false otherwise.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key, typename>
+bool map<K, M, Compare, Allocator>::contains(const Key &key) const noexcept {
+  return tree_.contains(key);
+}
+
+/**
+ * @brief Counts the elements equivalent to key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return size_type - the number of matching elements.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto map<K, M, Compare, Allocator>::count(const Key &key) const noexcept
+    -> size_type {
+  return tree_.count(key);
+}
+
+/**
+ * @brief Returns a range containing all elements equivalent to key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator_range - the pair of lower_bound(key) and upper_bound(key).
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto map<K, M, Compare, Allocator>::equal_range(const Key &key) const noexcept
+    -> iterator_range {
+  return tree_.equal_range(key);
+}
+
+/**
+ * @brief Returns an iterator to the first element not less than key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator - an iterator to the found element, or `end()`.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto map<K, M, Compare, Allocator>::lower_bound(const Key &key) const noexcept
+    -> iterator {
+  return tree_.lower_bound(key);
+}
+
+/**
+ * @brief Returns an iterator to the first element greater than key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator - an iterator to the found element, or `end()`.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto map<K, M, Compare, Allocator>::upper_bound(const Key &key) const noexcept
+    -> iterator {
+  return tree_.upper_bound(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                MAP ALGEBRA                                 //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Returns the union of two maps.
+ *
+ * @details
+ * The result holds every element of first and the elements of second whose keys
+ * are not in first. This is what std::set_union writes for the two sorted
+ * ranges.
+ *
+ * Both operands are walked once in O(n + m), and only the elements of the
+ * result are copied. Large operands are split into key ranges that are merged
+ * on several threads (see tree::combine()).
+ *
+ * @param[in] first The first operand, its comparator and allocator are used
+ * for the result.
+ * @param[in] second The second operand.
+ * @return map - the new map.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto set_union(const map<K, M, Compare, Allocator> &first,
+               const map<K, M, Compare, Allocator> &second)
+    -> map<K, M, Compare, Allocator> {
+  using tree_type = typename map<K, M, Compare, Allocator>::tree_type;
+  map<K, M, Compare, Allocator> result{first.key_comp()};
+
+  result.tree_ =
+      tree_type::combine(first.tree_, second.tree_, tree_type::kUNION);
+
+  return result;
+}
+
+/**
+ * @brief Returns the intersection of two maps.
+ *
+ * @details
+ * The result holds the elements of first whose keys are also in second. This is
+ * what std::set_intersection writes for the two sorted ranges.
+ *
+ * Both operands are walked once in O(n + m), and only the elements of the
+ * result are copied. Large operands are split into key ranges that are merged
+ * on several threads (see tree::combine()).
+ *
+ * @param[in] first The first operand, its comparator and allocator are used
+ * for the result.
+ * @param[in] second The second operand.
+ * @return map - the new map.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto set_intersection(const map<K, M, Compare, Allocator> &first,
+                      const map<K, M, Compare, Allocator> &second)
+    -> map<K, M, Compare, Allocator> {
+  using tree_type = typename map<K, M, Compare, Allocator>::tree_type;
+  map<K, M, Compare, Allocator> result{first.key_comp()};
+
+  result.tree_ =
+      tree_type::combine(first.tree_, second.tree_, tree_type::kINTERSECTION);
+
+  return result;
+}
+
+/**
+ * @brief Returns the difference of two maps.
+ *
+ * @details
+ * The result holds the elements of first whose keys are not in second. This is
+ * what std::set_difference writes for the two sorted ranges.
+ *
+ * Both operands are walked once in O(n + m), and only the elements of the
+ * result are copied. Large operands are split into key ranges that are merged
+ * on several threads (see tree::combine()).
+ *
+ * @param[in] first The first operand, its comparator and allocator are used
+ * for the result.
+ * @param[in] second The second operand.
+ * @return map - the new map.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto set_difference(const map<K, M, Compare, Allocator> &first,
+                    const map<K, M, Compare, Allocator> &second)
+    -> map<K, M, Compare, Allocator> {
+  using tree_type = typename map<K, M, Compare, Allocator>::tree_type;
+  map<K, M, Compare, Allocator> result{first.key_comp()};
+
+  result.tree_ =
+      tree_type::combine(first.tree_, second.tree_, tree_type::kDIFFERENCE);
+
+  return result;
+}
+
+namespace pmr {
+
+/**
+ * @brief Map whose nodes are taken from a std::pmr::memory_resource.
+ *
+ * @tparam K The type of keys.
+ * @tparam M The type of mapped values.
+ * @tparam Compare The strict weak ordering of the keys.
+ */
+template <typename K, typename M, typename Compare = std::less<K>>
+using map =
+    s21::map<K, M, Compare, std::pmr::polymorphic_allocator<std::pair<K, M>>>;
+
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif  // SRC_CONTAINERS_MAP_H_
@@ -31,14 +31,18 @@ namespace s21 {
  * element access, and size management.
  *
  * @tparam K The type of keys stored in the multiset.
+ * @tparam Compare The strict weak ordering of the keys.
+ * @tparam Allocator The allocator type used for the nodes of the multiset.
  */
-template <typename K>
+template <typename K, typename Compare = std::less<K>,
+          typename Allocator = std::allocator<K>>
 class multiset {
  private:
   // Container types
 
-  typedef typename set<K>::const_iterator MultisetConstIterator;
-  typedef typename set<K>::iterator MultisetIterator;
+  typedef typename set<K, Compare, Allocator>::const_iterator
+      MultisetConstIterator;
+  typedef typename set<K, Compare, Allocator>::iterator MultisetIterator;
 
  public:
   // Type aliases
@@ -48,23 +52,36 @@ class multiset {
   using reference = value_type &;                ///< Reference to value
   using const_reference = const value_type &;    ///< Const reference to value
   using size_type = std::size_t;                 ///< Containers size type
+  using allocator_type = Allocator;              ///< Allocator of elements
+  using key_compare = Compare;                   ///< Ordering of keys
   using iterator = MultisetIterator;             ///< For read/write elements
   using const_iterator = MultisetConstIterator;  ///< For read elements
   using iterator_range = std::pair<iterator, iterator>;  ///< Pair iterator-bool
+  using node_type = typename tree<const K, void, Compare,
+                                  Allocator>::node_type;  ///< Node owner
 
  private:
-  tree<const key_type, const key_type> tree_{
-      tree<const key_type, const key_type>::kNON_UNIQUE};  ///< Tree of elements
+  using tree_type = tree<const key_type, void, Compare, Allocator>;
+
+  tree_type tree_{tree_type::kNON_UNIQUE};  ///< Tree of elements
 
  public:
   // Constructors/assignment operators/destructor
 
   multiset() noexcept = default;
+  explicit multiset(const allocator_type &alloc) noexcept;
+  explicit multiset(const key_compare &comp,
+                    const allocator_type &alloc = allocator_type{});
   multiset(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  static multiset from_sorted(InputIt first, InputIt last);
   multiset(const multiset &ms);
+  multiset(const multiset &ms, const allocator_type &alloc);
   multiset(multiset &&ms);
   multiset &operator=(multiset &&ms);
   multiset &operator=(const multiset &ms);
+  allocator_type get_allocator() const noexcept;
+  key_compare key_comp() const;
 
   // Multiset Iterators
 
@@ -83,21 +100,70 @@ class multiset {
 
   void clear();
   iterator insert(const_reference value);
+  iterator insert(const_iterator hint, const_reference value);
   iterator erase(const_iterator pos);
   void swap(multiset &other);
   void merge(multiset &other);
+  node_type extract(const_iterator pos);
+  node_type extract(const key_type &key);
+  iterator insert(node_type &&node);
 
   template <typename... Args>
   iterator emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last);
+  template <typename InputIt>
+  void assign_sorted_checked(InputIt first, InputIt last);
 
   // Multiset Lookup
 
   size_type count(const key_type &key) const noexcept;
   iterator find(const key_type &key) const noexcept;
   bool conatains(const key_type &key) const noexcept;
+  bool contains(const key_type &key) const noexcept;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last, OutputIt out) const;
   iterator_range equal_range(const key_type &key) const noexcept;
-  iterator lower_bound(const key_type &key);
-  iterator upper_bound(const key_type &key);
+  iterator lower_bound(const key_type &key) const noexcept;
+  iterator upper_bound(const key_type &key) const noexcept;
+  size_type rank(const key_type &key) const;
+  iterator nth(size_type index) const noexcept;
+
+  // Heterogeneous lookup
+
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator find(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  bool contains(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  size_type count(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator_range equal_range(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator lower_bound(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator upper_bound(const Key &key) const noexcept;
+
+  // Multiset algebra
+
+  template <typename Key, typename Comp, typename Alloc>
+  friend multiset<Key, Comp, Alloc> set_union(
+      const multiset<Key, Comp, Alloc> &first,
+      const multiset<Key, Comp, Alloc> &second);
+
+  template <typename Key, typename Comp, typename Alloc>
+  friend multiset<Key, Comp, Alloc> set_intersection(
+      const multiset<Key, Comp, Alloc> &first,
+      const multiset<Key, Comp, Alloc> &second);
+
+  template <typename Key, typename Comp, typename Alloc>
+  friend multiset<Key, Comp, Alloc> set_difference(
+      const multiset<Key, Comp, Alloc> &first,
+      const multiset<Key, Comp, Alloc> &second);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -114,13 +180,38 @@ class multiset {
  *
  * @param[in] items The initializer list of values to insert into the multiset.
  */
-template <typename K>
-multiset<K>::multiset(std::initializer_list<value_type> const &items) {
+template <typename K, typename Compare, typename Allocator>
+multiset<K, Compare, Allocator>::multiset(
+    std::initializer_list<value_type> const &items) {
   for (auto i : items) {
-    tree_.insert({i, i});
+    tree_.try_emplace(i, i);
   }
 }
 
+/**
+ * @brief Creates a multiset from a range of keys sorted by key_compare.
+ *
+ * @details
+ * The balanced tree is built bottom-up in O(n), without comparisons or
+ * rebalancing. The keys of the range must be non-decreasing; use
+ * assign_sorted_checked() for input that may not be sorted.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ * @return multiset - the new multiset.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename InputIt>
+auto multiset<K, Compare, Allocator>::from_sorted(InputIt first,
+                                                  InputIt last) -> multiset {
+  multiset result;
+
+  result.assign_sorted(first, last);
+
+  return result;
+}
+
 /**
  * @brief Copy constructor for the multiset.
  *
@@ -130,8 +221,40 @@ multiset<K>::multiset(std::initializer_list<value_type> const &items) {
  *
  * @param[in] ms The multiset to copy from.
  */
-template <typename K>
-multiset<K>::multiset(const multiset &ms) : tree_{ms.tree_} {}
+template <typename K, typename Compare, typename Allocator>
+multiset<K, Compare, Allocator>::multiset(const multiset &ms)
+    : tree_{ms.tree_} {}
+
+/**
+ * @brief Constructs an empty multiset that uses the given allocator.
+ *
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename Compare, typename Allocator>
+multiset<K, Compare, Allocator>::multiset(const allocator_type &alloc) noexcept
+    : tree_{alloc, tree_type::kNON_UNIQUE} {}
+
+/**
+ * @brief Constructs an empty multiset that orders the keys with comp.
+ *
+ * @param[in] comp The comparator of the keys.
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename Compare, typename Allocator>
+multiset<K, Compare, Allocator>::multiset(const key_compare &comp,
+                                          const allocator_type &alloc)
+    : tree_{comp, alloc, tree_type::kNON_UNIQUE} {}
+
+/**
+ * @brief Copy constructor that takes the nodes from the given allocator.
+ *
+ * @param[in] ms The multiset to copy from.
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename Compare, typename Allocator>
+multiset<K, Compare, Allocator>::multiset(const multiset &ms,
+                                          const allocator_type &alloc)
+    : tree_{ms.tree_, alloc} {}
 
 /**
  * @brief Move constructor for the multiset.
@@ -143,8 +266,9 @@ multiset<K>::multiset(const multiset &ms) : tree_{ms.tree_} {}
  *
  * @param[in] ms The multiset to move from.
  */
-template <typename K>
-multiset<K>::multiset(multiset &&s) : tree_{std::move(s.tree_)} {}
+template <typename K, typename Compare, typename Allocator>
+multiset<K, Compare, Allocator>::multiset(multiset &&s)
+    : tree_{std::move(s.tree_)} {}
 
 /**
  * @brief Move assignment operator for the multiset.
@@ -155,13 +279,13 @@ multiset<K>::multiset(multiset &&s) : tree_{std::move(s.tree_)} {}
  * from the source multiset.
  *
  * @param[in] ms The multiset to move from.
- * @return multiset<K>& - reference to the assigned multiset.
+ * @return multiset<K, Compare, Allocator>& - reference to the assigned
+ * multiset.
  */
-template <typename K>
-auto multiset<K>::operator=(multiset &&ms) -> multiset & {
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::operator=(multiset &&ms) -> multiset & {
   if (this != &ms) {
-    tree_.clear();
-    new (this) multiset{std::move(ms)};
+    tree_ = std::move(ms.tree_);
   }
 
   return *this;
@@ -176,18 +300,40 @@ auto multiset<K>::operator=(multiset &&ms) -> multiset & {
  * elements from the source multiset.
  *
  * @param[in] ms The multiset to copy from.
- * @return multiset<K>& - reference to the assigned multiset.
+ * @return multiset<K, Compare, Allocator>& - reference to the assigned
+ * multiset.
  */
-template <typename K>
-auto multiset<K>::operator=(const multiset &ms) -> multiset & {
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::operator=(const multiset &ms)
+    -> multiset & {
   if (this != &ms) {
-    tree_.clear();
-    new (this) multiset{ms};
+    tree_ = ms.tree_;
   }
 
   return *this;
 }
 
+/**
+ * @brief Returns the allocator associated with the multiset.
+ *
+ * @return allocator_type - a copy of the allocator of the multiset.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::get_allocator() const noexcept
+    -> allocator_type {
+  return tree_.get_allocator();
+}
+
+/**
+ * @brief Returns the comparator that orders the keys.
+ *
+ * @return key_compare - a copy of the comparator of the multiset.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::key_comp() const -> key_compare {
+  return tree_.key_comp();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                             MULTISET ITERATORS                             //
 ////////////////////////////////////////////////////////////////////////////////
@@ -200,8 +346,8 @@ auto multiset<K>::operator=(const multiset &ms) -> multiset & {
  *
  * @return iterator - an iterator to the beginning of the multiset.
  */
-template <typename K>
-auto multiset<K>::begin() const noexcept -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::begin() const noexcept -> iterator {
   return tree_.begin();
 }
 
@@ -214,8 +360,8 @@ auto multiset<K>::begin() const noexcept -> iterator {
  *
  * @return iterator - an iterator to the end of the multiset.
  */
-template <typename K>
-auto multiset<K>::end() const noexcept -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::end() const noexcept -> iterator {
   return tree_.end();
 }
 
@@ -227,8 +373,9 @@ auto multiset<K>::end() const noexcept -> iterator {
  *
  * @return const_iterator - a const iterator to the beginning of the multiset.
  */
-template <typename K>
-auto multiset<K>::cbegin() const noexcept -> const_iterator {
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::cbegin() const noexcept
+    -> const_iterator {
   return tree_.cbegin();
 }
 
@@ -241,8 +388,8 @@ auto multiset<K>::cbegin() const noexcept -> const_iterator {
  *
  * @return const_iterator - a const iterator to the end of the multiset.
  */
-template <typename K>
-auto multiset<K>::cend() const noexcept -> const_iterator {
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::cend() const noexcept -> const_iterator {
   return tree_.cend();
 }
 
@@ -259,8 +406,8 @@ auto multiset<K>::cend() const noexcept -> const_iterator {
  *
  * @return bool - true if the multiset is empty, false otherwise.
  */
-template <typename K>
-bool multiset<K>::empty() const noexcept {
+template <typename K, typename Compare, typename Allocator>
+bool multiset<K, Compare, Allocator>::empty() const noexcept {
   return (!tree_.size()) ? true : false;
 }
 
@@ -272,8 +419,8 @@ bool multiset<K>::empty() const noexcept {
  *
  * @return size_type - the number of elements in the multiset.
  */
-template <typename K>
-auto multiset<K>::size() const noexcept -> size_type {
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::size() const noexcept -> size_type {
   return tree_.size();
 }
 
@@ -282,8 +429,8 @@ auto multiset<K>::size() const noexcept -> size_type {
  *
  * @return size_type - the maximum number of elements.
  */
-template <typename K>
-auto multiset<K>::max_size() const noexcept -> size_type {
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::max_size() const noexcept -> size_type {
   return tree_.max_size();
 }
 
@@ -297,8 +444,8 @@ auto multiset<K>::max_size() const noexcept -> size_type {
  * @details
  * This method removes all elements from the multiset, leaving it empty.
  */
-template <typename K>
-void multiset<K>::clear() {
+template <typename K, typename Compare, typename Allocator>
+void multiset<K, Compare, Allocator>::clear() {
   tree_.clear();
 }
 
@@ -313,9 +460,30 @@ void multiset<K>::clear() {
  * @param[in] value The value to insert.
  * @return iterator - an iterator to the inserted element.
  */
-template <typename K>
-auto multiset<K>::insert(const_reference value) -> iterator {
-  return tree_.insert({value, value});
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::insert(const_reference value)
+    -> iterator {
+  return tree_.try_emplace(value, value).first;
+}
+
+/**
+ * @brief Inserts a new element as close as possible before hint.
+ *
+ * @details
+ * When the key belongs right before hint, the element is linked in next to
+ * it without searching from the root; appending keys in increasing order
+ * with end() as the hint costs O(1) plus the rebalancing. A wrong hint only
+ * costs the usual search.
+ *
+ * @param[in] hint The position before which the element should be inserted.
+ * @param[in] value The value to insert.
+ * @return iterator - an iterator to the inserted element.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::insert(const_iterator hint,
+                                             const_reference value)
+    -> iterator {
+  return tree_.emplace_hint(hint, value);
 }
 
 /**
@@ -328,8 +496,8 @@ auto multiset<K>::insert(const_reference value) -> iterator {
  * @return iterator - an iterator to the element following the erased element,
  * or end() if the erased element was the last element.
  */
-template <typename K>
-auto multiset<K>::erase(const_iterator pos) -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::erase(const_iterator pos) -> iterator {
   return tree_.erase(pos);
 }
 
@@ -342,8 +510,8 @@ auto multiset<K>::erase(const_iterator pos) -> iterator {
  *
  * @param[in,out] other The multiset to swap with.
  */
-template <typename K>
-void multiset<K>::swap(multiset &other) {
+template <typename K, typename Compare, typename Allocator>
+void multiset<K, Compare, Allocator>::swap(multiset &other) {
   std::swap(tree_, other.tree_);
 }
 
@@ -357,11 +525,53 @@ void multiset<K>::swap(multiset &other) {
  *
  * @param[in,out] other The multiset to merge with.
  */
-template <typename K>
-void multiset<K>::merge(multiset &other) {
+template <typename K, typename Compare, typename Allocator>
+void multiset<K, Compare, Allocator>::merge(multiset &other) {
   tree_.merge(other.tree_);
 }
 
+/**
+ * @brief Unlinks the element at the given position from the multiset.
+ *
+ * @details
+ * The node is handed over as it is: nothing is copied, allocated or freed.
+ *
+ * @param[in] pos The position of the element to extract.
+ * @return node_type - a handle owning the element, empty for end().
+ */
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::extract(const_iterator pos) -> node_type {
+  return tree_.extract(pos);
+}
+
+/**
+ * @brief Unlinks the first element with the given key from the multiset.
+ *
+ * @param[in] key The key of the element to extract.
+ * @return node_type - a handle owning the element, empty if there is none.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::extract(const key_type &key)
+    -> node_type {
+  return tree_.extract(key);
+}
+
+/**
+ * @brief Inserts the element owned by a node handle.
+ *
+ * @details
+ * The node is linked in after the equivalent elements, without allocating.
+ * The node must come from a multiset or a set with an equal allocator.
+ *
+ * @param[in,out] node The handle to take the element from, left empty.
+ * @return iterator - an iterator to the inserted element, or end() for an
+ * empty handle.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::insert(node_type &&node) -> iterator {
+  return tree_.insert(std::move(node)).first;
+}
+
 /**
  * @brief Inserts a new element into the multiset, constructed in place.
  *
@@ -377,12 +587,74 @@ void multiset<K>::merge(multiset &other) {
  * @param args The arguments to forward to the constructor of the element.
  * @return An iterator to the inserted element.
  */
-template <typename K>
+template <typename K, typename Compare, typename Allocator>
+template <typename... Args>
+auto multiset<K, Compare, Allocator>::emplace(Args &&...args) -> iterator {
+  return tree_.emplace(std::forward<Args>(args)...).first;
+}
+
+/**
+ * @brief Inserts a new element, constructed in place, as close as possible
+ * before hint.
+ *
+ * @details
+ * The key is constructed in its node from args and placed like by insert()
+ * with a hint.
+ *
+ * @tparam Args The types of the arguments to forward to the constructor of the
+ * element.
+ * @param[in] hint The position before which the element should be inserted.
+ * @param[in] args The arguments to forward to the constructor of the element.
+ * @return iterator - an iterator to the inserted element.
+ */
+template <typename K, typename Compare, typename Allocator>
 template <typename... Args>
-auto multiset<K>::emplace(Args &&...args) -> iterator {
-  return (tree_.emplace(std::forward<Args>(args)...,
-                        std::forward<Args>(args)...))
-      .first;
+auto multiset<K, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                   Args &&...args)
+    -> iterator {
+  return tree_.emplace_hint(hint, std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Replaces the contents with a range of keys sorted by key_compare.
+ *
+ * @details
+ * The balanced tree is built bottom-up in O(n), without comparisons or
+ * rebalancing. The keys of the range must be non-decreasing.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename InputIt>
+void multiset<K, Compare, Allocator>::assign_sorted(
+    InputIt first, InputIt last) {
+  tree_.assign_sorted(
+      first, last, [](const key_type &key) -> const key_type & { return key; });
+}
+
+/**
+ * @brief Replaces the contents with a range of keys that is expected to be
+ * sorted.
+ *
+ * @details
+ * The order of the range is verified while it is read. A sorted range is
+ * built in O(n) as by assign_sorted(); otherwise the elements are inserted
+ * one by one, with the same result as clear() followed by insert() for every
+ * element.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename InputIt>
+void multiset<K, Compare, Allocator>::assign_sorted_checked(
+    InputIt first, InputIt last) {
+  tree_.assign_sorted(
+      first, last,
+      [](const key_type &key) -> const key_type & { return key; }, true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -394,24 +666,16 @@ auto multiset<K>::emplace(Args &&...args) -> iterator {
  *
  * @details
  * This method returns the number of elements in the multiset with the specified
- * key.
+ * key. The first matching element is found in O(log n), after which only the
+ * matching elements are visited.
  *
  * @param[in] key The key to search for.
  * @return size_type - the number of elements with the specified key.
  */
-template <typename K>
-auto multiset<K>::count(const key_type &key) const noexcept -> size_type {
-  size_type cnt{};
-
-  for (auto i : *this) {
-    if (i == key) {
-      ++cnt;
-    } else if (i != key && cnt) {
-      break;
-    }
-  }
-
-  return cnt;
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::count(const key_type &key) const noexcept
+    -> size_type {
+  return tree_.count(key);
 }
 
 /**
@@ -426,8 +690,9 @@ auto multiset<K>::count(const key_type &key) const noexcept -> size_type {
  * @return iterator - an iterator to the element with the specified key, or
  * `end()` if the key is not found.
  */
-template <typename K>
-auto multiset<K>::find(const key_type &key) const noexcept -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::find(const key_type &key) const noexcept
+    -> iterator {
   return tree_.find(key);
 }
 
@@ -442,44 +707,85 @@ auto multiset<K>::find(const key_type &key) const noexcept -> iterator {
  * @return bool - true if the multiset contains an element with the specified
  * key, false otherwise.
  */
-template <typename K>
-bool multiset<K>::conatains(const key_type &key) const noexcept {
+template <typename K, typename Compare, typename Allocator>
+bool multiset<K, Compare, Allocator>::conatains(
+    const key_type &key) const noexcept {
   return (tree_.find(key) != tree_.end()) ? true : false;
 }
 
+/**
+ * @brief Checks if the multiset contains an element with the specified key.
+ *
+ * @param[in] key The key to search for.
+ * @return bool - true if the multiset contains an element with the specified
+ * key, false otherwise.
+ */
+template <typename K, typename Compare, typename Allocator>
+bool multiset<K, Compare, Allocator>::contains(
+    const key_type &key) const noexcept {
+  return tree_.contains(key);
+}
+
+/**
+ * @brief Searches for many keys at once.
+ *
+ * @details
+ * The lookups are interleaved so that their cache misses overlap, which is
+ * faster than a loop of find() calls on a large multiset.
+ *
+ * @tparam ForwardIt The iterator type of the keys.
+ * @tparam OutputIt The iterator type receiving the results.
+ * @param[in] first The first key to search for.
+ * @param[in] last The end of the keys.
+ * @param[in] out The beginning of the destination for one iterator per key,
+ * `end()` for a missing key.
+ * @return OutputIt - the iterator past the last result written.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt multiset<K, Compare, Allocator>::find_many(ForwardIt first,
+                                                    ForwardIt last,
+                                                    OutputIt out) const {
+  return tree_.find_many(first, last, out);
+}
+
+/**
+ * @brief Checks for many keys at once whether the multiset contains them.
+ *
+ * @tparam ForwardIt The iterator type of the keys.
+ * @tparam OutputIt The iterator type receiving the results.
+ * @param[in] first The first key to search for.
+ * @param[in] last The end of the keys.
+ * @param[in] out The beginning of the destination for one bool per key.
+ * @return OutputIt - the iterator past the last result written.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt multiset<K, Compare, Allocator>::contains_many(ForwardIt first,
+                                                        ForwardIt last,
+                                                        OutputIt out) const {
+  return tree_.contains_many(first, last, out);
+}
+
 /**
  * @brief Returns a range containing all elements with the specified key.
  *
  * @details
  * This method returns a pair of iterators representing the range of elements
  * with the specified key. If the key is not found, both iterators will point
- * to `end()`.
+ * to the first element greater than the key. Both bounds are found by a single
+ * O(log n) descent of the tree.
  *
  * @param[in] key The key to search for.
  * @return iterator_range - a pair of iterators representing the range of
  * elements with the specified key.
  */
-template <typename K>
-auto multiset<K>::equal_range(const key_type &key) const noexcept
-    -> iterator_range {
-  iterator first{end()};
-  iterator last{end()};
-  size_type cnt{};
-
-  for (iterator i = begin(); i != end(); i++) {
-    if (*i == key && !cnt) {
-      first = i;
-      ++cnt;
-    } else if (*i > key) {
-      last = i;
-      if (!cnt) {
-        first = i;
-      }
-      break;
-    }
-  }
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::equal_range(
+    const key_type &key) const noexcept -> iterator_range {
+  auto range = tree_.equal_range(key);
 
-  return iterator_range{first, last};
+  return iterator_range{range.first, range.second};
 }
 
 /**
@@ -495,21 +801,10 @@ auto multiset<K>::equal_range(const key_type &key) const noexcept
  * @return iterator - an iterator to the first element not less than the
  * specified key.
  */
-template <typename K>
-auto multiset<K>::lower_bound(const key_type &key) -> iterator {
-  iterator first{end()};
-
-  for (iterator i = begin(); i != end(); i++) {
-    if (*i == key) {
-      first = i;
-      break;
-    } else if (*i > key) {
-      first = i;
-      break;
-    }
-  }
-
-  return first;
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::lower_bound(
+    const key_type &key) const noexcept -> iterator {
+  return tree_.lower_bound(key);
 }
 
 /**
@@ -525,20 +820,241 @@ auto multiset<K>::lower_bound(const key_type &key) -> iterator {
  * @return iterator - an iterator to the first element greater than the
  * specified key.
  */
-template <typename K>
-auto multiset<K>::upper_bound(const key_type &key) -> iterator {
-  iterator last{end()};
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::upper_bound(
+    const key_type &key) const noexcept -> iterator {
+  return tree_.upper_bound(key);
+}
 
-  for (iterator i = begin(); i != end(); i++) {
-    if (*i > key) {
-      last = i;
-      break;
-    }
-  }
+/**
+ * @brief Returns the number of elements whose keys are less than the
+ * specified key.
+ *
+ * @details
+ * This is the position at which lower_bound(key) lies, found in O(log n). It
+ * is useful for percentile queries.
+ *
+ * @param[in] key The key to compare the elements to.
+ * @return size_type - the number of elements less than key.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::rank(const key_type &key) const
+    -> size_type {
+  return tree_.rank(key);
+}
+
+/**
+ * @brief Returns an iterator to the element at the specified position.
+ *
+ * @details
+ * Elements are numbered from zero in sorted order. The element is found in
+ * O(log n), which makes the method suitable for pagination.
+ *
+ * @param[in] index The position of the element.
+ * @return iterator - an iterator to the element, or `end()` if index is not
+ * less than size().
+ */
+template <typename K, typename Compare, typename Allocator>
+auto multiset<K, Compare, Allocator>::nth(size_type index) const noexcept
+    -> iterator {
+  return tree_.nth(index);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                       HETEROGENEOUS MULTISET LOOKUP                        //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Searches for an element whose key is equivalent to key.
+ *
+ * @details
+ * Takes part in overload resolution only if Compare is transparent, so a key
+ * of another type (e.g. a string_view for string keys) is compared with the
+ * stored keys directly, without building a temporary key_type.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator - an iterator to the found element, or `end()`.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto multiset<K, Compare, Allocator>::find(const Key &key) const noexcept
+    -> iterator {
+  return tree_.find(key);
+}
+
+/**
+ * @brief Checks if the multiset contains an element equivalent to key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return bool - true if such an element exists, false otherwise.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename Key, typename>
+bool multiset<K, Compare, Allocator>::contains(const Key &key) const noexcept {
+  return tree_.contains(key);
+}
+
+/**
+ * @brief Counts the elements equivalent to key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return size_type - the number of matching elements.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto multiset<K, Compare, Allocator>::count(const Key &key) const noexcept
+    -> size_type {
+  return tree_.count(key);
+}
 
-  return last;
+/**
+ * @brief Returns a range containing all elements equivalent to key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator_range - the pair of lower_bound(key) and upper_bound(key).
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto multiset<K, Compare, Allocator>::equal_range(const Key &key) const noexcept
+    -> iterator_range {
+  auto range = tree_.equal_range(key);
+
+  return iterator_range{range.first, range.second};
+}
+
+/**
+ * @brief Returns an iterator to the first element not less than key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator - an iterator to the found element, or `end()`.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto multiset<K, Compare, Allocator>::lower_bound(const Key &key) const noexcept
+    -> iterator {
+  return tree_.lower_bound(key);
+}
+
+/**
+ * @brief Returns an iterator to the first element greater than key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator - an iterator to the found element, or `end()`.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto multiset<K, Compare, Allocator>::upper_bound(const Key &key) const noexcept
+    -> iterator {
+  return tree_.upper_bound(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                              MULTISET ALGEBRA                              //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Returns the union of two multisets.
+ *
+ * @details
+ * Each key appears as many times as in the operand that has more of it; the
+ * elements of first come before the extra elements of second. This is what
+ * std::set_union writes for the two sorted ranges.
+ *
+ * Both operands are walked once in O(n + m), and only the elements of the
+ * result are copied. Large operands are split into key ranges that are merged
+ * on several threads (see tree::combine()).
+ *
+ * @param[in] first The first operand, its comparator and allocator are used
+ * for the result.
+ * @param[in] second The second operand.
+ * @return multiset - the new multiset.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set_union(const multiset<K, Compare, Allocator> &first,
+               const multiset<K, Compare, Allocator> &second)
+    -> multiset<K, Compare, Allocator> {
+  using tree_type = typename multiset<K, Compare, Allocator>::tree_type;
+  multiset<K, Compare, Allocator> result{first.key_comp()};
+
+  result.tree_ =
+      tree_type::combine(first.tree_, second.tree_, tree_type::kUNION);
+
+  return result;
+}
+
+/**
+ * @brief Returns the intersection of two multisets.
+ *
+ * @details
+ * Each key appears as many times as in the operand that has fewer of it, and
+ * the elements are taken from first. This is what std::set_intersection writes
+ * for the two sorted ranges.
+ *
+ * Both operands are walked once in O(n + m), and only the elements of the
+ * result are copied. Large operands are split into key ranges that are merged
+ * on several threads (see tree::combine()).
+ *
+ * @param[in] first The first operand, its comparator and allocator are used
+ * for the result.
+ * @param[in] second The second operand.
+ * @return multiset - the new multiset.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set_intersection(const multiset<K, Compare, Allocator> &first,
+                      const multiset<K, Compare, Allocator> &second)
+    -> multiset<K, Compare, Allocator> {
+  using tree_type = typename multiset<K, Compare, Allocator>::tree_type;
+  multiset<K, Compare, Allocator> result{first.key_comp()};
+
+  result.tree_ =
+      tree_type::combine(first.tree_, second.tree_, tree_type::kINTERSECTION);
+
+  return result;
 }
 
+/**
+ * @brief Returns the difference of two multisets.
+ *
+ * @details
+ * Each key appears as many times as first has more of it than second, and the
+ * last ones of first are kept. This is what std::set_difference writes for the
+ * two sorted ranges.
+ *
+ * Both operands are walked once in O(n + m), and only the elements of the
+ * result are copied. Large operands are split into key ranges that are merged
+ * on several threads (see tree::combine()).
+ *
+ * @param[in] first The first operand, its comparator and allocator are used
+ * for the result.
+ * @param[in] second The second operand.
+ * @return multiset - the new multiset.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set_difference(const multiset<K, Compare, Allocator> &first,
+                    const multiset<K, Compare, Allocator> &second)
+    -> multiset<K, Compare, Allocator> {
+  using tree_type = typename multiset<K, Compare, Allocator>::tree_type;
+  multiset<K, Compare, Allocator> result{first.key_comp()};
+
+  result.tree_ =
+      tree_type::combine(first.tree_, second.tree_, tree_type::kDIFFERENCE);
+
+  return result;
+}
+
+namespace pmr {
+
+/**
+ * @brief Multiset whose nodes are taken from a std::pmr::memory_resource.
+ *
+ * @tparam K The type of keys.
+ * @tparam Compare The strict weak ordering of the keys.
+ */
+template <typename K, typename Compare = std::less<K>>
+using multiset = s21::multiset<K, Compare, std::pmr::polymorphic_allocator<K>>;
+
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif  // SRC_CONTAINERS_MULTISET_H_
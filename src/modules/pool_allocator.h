@@ -0,0 +1,455 @@
+/**
+ * @file pool_allocator.h
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Header for the pool (arena) allocator of container nodes
+ * @version 1.0
+ * @date 2024-08-14
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_CONTAINERS_POOL_ALLOCATOR_H_
+#define SRC_CONTAINERS_POOL_ALLOCATOR_H_
+
+#include <cstddef>      // for size_t, max_align_t
+#include <memory>       // for shared_ptr, allocator
+#include <new>          // for operator new/delete
+#include <type_traits>  // for true_type, false_type
+
+/// @brief Namespace for working with containers
+namespace s21 {
+
+/**
+ * @brief Arena of memory slabs with free lists for small fixed-size blocks.
+ *
+ * @details
+ * The arena carves blocks out of large slabs obtained from the global
+ * operator new. Blocks are grouped in size classes of kAlign bytes; a freed
+ * block is pushed onto the free list of its class and handed out again by the
+ * next allocation of the same class. All slabs are returned to the system at
+ * once by release() or by the destructor, without visiting single blocks.
+ */
+class pool_arena {
+ public:
+  // Constructors/assignment operators/destructor
+
+  pool_arena() noexcept = default;
+  pool_arena(const pool_arena &other) = delete;
+  pool_arena &operator=(const pool_arena &other) = delete;
+  ~pool_arena();
+
+  // Working with memory
+
+  void *allocate(std::size_t bytes);
+  void deallocate(void *ptr, std::size_t bytes) noexcept;
+  void reserve(std::size_t bytes, std::size_t count);
+  void release() noexcept;
+  static bool fits(std::size_t bytes, std::size_t align) noexcept;
+
+ private:
+  // Container types
+
+  struct Block;
+
+  // Constants
+
+  static constexpr std::size_t kAlign = alignof(std::max_align_t);
+  static constexpr std::size_t kClasses = 16;  ///< Largest block 16 * kAlign
+  static constexpr std::size_t kFirstSlab = 4096;
+  static constexpr std::size_t kMaxSlab = 1 << 20;
+  static constexpr std::size_t kHeader = kAlign;  ///< Slab header, one Block
+
+  // Fields
+
+  Block *free_[kClasses]{};            ///< Free lists per size class
+  Block *slabs_{};                     ///< List of allocated slabs
+  char *cursor_{};                     ///< First free byte of the slab
+  char *limit_{};                      ///< End of the current slab
+  std::size_t slab_size_{kFirstSlab};  ///< Size of the next slab
+
+  // Helpers
+
+  static std::size_t sizeClass(std::size_t bytes) noexcept;
+  void addSlab(std::size_t bytes);
+  void pushSlab(std::size_t size);
+};
+
+/**
+ * @brief Header of a free block or of a slab.
+ */
+struct pool_arena::Block {
+  Block *next;  ///< Next block in the list
+};
+
+/**
+ * @brief A standard allocator drawing single objects from a shared arena.
+ *
+ * @details
+ * Copies and rebinds of a pool_allocator share one pool_arena, so a tree that
+ * rebinds it to its node type takes every node from the same slabs. Requests
+ * for more than one object, or for objects too large or over-aligned for the
+ * arena, are forwarded to std::allocator. Copy-constructing a container
+ * gives the copy a fresh arena, so two containers never share slabs unless
+ * they were explicitly given the same allocator.
+ *
+ * @tparam T The type of objects to allocate.
+ */
+template <typename T>
+class pool_allocator {
+ public:
+  // Type aliases
+
+  using value_type = T;           ///< Type of allocated objects
+  using size_type = std::size_t;  ///< Type of object counts
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  // Constructors
+
+  pool_allocator();
+  template <typename U>
+  pool_allocator(const pool_allocator<U> &other) noexcept;
+
+  // Working with memory
+
+  T *allocate(size_type n);
+  void deallocate(T *ptr, size_type n) noexcept;
+  void reserve(size_type n);
+  bool unique() const noexcept;
+  void release() noexcept;
+  pool_allocator select_on_container_copy_construction() const;
+
+  // Comparison
+
+  template <typename U>
+  bool operator==(const pool_allocator<U> &other) const noexcept;
+  template <typename U>
+  bool operator!=(const pool_allocator<U> &other) const noexcept;
+
+ private:
+  template <typename U>
+  friend class pool_allocator;
+
+  // Fields
+
+  std::shared_ptr<pool_arena> arena_;  ///< Arena shared by all copies
+};
+
+/**
+ * @brief Detects allocators able to free all their memory in one step.
+ *
+ * @details
+ * A container whose node allocator satisfies this trait may skip the
+ * per-node deallocation on clear() and destruction and call release() once
+ * instead, provided unique() reports that no other container shares the
+ * memory.
+ *
+ * @tparam A The allocator type to check.
+ */
+template <typename A, typename = void>
+struct has_bulk_release : std::false_type {};
+
+template <typename A>
+struct has_bulk_release<A, std::void_t<decltype(std::declval<A &>().release()),
+                                       decltype(std::declval<A &>().unique())>>
+    : std::true_type {};
+
+/**
+ * @brief Detects allocators able to set aside memory for a number of single
+ * objects in advance.
+ *
+ * @details
+ * A container that knows how many nodes it is about to allocate, for example
+ * when copying another container, may call reserve() once so that the nodes
+ * are cut from one contiguous block.
+ *
+ * @tparam A The allocator type to check.
+ */
+template <typename A, typename = void>
+struct has_reserve : std::false_type {};
+
+template <typename A>
+struct has_reserve<A, std::void_t<decltype(std::declval<A &>().reserve(
+                          std::declval<std::size_t>()))>> : std::true_type {};
+
+////////////////////////////////////////////////////////////////////////////////
+//                                  POOL ARENA                                //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Destructor. Returns all slabs to the system.
+ */
+inline pool_arena::~pool_arena() { release(); }
+
+/**
+ * @brief Allocates a block of the given size.
+ *
+ * @details
+ * The block is taken from the free list of its size class if possible,
+ * otherwise it is cut from the current slab. A new slab, twice as large as
+ * the previous one up to kMaxSlab bytes, is added when the current one is
+ * exhausted.
+ *
+ * @param[in] bytes The size of the block. It must satisfy fits().
+ * @return void* - pointer to the block.
+ */
+inline void *pool_arena::allocate(std::size_t bytes) {
+  std::size_t index = sizeClass(bytes);
+  Block *block = free_[index];
+
+  if (block) {
+    free_[index] = block->next;
+    return block;
+  }
+
+  std::size_t rounded = (index + 1) * kAlign;
+
+  if (static_cast<std::size_t>(limit_ - cursor_) < rounded) {
+    addSlab(rounded);
+  }
+
+  void *ptr = cursor_;
+  cursor_ += rounded;
+
+  return ptr;
+}
+
+/**
+ * @brief Returns a block to the free list of its size class.
+ *
+ * @param[in] ptr The block to free.
+ * @param[in] bytes The size the block was allocated with.
+ */
+inline void pool_arena::deallocate(void *ptr, std::size_t bytes) noexcept {
+  std::size_t index = sizeClass(bytes);
+  Block *block = static_cast<Block *>(ptr);
+
+  block->next = free_[index];
+  free_[index] = block;
+}
+
+/**
+ * @brief Makes sure the next count blocks of the given size are cut from the
+ * current slab.
+ *
+ * @details
+ * If the current slab is too small, a slab of exactly the required size is
+ * added. The growth of regular slabs is not affected.
+ *
+ * @param[in] bytes The size of the blocks. It must satisfy fits().
+ * @param[in] count The number of blocks.
+ */
+inline void pool_arena::reserve(std::size_t bytes, std::size_t count) {
+  std::size_t rounded = (sizeClass(bytes) + 1) * kAlign;
+
+  if (static_cast<std::size_t>(limit_ - cursor_) / rounded < count) {
+    pushSlab(kHeader + rounded * count);
+  }
+}
+
+/**
+ * @brief Frees all slabs at once.
+ *
+ * @details
+ * Every block handed out by the arena becomes invalid. Objects living in
+ * them are not destroyed.
+ */
+inline void pool_arena::release() noexcept {
+  while (slabs_) {
+    Block *next = slabs_->next;
+    ::operator delete(slabs_);
+    slabs_ = next;
+  }
+
+  for (auto &list : free_) {
+    list = nullptr;
+  }
+
+  cursor_ = limit_ = nullptr;
+  slab_size_ = kFirstSlab;
+}
+
+/**
+ * @brief Checks whether a block of the given size and alignment can be taken
+ * from the arena.
+ *
+ * @param[in] bytes The size of the block.
+ * @param[in] align The alignment of the block.
+ * @return true if the arena can serve the block, false otherwise.
+ */
+inline bool pool_arena::fits(std::size_t bytes, std::size_t align) noexcept {
+  return bytes && bytes <= kClasses * kAlign && align <= kAlign;
+}
+
+/**
+ * @brief Returns the index of the size class for the given size.
+ *
+ * @param[in] bytes The size of the block.
+ * @return std::size_t - the index of the size class.
+ */
+inline std::size_t pool_arena::sizeClass(std::size_t bytes) noexcept {
+  return (bytes - 1) / kAlign;
+}
+
+/**
+ * @brief Adds a new slab large enough for a block of the given size.
+ *
+ * @param[in] bytes The size of the block that did not fit.
+ */
+inline void pool_arena::addSlab(std::size_t bytes) {
+  while (slab_size_ < kHeader + bytes) {
+    slab_size_ *= 2;
+  }
+
+  pushSlab(slab_size_);
+
+  if (slab_size_ < kMaxSlab) {
+    slab_size_ *= 2;
+  }
+}
+
+/**
+ * @brief Allocates a slab of the given size and makes it the current one.
+ *
+ * @param[in] size The size of the slab including its header.
+ */
+inline void pool_arena::pushSlab(std::size_t size) {
+  char *slab = static_cast<char *>(::operator new(size));
+
+  reinterpret_cast<Block *>(slab)->next = slabs_;
+  slabs_ = reinterpret_cast<Block *>(slab);
+  cursor_ = slab + kHeader;
+  limit_ = slab + size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                               POOL ALLOCATOR                               //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Default constructor. Creates an allocator with a new empty arena.
+ */
+template <typename T>
+pool_allocator<T>::pool_allocator() : arena_{std::make_shared<pool_arena>()} {}
+
+/**
+ * @brief Converting constructor. The new allocator shares the arena of other.
+ *
+ * @param[in] other The allocator to share the arena with.
+ */
+template <typename T>
+template <typename U>
+pool_allocator<T>::pool_allocator(const pool_allocator<U> &other) noexcept
+    : arena_{other.arena_} {}
+
+/**
+ * @brief Allocates storage for n objects of type T.
+ *
+ * @param[in] n The number of objects.
+ * @return T* - pointer to the uninitialized storage.
+ */
+template <typename T>
+T *pool_allocator<T>::allocate(size_type n) {
+  if (n == 1 && pool_arena::fits(sizeof(T), alignof(T))) {
+    return static_cast<T *>(arena_->allocate(sizeof(T)));
+  }
+
+  return std::allocator<T>{}.allocate(n);
+}
+
+/**
+ * @brief Frees storage obtained from allocate().
+ *
+ * @param[in] ptr The pointer returned by allocate().
+ * @param[in] n The number of objects passed to allocate().
+ */
+template <typename T>
+void pool_allocator<T>::deallocate(T *ptr, size_type n) noexcept {
+  if (n == 1 && pool_arena::fits(sizeof(T), alignof(T))) {
+    arena_->deallocate(ptr, sizeof(T));
+  } else {
+    std::allocator<T>{}.deallocate(ptr, n);
+  }
+}
+
+/**
+ * @brief Sets aside memory for n single objects of type T.
+ *
+ * @details
+ * The following n calls to allocate(1) are served from one contiguous block.
+ * Objects too large or over-aligned for the arena are not affected.
+ *
+ * @param[in] n The number of objects.
+ */
+template <typename T>
+void pool_allocator<T>::reserve(size_type n) {
+  if (n && pool_arena::fits(sizeof(T), alignof(T))) {
+    arena_->reserve(sizeof(T), n);
+  }
+}
+
+/**
+ * @brief Checks whether this allocator is the only user of its arena.
+ *
+ * @return true if no other allocator shares the arena, false otherwise.
+ */
+template <typename T>
+bool pool_allocator<T>::unique() const noexcept {
+  return arena_.use_count() == 1;
+}
+
+/**
+ * @brief Frees all single objects allocated from the arena in O(1) per slab.
+ *
+ * @details
+ * Storage obtained for n != 1 objects is not affected and must still be
+ * passed to deallocate().
+ */
+template <typename T>
+void pool_allocator<T>::release() noexcept {
+  arena_->release();
+}
+
+/**
+ * @brief Returns the allocator for a copy of a container.
+ *
+ * @return pool_allocator - an allocator with a new empty arena.
+ */
+template <typename T>
+auto pool_allocator<T>::select_on_container_copy_construction() const
+    -> pool_allocator {
+  return pool_allocator{};
+}
+
+/**
+ * @brief Equality comparison. Allocators are equal if they share the arena.
+ *
+ * @param[in] other The allocator to compare with.
+ * @return true if memory from one can be freed through the other.
+ */
+template <typename T>
+template <typename U>
+bool pool_allocator<T>::operator==(
+    const pool_allocator<U> &other) const noexcept {
+  return arena_ == other.arena_;
+}
+
+/**
+ * @brief Inequality comparison.
+ *
+ * @param[in] other The allocator to compare with.
+ * @return true if the allocators use different arenas.
+ */
+template <typename T>
+template <typename U>
+bool pool_allocator<T>::operator!=(
+    const pool_allocator<U> &other) const noexcept {
+  return arena_ != other.arena_;
+}
+
+}  // namespace s21
+
+#endif  // SRC_CONTAINERS_POOL_ALLOCATOR_H_
@@ -12,6 +12,10 @@
 #ifndef SRC_CONTAINERS_QUEUE_H_
 #define SRC_CONTAINERS_QUEUE_H_
 
+#include <memory>       // for std::uses_allocator
+#include <type_traits>  // for std::enable_if_t
+#include <utility>      // for std::move
+
 namespace s21 {
 
 /**
@@ -35,6 +39,12 @@ class queue {
   queue() : queue(Container()) {}
   explicit queue(const Container &other);
   explicit queue(Container &&other);
+  template <typename Alloc, typename = std::enable_if_t<
+                                std::uses_allocator_v<Container, Alloc>>>
+  explicit queue(const Alloc &alloc);
+  template <typename Alloc, typename = std::enable_if_t<
+                                std::uses_allocator_v<Container, Alloc>>>
+  queue(const Container &other, const Alloc &alloc);
   queue(const queue &q);
   queue(queue &&q);
   ~queue();
@@ -53,6 +63,7 @@ class queue {
   // Queue Modifiers
 
   void push(const_reference value);
+  void push(value_type &&value);
   void pop();
   void swap(queue &other) noexcept;
 
@@ -69,6 +80,31 @@ queue<value_type, Container>::queue(const Container &other) : c(other) {}
 template <typename value_type, typename Container>
 queue<value_type, Container>::queue(Container &&other) : c(std::move(other)) {}
 
+/**
+ * @brief Constructor that passes an allocator to the underlying container.
+ *
+ * @details
+ *
+ * Initializes an empty queue whose container takes its memory from the
+ * given allocator. Available only if the container uses such an allocator.
+ *
+ * @param alloc The allocator for the underlying container.
+ */
+template <typename value_type, typename Container>
+template <typename Alloc, typename>
+queue<value_type, Container>::queue(const Alloc &alloc) : c(alloc) {}
+
+/**
+ * @brief Constructor that copies a container using the given allocator.
+ *
+ * @param other The container to be copied into the queue.
+ * @param alloc The allocator for the underlying container.
+ */
+template <typename value_type, typename Container>
+template <typename Alloc, typename>
+queue<value_type, Container>::queue(const Container &other, const Alloc &alloc)
+    : c(other, alloc) {}
+
 /**
  * @brief Copy constructor.
  *
@@ -114,7 +150,7 @@ queue<value_type, Container>::~queue() {}
 template <typename value_type, typename Container>
 typename queue<value_type, Container>::queue &
 queue<value_type, Container>::operator=(queue &&q) {
-  swap(q);
+  c = std::move(q.c);
 
   return *this;
 }
@@ -196,6 +232,21 @@ void queue<value_type, Container>::push(const_reference value) {
   c.push_back(value);
 }
 
+/**
+ * @brief Moves an element to the end of the queue.
+ *
+ * @details
+ *
+ * Works like the copying push, but the element is moved all the way into the
+ * node of the underlying container instead of being copied.
+ *
+ * @param value The element to move into the queue.
+ */
+template <typename value_type, typename Container>
+void queue<value_type, Container>::push(value_type &&value) {
+  c.push_back(std::move(value));
+}
+
 /**
  * @brief Removes the element at the front of the queue.
  *
@@ -247,6 +298,27 @@ void queue<value_type, Container>::emplace(Args &&...args) {
   c.emplace_back(std::forward<Args>(args)...);
 }
 
+namespace pmr {
+
+/**
+ * @brief Queue built on a list that takes its nodes from a
+ * std::pmr::memory_resource.
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+using queue = s21::queue<T, s21::pmr::list<T>>;
+
+}  // namespace pmr
+
 }  // namespace s21
 
+namespace std {
+
+/// @brief The queue uses an allocator whenever its container does.
+template <typename T, typename Container, typename Alloc>
+struct uses_allocator<s21::queue<T, Container>, Alloc>
+    : uses_allocator<Container, Alloc>::type {};
+
+}  // namespace std
+
 #endif  // SRC_CONTAINERS_QUEUE_H_
@@ -14,6 +14,7 @@
 
 #include <initializer_list>  // for init_list type
 #include <limits>            // for max()
+#include <memory_resource>   // for pmr::polymorphic_allocator
 #include <string>            // for string type
 
 #include "./tree.h"
@@ -31,8 +32,11 @@ namespace s21 {
  * and size management.
  *
  * @tparam K The type of keys stored in the set.
+ * @tparam Compare The strict weak ordering of the keys.
+ * @tparam Allocator The allocator type used for the nodes of the set.
  */
-template <typename K>
+template <typename K, typename Compare = std::less<K>,
+          typename Allocator = std::allocator<K>>
 class set {
  public:
   // Container types
@@ -47,18 +51,33 @@ class set {
   using reference = value_type &;              ///< Reference to value
   using const_reference = const value_type &;  ///< Const reference to value
   using size_type = std::size_t;               ///< Containers size type
+  using allocator_type = Allocator;            ///< Allocator of keys
+  using key_compare = Compare;                 ///< Ordering of keys
   using iterator = SetIterator;                ///< For read/write elements
   using const_iterator = SetConstIterator;     ///< For read elements
   using iterator_bool = std::pair<iterator, bool>;  ///< Pair iterator-bool
+  using iterator_range = std::pair<iterator, iterator>;  ///< Pair of bounds
+  using node_type = typename tree<const K, void, Compare,
+                                  Allocator>::node_type;  ///< Node owner
+  using insert_return_type =
+      node_insert_return<iterator, node_type>;  ///< Result of node insert
 
   // Constructors/assignment operators/destructor
 
   set() noexcept = default;
+  explicit set(const allocator_type &alloc) noexcept;
+  explicit set(const key_compare &comp,
+               const allocator_type &alloc = allocator_type{});
   set(std::initializer_list<value_type> const &items);
+  template <typename InputIt>
+  static set from_sorted(InputIt first, InputIt last);
   set(const set &s);
+  set(const set &s, const allocator_type &alloc);
   set(set &&s);
   set &operator=(set &&s);
   set &operator=(const set &s);
+  allocator_type get_allocator() const noexcept;
+  key_compare key_comp() const;
 
   // Set Iterators
 
@@ -77,23 +96,77 @@ class set {
 
   void clear();
   iterator_bool insert(const_reference value);
+  iterator insert(const_iterator hint, const_reference value);
   iterator erase(const_iterator pos);
   iterator erase(const_iterator first, const_iterator last);
   void swap(set &other);
   void merge(set &other);
+  node_type extract(const_iterator pos);
+  node_type extract(const key_type &key);
+  insert_return_type insert(node_type &&node);
 
   template <typename... Args>
   std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last);
+  template <typename InputIt>
+  void assign_sorted_checked(InputIt first, InputIt last);
 
   // Set Lookup
 
   iterator find(const key_type &key) const noexcept;
   bool conatains(const key_type &key) const noexcept;
+  bool contains(const key_type &key) const noexcept;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  size_type count(const key_type &key) const noexcept;
+  iterator_range equal_range(const key_type &key) const noexcept;
+  iterator lower_bound(const key_type &key) const noexcept;
+  iterator upper_bound(const key_type &key) const noexcept;
+  size_type rank(const key_type &key) const;
+  iterator nth(size_type index) const noexcept;
+
+  // Heterogeneous lookup
+
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator find(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  bool contains(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  size_type count(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator_range equal_range(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator lower_bound(const Key &key) const noexcept;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator upper_bound(const Key &key) const noexcept;
+
+  // Set algebra
+
+  template <typename Key, typename Comp, typename Alloc>
+  friend set<Key, Comp, Alloc> set_union(const set<Key, Comp, Alloc> &first,
+                                         const set<Key, Comp, Alloc> &second);
+
+  template <typename Key, typename Comp, typename Alloc>
+  friend set<Key, Comp, Alloc> set_intersection(
+      const set<Key, Comp, Alloc> &first, const set<Key, Comp, Alloc> &second);
+
+  template <typename Key, typename Comp, typename Alloc>
+  friend set<Key, Comp, Alloc> set_difference(
+      const set<Key, Comp, Alloc> &first, const set<Key, Comp, Alloc> &second);
 
  private:
+  // Type aliases
+
+  using tree_type = tree<const key_type, void, Compare, Allocator>;
+
   // Fields
 
-  tree<const key_type, const key_type> tree_{};  ///< Tree of elements
+  tree_type tree_{};  ///< Tree of keys
 };
 
 /**
@@ -105,12 +178,14 @@ class set {
  *
  * @tparam K The type of keys stored in the set.
  */
-template <typename K>
-class set<K>::SetIterator : public tree<const K, const K>::TreeIterator {
+template <typename K, typename Compare, typename Allocator>
+class set<K, Compare, Allocator>::SetIterator
+    : public tree<const K, void, Compare, Allocator>::TreeIterator {
  public:
   // Type aliases
 
-  using _tree_it = typename tree<const K, const K>::TreeIterator;
+  using _tree_it =
+      typename tree<const K, void, Compare, Allocator>::TreeIterator;
 
   // Constructors
 
@@ -139,13 +214,14 @@ class set<K>::SetIterator : public tree<const K, const K>::TreeIterator {
  *
  * @tparam K The type of keys stored in the set.
  */
-template <typename K>
-class set<K>::SetConstIterator
-    : public tree<const K, const K>::TreeConstIterator {
+template <typename K, typename Compare, typename Allocator>
+class set<K, Compare, Allocator>::SetConstIterator
+    : public tree<const K, void, Compare, Allocator>::TreeConstIterator {
  public:
   // Type aliases
 
-  using _tree_cit = typename tree<const K, const K>::TreeConstIterator;
+  using _tree_cit =
+      typename tree<const K, void, Compare, Allocator>::TreeConstIterator;
 
   // Constructors
 
@@ -180,13 +256,38 @@ class set<K>::SetConstIterator
  *
  * @param[in] items The initializer list of values to insert into the set.
  */
-template <typename K>
-set<K>::set(std::initializer_list<value_type> const &items) {
+template <typename K, typename Compare, typename Allocator>
+set<K, Compare, Allocator>::set(
+    std::initializer_list<value_type> const &items) {
   for (auto i : items) {
-    tree_.insert({i, i});
+    tree_.try_emplace(i, i);
   }
 }
 
+/**
+ * @brief Creates a set from a range of keys sorted by key_compare.
+ *
+ * @details
+ * The balanced tree is built bottom-up in O(n), without comparisons or
+ * rebalancing. The keys of the range must be strictly increasing; use
+ * assign_sorted_checked() for input that may not be sorted.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ * @return set - the new set.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename InputIt>
+auto set<K, Compare, Allocator>::from_sorted(InputIt first,
+                                             InputIt last) -> set {
+  set result;
+
+  result.assign_sorted(first, last);
+
+  return result;
+}
+
 /**
  * @brief Copy constructor for the set.
  *
@@ -196,8 +297,38 @@ set<K>::set(std::initializer_list<value_type> const &items) {
  *
  * @param[in] s The set to copy from.
  */
-template <typename K>
-set<K>::set(const set &s) : tree_{s.tree_} {}
+template <typename K, typename Compare, typename Allocator>
+set<K, Compare, Allocator>::set(const set &s) : tree_{s.tree_} {}
+
+/**
+ * @brief Constructs an empty set that uses the given allocator.
+ *
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename Compare, typename Allocator>
+set<K, Compare, Allocator>::set(const allocator_type &alloc) noexcept
+    : tree_{alloc} {}
+
+/**
+ * @brief Constructs an empty set that orders the keys with comp.
+ *
+ * @param[in] comp The comparator of the keys.
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename Compare, typename Allocator>
+set<K, Compare, Allocator>::set(const key_compare &comp,
+                                const allocator_type &alloc)
+    : tree_{comp, alloc} {}
+
+/**
+ * @brief Copy constructor that takes the nodes from the given allocator.
+ *
+ * @param[in] s The set to copy from.
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename Compare, typename Allocator>
+set<K, Compare, Allocator>::set(const set &s, const allocator_type &alloc)
+    : tree_{s.tree_, alloc} {}
 
 /**
  * @brief Move constructor for the set.
@@ -209,8 +340,8 @@ set<K>::set(const set &s) : tree_{s.tree_} {}
  *
  * @param[in] s The set to move from.
  */
-template <typename K>
-set<K>::set(set &&s) : tree_{std::move(s.tree_)} {}
+template <typename K, typename Compare, typename Allocator>
+set<K, Compare, Allocator>::set(set &&s) : tree_{std::move(s.tree_)} {}
 
 /**
  * @brief Move assignment operator for the set.
@@ -221,13 +352,12 @@ set<K>::set(set &&s) : tree_{std::move(s.tree_)} {}
  * source set.
  *
  * @param[in] s The set to move from.
- * @return set<K>& - reference to the assigned set.
+ * @return set<K, Compare, Allocator>& - reference to the assigned set.
  */
-template <typename K>
-set<K> &set<K>::operator=(set &&s) {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::operator=(set &&s) -> set & {
   if (this != &s) {
-    tree_.clear();
-    new (this) set{std::move(s)};
+    tree_ = std::move(s.tree_);
   }
 
   return *this;
@@ -242,18 +372,38 @@ set<K> &set<K>::operator=(set &&s) {
  * source set.
  *
  * @param[in] s The set to copy from.
- * @return set<K>& - reference to the assigned set.
+ * @return set<K, Compare, Allocator>& - reference to the assigned set.
  */
-template <typename K>
-set<K> &set<K>::operator=(const set &s) {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::operator=(const set &s) -> set & {
   if (this != &s) {
-    tree_.clear();
-    new (this) set{s};
+    tree_ = s.tree_;
   }
 
   return *this;
 }
 
+/**
+ * @brief Returns the allocator associated with the set.
+ *
+ * @return allocator_type - a copy of the allocator of the set.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::get_allocator() const noexcept
+    -> allocator_type {
+  return tree_.get_allocator();
+}
+
+/**
+ * @brief Returns the comparator that orders the keys.
+ *
+ * @return key_compare - a copy of the comparator of the set.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::key_comp() const -> key_compare {
+  return tree_.key_comp();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                               SET ITERATORS                                //
 ////////////////////////////////////////////////////////////////////////////////
@@ -266,8 +416,8 @@ set<K> &set<K>::operator=(const set &s) {
  *
  * @return iterator - an iterator to the beginning of the set.
  */
-template <typename K>
-auto set<K>::begin() const noexcept -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::begin() const noexcept -> iterator {
   return tree_.begin();
 }
 
@@ -280,8 +430,8 @@ auto set<K>::begin() const noexcept -> iterator {
  *
  * @return iterator - an iterator to the end of the set.
  */
-template <typename K>
-auto set<K>::end() const noexcept -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::end() const noexcept -> iterator {
   return tree_.end();
 }
 
@@ -293,8 +443,8 @@ auto set<K>::end() const noexcept -> iterator {
  *
  * @return const_iterator - a const iterator to the beginning of the set.
  */
-template <typename K>
-auto set<K>::cbegin() const noexcept -> const_iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::cbegin() const noexcept -> const_iterator {
   return tree_.cbegin();
 }
 
@@ -307,8 +457,8 @@ auto set<K>::cbegin() const noexcept -> const_iterator {
  *
  * @return const_iterator - a const iterator to the end of the set.
  */
-template <typename K>
-auto set<K>::cend() const noexcept -> const_iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::cend() const noexcept -> const_iterator {
   return tree_.cend();
 }
 
@@ -325,8 +475,8 @@ auto set<K>::cend() const noexcept -> const_iterator {
  *
  * @return bool - true if the set is empty, false otherwise.
  */
-template <typename K>
-bool set<K>::empty() const noexcept {
+template <typename K, typename Compare, typename Allocator>
+bool set<K, Compare, Allocator>::empty() const noexcept {
   return (!tree_.size()) ? true : false;
 }
 
@@ -338,8 +488,8 @@ bool set<K>::empty() const noexcept {
  *
  * @return size_type - the number of elements in the set.
  */
-template <typename K>
-auto set<K>::size() const noexcept -> size_type {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::size() const noexcept -> size_type {
   return tree_.size();
 }
 
@@ -348,8 +498,8 @@ auto set<K>::size() const noexcept -> size_type {
  *
  * @return size_type - the maximum number of elements.
  */
-template <typename K>
-auto set<K>::max_size() const noexcept -> size_type {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::max_size() const noexcept -> size_type {
   return tree_.max_size();
 }
 
@@ -363,8 +513,8 @@ auto set<K>::max_size() const noexcept -> size_type {
  * @details
  * This method removes all elements from the set, leaving it empty.
  */
-template <typename K>
-void set<K>::clear() {
+template <typename K, typename Compare, typename Allocator>
+void set<K, Compare, Allocator>::clear() {
   tree_.clear();
 }
 
@@ -380,12 +530,31 @@ void set<K>::clear() {
  * @return iterator_bool - a pair containing an iterator to the inserted element
  * and a bool indicating whether the insertion took place.
  */
-template <typename K>
-auto set<K>::insert(const_reference value) -> iterator_bool {
-  iterator it = tree_.insert({value, value});
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::insert(const_reference value)
+    -> iterator_bool {
+  return tree_.try_emplace(value, value);
+}
 
-  return (it != end()) ? iterator_bool{it, true}
-                       : iterator_bool{tree_.find(value), false};
+/**
+ * @brief Inserts a new element as close as possible before hint.
+ *
+ * @details
+ * When the key belongs right before hint, the element is linked in next to
+ * it without searching from the root; appending keys in increasing order
+ * with end() as the hint costs O(1) plus the rebalancing. A wrong hint only
+ * costs the usual search.
+ *
+ * @param[in] hint The position before which the element should be inserted.
+ * @param[in] value The value to insert.
+ * @return iterator - an iterator to the inserted element, or to the element
+ * that prevented the insertion.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::insert(const_iterator hint,
+                                        const_reference value)
+    -> iterator {
+  return tree_.emplace_hint(hint, value);
 }
 
 /**
@@ -398,8 +567,8 @@ auto set<K>::insert(const_reference value) -> iterator_bool {
  * @return iterator - an iterator to the element following the erased element,
  * or end() if the erased element was the last element.
  */
-template <typename K>
-auto set<K>::erase(const_iterator pos) -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::erase(const_iterator pos) -> iterator {
   return tree_.erase(*pos);
 }
 
@@ -415,8 +584,9 @@ auto set<K>::erase(const_iterator pos) -> iterator {
  * element, or end() if the last erased element was the last element.
  * @throws std::range_error if the range is invalid.
  */
-template <typename K>
-auto set<K>::erase(const_iterator first, const_iterator last) -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::erase(const_iterator first,
+                                       const_iterator last) -> iterator {
   return tree_.erase(first, last);
 }
 
@@ -428,8 +598,8 @@ auto set<K>::erase(const_iterator first, const_iterator last) -> iterator {
  *
  * @param[in,out] other The set to swap with.
  */
-template <typename K>
-void set<K>::swap(set &other) {
+template <typename K, typename Compare, typename Allocator>
+void set<K, Compare, Allocator>::swap(set &other) {
   std::swap(tree_, other.tree_);
 }
 
@@ -442,11 +612,56 @@ void set<K>::swap(set &other) {
  *
  * @param[in,out] other The set to merge with.
  */
-template <typename K>
-void set<K>::merge(set &other) {
+template <typename K, typename Compare, typename Allocator>
+void set<K, Compare, Allocator>::merge(set &other) {
   tree_.merge(other.tree_);
 }
 
+/**
+ * @brief Unlinks the element at the given position from the set.
+ *
+ * @details
+ * The node is handed over as it is: nothing is copied, allocated or freed.
+ *
+ * @param[in] pos The position of the element to extract.
+ * @return node_type - a handle owning the element, empty for end().
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::extract(const_iterator pos) -> node_type {
+  return tree_.extract(pos);
+}
+
+/**
+ * @brief Unlinks the element with the given key from the set.
+ *
+ * @param[in] key The key of the element to extract.
+ * @return node_type - a handle owning the element, empty if there is none.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::extract(const key_type &key) -> node_type {
+  return tree_.extract(key);
+}
+
+/**
+ * @brief Inserts the element owned by a node handle.
+ *
+ * @details
+ * The node is linked in without allocating. If the key already exists, the
+ * node stays in the returned handle. The node must come from a set with an
+ * equal allocator.
+ *
+ * @param[in,out] node The handle to take the element from.
+ * @return insert_return_type - the position of the element with the key,
+ * whether the node was inserted, and the node if it was not.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::insert(node_type &&node)
+    -> insert_return_type {
+  auto [it, inserted] = tree_.insert(std::move(node));
+
+  return {it, inserted, std::move(node)};
+}
+
 /**
  * @brief Inserts a new element into the set, constructed in place.
  *
@@ -464,11 +679,75 @@ void set<K>::merge(set &other) {
  * element that prevented the insertion) and a bool indicating whether the
  * insertion took place.
  */
-template <typename K>
+template <typename K, typename Compare, typename Allocator>
 template <typename... Args>
-auto set<K>::emplace(Args &&...args) -> std::pair<iterator, bool> {
-  return tree_.emplace(std::forward<Args>(args)...,
-                       std::forward<Args>(args)...);
+auto set<K, Compare, Allocator>::emplace(Args &&...args)
+    -> std::pair<iterator, bool> {
+  return tree_.emplace(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Inserts a new element, constructed in place, as close as possible
+ * before hint.
+ *
+ * @details
+ * The key is constructed in its node from args and placed like by insert()
+ * with a hint.
+ *
+ * @tparam Args The types of the arguments to forward to the constructor of the
+ * element.
+ * @param[in] hint The position before which the element should be inserted.
+ * @param[in] args The arguments to forward to the constructor of the element.
+ * @return iterator - an iterator to the inserted element, or to the element
+ * that prevented the insertion.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename... Args>
+auto set<K, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                              Args &&...args)
+    -> iterator {
+  return tree_.emplace_hint(hint, std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Replaces the contents with a range of keys sorted by key_compare.
+ *
+ * @details
+ * The balanced tree is built bottom-up in O(n), without comparisons or
+ * rebalancing. The keys of the range must be strictly increasing.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename InputIt>
+void set<K, Compare, Allocator>::assign_sorted(InputIt first, InputIt last) {
+  tree_.assign_sorted(
+      first, last, [](const key_type &key) -> const key_type & { return key; });
+}
+
+/**
+ * @brief Replaces the contents with a range of keys that is expected to be
+ * sorted.
+ *
+ * @details
+ * The order of the range is verified while it is read. A sorted range is
+ * built in O(n) as by assign_sorted(); otherwise the elements are inserted
+ * one by one, with the same result as clear() followed by insert() for every
+ * element.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename InputIt>
+void set<K, Compare, Allocator>::assign_sorted_checked(
+    InputIt first, InputIt last) {
+  tree_.assign_sorted(
+      first, last,
+      [](const key_type &key) -> const key_type & { return key; }, true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -487,8 +766,9 @@ auto set<K>::emplace(Args &&...args) -> std::pair<iterator, bool> {
  * @return iterator - an iterator to the element with the specified key, or
  * `end()` if the key is not found.
  */
-template <typename K>
-auto set<K>::find(const key_type &key) const noexcept -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::find(const key_type &key) const noexcept
+    -> iterator {
   return tree_.find(key);
 }
 
@@ -503,11 +783,340 @@ auto set<K>::find(const key_type &key) const noexcept -> iterator {
  * @return bool - true if the set contains an element with the specified key,
  * false otherwise.
  */
-template <typename K>
-bool set<K>::conatains(const key_type &key) const noexcept {
+template <typename K, typename Compare, typename Allocator>
+bool set<K, Compare, Allocator>::conatains(const key_type &key) const noexcept {
   return (tree_.find(key) != tree_.end()) ? true : false;
 }
 
+/**
+ * @brief Checks if the set contains an element with the specified key.
+ *
+ * @param[in] key The key to search for.
+ * @return bool - true if the set contains an element with the specified key,
+ * false otherwise.
+ */
+template <typename K, typename Compare, typename Allocator>
+bool set<K, Compare, Allocator>::contains(const key_type &key) const noexcept {
+  return tree_.contains(key);
+}
+
+/**
+ * @brief Searches for many keys at once.
+ *
+ * @details
+ * The lookups are interleaved so that their cache misses overlap, which is
+ * faster than a loop of find() calls on a large set.
+ *
+ * @tparam ForwardIt The iterator type of the keys.
+ * @tparam OutputIt The iterator type receiving the results.
+ * @param[in] first The first key to search for.
+ * @param[in] last The end of the keys.
+ * @param[in] out The beginning of the destination for one iterator per key,
+ * `end()` for a missing key.
+ * @return OutputIt - the iterator past the last result written.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt set<K, Compare, Allocator>::find_many(ForwardIt first,
+                                               ForwardIt last,
+                                               OutputIt out) const {
+  return tree_.find_many(first, last, out);
+}
+
+/**
+ * @brief Checks for many keys at once whether the set contains them.
+ *
+ * @tparam ForwardIt The iterator type of the keys.
+ * @tparam OutputIt The iterator type receiving the results.
+ * @param[in] first The first key to search for.
+ * @param[in] last The end of the keys.
+ * @param[in] out The beginning of the destination for one bool per key.
+ * @return OutputIt - the iterator past the last result written.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt set<K, Compare, Allocator>::contains_many(ForwardIt first,
+                                                   ForwardIt last,
+                                                   OutputIt out) const {
+  return tree_.contains_many(first, last, out);
+}
+
+/**
+ * @brief Counts the number of elements with the specified key.
+ *
+ * @details
+ * Since the keys of the set are unique, the result is either 0 or 1.
+ *
+ * @param[in] key The key to search for.
+ * @return size_type - the number of elements with the specified key.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::count(const key_type &key) const noexcept
+    -> size_type {
+  return tree_.count(key);
+}
+
+/**
+ * @brief Returns a range containing all elements with the specified key.
+ *
+ * @details
+ * This method returns a pair of iterators representing the range of elements
+ * with the specified key. Both bounds are found by a single O(log n) descent
+ * of the tree.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator_range - a pair of iterators representing the range of
+ * elements with the specified key.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::equal_range(const key_type &key) const noexcept
+    -> iterator_range {
+  auto range = tree_.equal_range(key);
+
+  return iterator_range{range.first, range.second};
+}
+
+/**
+ * @brief Returns an iterator to the first element not less than the specified
+ * key.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the first element not less than the
+ * specified key, or `end()` if no such element is found.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::lower_bound(const key_type &key) const noexcept
+    -> iterator {
+  return tree_.lower_bound(key);
+}
+
+/**
+ * @brief Returns an iterator to the first element greater than the specified
+ * key.
+ *
+ * @param[in] key The key to search for.
+ * @return iterator - an iterator to the first element greater than the
+ * specified key, or `end()` if no such element is found.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::upper_bound(const key_type &key) const noexcept
+    -> iterator {
+  return tree_.upper_bound(key);
+}
+
+/**
+ * @brief Returns the number of elements whose keys are less than the
+ * specified key.
+ *
+ * @details
+ * This is the position at which lower_bound(key) lies, found in O(log n). It
+ * is useful for percentile queries.
+ *
+ * @param[in] key The key to compare the elements to.
+ * @return size_type - the number of elements less than key.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::rank(const key_type &key) const -> size_type {
+  return tree_.rank(key);
+}
+
+/**
+ * @brief Returns an iterator to the element at the specified position.
+ *
+ * @details
+ * Elements are numbered from zero in sorted order. The element is found in
+ * O(log n), which makes the method suitable for pagination.
+ *
+ * @param[in] index The position of the element.
+ * @return iterator - an iterator to the element, or `end()` if index is not
+ * less than size().
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::nth(size_type index) const noexcept
+    -> iterator {
+  return tree_.nth(index);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                          HETEROGENEOUS SET LOOKUP                          //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Searches for an element whose key is equivalent to key.
+ *
+ * @details
+ * Takes part in overload resolution only if Compare is transparent, so a key
+ * of another type (e.g. a string_view for string keys) is compared with the
+ * stored keys directly, without building a temporary key_type.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator - an iterator to the found element, or `end()`.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto set<K, Compare, Allocator>::find(const Key &key) const noexcept
+    -> iterator {
+  return tree_.find(key);
+}
+
+/**
+ * @brief Checks if the set contains an element equivalent to key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return bool - true if such an element exists, false otherwise.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename Key, typename>
+bool set<K, Compare, Allocator>::contains(const Key &key) const noexcept {
+  return tree_.contains(key);
+}
+
+/**
+ * @brief Counts the elements equivalent to key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return size_type - the number of matching elements.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto set<K, Compare, Allocator>::count(const Key &key) const noexcept
+    -> size_type {
+  return tree_.count(key);
+}
+
+/**
+ * @brief Returns a range containing all elements equivalent to key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator_range - the pair of lower_bound(key) and upper_bound(key).
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto set<K, Compare, Allocator>::equal_range(const Key &key) const noexcept
+    -> iterator_range {
+  auto range = tree_.equal_range(key);
+
+  return iterator_range{range.first, range.second};
+}
+
+/**
+ * @brief Returns an iterator to the first element not less than key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator - an iterator to the found element, or `end()`.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto set<K, Compare, Allocator>::lower_bound(const Key &key) const noexcept
+    -> iterator {
+  return tree_.lower_bound(key);
+}
+
+/**
+ * @brief Returns an iterator to the first element greater than key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator - an iterator to the found element, or `end()`.
+ */
+template <typename K, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto set<K, Compare, Allocator>::upper_bound(const Key &key) const noexcept
+    -> iterator {
+  return tree_.upper_bound(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                SET ALGEBRA                                 //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Returns the union of two sets.
+ *
+ * @details
+ * The result holds every element of first and the elements of second whose keys
+ * are not in first. This is what std::set_union writes for the two sorted
+ * ranges.
+ *
+ * Both operands are walked once in O(n + m), and only the elements of the
+ * result are copied. Large operands are split into key ranges that are merged
+ * on several threads (see tree::combine()).
+ *
+ * @param[in] first The first operand, its comparator and allocator are used
+ * for the result.
+ * @param[in] second The second operand.
+ * @return set - the new set.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set_union(const set<K, Compare, Allocator> &first,
+               const set<K, Compare, Allocator> &second)
+    -> set<K, Compare, Allocator> {
+  using tree_type = typename set<K, Compare, Allocator>::tree_type;
+  set<K, Compare, Allocator> result{first.key_comp()};
+
+  result.tree_ =
+      tree_type::combine(first.tree_, second.tree_, tree_type::kUNION);
+
+  return result;
+}
+
+/**
+ * @brief Returns the intersection of two sets.
+ *
+ * @details
+ * The result holds the elements of first whose keys are also in second. This is
+ * what std::set_intersection writes for the two sorted ranges.
+ *
+ * Both operands are walked once in O(n + m), and only the elements of the
+ * result are copied. Large operands are split into key ranges that are merged
+ * on several threads (see tree::combine()).
+ *
+ * @param[in] first The first operand, its comparator and allocator are used
+ * for the result.
+ * @param[in] second The second operand.
+ * @return set - the new set.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set_intersection(const set<K, Compare, Allocator> &first,
+                      const set<K, Compare, Allocator> &second)
+    -> set<K, Compare, Allocator> {
+  using tree_type = typename set<K, Compare, Allocator>::tree_type;
+  set<K, Compare, Allocator> result{first.key_comp()};
+
+  result.tree_ =
+      tree_type::combine(first.tree_, second.tree_, tree_type::kINTERSECTION);
+
+  return result;
+}
+
+/**
+ * @brief Returns the difference of two sets.
+ *
+ * @details
+ * The result holds the elements of first whose keys are not in second. This is
+ * what std::set_difference writes for the two sorted ranges.
+ *
+ * Both operands are walked once in O(n + m), and only the elements of the
+ * result are copied. Large operands are split into key ranges that are merged
+ * on several threads (see tree::combine()).
+ *
+ * @param[in] first The first operand, its comparator and allocator are used
+ * for the result.
+ * @param[in] second The second operand.
+ * @return set - the new set.
+ */
+template <typename K, typename Compare, typename Allocator>
+auto set_difference(const set<K, Compare, Allocator> &first,
+                    const set<K, Compare, Allocator> &second)
+    -> set<K, Compare, Allocator> {
+  using tree_type = typename set<K, Compare, Allocator>::tree_type;
+  set<K, Compare, Allocator> result{first.key_comp()};
+
+  result.tree_ =
+      tree_type::combine(first.tree_, second.tree_, tree_type::kDIFFERENCE);
+
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                           SET ITERATOR OPERATORS                           //
 ////////////////////////////////////////////////////////////////////////////////
@@ -518,8 +1127,9 @@ bool set<K>::conatains(const key_type &key) const noexcept {
  * @param[in] other The iterator to assign from.
  * @return iterator& - reference to the assigned iterator.
  */
-template <typename K>
-auto set<K>::iterator::operator=(const iterator &other) noexcept -> iterator & {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::iterator::operator=(
+    const iterator &other) noexcept -> iterator & {
   this->ptr_ = other.ptr_;
   this->first_ = other.first_;
   this->last_ = other.last_;
@@ -532,9 +1142,9 @@ auto set<K>::iterator::operator=(const iterator &other) noexcept -> iterator & {
  *
  * @return iterator& - reference to the incremented iterator.
  */
-template <typename K>
-auto set<K>::iterator::operator++() noexcept -> iterator & {
-  *this += 1;
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::iterator::operator++() noexcept -> iterator & {
+  _tree_it::operator++();
 
   return *this;
 }
@@ -544,11 +1154,12 @@ auto set<K>::iterator::operator++() noexcept -> iterator & {
  *
  * @return iterator - the original iterator before the increment.
  */
-template <typename K>
-auto set<K>::iterator::operator++(int) noexcept -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::iterator::operator++(int) noexcept
+    -> iterator {
   iterator copy{*this};
 
-  *this += 1;
+  _tree_it::operator++();
 
   return copy;
 }
@@ -558,9 +1169,9 @@ auto set<K>::iterator::operator++(int) noexcept -> iterator {
  *
  * @return iterator& - reference to the decremented iterator.
  */
-template <typename K>
-auto set<K>::iterator::operator--() noexcept -> iterator & {
-  *this -= 1;
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::iterator::operator--() noexcept -> iterator & {
+  _tree_it::operator--();
 
   return *this;
 }
@@ -570,11 +1181,12 @@ auto set<K>::iterator::operator--() noexcept -> iterator & {
  *
  * @return iterator - the original iterator before the decrement.
  */
-template <typename K>
-auto set<K>::iterator::operator--(int) noexcept -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::iterator::operator--(int) noexcept
+    -> iterator {
   iterator copy{*this};
 
-  *this -= 1;
+  _tree_it::operator--();
 
   return copy;
 }
@@ -585,8 +1197,9 @@ auto set<K>::iterator::operator--(int) noexcept -> iterator {
  * @param[in] shift The number of positions to shift.
  * @return iterator - the shifted iterator.
  */
-template <typename K>
-auto set<K>::iterator::operator+(size_type shift) const noexcept -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::iterator::operator+(
+    size_type shift) const noexcept -> iterator {
   return _tree_it{*this} + shift;
 }
 
@@ -596,8 +1209,9 @@ auto set<K>::iterator::operator+(size_type shift) const noexcept -> iterator {
  * @param[in] shift The number of positions to shift.
  * @return iterator - the shifted iterator.
  */
-template <typename K>
-auto set<K>::iterator::operator-(size_type shift) const noexcept -> iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::iterator::operator-(
+    size_type shift) const noexcept -> iterator {
   return _tree_it{*this} - shift;
 }
 
@@ -606,9 +1220,9 @@ auto set<K>::iterator::operator-(size_type shift) const noexcept -> iterator {
  *
  * @return reference - reference to the value at the current position.
  */
-template <typename K>
-auto set<K>::iterator::operator*() noexcept -> reference {
-  return (*this->ptr_->pair).first;
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::iterator::operator*() noexcept -> reference {
+  return this->ptr_->key();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -621,9 +1235,9 @@ auto set<K>::iterator::operator*() noexcept -> reference {
  * @param[in] other The const_iterator to assign from.
  * @return const_iterator& - reference to the assigned const_iterator.
  */
-template <typename K>
-auto set<K>::const_iterator::operator=(const const_iterator &other) noexcept
-    -> const_iterator & {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::const_iterator::operator=(
+    const const_iterator &other) noexcept -> const_iterator & {
   this->ptr_ = other.ptr_;
   this->first_ = other.first_;
   this->last_ = other.last_;
@@ -636,9 +1250,10 @@ auto set<K>::const_iterator::operator=(const const_iterator &other) noexcept
  *
  * @return const_iterator& - reference to the incremented const_iterator.
  */
-template <typename K>
-auto set<K>::const_iterator::operator++() noexcept -> const_iterator & {
-  *this += 1;
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::const_iterator::operator++() noexcept
+    -> const_iterator & {
+  _tree_cit::operator++();
 
   return *this;
 }
@@ -648,11 +1263,12 @@ auto set<K>::const_iterator::operator++() noexcept -> const_iterator & {
  *
  * @return const_iterator - the original const_iterator before the increment.
  */
-template <typename K>
-auto set<K>::const_iterator::operator++(int) noexcept -> const_iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::const_iterator::operator++(int) noexcept
+    -> const_iterator {
   const_iterator copy{*this};
 
-  *this += 1;
+  _tree_cit::operator++();
 
   return copy;
 }
@@ -662,9 +1278,10 @@ auto set<K>::const_iterator::operator++(int) noexcept -> const_iterator {
  *
  * @return const_iterator& - reference to the decremented const_iterator.
  */
-template <typename K>
-auto set<K>::const_iterator::operator--() noexcept -> const_iterator & {
-  *this -= 1;
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::const_iterator::operator--() noexcept
+    -> const_iterator & {
+  _tree_cit::operator--();
 
   return *this;
 }
@@ -674,11 +1291,12 @@ auto set<K>::const_iterator::operator--() noexcept -> const_iterator & {
  *
  * @return const_iterator - the original const_iterator before the decrement.
  */
-template <typename K>
-auto set<K>::const_iterator::operator--(int) noexcept -> const_iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::const_iterator::operator--(int) noexcept
+    -> const_iterator {
   const_iterator copy{*this};
 
-  *this -= 1;
+  _tree_cit::operator--();
 
   return copy;
 }
@@ -689,9 +1307,9 @@ auto set<K>::const_iterator::operator--(int) noexcept -> const_iterator {
  * @param[in] shift The number of positions to shift.
  * @return const_iterator - the shifted const_iterator.
  */
-template <typename K>
-auto set<K>::const_iterator::operator+(size_type shift) const noexcept
-    -> const_iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::const_iterator::operator+(
+    size_type shift) const noexcept -> const_iterator {
   return _tree_cit{*this} + shift;
 }
 
@@ -701,9 +1319,9 @@ auto set<K>::const_iterator::operator+(size_type shift) const noexcept
  * @param[in] shift The number of positions to shift.
  * @return const_iterator - the shifted const_iterator.
  */
-template <typename K>
-auto set<K>::const_iterator::operator-(size_type shift) const noexcept
-    -> const_iterator {
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::const_iterator::operator-(
+    size_type shift) const noexcept -> const_iterator {
   return _tree_cit{*this} - shift;
 }
 
@@ -713,11 +1331,25 @@ auto set<K>::const_iterator::operator-(size_type shift) const noexcept
  * @return const_reference - const reference to the value at the current
  * position.
  */
-template <typename K>
-auto set<K>::const_iterator::operator*() const noexcept -> const_reference {
-  return (*this->ptr_->pair).first;
+template <typename K, typename Compare, typename Allocator>
+auto set<K, Compare, Allocator>::const_iterator::operator*() const noexcept
+    -> const_reference {
+  return this->ptr_->key();
 }
 
+namespace pmr {
+
+/**
+ * @brief Set whose nodes are taken from a std::pmr::memory_resource.
+ *
+ * @tparam K The type of keys.
+ * @tparam Compare The strict weak ordering of the keys.
+ */
+template <typename K, typename Compare = std::less<K>>
+using set = s21::set<K, Compare, std::pmr::polymorphic_allocator<K>>;
+
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif  // SRC_CONTAINERS_SET_H_
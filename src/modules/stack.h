@@ -12,6 +12,9 @@
 #ifndef SRC_CONTAINERS_STACK_H_
 #define SRC_CONTAINERS_STACK_H_
 
+#include <memory>       // for std::uses_allocator
+#include <type_traits>  // for std::enable_if_t
+
 #include "./list.h"
 
 namespace s21 {
@@ -36,6 +39,12 @@ class stack {
   stack() : c{Container()} {}
   explicit stack(const Container &s);
   explicit stack(Container &&s);
+  template <typename Alloc, typename = std::enable_if_t<
+                                std::uses_allocator_v<Container, Alloc>>>
+  explicit stack(const Alloc &alloc);
+  template <typename Alloc, typename = std::enable_if_t<
+                                std::uses_allocator_v<Container, Alloc>>>
+  stack(const Container &s, const Alloc &alloc);
   stack(const stack &other);
   stack(stack &&other);
   ~stack() {}
@@ -91,6 +100,31 @@ stack<T, Container>::stack(const Container &s) : c(s) {}
 template <typename T, typename Container>
 stack<T, Container>::stack(Container &&other) : c(std::move(other)) {}
 
+/**
+ * @brief Constructor that passes an allocator to the underlying container.
+ *
+ * @details
+ *
+ * Initializes an empty stack whose container takes its memory from the
+ * given allocator. Available only if the container uses such an allocator.
+ *
+ * @param alloc The allocator for the underlying container.
+ */
+template <typename T, typename Container>
+template <typename Alloc, typename>
+stack<T, Container>::stack(const Alloc &alloc) : c(alloc) {}
+
+/**
+ * @brief Constructor that copies a container using the given allocator.
+ *
+ * @param s The container to be copied into the stack.
+ * @param alloc The allocator for the underlying container.
+ */
+template <typename T, typename Container>
+template <typename Alloc, typename>
+stack<T, Container>::stack(const Container &s, const Alloc &alloc)
+    : c(s, alloc) {}
+
 /**
  * @brief Move constructor for the stack.
  *
@@ -120,7 +154,7 @@ stack<T, Container>::stack(stack &&other) : c(std::move(other.c)) {}
  */
 template <typename value_type, typename Container>
 auto stack<value_type, Container>::operator=(stack &&s) -> stack & {
-  swap(s);
+  c = std::move(s.c);
 
   return *this;
 }
@@ -276,6 +310,27 @@ void stack<value_type, Container>::emplace(Args &&...args) {
   c.emplace_back(std::forward<Args>(args)...);
 }
 
+namespace pmr {
+
+/**
+ * @brief Stack built on a list that takes its nodes from a
+ * std::pmr::memory_resource.
+ * @tparam T The type of the elements.
+ */
+template <typename T>
+using stack = s21::stack<T, s21::pmr::list<T>>;
+
+}  // namespace pmr
+
 }  // namespace s21
 
+namespace std {
+
+/// @brief The stack uses an allocator whenever its container does.
+template <typename T, typename Container, typename Alloc>
+struct uses_allocator<s21::stack<T, Container>, Alloc>
+    : uses_allocator<Container, Alloc>::type {};
+
+}  // namespace std
+
 #endif  // SRC_CONTAINERS_STACK_H_
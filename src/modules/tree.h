@@ -12,14 +12,79 @@
 #ifndef SRC_CONTAINERS_TREE_H_
 #define SRC_CONTAINERS_TREE_H_
 
-#include <algorithm>         // for exchange()
+#include <algorithm>         // for swap(), min(), max()
+#include <exception>         // for exception_ptr, rethrow_exception()
+#include <functional>        // for less
 #include <initializer_list>  // for init_list type
 #include <limits>            // for max()
+#include <memory>            // for allocator, allocator_traits
+#include <optional>          // for optional
 #include <string>            // for string type
+#include <system_error>      // for system_error
+#include <thread>            // for thread, hardware_concurrency()
+#include <tuple>             // for tie()
+#include <type_traits>       // for is_trivially_destructible
+#include <utility>           // for exchange()
+
+#include "./pool_allocator.h"
 
 /// @brief Namespace for working with containers
 namespace s21 {
 
+/**
+ * @brief Detects comparators that allow lookups by keys of other types.
+ *
+ * @details
+ * A comparator declaring the member type is_transparent (like std::less<>)
+ * can compare the stored keys with any type it accepts, so lookups do not
+ * have to build a temporary key. The Key parameter only makes the check
+ * dependent on the lookup argument, so it can be used for SFINAE.
+ *
+ * @tparam Compare The comparator type to check.
+ * @tparam Key The type of the lookup argument.
+ */
+template <typename Compare, typename Key, typename = void>
+struct is_transparent : std::false_type {};
+
+template <typename Compare, typename Key>
+struct is_transparent<Compare, Key,
+                      std::void_t<typename Compare::is_transparent>>
+    : std::true_type {};
+
+/// @brief Enables a heterogeneous lookup overload for a transparent Compare.
+template <typename Compare, typename Key>
+using transparent_key_t =
+    std::enable_if_t<is_transparent<Compare, Key>::value, Key>;
+
+/// @brief Takes the key of a map element from the first member of the pair.
+struct select_first {
+  template <typename Pair>
+  const auto &operator()(const Pair &pair) const noexcept {
+    return pair.first;
+  }
+};
+
+/// @brief Uses a set element as its own key.
+struct select_self {
+  template <typename T>
+  const T &operator()(const T &value) const noexcept {
+    return value;
+  }
+};
+
+/**
+ * @brief The result of inserting a node handle into a unique container.
+ *
+ * @tparam Iterator The iterator type of the container.
+ * @tparam NodeType The node handle type of the container.
+ */
+template <typename Iterator, typename NodeType>
+struct node_insert_return {
+  Iterator position;  ///< The inserted element or the one blocking it
+  bool inserted;      ///< Whether the node was inserted
+  NodeType node;      ///< The node if it was not inserted, otherwise empty
+};
+
 /**
  * @brief A red-black tree container template class.
  *
@@ -29,33 +94,51 @@ namespace s21 {
  * tree of elements of type K and M, supporting various
  * operations including iteration, element access, and size management.
  *
+ * With M = void the nodes hold the keys only, as needed by set and multiset.
+ * The interface stays the same, with the key doubling as the mapped value,
+ * but every node stores, compares and copies a single key.
+ *
  * @tparam K The type of keys stored in the tree.
- * @tparam M The type of values stored in the tree.
+ * @tparam M The type of values stored in the tree, void for keys only.
+ * @tparam Compare The strict weak ordering of the keys.
+ * @tparam Allocator The allocator type, rebound to the node type of the tree.
  */
-template <typename K, typename M>
+template <typename K, typename M, typename Compare = std::less<K>,
+          typename Allocator = std::allocator<std::pair<K, M>>>
 class tree {
  public:
   // Container types
 
   class TreeIterator;
   class TreeConstIterator;
+  class NodeHandle;
   enum Uniq { kUNIQUE, kNON_UNIQUE };
+  enum SetOperation { kUNION, kINTERSECTION, kDIFFERENCE };
 
   // Type aliases
 
-  using key_type = K;             ///< Type of first template (nodes key)
-  using mapped_type = M;          ///< Type of second template (nodes value)
-  using iterator = TreeIterator;  ///< For read/write elements
-  using const_iterator = TreeConstIterator;  ///< For read elements
-  using value_type = std::pair<K, M>;        ///< Key-map pair
+  using key_type = K;  ///< Type of first template (nodes key)
+  using mapped_type =
+      std::conditional_t<std::is_void_v<M>, K, M>;  ///< The key if M is void
+  using iterator = TreeIterator;                    ///< For read/write elements
+  using const_iterator = TreeConstIterator;         ///< For read elements
+  using value_type = std::pair<K, mapped_type>;     ///< Key-map pair
   using size_type = std::size_t;
+  using allocator_type = Allocator;  ///< Allocator rebound to nodes
+  using key_compare = Compare;       ///< Ordering of keys
+  using node_type = NodeHandle;      ///< Owner of an extracted node
 
   // Constructors/destructor
 
-  explicit tree(Uniq type = kUNIQUE) noexcept;
+  explicit tree(Uniq type = kUNIQUE) noexcept(
+      std::is_nothrow_default_constructible_v<Allocator>);
+  explicit tree(const Allocator &alloc, Uniq type = kUNIQUE) noexcept;
+  explicit tree(const Compare &comp, const Allocator &alloc = Allocator{},
+                Uniq type = kUNIQUE);
   explicit tree(const value_type &pair, Uniq type = kUNIQUE);
   tree(std::initializer_list<value_type> const &items, Uniq type = kUNIQUE);
   tree(const tree &t);
+  tree(const tree &t, const Allocator &alloc);
   tree(tree &&t);
   tree &operator=(tree &&t);
   tree &operator=(const tree &t);
@@ -71,70 +154,191 @@ class tree {
   // Working with tree
 
   iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+  std::pair<iterator, iterator> equal_range(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  size_type rank(const key_type &key) const;
+  iterator nth(size_type index) const noexcept;
   iterator insert(const value_type &pair);
+  iterator insert(const_iterator hint, const value_type &pair);
   iterator erase(const key_type &key) noexcept;
   iterator erase(const_iterator it) noexcept;
   iterator erase(const_iterator first, const_iterator last);
   size_type size() const noexcept;
   size_type max_size() const noexcept;
   void merge(tree &other);
+  static tree combine(const tree &first, const tree &second,
+                      SetOperation op);
   void clear() noexcept;
   std::string structure() const noexcept;
+  allocator_type get_allocator() const noexcept;
+  key_compare key_comp() const;
+
+  // Node handles
+
+  node_type extract(const_iterator it) noexcept;
+  node_type extract(const key_type &key) noexcept;
+  std::pair<iterator, bool> insert(node_type &&node);
+
+  // Heterogeneous lookup
+
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator find(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  bool contains(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator lower_bound(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  iterator upper_bound(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  std::pair<iterator, iterator> equal_range(const Key &key) const;
+  template <typename Key, typename = transparent_key_t<Compare, Key>>
+  size_type count(const Key &key) const;
 
   template <typename... Args>
   std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+  template <typename InputIt, typename Project>
+  void assign_sorted(InputIt first, InputIt last, Project project,
+                     bool checked = false);
 
  private:
   // Container types
 
   struct Node;
+  struct InsertPos;
+  struct Subtree;
   enum Colors { kRED, kBLACK };
 
+  // Type aliases
+
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+  using stored_type = std::conditional_t<std::is_void_v<M>, K,
+                                         value_type>;  ///< Element of a node
+
   // Fields
 
-  Node *root_{};      ///< Root of tree
-  Node *sentinel_{};  ///< Dummy element
-  size_type size_{};  ///< Size of tree
-  Uniq type_{};       ///< Determines whether to allow duplicates
+  Node *root_{};            ///< Root of tree
+  Node *sentinel_{};        ///< Dummy element
+  Node *rightmost_{};       ///< Node with the greatest key, nullptr if unknown
+  size_type size_{};        ///< Size of tree
+  Uniq type_{};             ///< Determines whether to allow duplicates
+  Compare comp_{};          ///< Ordering of keys
+  node_allocator alloc_{};  ///< Allocator of nodes
 
   // Add/remove nodes
 
-  Node *createNode(const value_type &pair, Node *&node, Node *parent = nullptr);
-  void insertNode(Node *insert, Node *&node, Node *parent = nullptr);
+  template <typename... Args>
+  Node *newNode(Args &&...args);
+  void deleteNode(Node *node) noexcept;
+  void destroyTree() noexcept;
+  void insertNode(Node *insert);
+  void linkNode(Node *node, const InsertPos &pos) noexcept;
   Node *extractNode(Node *node) noexcept;
+  iterator eraseNode(Node *node) noexcept;
   void cleanTree(Node *&node) noexcept;
   void removeConnect(Node *node) noexcept;
-  void copyTree(Node *node);
+  void copyTree(const tree &other);
+  void cloneNodes(const Node *node, Node *parent, Node *&link);
+  static Node *buildBalanced(Node *&list, size_type count, size_type depth,
+                             size_type red_depth) noexcept;
+  static size_type redDepth(size_type count) noexcept;
+  static const stored_type &stored(const value_type &pair) noexcept;
 
   // Tree balancing
 
   void balancingTree(Node *node) noexcept;
-  void fixDoubleBlack(Node *&node) noexcept;
+  void fixDoubleBlack(Node *node) noexcept;
   void rotateLeft(Node *old_root) noexcept;
   void rotateRight(Node *old_root) noexcept;
-  void swapColors(Node *node) noexcept;
+  static bool isBlack(const Node *node) noexcept;
 
   // Tree searching
 
-  Node *findNode(Node *node, const key_type &key) const noexcept;
+  template <typename Key>
+  Node *findNode(Node *node, const Key &key) const noexcept;
+  template <typename Key>
+  InsertPos findInsertPos(const Key &key) const noexcept;
+  template <typename Key>
+  InsertPos findHintPos(Node *hint, const Key &key) noexcept;
+  Node *maxNode() noexcept;
+  static Node *predecessor(Node *node) noexcept;
+  static Node *successor(const Node *node) noexcept;
+  template <typename Key>
+  Node *lowerBound(const Key &key) const noexcept;
+  template <typename Key>
+  Node *upperBound(const Key &key) const noexcept;
+  template <typename Key>
+  std::pair<Node *, Node *> equalBounds(const Key &key) const noexcept;
+  template <typename Key>
+  size_type countNodes(const Key &key) const noexcept;
   static Node *findMax(Node *node) noexcept;
   static Node *findMin(Node *node) noexcept;
 
+  // Batched lookup
+
+  static constexpr size_type kBatch{16};  ///< Descents interleaved at once
+
+  template <typename ForwardIt, typename Visit>
+  void findBatch(ForwardIt first, ForwardIt last, Visit visit) const;
+  static void prefetch(const Node *node) noexcept;
+
+  // Order statistics
+
+  static size_type subtreeSize(const Node *node) noexcept;
+  static size_type rankOf(const Node *node) noexcept;
+  static Node *selectNode(Node *node, size_type index) noexcept;
+  static void shrinkPath(Node *node) noexcept;
+  bool ownsNode(const Node *node) const noexcept;
+
+  // Split and join
+
+  static size_type blackHeight(const Node *node) noexcept;
+  static std::pair<Subtree, Subtree> detachSons(const Subtree &sub) noexcept;
+  Subtree join(Subtree left, Node *pivot, Subtree right) noexcept;
+  Subtree join(Subtree left, Subtree right) noexcept;
+  std::pair<Subtree, Subtree> split(const Subtree &sub,
+                                    size_type index) noexcept;
+  std::pair<Subtree, Subtree> splitKey(const Subtree &sub, const key_type &key,
+                                       Node *&match) noexcept;
+  std::pair<Subtree, Subtree> unite(const Subtree &target,
+                                    const Subtree &source) noexcept;
+
+  // Set algebra
+
+  struct NodeList;
+  using Ranks = std::pair<size_type, size_type>;  ///< Range [begin, end)
+
+  static constexpr size_type kForkGrain{1 << 14};  ///< Least nodes to fork
+
+  NodeList combineRanges(const tree &first, const tree &second,
+                         Ranks first_ranks, Ranks second_ranks,
+                         SetOperation op, size_type forks);
+  NodeList mergeRanges(const tree &first, const tree &second,
+                       Ranks first_ranks, Ranks second_ranks,
+                       SetOperation op);
+  size_type boundRank(const key_type &key) const noexcept;
+  void deleteList(NodeList &list) noexcept;
+  template <typename First, typename Second>
+  void forkJoin(bool parallel, First &&first, Second &&second);
+
   // Cases of node removal
 
   Node *deleteTwoChild(Node *&node) noexcept;
-  Node *deleteOneChild(Node *&node, Node *&child) noexcept;
+  Node *deleteOneChild(Node *node, Node *child) noexcept;
   void deleteBlackNoChild(Node *&node) noexcept;
-
-  // Black no child node removal cases
-
-  void redParBlackSonRedLeft(Node *&node) noexcept;
-  void redParBlackSonRedRight(Node *&node) noexcept;
-  void blackParRedSonBlackRight(Node *&node) noexcept;
-  void blackParRedBrosBlackRightRedLeft(Node *&node) noexcept;
-  void blackParBlackBrosBlackAll(Node *&node) noexcept;
-  void blackParBlackBrosRedRightGran(Node *&node) noexcept;
-  void blackParBlackBrosRedLeftOrAllGran(Node *&node) noexcept;
+  void swapNodes(Node *first, Node *second) noexcept;
 
   // Printing
 
@@ -152,8 +356,8 @@ class tree {
  * @tparam K The type of keys stored in the tree.
  * @tparam M The type of values stored in the tree.
  */
-template <typename K, typename M>
-class tree<K, M>::TreeIterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+class tree<K, M, Compare, Allocator>::TreeIterator {
  public:
   // Constructors
 
@@ -193,6 +397,8 @@ class tree<K, M>::TreeIterator {
   }
 
  protected:
+  friend class tree;
+
   // Fields
 
   Node *ptr_{};    ///< Pointer to the current node
@@ -213,8 +419,8 @@ class tree<K, M>::TreeIterator {
  * @tparam K The type of keys stored in the tree.
  * @tparam M The type of values stored in the tree.
  */
-template <typename K, typename M>
-class tree<K, M>::TreeConstIterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+class tree<K, M, Compare, Allocator>::TreeConstIterator {
  public:
   // Constructors
 
@@ -239,6 +445,8 @@ class tree<K, M>::TreeConstIterator {
   iterator toIterator() const noexcept;
 
  protected:
+  friend class tree;
+
   // Fields
 
   Node *ptr_{};    ///< Pointer to the current node
@@ -246,40 +454,181 @@ class tree<K, M>::TreeConstIterator {
   Node *last_{};   ///< Pointer to a dummy node
 };
 
+/**
+ * @brief An owner of a node extracted from the red-black tree.
+ *
+ * @details
+ * The handle keeps the node together with a copy of the node allocator, so
+ * an element can leave one tree and enter another one with an equal
+ * allocator without being copied, allocated or freed. The key of a map node
+ * can be changed while the node is outside of a tree. A handle that still
+ * owns its node when destroyed destroys and frees it.
+ *
+ * @tparam K The type of keys stored in the tree.
+ * @tparam M The type of values stored in the tree.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+class tree<K, M, Compare, Allocator>::NodeHandle {
+ public:
+  // Constructors/assignment operators/destructor
+
+  constexpr NodeHandle() noexcept = default;
+  NodeHandle(NodeHandle &&other) noexcept;
+  NodeHandle &operator=(NodeHandle &&other) noexcept;
+  ~NodeHandle();
+
+  // Observers
+
+  bool empty() const noexcept;
+  explicit operator bool() const noexcept;
+  allocator_type get_allocator() const;
+  key_type &key() const noexcept;
+  mapped_type &mapped() const noexcept;
+  template <typename T = M,
+            typename = std::enable_if_t<std::is_void_v<T> ||
+                                        (std::is_const_v<T> &&
+                                         std::is_same_v<T, K>)>>
+  key_type &value() const noexcept;
+
+  // Modifiers
+
+  void swap(NodeHandle &other) noexcept;
+
+ private:
+  friend class tree;
+
+  // Fields
+
+  Node *node_{};                          ///< Owned node, nullptr if empty
+  std::optional<node_allocator> alloc_{};  ///< Allocator of the node
+
+  // Constructors
+
+  NodeHandle(Node *node, const node_allocator &alloc) noexcept;
+
+  // Releasing the node
+
+  Node *release() noexcept;
+  void reset() noexcept;
+};
+
 /**
  * @brief A node in the red-black tree.
  *
  * @details
- * This class represents a node in the red-black tree. It contains the key,
- * value, color, parent, left child, and right child of the node.
+ * This class represents a node in the red-black tree. It contains the color,
+ * parent, left child, right child and the key-value pair of the node, or only
+ * the key in a tree of keys. The element is stored inline, so every element
+ * costs a single allocation and a search touches one block of memory per
+ * level instead of two. Each node also keeps the size of its subtree, which
+ * turns positional queries (rank, nth element, iterator jumps) into a single
+ * O(log n) walk.
  *
  * @tparam K The type of keys stored in the tree.
  * @tparam M The type of values stored in the tree.
  */
-template <typename K, typename M>
-struct tree<K, M>::Node {
+template <typename K, typename M, typename Compare, typename Allocator>
+struct tree<K, M, Compare, Allocator>::Node {
  public:
-  value_type *pair;  ///< Node key
-  Colors color;      ///< Color of node (red/black)
-  Node *parent;      ///< Parent of this node
-  Node *left{};      ///< Left son of this node
-  Node *right{};     ///< Right son of this node
+  Colors color;       ///< Color of node (red/black)
+  Node *parent;       ///< Parent of this node
+  Node *left{};       ///< Left son of this node
+  Node *right{};      ///< Right son of this node
+  size_type size{1};  ///< Number of nodes in the subtree of this node
+  stored_type value;  ///< Node key-value pair, or the key alone
 
   /**
    * @brief Constructs a new node.
    *
-   * @param[in] k The key of the node.
-   * @param[in] v The value of the node.
-   * @param[in] c The color of the node.
-   * @param[in] p The parent of the node.
+   * @param[in] value_ The element of the node.
+   * @param[in] color_ The color of the node.
+   * @param[in] parent_ The parent of the node.
+   */
+  Node(const stored_type &value_, Colors color_ = kRED, Node *parent_ = 0)
+      : color{color_}, parent{parent_}, value{value_} {}
+
+  /**
+   * @brief Constructs a new red node with the element built in place.
+   *
+   * @param[in] args The arguments forwarded to the element constructor.
+   */
+  template <typename... Args>
+  explicit Node(std::in_place_t, Args &&...args)
+      : color{kRED}, parent{}, value(std::forward<Args>(args)...) {}
+
+  /**
+   * @brief Accesses the key of the node.
+   *
+   * @return key_type& - the key.
+   */
+  key_type &key() noexcept {
+    if constexpr (std::is_void_v<M>) {
+      return value;
+    } else {
+      return value.first;
+    }
+  }
+
+  /**
+   * @brief Accesses the key of the node.
+   *
+   * @return const key_type& - the key.
    */
-  Node(const value_type &pair_, Colors color_ = kRED, Node *parent_ = 0)
-      : pair{new value_type{pair_}}, color{color_}, parent{parent_} {}
+  const key_type &key() const noexcept {
+    return const_cast<Node *>(this)->key();
+  }
 
   /**
-   * @brief Destructor. Destroys nodes pair.
+   * @brief Accesses the mapped value of the node, the key in a tree of keys.
+   *
+   * @return mapped_type& - the value.
    */
-  ~Node() { delete pair; }
+  mapped_type &mapped() noexcept {
+    if constexpr (std::is_void_v<M>) {
+      return value;
+    } else {
+      return value.second;
+    }
+  }
+};
+
+/**
+ * @brief The place found by a single descent for a new key.
+ *
+ * @details
+ * The new node becomes the left or the right son of parent. For a tree of
+ * unique elements, match points to the node with an equivalent key if there
+ * is one, in which case nothing has to be inserted.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+struct tree<K, M, Compare, Allocator>::InsertPos {
+  Node *parent;  ///< Future parent of the new node, nullptr for an empty tree
+  Node *match;   ///< Node with an equivalent key, or nullptr
+  bool left;     ///< Whether the new node is the left son of parent
+};
+
+/**
+ * @brief A detached subtree together with its black height.
+ *
+ * @details
+ * The height is the number of black nodes on a path from the root down to a
+ * leaf, the root included. Split and join pass it along, so it does not have
+ * to be recounted on every join.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+struct tree<K, M, Compare, Allocator>::Subtree {
+  Node *root{};        ///< Root of the subtree, nullptr if it is empty
+  size_type height{};  ///< Black height of the subtree
+};
+
+/**
+ * @brief A list of detached nodes chained through their right pointers.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+struct tree<K, M, Compare, Allocator>::NodeList {
+  Node *head{};       ///< First node, nullptr if the list is empty
+  Node *tail{};       ///< Last node, nullptr if the list is empty
+  size_type count{};  ///< Number of nodes
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -294,8 +643,32 @@ struct tree<K, M>::Node {
  *
  * @param[in] type Type of tree elements (unique/non-unique).
  */
-template <typename K, typename M>
-tree<K, M>::tree(Uniq type) noexcept : type_{type} {}
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::tree(Uniq type) noexcept(
+    std::is_nothrow_default_constructible_v<Allocator>)
+    : type_{type} {}
+
+/**
+ * @brief Constructs a tree without nodes that uses the given allocator.
+ *
+ * @param[in] alloc The allocator to take the nodes from.
+ * @param[in] type Type of tree elements (unique/non-unique).
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::tree(const Allocator &alloc, Uniq type) noexcept
+    : type_{type}, alloc_{alloc} {}
+
+/**
+ * @brief Constructs a tree without nodes that orders the keys with comp.
+ *
+ * @param[in] comp The comparator of the keys.
+ * @param[in] alloc The allocator to take the nodes from.
+ * @param[in] type Type of tree elements (unique/non-unique).
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::tree(const Compare &comp,
+                                     const Allocator &alloc, Uniq type)
+    : type_{type}, comp_{comp}, alloc_{alloc} {}
 
 /**
  * @brief Constructs a tree with a single node.
@@ -307,9 +680,10 @@ tree<K, M>::tree(Uniq type) noexcept : type_{type} {}
  * @param[in] pair The pair of key/value for node.
  * @param[in] type Type of tree elements (unique/non-unique).
  */
-template <typename K, typename M>
-tree<K, M>::tree(const value_type &pair, Uniq type) : type_{type} {
-  sentinel_ = new Node{value_type{}};
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::tree(const value_type &pair, Uniq type)
+    : type_{type} {
+  sentinel_ = newNode(std::in_place);
   insert(pair);
 }
 
@@ -324,10 +698,11 @@ tree<K, M>::tree(const value_type &pair, Uniq type) : type_{type} {
  * @param[in] items The initializer list of key-val pairs insert into the tree.
  * @param[in] type Type of tree elements (unique/non-unique).
  */
-template <typename K, typename M>
-tree<K, M>::tree(std::initializer_list<value_type> const &items, Uniq type)
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::tree(
+    std::initializer_list<value_type> const &items, Uniq type)
     : type_{type} {
-  sentinel_ = new Node{value_type{}};
+  sentinel_ = newNode(std::in_place);
 
   for (auto pair : items) {
     insert(pair);
@@ -340,15 +715,25 @@ tree<K, M>::tree(std::initializer_list<value_type> const &items, Uniq type)
  * @details
  * This constructor creates a new tree by copying the elements from another
  * tree. It initializes the sentinel node and then inserts all elements from the
- * source tree.
+ * source tree. The allocator is obtained through
+ * select_on_container_copy_construction().
  *
  * @param[in] t The tree to copy from.
  */
-template <typename K, typename M>
-tree<K, M>::tree(const tree &t) : type_{t.type_} {
-  sentinel_ = new Node{value_type{}};
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::tree(const tree &t)
+    : tree{t, node_traits::select_on_container_copy_construction(t.alloc_)} {}
 
-  copyTree(t.root_);
+/**
+ * @brief Copy constructor that takes the nodes from the given allocator.
+ *
+ * @param[in] t The tree to copy from.
+ * @param[in] alloc The allocator to take the nodes from.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::tree(const tree &t, const Allocator &alloc)
+    : type_{t.type_}, comp_{t.comp_}, alloc_{alloc} {
+  copyTree(t);
 }
 
 /**
@@ -357,35 +742,48 @@ tree<K, M>::tree(const tree &t) : type_{t.type_} {
  * @details
  * This constructor creates a new tree by moving the elements from another tree.
  * It takes ownership of the root and sentinel nodes from the source tree,
- * leaving the source tree in a valid but unspecified state.
+ * leaving the source tree empty. Both trees keep a copy of the allocator, so
+ * the source tree stays usable.
  *
  * @param[in] t The tree to move from.
  */
-template <typename K, typename M>
-tree<K, M>::tree(tree &&t)
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::tree(tree &&t)
     : root_{std::exchange(t.root_, nullptr)},
       sentinel_{std::exchange(t.sentinel_, nullptr)},
+      rightmost_{std::exchange(t.rightmost_, nullptr)},
       size_{std::exchange(t.size_, 0)},
-      type_{t.type_} {}
+      type_{t.type_},
+      comp_{t.comp_},
+      alloc_{t.alloc_} {}
 
 /**
  * @brief Move assignment operator for the red-black tree.
  *
  * @details
  * This operator moves the elements from another tree to the current tree.
- * It first cleans up the current tree and then moves the elements from the
- * source tree.
+ * It first destroys the current tree and then moves the elements and the
+ * allocator from the source tree. If the allocator does not propagate on move
+ * assignment and the allocators differ, the nodes of the source tree can not
+ * be adopted, so the elements are copied and the source tree is cleared.
  *
  * @param[in] t The tree to move from.
- * @return tree<K, M>& - reference to the assigned tree.
+ * @return tree<K, M, Compare, Allocator>& - reference to the assigned tree.
  */
-template <typename K, typename M>
-tree<K, M> &tree<K, M>::operator=(tree &&t) {
-  if (this != &t) {
-    cleanTree(root_);
-    delete sentinel_;
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::operator=(tree &&t) -> tree & {
+  if (this == &t) {
+    return *this;
+  }
+
+  if (node_traits::propagate_on_container_move_assignment::value ||
+      alloc_ == t.alloc_) {
+    this->~tree();
 
     new (this) tree{std::move(t)};
+  } else {
+    *this = t;
+    t.clear();
   }
 
   return *this;
@@ -397,18 +795,19 @@ tree<K, M> &tree<K, M>::operator=(tree &&t) {
  * @details
  * This operator copies the elements from another tree to the current tree.
  * It first cleans up the current tree and then copies the elements from the
- * source tree.
+ * source tree. The current allocator is kept.
  *
  * @param[in] t The tree to copy from.
- * @return tree<K, M>& - reference to the assigned tree.
+ * @return tree<K, M, Compare, Allocator>& - reference to the assigned tree.
  */
-template <typename K, typename M>
-tree<K, M> &tree<K, M>::operator=(const tree &t) {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::operator=(const tree &t) -> tree & {
   if (this != &t) {
-    cleanTree(root_);
-    delete sentinel_;
+    destroyTree();
 
-    new (this) tree{t};
+    type_ = t.type_;
+    comp_ = t.comp_;
+    copyTree(t);
   }
 
   return *this;
@@ -420,15 +819,9 @@ tree<K, M> &tree<K, M>::operator=(const tree &t) {
  * @details
  * Destroys the tree and frees allocated memory.
  */
-template <typename K, typename M>
-tree<K, M>::~tree() {
-  if (root_) {
-    cleanTree(root_);
-  }
-
-  if (sentinel_) {
-    delete sentinel_;
-  }
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::~tree() {
+  destroyTree();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -438,11 +831,12 @@ tree<K, M>::~tree() {
 /**
  * @brief Returns an iterator to the beginning of the tree.
  *
- * @return iterator - an iterator to the beginning of the tree.
+ * @return iterator - an iterator to the beginning of the tree, or end() if
+ * the tree is empty.
  */
-template <typename K, typename M>
-auto tree<K, M>::begin() const noexcept -> iterator {
-  return iterator{findMin(root_), root_, sentinel_};
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::begin() const noexcept -> iterator {
+  return (root_) ? iterator{findMin(root_), root_, sentinel_} : end();
 }
 
 /**
@@ -450,19 +844,20 @@ auto tree<K, M>::begin() const noexcept -> iterator {
  *
  * @return iterator - an iterator to the end of the tree.
  */
-template <typename K, typename M>
-auto tree<K, M>::end() const noexcept -> iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::end() const noexcept -> iterator {
   return iterator{sentinel_, root_, findMax(root_)};
 }
 
 /**
  * @brief Returns an iterator to the beginning of the tree.
  *
- * @return iterator - an iterator to the beginning of the tree.
+ * @return iterator - an iterator to the beginning of the tree, or end() if
+ * the tree is empty.
  */
-template <typename K, typename M>
-auto tree<K, M>::cbegin() const noexcept -> const_iterator {
-  return const_iterator{findMin(root_), root_, sentinel_};
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::cbegin() const noexcept -> const_iterator {
+  return (root_) ? const_iterator{findMin(root_), root_, sentinel_} : cend();
 }
 
 /**
@@ -470,8 +865,8 @@ auto tree<K, M>::cbegin() const noexcept -> const_iterator {
  *
  * @return iterator - an iterator to the end of the tree.
  */
-template <typename K, typename M>
-auto tree<K, M>::cend() const noexcept -> const_iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::cend() const noexcept -> const_iterator {
   return const_iterator{sentinel_, root_, findMax(root_)};
 }
 
@@ -486,68 +881,288 @@ auto tree<K, M>::cend() const noexcept -> const_iterator {
  * @return value_type - pointer to pair associated with the key, or a
  * nullptr if the key is not found.
  */
-template <typename K, typename M>
-auto tree<K, M>::find(const key_type &key) const -> iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::find(const key_type &key) const
+    -> iterator {
   Node *find = findNode(root_, key);
 
   return (find) ? iterator{find, root_, sentinel_} : end();
 }
 
+/**
+ * @brief Checks whether the tree contains an element with the given key.
+ *
+ * @param[in] key The key to search for.
+ * @return true if such an element exists, false otherwise.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+bool tree<K, M, Compare, Allocator>::contains(const key_type &key) const {
+  return findNode(root_, key);
+}
+
+/**
+ * @brief Searches for many keys at once.
+ *
+ * @details
+ * The descents for up to kBatch keys advance together, one level at a time,
+ * and the next node of every descent is prefetched while the others are
+ * compared. The cache misses of independent lookups then overlap instead of
+ * stalling one after another, which pays off once the tree no longer fits
+ * in the cache. The results are the same as calling find() for every key.
+ *
+ * @tparam ForwardIt The iterator type of the keys.
+ * @tparam OutputIt The iterator type receiving the results.
+ * @param[in] first The first key to search for.
+ * @param[in] last The end of the keys.
+ * @param[in] out The beginning of the destination for one iterator per key,
+ * end() for a missing key.
+ * @return OutputIt - the iterator past the last result written.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt tree<K, M, Compare, Allocator>::find_many(ForwardIt first,
+                                                   ForwardIt last,
+                                                   OutputIt out) const {
+  iterator missing = end();
+
+  findBatch(first, last, [&](Node *node) {
+    *out = (node) ? iterator{node, root_, sentinel_} : missing;
+    ++out;
+  });
+
+  return out;
+}
+
+/**
+ * @brief Checks for many keys at once whether the tree contains them.
+ *
+ * @details
+ * Interleaves the descents like find_many().
+ *
+ * @tparam ForwardIt The iterator type of the keys.
+ * @tparam OutputIt The iterator type receiving the results.
+ * @param[in] first The first key to search for.
+ * @param[in] last The end of the keys.
+ * @param[in] out The beginning of the destination for one bool per key.
+ * @return OutputIt - the iterator past the last result written.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt tree<K, M, Compare, Allocator>::contains_many(ForwardIt first,
+                                                       ForwardIt last,
+                                                       OutputIt out) const {
+  findBatch(first, last, [&](Node *node) {
+    *out = (node != nullptr);
+    ++out;
+  });
+
+  return out;
+}
+
+/**
+ * @brief Returns an iterator to the first element not less than the given key.
+ *
+ * @details
+ * The tree is descended once from the root, so the lookup takes O(log n)
+ * regardless of how many elements share the same key.
+ *
+ * @param[in] key The key to compare the elements to.
+ * @return iterator - an iterator to the first element not less than key, or
+ * end() if there is no such element.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::lower_bound(const key_type &key) const
+    -> iterator {
+  Node *bound = lowerBound(key);
+
+  return (bound) ? iterator{bound, root_, sentinel_} : end();
+}
+
+/**
+ * @brief Returns an iterator to the first element greater than the given key.
+ *
+ * @details
+ * The tree is descended once from the root, so the lookup takes O(log n)
+ * regardless of how many elements share the same key.
+ *
+ * @param[in] key The key to compare the elements to.
+ * @return iterator - an iterator to the first element greater than key, or
+ * end() if there is no such element.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::upper_bound(const key_type &key) const
+    -> iterator {
+  Node *bound = upperBound(key);
+
+  return (bound) ? iterator{bound, root_, sentinel_} : end();
+}
+
+/**
+ * @brief Returns a range containing all elements with the given key.
+ *
+ * @details
+ * Both bounds are found by one descent (see equalBounds()).
+ *
+ * @param[in] key The key to compare the elements to.
+ * @return std::pair<iterator, iterator> - the pair of lower_bound(key) and
+ * upper_bound(key).
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::equal_range(const key_type &key) const
+    -> std::pair<iterator, iterator> {
+  auto [lower, upper] = equalBounds(key);
+
+  return {(lower) ? iterator{lower, root_, sentinel_} : end(),
+          (upper) ? iterator{upper, root_, sentinel_} : end()};
+}
+
+/**
+ * @brief Returns the number of elements with the given key.
+ *
+ * @details
+ * The bounds of the equal elements are found by one descent and their ranks
+ * are subtracted (see countNodes()), so the cost is O(log n) however many
+ * elements match.
+ *
+ * @param[in] key The key of the elements to count.
+ * @return size_type - the number of elements with the given key.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::count(const key_type &key) const
+    -> size_type {
+  return countNodes(key);
+}
+
+/**
+ * @brief Returns the number of elements whose keys are less than the given
+ * key.
+ *
+ * @details
+ * The subtree sizes stored in the nodes let a single descent sum up the
+ * elements on the left, so the cost is O(log n).
+ *
+ * @param[in] key The key to compare the elements to.
+ * @return size_type - the position lower_bound(key) would have.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::rank(const key_type &key) const
+    -> size_type {
+  Node *node = root_;
+  size_type index{};
+
+  while (node) {
+    if (comp_(node->key(), key)) {
+      index += subtreeSize(node->left) + 1;
+      node = node->right;
+    } else {
+      node = node->left;
+    }
+  }
+
+  return index;
+}
+
+/**
+ * @brief Returns an iterator to the element at the given position.
+ *
+ * @param[in] index The zero-based position of the element in sorted order.
+ * @return iterator - an iterator to the element, or end() if index is not
+ * less than size().
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::nth(size_type index) const noexcept
+    -> iterator {
+  Node *node = selectNode(root_, index);
+
+  return (node) ? iterator{node, root_, sentinel_} : end();
+}
+
 /**
  * @brief Inserts a new node with the given key and value into the tree.
  *
  * @param[in] pair The pair of key/value for node.
  */
-template <typename K, typename M>
-auto tree<K, M>::insert(const value_type &pair) -> iterator {
-  if (type_ == kUNIQUE && findNode(root_, pair.first)) {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::insert(const value_type &pair)
+    -> iterator {
+  InsertPos pos = findInsertPos(pair.first);
+
+  if (type_ == kUNIQUE && pos.match) {
     return end();
   }
 
   if (!sentinel_) {
-    sentinel_ = new Node{value_type{}};
+    sentinel_ = newNode(std::in_place);
   }
 
-  Node *node_pos = createNode(pair, root_);
+  Node *node = newNode(stored(pair));
+  linkNode(node, pos);
 
-  return iterator{node_pos, root_, sentinel_};
+  return iterator{node, root_, sentinel_};
 }
 
 /**
- * @brief Removes the node with the given key from the tree.
+ * @brief Inserts a copy of the pair as close as possible before hint.
  *
- * @param[in] key The key of the node to remove.
+ * @details
+ * When the key belongs right before hint, the node is linked next to it
+ * without a descent from the root (see findHintPos()); with end() as the
+ * hint, appending a new greatest key costs O(1) plus the rebalancing.
+ * Otherwise the place is searched as by insert().
+ *
+ * @param[in] hint The position before which the pair should be inserted.
+ * @param[in] pair The pair of key/value for node.
+ * @return iterator - an iterator to the inserted element, or to the element
+ * with an equivalent key in a tree of unique elements.
  */
-template <typename K, typename M>
-auto tree<K, M>::erase(const key_type &key) noexcept -> iterator {
-  Node *node = findNode(root_, key);
-  iterator it = (node) ? ++iterator{node, root_, sentinel_} : end();
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::insert(const_iterator hint,
+                                            const value_type &pair)
+    -> iterator {
+  InsertPos pos = findHintPos(hint.ptr_, pair.first);
 
-  if (node) {
-    delete extractNode(node);
+  if (type_ == kUNIQUE && pos.match) {
+    return iterator{pos.match, root_, sentinel_};
+  }
 
-    if (!size_) {
-      root_ = nullptr;
-    }
+  if (!sentinel_) {
+    sentinel_ = newNode(std::in_place);
   }
 
-  return it;
+  Node *node = newNode(stored(pair));
+  linkNode(node, pos);
+
+  return iterator{node, root_, sentinel_};
+}
+
+/**
+ * @brief Removes the node with the given key from the tree.
+ *
+ * @param[in] key The key of the node to remove.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::erase(const key_type &key) noexcept
+    -> iterator {
+  Node *node = findNode(root_, key);
+
+  return (node) ? eraseNode(node) : end();
 }
 
 /**
  * @brief Erases the node pointed to by the constant iterator.
  *
  * @details
- * This method erases the node pointed to by the constant iterator. It uses the
- * key of the node to find and remove it from the tree.
+ * This method erases exactly the node the iterator points to, without
+ * searching the tree for its key again.
  *
  * @param[in] it The constant iterator pointing to the node to be erased.
  * @return iterator - an iterator to the next node after the erased node, or
  * end() if the erased node was the last node.
  */
-template <typename K, typename M>
-auto tree<K, M>::erase(const_iterator it) noexcept -> iterator {
-  return erase((*it).first);
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::erase(const_iterator it) noexcept
+    -> iterator {
+  return (it.ptr_ && it.ptr_ != sentinel_) ? eraseNode(it.ptr_) : end();
 }
 
 /**
@@ -555,6 +1170,14 @@ auto tree<K, M>::erase(const_iterator it) noexcept -> iterator {
  *
  * @details
  * This method removes the elements in the range [first, last) from the tree.
+ * The positions of the bounds are found from the subtree sizes, the tree is
+ * split into the part before the range, the range itself and the part after
+ * it, the range is destroyed and the outer parts are joined again. The cost is
+ * O(k + log n) for k erased elements.
+ *
+ * Nodes outside the range are not moved, but the splits and joins change the
+ * root and the greatest node, which every iterator caches. All iterators to
+ * the tree are therefore invalidated; use the returned one to continue.
  *
  * @param[in] first The position of the first element to erase.
  * @param[in] last The position following the last element to erase.
@@ -562,8 +1185,9 @@ auto tree<K, M>::erase(const_iterator it) noexcept -> iterator {
  * element, or end() if the last erased element was the last element.
  * @throws std::range_error if the range is invalid.
  */
-template <typename K, typename M>
-auto tree<K, M>::erase(const_iterator first, const_iterator last) -> iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::erase(const_iterator first,
+                                           const_iterator last) -> iterator {
   if (first == last) {
     return first.toIterator();
   } else if (first == begin() && last == end()) {
@@ -571,53 +1195,28 @@ auto tree<K, M>::erase(const_iterator first, const_iterator last) -> iterator {
     return end();
   }
 
-  bool has_first{};
-  bool has_last{(last == cend()) ? true : false};
-
-  for (auto i = cbegin(); i != cend() && !(has_first && has_last); i++) {
-    if (first == i) {
-      if (!has_last || last == cend()) {
-        has_first = true;
-      }
-    } else if (last == i && has_first) {
-      has_last = true;
-    }
-  }
+  bool last_is_end = last.ptr_ && last.ptr_ == sentinel_;
 
-  if (!has_first || !has_last) {
+  if (!ownsNode(first.ptr_) || !(last_is_end || ownsNode(last.ptr_))) {
     throw std::range_error("map::erase() - invalid map range");
   }
 
-  key_type first_key = (*first).first;
-
-  iterator ret_it;
-
-  if (last == end()) {
-    ret_it = --find((*first).first);
+  size_type from = rankOf(first.ptr_);
+  size_type to = (last_is_end) ? size_ : rankOf(last.ptr_);
 
-    for (auto it = cbegin(); it != cend(); it++) {
-      auto current = (*it).first;
-
-      if (current >= first_key) {
-        erase(current);
-        it = cbegin();
-      }
-    }
-  } else {
-    key_type last_key = (*last).first;
-    ret_it = --find(last_key);
+  if (from >= to) {
+    throw std::range_error("map::erase() - invalid map range");
+  }
 
-    for (auto it = cbegin(); it != cend(); it++) {
-      auto current = (*it).first;
+  size_type remaining = size_ - (to - from);
+  auto [low, rest] = split(Subtree{root_, blackHeight(root_)}, from);
+  auto [range, high] = split(rest, to - from);
 
-      if (current >= first_key && current < last_key) {
-        erase(current);
-        it = cbegin();
-      }
-    }
-  }
+  cleanTree(range.root);
+  join(low, high);
+  size_ = remaining;
 
-  return ret_it;
+  return (!last_is_end) ? iterator{last.ptr_, root_, sentinel_} : end();
 }
 
 /**
@@ -629,8 +1228,8 @@ auto tree<K, M>::erase(const_iterator first, const_iterator last) -> iterator {
  *
  * @return size_type - the number of elements in the tree.
  */
-template <typename K, typename M>
-auto tree<K, M>::size() const noexcept -> size_type {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::size() const noexcept -> size_type {
   return size_;
 }
 
@@ -639,8 +1238,8 @@ auto tree<K, M>::size() const noexcept -> size_type {
  *
  * @return size_type - the maximum number of elements.
  */
-template <typename K, typename M>
-auto tree<K, M>::max_size() const noexcept -> size_type {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::max_size() const noexcept -> size_type {
   return std::numeric_limits<size_type>::max() / sizeof(Node) / 2;
 }
 
@@ -649,59 +1248,124 @@ auto tree<K, M>::max_size() const noexcept -> size_type {
  *
  * @details
  * This method merges the elements of another red-black tree into the current
- * tree. It iterates through the other tree and inserts each unique element into
- * the current tree. If an element already exists in the current tree, it is not
- * inserted again.
+ * tree. If an element already exists in a tree of unique elements, it is not
+ * inserted again and stays in other; equivalent elements of a non-unique tree
+ * are placed after the existing ones.
+ *
+ * When both trees use equal allocators, the nodes are relinked by splits and
+ * joins (see unite()) in O(m log(n / m + 1)) for m and n elements in the
+ * smaller and the larger tree. Otherwise the elements are moved one by one:
+ * each is looked up by a single descent, which also gives the place to link
+ * its copy at, and is then erased from other.
  *
  * @param[in,out] other The tree to merge into the current tree.
  */
-template <typename K, typename M>
-void tree<K, M>::merge(tree &other) {
-  if (type_ == kUNIQUE) {
-    auto it = other.begin();
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::merge(tree &other) {
+  if (alloc_ != other.alloc_) {
+    iterator it = other.begin();
 
     while (it != other.end()) {
-      if (!findNode(root_, (*it).first)) {
-        Node *extracted = other.extractNode(findNode(other.root_, (*it).first));
-
-        if (extracted == other.root_) {
-          other.root_ = nullptr;
-          delete other.sentinel_;
-          other.sentinel_ = nullptr;
-          it = other.end();
-        } else {
-          it = other.begin();
-        }
+      InsertPos pos = findInsertPos(it.ptr_->key());
 
-        insertNode(extracted, root_);
-      } else {
+      if (type_ == kUNIQUE && pos.match) {
         ++it;
+      } else {
+        if (!sentinel_) {
+          sentinel_ = newNode(std::in_place);
+        }
+
+        linkNode(newNode(it.ptr_->value), pos);
+        it = other.eraseNode(it.ptr_);
       }
     }
-  } else {
-    while (other.size_) {
-      insertNode(other.extractNode(findMin(other.root_)), root_);
+
+    if (!other.size_) {
+      other.clear();
+    }
+  } else if (this != &other && other.root_) {
+    if (!sentinel_) {
+      sentinel_ = newNode(std::in_place);
     }
 
-    other.root_ = nullptr;
-    delete other.sentinel_;
-    other.sentinel_ = nullptr;
+    auto [merged, rejected] =
+        unite(Subtree{root_, blackHeight(root_)},
+              Subtree{other.root_, blackHeight(other.root_)});
+
+    for (Node *sub : {merged.root, rejected.root}) {
+      if (sub) {
+        sub->parent = nullptr;
+        sub->color = kBLACK;
+      }
+    }
+
+    root_ = merged.root;
+    size_ = subtreeSize(root_);
+    rightmost_ = nullptr;
+    other.root_ = rejected.root;
+    other.size_ = subtreeSize(other.root_);
+    other.rightmost_ = nullptr;
+
+    if (!other.root_) {
+      other.deleteNode(other.sentinel_);
+      other.sentinel_ = nullptr;
+    }
   }
 }
 
 /**
- * @brief Cleans the tree by deleting all nodes.
- */
-template <typename K, typename M>
-void tree<K, M>::clear() noexcept {
-  if (root_) {
-    cleanTree(root_);
+ * @brief Builds the union, intersection or difference of two trees.
+ *
+ * @details
+ * The result holds the elements the corresponding std set algorithm would
+ * write for the sorted ranges of first and second. For equivalent elements
+ * the ones of first are taken. Both trees are walked once in order and only
+ * the selected elements are copied (see mergeRanges()), so the cost is
+ * O(n + m) comparisons and as many allocations as the result has elements.
+ * The sorted copies are then linked into a balanced tree in O(k).
+ *
+ * When the node allocator is always equal (so it holds no state that threads
+ * would share) and the operands are large, the walk is cut into key ranges
+ * that are merged on up to std::thread::hardware_concurrency() threads (see
+ * combineRanges()). Otherwise all work is done on the calling thread.
+ *
+ * @param[in] first The first operand, its comparator and allocator are used
+ * for the result.
+ * @param[in] second The second operand.
+ * @param[in] op The set operation.
+ * @return tree - the new tree.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::combine(const tree &first,
+                                             const tree &second,
+                                             SetOperation op) -> tree {
+  tree result{first.comp_,
+              node_traits::select_on_container_copy_construction(first.alloc_),
+              first.type_};
+  size_type forks{};
+
+  if (node_traits::is_always_equal::value &&
+      first.size_ + second.size_ >= 2 * kForkGrain) {
+    forks = std::max(std::thread::hardware_concurrency(), 1U) - 1;
   }
 
-  if (sentinel_) {
-    delete sentinel_;
-    sentinel_ = nullptr;
-  }
+  result.sentinel_ = result.newNode(std::in_place);
+
+  NodeList list = result.combineRanges(first, second, {0, first.size_},
+                                       {0, second.size_}, op, forks);
+
+  result.root_ = buildBalanced(list.head, list.count, 0, redDepth(list.count));
+  result.size_ = list.count;
+
+  return result;
+}
+
+/**
+ * @brief Cleans the tree by deleting all nodes.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::clear() noexcept {
+  destroyTree();
 }
 
 /**
@@ -709,11 +1373,208 @@ void tree<K, M>::clear() noexcept {
  *
  * @return std::string - a string representation of the tree structure.
  */
-template <typename K, typename M>
-std::string tree<K, M>::structure() const noexcept {
+template <typename K, typename M, typename Compare, typename Allocator>
+std::string tree<K, M, Compare, Allocator>::structure() const noexcept {
   return printNodes(root_);
 }
 
+/**
+ * @brief Returns the allocator associated with the tree.
+ *
+ * @return allocator_type - a copy of the allocator of the tree.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::get_allocator() const noexcept
+    -> allocator_type {
+  return allocator_type{alloc_};
+}
+
+/**
+ * @brief Returns the comparator that orders the keys.
+ *
+ * @return key_compare - a copy of the comparator of the tree.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::key_comp() const -> key_compare {
+  return comp_;
+}
+
+/**
+ * @brief Unlinks the node at the given position and hands it over.
+ *
+ * @details
+ * The element is neither copied nor destroyed; only iterators to it are
+ * invalidated.
+ *
+ * @param[in] it The position of the element to extract.
+ * @return node_type - a handle owning the node, empty for end().
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::extract(const_iterator it) noexcept
+    -> node_type {
+  if (!it.ptr_ || it.ptr_ == sentinel_) {
+    return node_type{};
+  }
+
+  Node *node = extractNode(it.ptr_);
+
+  if (!size_) {
+    root_ = nullptr;
+  }
+
+  return node_type{node, alloc_};
+}
+
+/**
+ * @brief Unlinks the first node with the given key and hands it over.
+ *
+ * @param[in] key The key of the element to extract.
+ * @return node_type - a handle owning the node, empty if there is none.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::extract(const key_type &key) noexcept
+    -> node_type {
+  Node *node = lowerBound(key);
+
+  if (!node || comp_(key, node->key())) {
+    return node_type{};
+  }
+
+  return extract(const_iterator{node, root_, sentinel_});
+}
+
+/**
+ * @brief Links the node owned by a handle into the tree.
+ *
+ * @details
+ * The node is placed by one descent, like a new element, but nothing is
+ * allocated. If a tree of unique elements already has the key, the handle
+ * keeps the node. The node must come from a tree with an equal allocator.
+ *
+ * @param[in,out] node The handle to take the node from.
+ * @return std::pair<iterator, bool> - an iterator to the inserted element or
+ * to the one with the same key, and whether the insertion took place; end()
+ * and false for an empty handle.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::insert(node_type &&node)
+    -> std::pair<iterator, bool> {
+  if (node.empty()) {
+    return {end(), false};
+  }
+
+  InsertPos pos = findInsertPos(node.key());
+
+  if (type_ == kUNIQUE && pos.match) {
+    return {iterator{pos.match, root_, sentinel_}, false};
+  }
+
+  if (!sentinel_) {
+    sentinel_ = newNode(std::in_place);
+  }
+
+  Node *inserted = node.release();
+  linkNode(inserted, pos);
+
+  return {iterator{inserted, root_, sentinel_}, true};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                             HETEROGENEOUS LOOKUP                           //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Searches for an element whose key is equivalent to key.
+ *
+ * @details
+ * Takes part in overload resolution only if Compare is transparent. The key
+ * is compared with the stored keys as is, without building a key_type.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator - an iterator to the found element, or end().
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto tree<K, M, Compare, Allocator>::find(const Key &key) const -> iterator {
+  Node *find = findNode(root_, key);
+
+  return (find) ? iterator{find, root_, sentinel_} : end();
+}
+
+/**
+ * @brief Checks whether the tree contains an element equivalent to key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return true if such an element exists, false otherwise.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key, typename>
+bool tree<K, M, Compare, Allocator>::contains(const Key &key) const {
+  return findNode(root_, key);
+}
+
+/**
+ * @brief Returns an iterator to the first element not less than key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator - an iterator to the found element, or end().
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto tree<K, M, Compare, Allocator>::lower_bound(const Key &key) const
+    -> iterator {
+  Node *bound = lowerBound(key);
+
+  return (bound) ? iterator{bound, root_, sentinel_} : end();
+}
+
+/**
+ * @brief Returns an iterator to the first element greater than key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return iterator - an iterator to the found element, or end().
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto tree<K, M, Compare, Allocator>::upper_bound(const Key &key) const
+    -> iterator {
+  Node *bound = upperBound(key);
+
+  return (bound) ? iterator{bound, root_, sentinel_} : end();
+}
+
+/**
+ * @brief Returns a range containing all elements equivalent to key.
+ *
+ * @details
+ * Both bounds are found by one descent (see equalBounds()).
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return std::pair<iterator, iterator> - the pair of lower_bound(key) and
+ * upper_bound(key).
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto tree<K, M, Compare, Allocator>::equal_range(const Key &key) const
+    -> std::pair<iterator, iterator> {
+  auto [lower, upper] = equalBounds(key);
+
+  return {(lower) ? iterator{lower, root_, sentinel_} : end(),
+          (upper) ? iterator{upper, root_, sentinel_} : end()};
+}
+
+/**
+ * @brief Returns the number of elements equivalent to key.
+ *
+ * @param[in] key The value to compare the keys to.
+ * @return size_type - the number of matching elements.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key, typename>
+auto tree<K, M, Compare, Allocator>::count(const Key &key) const -> size_type {
+  return countNodes(key);
+}
+
 /**
  * @brief Inserts a new element into the tree, constructed in place.
  *
@@ -731,103 +1592,318 @@ std::string tree<K, M>::structure() const noexcept {
  * element that prevented the insertion) and a bool denoting whether the
  * insertion took place.
  */
-template <typename K, typename M>
+template <typename K, typename M, typename Compare, typename Allocator>
 template <typename... Args>
-auto tree<K, M>::emplace(Args &&...args) -> std::pair<iterator, bool> {
-  Node *new_node = new Node{value_type{std::forward<Args>(args)...}};
-
-  if (type_ == kUNIQUE && findNode(root_, new_node->pair->first)) {
-    delete new_node;
-    return {end(), false};
+auto tree<K, M, Compare, Allocator>::emplace(Args &&...args)
+    -> std::pair<iterator, bool> {
+  Node *new_node = newNode(std::in_place, std::forward<Args>(args)...);
+  InsertPos pos = findInsertPos(new_node->key());
+
+  if (type_ == kUNIQUE && pos.match) {
+    deleteNode(new_node);
+    return {iterator{pos.match, root_, sentinel_}, false};
   }
 
   if (!sentinel_) {
-    sentinel_ = new Node{value_type{}};
+    try {
+      sentinel_ = newNode(std::in_place);
+    } catch (...) {
+      deleteNode(new_node);
+      throw;
+    }
   }
 
-  insertNode(new_node, root_);
+  linkNode(new_node, pos);
 
   return {iterator{new_node, root_, sentinel_}, true};
 }
 
-////////////////////////////////////////////////////////////////////////////////
-//                              ADD/REMOVE NODES                              //
-////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Inserts an element built from args unless the key exists.
+ *
+ * @details
+ * Unlike emplace(), the place of the key is found first, by the same single
+ * descent that links the node in. Nothing is constructed or allocated when
+ * a tree of unique elements already has the key. The element built from args
+ * must have the given key.
+ *
+ * @tparam Args The types of the arguments for the element constructor.
+ * @param[in] key The key of the new element.
+ * @param[in] args The arguments forwarded to the element constructor.
+ * @return std::pair<iterator, bool> - an iterator to the element with the key
+ * and whether the insertion took place.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename... Args>
+auto tree<K, M, Compare, Allocator>::try_emplace(const key_type &key,
+                                                 Args &&...args)
+    -> std::pair<iterator, bool> {
+  InsertPos pos = findInsertPos(key);
+
+  if (type_ == kUNIQUE && pos.match) {
+    return {iterator{pos.match, root_, sentinel_}, false};
+  }
+
+  if (!sentinel_) {
+    sentinel_ = newNode(std::in_place);
+  }
+
+  Node *node = newNode(std::in_place, std::forward<Args>(args)...);
+  linkNode(node, pos);
+
+  return {iterator{node, root_, sentinel_}, true};
+}
 
 /**
- * @brief Creates a new node with the given key and value.
+ * @brief Inserts an element built from args as close as possible before
+ * hint.
  *
- * @param[in] pair The pair of key/value for node.
- * @param[in,out] node A reference to the node pointer where the new node will
- * be created.
- * @param[in] parent The parent of the new node.
- * @return Node* - a pointer to the newly created node.
+ * @details
+ * The element is constructed first, then placed as by insert() with a hint.
+ * In a tree of unique elements it is destroyed again if its key exists.
+ *
+ * @tparam Args The types of the arguments for the element constructor.
+ * @param[in] hint The position before which the element should be inserted.
+ * @param[in] args The arguments forwarded to the element constructor.
+ * @return iterator - an iterator to the inserted element, or to the element
+ * with an equivalent key in a tree of unique elements.
  */
-template <typename K, typename M>
-auto tree<K, M>::createNode(const value_type &pair, Node *&node, Node *parent)
-    -> Node * {
-  Node *ret_node{root_};
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename... Args>
+auto tree<K, M, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                  Args &&...args)
+    -> iterator {
+  Node *node = newNode(std::in_place, std::forward<Args>(args)...);
+  InsertPos pos = findHintPos(hint.ptr_, node->key());
 
-  if (!node) {
-    node = new Node{pair, kRED, parent};
-    ret_node = node;
-    ++size_;
+  if (type_ == kUNIQUE && pos.match) {
+    deleteNode(node);
+    return iterator{pos.match, root_, sentinel_};
+  }
+
+  if (!sentinel_) {
+    try {
+      sentinel_ = newNode(std::in_place);
+    } catch (...) {
+      deleteNode(node);
+      throw;
+    }
+  }
+
+  linkNode(node, pos);
+
+  return iterator{node, root_, sentinel_};
+}
+
+/**
+ * @brief Replaces the contents of the tree with the elements of a sorted
+ * range.
+ *
+ * @details
+ * The elements are first allocated as a list in input order. If the range is
+ * sorted (strictly for a tree of unique elements), the list is turned into a
+ * balanced red-black tree bottom-up by buildBalanced() in O(n), without
+ * comparisons or rotations. With checked set, the order is verified while
+ * the range is read and an unsorted range falls back to inserting the nodes
+ * one by one, which gives the same result as insert() in O(n log n). Without
+ * the check the range must be sorted.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @tparam Project The type of the callable converting an element of the range
+ * to value_type, or to key_type for a tree of keys.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ * @param[in] project The conversion of the elements to the node elements.
+ * @param[in] checked Whether to verify the order of the range.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename InputIt, typename Project>
+void tree<K, M, Compare, Allocator>::assign_sorted(InputIt first, InputIt last,
+                                                   Project project,
+                                                   bool checked) {
+  clear();
+
+  Node *list{};
+  Node **tail = &list;
+  const Node *prev{};
+  size_type count{};
+  bool sorted = true;
+
+  try {
+    for (; first != last; ++first, ++count) {
+      Node *node = newNode(project(*first));
+
+      *tail = node;
+      tail = &node->right;
+
+      if (checked && sorted && prev) {
+        const key_type &key = node->key();
+
+        sorted = (type_ == kUNIQUE) ? comp_(prev->key(), key)
+                                    : !comp_(key, prev->key());
+      }
+
+      prev = node;
+    }
 
-    if (node->parent && node->parent->color == kRED) {
-      balancingTree(node);
+    if (list && !sentinel_) {
+      sentinel_ = newNode(std::in_place);
+    }
+  } catch (...) {
+    while (list) {
+      deleteNode(std::exchange(list, list->right));
     }
+
+    throw;
+  }
+
+  if (sorted) {
+    root_ = buildBalanced(list, count, 0, redDepth(count));
+    rightmost_ = nullptr;
+    size_ = count;
   } else {
-    if (pair.first < node->pair->first) {
-      ret_node = createNode(pair, node->left, node);
-    } else {
-      ret_node = createNode(pair, node->right, node);
+    try {
+      while (list) {
+        InsertPos pos = findInsertPos(list->key());
+        Node *node = std::exchange(list, list->right);
+
+        if (type_ == kUNIQUE && pos.match) {
+          deleteNode(node);
+        } else {
+          linkNode(node, pos);
+        }
+      }
+    } catch (...) {
+      while (list) {
+        deleteNode(std::exchange(list, list->right));
+      }
+
+      throw;
     }
   }
+}
 
-  if (root_) {
-    root_->color = kBLACK;
+////////////////////////////////////////////////////////////////////////////////
+//                              ADD/REMOVE NODES                              //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Allocates and constructs a node through the node allocator.
+ *
+ * @tparam Args The types of the arguments for the node constructor.
+ * @param[in] args The arguments forwarded to the node constructor.
+ * @return Node* - a pointer to the new node.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename... Args>
+auto tree<K, M, Compare, Allocator>::newNode(Args &&...args) -> Node * {
+  Node *node = node_traits::allocate(alloc_, 1);
+
+  try {
+    node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+
+  return node;
+}
+
+/**
+ * @brief Destroys and deallocates a node through the node allocator.
+ *
+ * @param[in] node The node to delete, may be nullptr.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::deleteNode(Node *node) noexcept {
+  if (node) {
+    node_traits::destroy(alloc_, node);
+    node_traits::deallocate(alloc_, node, 1);
+  }
+}
+
+/**
+ * @brief Deletes all nodes of the tree including the sentinel.
+ *
+ * @details
+ * When the node allocator can free all of its memory at once (see
+ * has_bulk_release), no other container shares it and the elements need no
+ * destructor, the whole tree is dropped in one step instead of visiting every
+ * node.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::destroyTree() noexcept {
+  if constexpr (has_bulk_release<node_allocator>::value &&
+                std::is_trivially_destructible_v<Node>) {
+    if (alloc_.unique()) {
+      alloc_.release();
+      root_ = sentinel_ = rightmost_ = nullptr;
+      size_ = 0;
+      return;
+    }
   }
 
-  return ret_node;
+  cleanTree(root_);
+  deleteNode(sentinel_);
+  sentinel_ = rightmost_ = nullptr;
 }
 
 /**
- * @brief Inserts a node into the red-black tree.
+ * @brief Inserts a detached node into the red-black tree.
  *
  * @details
- * This method inserts a given node into the red-black tree, maintaining the
- * red-black tree properties. If the node is inserted successfully, it may
- * require rebalancing the tree to maintain its properties.
+ * The place of the node is found by findInsertPos(), after which the node is
+ * linked in and the tree is rebalanced. Equal keys are not checked here, the
+ * caller decides whether the node may be inserted.
  *
  * @param[in] insert The node to insert.
- * @param[in,out] node A reference to the node pointer where the new node will
- * be inserted.
- * @param[in] parent The parent of the new node.
  */
-template <typename K, typename M>
-void tree<K, M>::insertNode(Node *insert, Node *&node, Node *parent) {
-  if (!node) {
-    insert->color = kRED;
-    insert->parent = parent;
-    insert->left = insert->right = nullptr;
-
-    ++size_;
-    node = insert;
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::insertNode(Node *insert) {
+  linkNode(insert, findInsertPos(insert->key()));
+}
 
-    if (node->parent && node->parent->color == kRED) {
-      balancingTree(node);
-    }
+/**
+ * @brief Links a node in as a red leaf at the place found by findInsertPos().
+ *
+ * @details
+ * Old links of the node are dropped, so it may come from another tree. After
+ * linking, the red-black properties are restored by balancingTree().
+ *
+ * @param[in] node The node to link.
+ * @param[in] pos The place of the node in the tree.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::linkNode(Node *node,
+                                              const InsertPos &pos) noexcept {
+  node->color = kRED;
+  node->parent = pos.parent;
+  node->left = node->right = nullptr;
+  node->size = 1;
+
+  if (!pos.parent) {
+    root_ = rightmost_ = node;
+  } else if (pos.left) {
+    pos.parent->left = node;
   } else {
-    if (insert->pair->first < node->pair->first) {
-      insertNode(insert, node->left, node);
-    } else {
-      insertNode(insert, node->right, node);
+    pos.parent->right = node;
+
+    if (pos.parent == rightmost_) {
+      rightmost_ = node;
     }
   }
 
-  if (root_) {
-    root_->color = kBLACK;
+  for (Node *ancestor = pos.parent; ancestor; ancestor = ancestor->parent) {
+    ++ancestor->size;
+  }
+
+  ++size_;
+
+  if (pos.parent && pos.parent->color == kRED) {
+    balancingTree(node);
   }
+
+  root_->color = kBLACK;
 }
 
 /**
@@ -836,40 +1912,44 @@ void tree<K, M>::insertNode(Node *insert, Node *&node, Node *parent) {
  * @details
  * This method extracts a given node from the red-black tree, maintaining the
  * red-black tree properties. The method handles different cases based on the
- * color of the node and the number of its children.
+ * color of the node and the number of its children. The returned node is
+ * always the given one, so it can be destroyed or relinked by the caller.
  *
  * @param[in] node The node to extract.
  * @return Node* - a pointer to the node that was extracted.
  */
-template <typename K, typename M>
-auto tree<K, M>::extractNode(Node *node) noexcept -> Node * {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::extractNode(Node *node) noexcept
+    -> Node * {
   if (!node) {
     return nullptr;
   }
 
-  Node *to_del{node};
+  if (node == rightmost_) {
+    rightmost_ = (node->left) ? node->left : node->parent;
+  }
 
   if (node->color == kRED) {
     if (!node->left && !node->right) {
       removeConnect(node);
     } else if (node->left && node->right) {
-      to_del = deleteTwoChild(node);
+      deleteTwoChild(node);
     }
   } else {
     if (!node->left && !node->right) {
       deleteBlackNoChild(node);
     } else if (!node->left && node->right) {
-      to_del = deleteOneChild(node, node->right);
+      deleteOneChild(node, node->right);
     } else if (node->left && !node->right) {
-      to_del = deleteOneChild(node, node->left);
+      deleteOneChild(node, node->left);
     } else {
-      to_del = deleteTwoChild(node);
+      deleteTwoChild(node);
     }
   }
 
   --size_;
 
-  return to_del;
+  return node;
 }
 
 /**
@@ -877,13 +1957,13 @@ auto tree<K, M>::extractNode(Node *node) noexcept -> Node * {
  *
  * @param[in,out] node The root node of the tree.
  */
-template <typename K, typename M>
-void tree<K, M>::cleanTree(Node *&node) noexcept {
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::cleanTree(Node *&node) noexcept {
   if (node) {
     cleanTree(node->left);
     cleanTree(node->right);
 
-    delete node;
+    deleteNode(node);
     node = nullptr;
     --size_;
   }
@@ -894,146 +1974,285 @@ void tree<K, M>::cleanTree(Node *&node) noexcept {
  *
  * @param[in,out] node Node to break connection with.
  */
-template <typename K, typename M>
-void tree<K, M>::removeConnect(Node *node) noexcept {
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::removeConnect(Node *node) noexcept {
   if (node->parent) {
     if (node->parent->left == node) {
       node->parent->left = nullptr;
     } else {
       node->parent->right = nullptr;
     }
+
+    shrinkPath(node->parent);
   }
 }
 
 /**
- * @brief Copies the nodes from another red-black tree.
+ * @brief Removes the given node from the tree and destroys it.
  *
- * @details
- * This method recursively copies all the nodes from another red-black tree into
- * the current tree. It inserts each node's key-value pair into the current
- * tree, ensuring that the tree properties are maintained.
- *
- * @param[in] node The root node of the tree to copy from.
+ * @param[in] node The node to remove.
+ * @return iterator - an iterator to the node following the removed one, or
+ * end() if the removed node was the last node.
  */
-template <typename K, typename M>
-void tree<K, M>::copyTree(Node *node) {
-  if (node) {
-    insert(*node->pair);
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::eraseNode(Node *node) noexcept
+    -> iterator {
+  Node *next = (++iterator{node, root_, sentinel_}).ptr_;
 
-    copyTree(node->left);
-    copyTree(node->right);
+  deleteNode(extractNode(node));
+
+  if (!size_) {
+    root_ = nullptr;
   }
-}
 
-////////////////////////////////////////////////////////////////////////////////
-//                                BALANCING TREE                              //
-////////////////////////////////////////////////////////////////////////////////
+  return (next != sentinel_) ? iterator{next, root_, sentinel_} : end();
+}
 
 /**
- * @brief Balances the tree after inserting a new node.
+ * @brief Copies the nodes from another red-black tree.
  *
- * @param[in] node The newly inserted node.
+ * @details
+ * The shape, colors and subtree sizes of other are cloned node by node, so
+ * the copy costs O(n) without a single comparison or rotation. An allocator
+ * that supports reserve() is asked for all nodes at once. If an allocation
+ * throws, the nodes copied so far are freed and the tree is left empty.
+ *
+ * @param[in] other The tree to copy from. The current tree must be empty.
  */
-template <typename K, typename M>
-void tree<K, M>::balancingTree(Node *node) noexcept {
-  while (node->parent && node->parent->color == kRED) {
-    Node *parent = node->parent;
-    Node *grandpar = parent->parent;
-    Node *uncle = (parent == grandpar->left) ? grandpar->right : grandpar->left;
-
-    if (uncle && uncle->color == kRED) {
-      parent->color = kBLACK;
-      uncle->color = kBLACK;
-      grandpar->color = kRED;
-      node = grandpar;
-    } else {
-      if (node == parent->right && parent == grandpar->left) {
-        rotateLeft(parent);
-        node = parent;
-        parent = node->parent;
-      } else if (node == parent->left && parent == grandpar->right) {
-        rotateRight(parent);
-        node = parent;
-        parent = node->parent;
-      }
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::copyTree(const tree &other) {
+  if constexpr (has_reserve<node_allocator>::value) {
+    alloc_.reserve(other.size_ + 1);
+  }
 
-      parent->color = kBLACK;
-      grandpar->color = kRED;
+  sentinel_ = newNode(std::in_place);
 
-      if (parent == grandpar->left) {
-        rotateRight(grandpar);
-      } else {
-        rotateLeft(grandpar);
-      }
+  if (other.root_) {
+    try {
+      cloneNodes(other.root_, nullptr, root_);
+    } catch (...) {
+      destroyTree();
+      throw;
     }
   }
 }
 
 /**
- * @brief Fixes a double black violation.
+ * @brief Clones a subtree and links the copy under the given parent.
  *
- * @param[in,out] node The node with the double black violation.
+ * @details
+ * Each copy is linked before its sons are cloned, so a partially built tree
+ * is always well formed and can be destroyed if an allocation throws.
+ *
+ * @param[in] node The root of the subtree to clone.
+ * @param[in] parent The parent of the copy.
+ * @param[out] link The son pointer of parent (or root_) to store the copy in.
  */
-template <typename K, typename M>
-void tree<K, M>::fixDoubleBlack(Node *&node) noexcept {
-  if (node == root_) {
-    return;
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::cloneNodes(const Node *node, Node *parent,
+                                                Node *&link) {
+  link = newNode(node->value, node->color, parent);
+  link->size = node->size;
+  ++size_;
+
+  if (node->left) {
+    cloneNodes(node->left, link, link->left);
   }
 
-  Node *parent = node->parent;
-  Node *brother = (parent->left == node) ? parent->right : parent->left;
+  if (node->right) {
+    cloneNodes(node->right, link, link->right);
+  }
+}
+
+/**
+ * @brief Builds a balanced red-black tree from a sorted list of nodes.
+ *
+ * @details
+ * The nodes are chained through their right pointers. The first half of the
+ * list becomes the left subtree, the next node the root and the rest the
+ * right subtree, so all levels but the deepest one are full. Nodes on the
+ * deepest, incomplete level are red and all others are black, which gives
+ * every path the same black height.
+ *
+ * @param[in,out] list The head of the list, advanced past the used nodes.
+ * @param[in] count The number of nodes to take from the list.
+ * @param[in] depth The depth of the subtree root.
+ * @param[in] red_depth The depth of the incomplete level, floor(log2(n + 1))
+ * for n nodes in the whole tree.
+ * @return Node* - the root of the built subtree.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::buildBalanced(Node *&list, size_type count,
+                                                   size_type depth,
+                                                   size_type red_depth) noexcept
+    -> Node * {
+  if (!count) {
+    return nullptr;
+  }
+
+  Node *left = buildBalanced(list, count / 2, depth + 1, red_depth);
+  Node *node = list;
+  list = list->right;
+  Node *right =
+      buildBalanced(list, count - count / 2 - 1, depth + 1, red_depth);
+
+  node->parent = nullptr;
+  node->left = left;
+  node->right = right;
+  node->size = count;
+  node->color = (depth == red_depth) ? kRED : kBLACK;
+
+  for (Node *child : {left, right}) {
+    if (child) {
+      child->parent = node;
+    }
+  }
 
-  if (brother->color == kRED) {
-    parent->color = kRED;
-    brother->color = kBLACK;
+  return node;
+}
 
-    (brother == parent->left) ? rotateRight(parent) : rotateLeft(parent);
-    fixDoubleBlack(node);
+/**
+ * @brief Finds the depth of the incomplete level of a balanced tree.
+ *
+ * @param[in] count The number of nodes in the tree.
+ * @return size_type - floor(log2(count + 1)), the red_depth argument of
+ * buildBalanced().
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::redDepth(size_type count) noexcept
+    -> size_type {
+  size_type depth{};
+
+  for (size_type full = count + 1; full > 1; full >>= 1) {
+    ++depth;
+  }
+
+  return depth;
+}
+
+/**
+ * @brief Selects the part of a key-value pair that a node holds.
+ *
+ * @param[in] pair The key-value pair.
+ * @return const stored_type& - the pair itself, or its key in a tree of keys.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::stored(const value_type &pair) noexcept
+    -> const stored_type & {
+  if constexpr (std::is_void_v<M>) {
+    return pair.first;
   } else {
-    if ((brother->left && brother->left->color == kBLACK) &&
-        (brother->right && brother->right->color == kBLACK)) {
-      brother->color = kRED;
-      if (parent->color == kBLACK) {
-        fixDoubleBlack(parent);
+    return pair;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                BALANCING TREE                              //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Balances the tree after inserting a new node.
+ *
+ * @param[in] node The newly inserted node.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::balancingTree(Node *node) noexcept {
+  while (node->parent && node->parent->color == kRED) {
+    Node *parent = node->parent;
+    Node *grandpar = parent->parent;
+    Node *uncle = (parent == grandpar->left) ? grandpar->right : grandpar->left;
+
+    if (uncle && uncle->color == kRED) {
+      parent->color = kBLACK;
+      uncle->color = kBLACK;
+      grandpar->color = kRED;
+      node = grandpar;
+    } else {
+      if (node == parent->right && parent == grandpar->left) {
+        rotateLeft(parent);
+        node = parent;
+        parent = node->parent;
+      } else if (node == parent->left && parent == grandpar->right) {
+        rotateRight(parent);
+        node = parent;
+        parent = node->parent;
+      }
+
+      parent->color = kBLACK;
+      grandpar->color = kRED;
+
+      if (parent == grandpar->left) {
+        rotateRight(grandpar);
       } else {
-        parent->color = kBLACK;
+        rotateLeft(grandpar);
       }
+    }
+  }
+}
+
+/**
+ * @brief Fixes a double black violation.
+ *
+ * @details
+ * The node carries an extra black. While it is a black node other than the
+ * root, the extra black is either pushed up to the parent (black brother with
+ * black sons) or absorbed by at most two rotations. A red brother is first
+ * rotated above the parent, which reduces that case to one with a black
+ * brother. Both mirror images are handled, so the node may be a left or a
+ * right son.
+ *
+ * @param[in] node The node with the double black violation.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::fixDoubleBlack(Node *node) noexcept {
+  while (node != root_ && node->color == kBLACK) {
+    Node *parent = node->parent;
+    bool is_left = parent->left == node;
+    Node *brother = (is_left) ? parent->right : parent->left;
+
+    if (brother->color == kRED) {
+      brother->color = kBLACK;
+      parent->color = kRED;
+      (is_left) ? rotateLeft(parent) : rotateRight(parent);
+      brother = (is_left) ? parent->right : parent->left;
+    }
+
+    Node *near = (is_left) ? brother->left : brother->right;
+    Node *far = (is_left) ? brother->right : brother->left;
+
+    if (isBlack(near) && isBlack(far)) {
+      brother->color = kRED;
+      node = parent;
     } else {
-      if (brother == parent->left) {
-        if (brother->left && brother->left->color == kRED) {
-          brother->left->color = std::exchange(brother->color, parent->color);
-          rotateRight(parent);
-        } else {
-          if (brother->right && brother->right->color == kRED) {
-            brother->right->color = parent->color;
-            rotateLeft(brother);
-            rotateRight(parent);
-          }
-        }
-      } else {
-        if (brother->right && brother->right->color == kRED) {
-          brother->right->color = std::exchange(brother->color, parent->color);
-          rotateLeft(parent);
-        } else {
-          if (brother->left && brother->left->color == kRED) {
-            brother->left->color = parent->color;
-            rotateRight(brother);
-            rotateLeft(parent);
-          }
-        }
+      if (isBlack(far)) {
+        near->color = kBLACK;
+        brother->color = kRED;
+        (is_left) ? rotateRight(brother) : rotateLeft(brother);
+        far = std::exchange(brother, near);
       }
+
+      brother->color = parent->color;
       parent->color = kBLACK;
+      far->color = kBLACK;
+      (is_left) ? rotateLeft(parent) : rotateRight(parent);
+      node = root_;
     }
   }
+
+  node->color = kBLACK;
 }
 
 /**
  * @brief Performs a left rotation at the given node.
  *
+ * @details
+ * The subtree sizes of the two rotated nodes are recomputed, the sizes of all
+ * other nodes do not change.
+ *
  * @param[in] old_root The node at which to perform the rotation.
  */
-template <typename K, typename M>
-void tree<K, M>::rotateLeft(Node *old_root) noexcept {
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::rotateLeft(Node *old_root) noexcept {
   Node *new_root = old_root->right;
 
   if (new_root->left) {
@@ -1052,15 +2271,22 @@ void tree<K, M>::rotateLeft(Node *old_root) noexcept {
   }
 
   new_root->parent = std::exchange(old_root->parent, new_root);
+  new_root->size = old_root->size;
+  old_root->size =
+      1 + subtreeSize(old_root->left) + subtreeSize(old_root->right);
 }
 
 /**
  * @brief Performs a right rotation at the given node.
  *
+ * @details
+ * The subtree sizes of the two rotated nodes are recomputed, the sizes of all
+ * other nodes do not change.
+ *
  * @param[in] old_root The node at which to perform the rotation.
  */
-template <typename K, typename M>
-void tree<K, M>::rotateRight(Node *old_root) noexcept {
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::rotateRight(Node *old_root) noexcept {
   Node *new_root = old_root->left;
 
   if (new_root->right) {
@@ -1079,31 +2305,20 @@ void tree<K, M>::rotateRight(Node *old_root) noexcept {
   }
 
   new_root->parent = std::exchange(old_root->parent, new_root);
+  new_root->size = old_root->size;
+  old_root->size =
+      1 + subtreeSize(old_root->left) + subtreeSize(old_root->right);
 }
 
 /**
- * @brief Swaps the colors of the given node and its children.
+ * @brief Checks whether the node is black. Missing sons count as black.
  *
- * @param[in] node The node at which to swap colors.
+ * @param[in] node The node to check, may be nullptr.
+ * @return true if the node is nullptr or black, false otherwise.
  */
-template <typename K, typename M>
-void tree<K, M>::swapColors(Node *node) noexcept {
-  if (node == nullptr || node->left == nullptr || node->right == nullptr) {
-    return;
-  }
-
-  if (node->left->color == kRED && node->right->color == kRED) {
-    node->left->color = node->right->color = kBLACK;
-    node->color = kRED;
-
-    if (node->parent && node->parent != root_) {
-      swapColors(node->parent);
-    }
-  }
-
-  if (root_) {
-    root_->color = kBLACK;
-  }
+template <typename K, typename M, typename Compare, typename Allocator>
+bool tree<K, M, Compare, Allocator>::isBlack(const Node *node) noexcept {
+  return !node || node->color == kBLACK;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1113,55 +2328,1122 @@ void tree<K, M>::swapColors(Node *node) noexcept {
 /**
  * @brief Finds the node with the given key.
  *
+ * @details
+ * The descent makes one comparison per level: it looks for the leftmost node
+ * whose key is not less than key and checks for equivalence only once, at
+ * the end. For a tree with non-unique elements this is the first of the
+ * equivalent nodes.
+ *
+ * @tparam Key The type of the key, key_type or any type accepted by a
+ * transparent Compare.
  * @param[in] node The root node of the tree.
  * @param[in] key The key to search for.
  * @return Node* - the node with the given key, or nullptr if the key is not
  * found.
  */
-template <typename K, typename M>
-auto tree<K, M>::findNode(Node *node, const key_type &key) const noexcept
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key>
+auto tree<K, M, Compare, Allocator>::findNode(Node *node,
+                                              const Key &key) const noexcept
     -> Node * {
+  Node *bound{};
+
+  while (node) {
+    if (comp_(node->key(), key)) {
+      node = node->right;
+    } else {
+      bound = node;
+      node = node->left;
+    }
+  }
+
+  return (bound && !comp_(key, bound->key())) ? bound : nullptr;
+}
+
+/**
+ * @brief Finds the place for a new node with the given key.
+ *
+ * @details
+ * The descent makes one comparison per level and goes right on equal keys,
+ * so a new element is placed after its equivalents. The last node passed on
+ * the right is the only candidate for an equivalent key, which is checked
+ * with a single extra comparison.
+ *
+ * @tparam Key The type of the key.
+ * @param[in] key The key of the new node.
+ * @return InsertPos - the parent and side for the new node and the node with
+ * an equivalent key, if any.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key>
+auto tree<K, M, Compare, Allocator>::findInsertPos(
+    const Key &key) const noexcept -> InsertPos {
+  Node *node = root_;
+  Node *parent{};
+  Node *candidate{};
+  bool left{};
+
+  while (node) {
+    parent = node;
+    left = comp_(key, node->key());
+
+    if (left) {
+      node = node->left;
+    } else {
+      candidate = node;
+      node = node->right;
+    }
+  }
+
+  bool equal = candidate && !comp_(candidate->key(), key);
+
+  return InsertPos{parent, equal ? candidate : nullptr, left};
+}
+
+/**
+ * @brief Finds the place for a new key right before the hint node.
+ *
+ * @details
+ * The key fits before hint if it lies between the predecessor of hint and
+ * hint itself (equal keys are allowed on both sides in a tree of non-unique
+ * elements). The new node then becomes the left son of hint or, when hint
+ * has a left subtree, the right son of its predecessor, which is the
+ * greatest node of that subtree. For end() the predecessor is the cached
+ * greatest node, so appending costs a single comparison. A key equal to a
+ * neighbour of hint in a tree of unique elements is reported as match; any
+ * other key falls back to findInsertPos().
+ *
+ * @param[in] hint The node before which the key should go, nullptr or the
+ * sentinel for end().
+ * @param[in] key The key to place.
+ * @return InsertPos - the place of the new node.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key>
+auto tree<K, M, Compare, Allocator>::findHintPos(Node *hint,
+                                                 const Key &key) noexcept
+    -> InsertPos {
+  if (!root_) {
+    return findInsertPos(key);
+  }
+
+  bool unique = type_ == kUNIQUE;
+  Node *next = (hint != sentinel_) ? hint : nullptr;
+  Node *prev = (next) ? predecessor(next) : maxNode();
+
+  if (prev && !comp_(prev->key(), key)) {
+    if (unique && !comp_(key, prev->key())) {
+      return InsertPos{prev, prev, false};
+    } else if (unique || comp_(key, prev->key())) {
+      return findInsertPos(key);
+    }
+  }
+
+  if (next && !comp_(key, next->key())) {
+    if (unique && !comp_(next->key(), key)) {
+      return InsertPos{next, next, true};
+    } else if (unique || comp_(next->key(), key)) {
+      return findInsertPos(key);
+    }
+  }
+
+  if (next && !next->left) {
+    return InsertPos{next, nullptr, true};
+  }
+
+  return InsertPos{prev, nullptr, false};
+}
+
+/**
+ * @brief Finds the leftmost node whose key is not less than the given key.
+ *
+ * @param[in] key The key to compare the nodes to.
+ * @return Node* - the found node, or nullptr if all keys are less than key.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key>
+auto tree<K, M, Compare, Allocator>::lowerBound(const Key &key) const noexcept
+    -> Node * {
+  Node *node = root_;
+  Node *bound{};
+
+  while (node) {
+    if (comp_(node->key(), key)) {
+      node = node->right;
+    } else {
+      bound = node;
+      node = node->left;
+    }
+  }
+
+  return bound;
+}
+
+/**
+ * @brief Finds the leftmost node whose key is greater than the given key.
+ *
+ * @param[in] key The key to compare the nodes to.
+ * @return Node* - the found node, or nullptr if no key is greater than key.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key>
+auto tree<K, M, Compare, Allocator>::upperBound(const Key &key) const noexcept
+    -> Node * {
+  Node *node = root_;
+  Node *bound{};
+
+  while (node) {
+    if (comp_(key, node->key())) {
+      bound = node;
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+
+  return bound;
+}
+
+/**
+ * @brief Finds the lower and the upper bound of a key in one descent.
+ *
+ * @details
+ * Both bounds follow the same path down to the first node with an equivalent
+ * key. There the path splits: the lower bound is looked for in the left
+ * subtree of that node and the upper bound in its right subtree. Without an
+ * equivalent key the two bounds are the same node.
+ *
+ * @param[in] key The key to compare the nodes to.
+ * @return std::pair<Node *, Node *> - the leftmost node not less than key and
+ * the leftmost node greater than key, nullptr where there is none.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key>
+auto tree<K, M, Compare, Allocator>::equalBounds(const Key &key) const noexcept
+    -> std::pair<Node *, Node *> {
+  Node *node = root_;
+  Node *upper{};
+
+  while (node) {
+    if (comp_(node->key(), key)) {
+      node = node->right;
+    } else if (comp_(key, node->key())) {
+      upper = node;
+      node = node->left;
+    } else {
+      break;
+    }
+  }
+
   if (!node) {
-    return nullptr;
+    return {upper, upper};
+  }
+
+  Node *lower = node;
+
+  for (Node *left = node->left; left;) {
+    if (comp_(left->key(), key)) {
+      left = left->right;
+    } else {
+      lower = left;
+      left = left->left;
+    }
+  }
+
+  for (Node *right = node->right; right;) {
+    if (comp_(key, right->key())) {
+      upper = right;
+      right = right->left;
+    } else {
+      right = right->right;
+    }
+  }
+
+  return {lower, upper};
+}
+
+/**
+ * @brief Counts the nodes whose keys are equivalent to the given key.
+ *
+ * @details
+ * For a tree of unique elements this is a single O(log n) search. Otherwise
+ * the bounds of the equal nodes are found by equalBounds() and the count is
+ * the difference of their ranks, which the subtree sizes give in O(log n).
+ *
+ * @param[in] key The key to compare the nodes to.
+ * @return size_type - the number of matching nodes.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename Key>
+auto tree<K, M, Compare, Allocator>::countNodes(const Key &key) const noexcept
+    -> size_type {
+  if (type_ == kUNIQUE) {
+    return (findNode(root_, key)) ? 1 : 0;
+  }
+
+  auto [lower, upper] = equalBounds(key);
+
+  if (lower == upper) {
+    return 0;
+  }
+
+  return ((upper) ? rankOf(upper) : size_) - rankOf(lower);
+}
+
+/**
+ * @brief Finds the node with the maximum key in the tree.
+ *
+ * @param[in] node The root node of the tree.
+ * @return Node* - the node with the maximum key.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::findMax(Node *node) noexcept -> Node * {
+  while (node && node->right) {
+    node = node->right;
+  }
+
+  return node;
+}
+
+/**
+ * @brief Returns the node with the greatest key, caching it.
+ *
+ * @details
+ * Linking and extracting single nodes keep the cache up to date; operations
+ * that rebuild the tree reset it, and it is found again on the next call.
+ *
+ * @return Node* - the greatest node, or nullptr for an empty tree.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::maxNode() noexcept -> Node * {
+  if (!rightmost_) {
+    rightmost_ = findMax(root_);
+  }
+
+  return rightmost_;
+}
+
+/**
+ * @brief Finds the in-order predecessor of a node.
+ *
+ * @param[in] node The node to start from.
+ * @return Node* - the predecessor, or nullptr for the least node.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::predecessor(Node *node) noexcept
+    -> Node * {
+  if (node->left) {
+    return findMax(node->left);
+  }
+
+  Node *parent = node->parent;
+
+  while (parent && node == parent->left) {
+    node = parent;
+    parent = parent->parent;
+  }
+
+  return parent;
+}
+
+/**
+ * @brief Finds the in-order successor of a node.
+ *
+ * @param[in] node The node to start from.
+ * @return Node* - the successor, or nullptr for the greatest node.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::successor(const Node *node) noexcept
+    -> Node * {
+  if (node->right) {
+    return findMin(node->right);
+  }
+
+  Node *parent = node->parent;
+
+  while (parent && node == parent->right) {
+    node = parent;
+    parent = parent->parent;
+  }
+
+  return parent;
+}
+
+/**
+ * @brief Finds the node with the minimum key in the tree.
+ *
+ * @param[in] node The node from which to start searching for the minimum key.
+ * @return Node* - the node with the minimum key.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::findMin(Node *node) noexcept -> Node * {
+  while (node && node->left) {
+    node = node->left;
+  }
+
+  return node;
+}
+
+/**
+ * @brief Looks up the keys in groups of kBatch interleaved descents.
+ *
+ * @details
+ * Every descent of a group makes the same comparisons as findNode(), but the
+ * group steps one level at a time: each lane moves to its next node and
+ * prefetches it, and that node is only read after the other lanes have
+ * taken their step. The found nodes are passed to visit in the order of the
+ * keys.
+ *
+ * @tparam ForwardIt The iterator type of the keys.
+ * @tparam Visit The callable taking the found node, or nullptr.
+ * @param[in] first The first key to search for.
+ * @param[in] last The end of the keys.
+ * @param[in] visit The callable receiving the result for every key.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename ForwardIt, typename Visit>
+void tree<K, M, Compare, Allocator>::findBatch(ForwardIt first, ForwardIt last,
+                                               Visit visit) const {
+  ForwardIt keys[kBatch];
+  Node *nodes[kBatch];
+  Node *bounds[kBatch];
+
+  while (first != last) {
+    size_type count{};
+
+    for (; count < kBatch && first != last; ++count, ++first) {
+      keys[count] = first;
+      nodes[count] = root_;
+      bounds[count] = nullptr;
+    }
+
+    for (bool active = root_; active;) {
+      active = false;
+
+      for (size_type i = 0; i < count; ++i) {
+        Node *node = nodes[i];
+
+        if (!node) {
+          continue;
+        }
+
+        if (comp_(node->key(), *keys[i])) {
+          node = node->right;
+        } else {
+          bounds[i] = node;
+          node = node->left;
+        }
+
+        if (node) {
+          prefetch(node);
+          active = true;
+        }
+
+        nodes[i] = node;
+      }
+    }
+
+    for (size_type i = 0; i < count; ++i) {
+      Node *bound = bounds[i];
+
+      visit((bound && !comp_(*keys[i], bound->key())) ? bound : nullptr);
+    }
   }
+}
+
+/**
+ * @brief Hints the processor to start loading a node into the cache.
+ *
+ * @param[in] node The node that is about to be read.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::prefetch(const Node *node) noexcept {
+#if defined(__GNUC__)
+  __builtin_prefetch(node);
+#else
+  static_cast<void>(node);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                              ORDER STATISTICS                              //
+////////////////////////////////////////////////////////////////////////////////
 
-  if (node->pair->first > key) {
-    return findNode(node->left, key);
-  } else if (node->pair->first < key) {
-    return findNode(node->right, key);
+/**
+ * @brief Returns the number of nodes in the subtree of the given node.
+ *
+ * @param[in] node The root of the subtree, may be nullptr.
+ * @return size_type - the size of the subtree.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::subtreeSize(const Node *node) noexcept
+    -> size_type {
+  return (node) ? node->size : 0;
+}
+
+/**
+ * @brief Returns the position of the node in the in-order sequence.
+ *
+ * @details
+ * The walk goes from the node up to the root and adds the left subtree and
+ * the parent for every step made from a right son.
+ *
+ * @param[in] node The node of the tree.
+ * @return size_type - the zero-based index of the node.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::rankOf(const Node *node) noexcept
+    -> size_type {
+  size_type index = subtreeSize(node->left);
+
+  for (; node->parent; node = node->parent) {
+    if (node == node->parent->right) {
+      index += subtreeSize(node->parent->left) + 1;
+    }
+  }
+
+  return index;
+}
+
+/**
+ * @brief Finds the node at the given position of the subtree.
+ *
+ * @param[in] node The root of the subtree.
+ * @param[in] index The zero-based position, less than the subtree size.
+ * @return Node* - the found node, or nullptr if index is out of range.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::selectNode(Node *node,
+                                                size_type index) noexcept
+    -> Node * {
+  while (node) {
+    size_type left = subtreeSize(node->left);
+
+    if (index < left) {
+      node = node->left;
+    } else if (index > left) {
+      index -= left + 1;
+      node = node->right;
+    } else {
+      break;
+    }
+  }
+
+  return node;
+}
+
+/**
+ * @brief Decrements the subtree sizes on the path from the node to the root.
+ *
+ * @details
+ * Called when a leaf below the node is unlinked from the tree.
+ *
+ * @param[in] node The parent of the unlinked node, may be nullptr.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::shrinkPath(Node *node) noexcept {
+  for (; node; node = node->parent) {
+    --node->size;
+  }
+}
+
+/**
+ * @brief Checks whether the node is an element of this tree.
+ *
+ * @param[in] node The node to check, may be nullptr or the sentinel.
+ * @return true if the node is reachable from root_, false otherwise.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+bool tree<K, M, Compare, Allocator>::ownsNode(const Node *node) const noexcept {
+  if (!node || node == sentinel_) {
+    return false;
+  }
+
+  while (node->parent) {
+    node = node->parent;
+  }
+
+  return node == root_;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                               SPLIT AND JOIN                               //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Returns the number of black nodes on a path from the node down to a
+ * leaf.
+ *
+ * @param[in] node The root of a valid red-black subtree, may be nullptr.
+ * @return size_type - the black height of the subtree.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::blackHeight(const Node *node) noexcept
+    -> size_type {
+  size_type height{};
+
+  for (; node; node = node->left) {
+    if (node->color == kBLACK) {
+      ++height;
+    }
+  }
+
+  return height;
+}
+
+/**
+ * @brief Detaches the sons of a subtree root.
+ *
+ * @details
+ * Both sons of a red-black node have the same black height, which is that
+ * of the node less one if the node is black.
+ *
+ * @param[in] sub The subtree, it must not be empty.
+ * @return std::pair<Subtree, Subtree> - the left and the right subtree.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::detachSons(const Subtree &sub) noexcept
+    -> std::pair<Subtree, Subtree> {
+  Node *node = sub.root;
+  size_type height = sub.height - (node->color == kBLACK);
+
+  for (Node *son : {node->left, node->right}) {
+    if (son) {
+      son->parent = nullptr;
+    }
+  }
+
+  return {Subtree{node->left, height}, Subtree{node->right, height}};
+}
+
+/**
+ * @brief Joins two detached subtrees and a pivot node into one tree.
+ *
+ * @details
+ * All keys of left must precede the pivot and all keys of right must follow
+ * it. The roots of both subtrees are painted black, then the pivot is linked
+ * as a red node into the spine of the higher subtree, at the first black node
+ * whose black height equals that of the lower one, and the red-red conflict
+ * is fixed as after an insertion. The black heights come with the subtrees,
+ * so the cost is O(|h(left) - h(right)| + 1).
+ *
+ * The joined tree becomes root_; the element count size_ is left to the
+ * caller.
+ *
+ * @param[in] left The lower subtree, may be empty.
+ * @param[in] pivot The node placed between the subtrees.
+ * @param[in] right The upper subtree, may be empty.
+ * @return Subtree - the joined tree.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::join(Subtree left, Node *pivot,
+                                          Subtree right) noexcept -> Subtree {
+  for (Subtree *sub : {&left, &right}) {
+    if (sub->root) {
+      sub->root->parent = nullptr;
+
+      if (sub->root->color == kRED) {
+        sub->root->color = kBLACK;
+        ++sub->height;
+      }
+    }
+  }
+
+  bool into_left = left.height > right.height;
+  size_type height = std::max(left.height, right.height);
+  Node *parent{};
+  Node *node{};
+
+  if (left.height == right.height) {
+    pivot->left = left.root;
+    pivot->right = right.root;
   } else {
-    return node;
+    Node *lower = (into_left) ? right.root : left.root;
+    size_type target = std::min(left.height, right.height);
+    size_type level = height;
+
+    node = (into_left) ? left.root : right.root;
+
+    while (node && (node->color == kRED || level > target)) {
+      if (node->color == kBLACK) {
+        --level;
+      }
+
+      node->size += subtreeSize(lower) + 1;
+      parent = node;
+      node = (into_left) ? node->right : node->left;
+    }
+
+    pivot->left = (into_left) ? node : left.root;
+    pivot->right = (into_left) ? right.root : node;
+    ((into_left) ? parent->right : parent->left) = pivot;
+    root_ = (into_left) ? left.root : right.root;
+  }
+
+  pivot->parent = parent;
+  pivot->color = kRED;
+  pivot->size = 1 + subtreeSize(pivot->left) + subtreeSize(pivot->right);
+
+  for (Node *child : {pivot->left, pivot->right}) {
+    if (child) {
+      child->parent = pivot;
+    }
+  }
+
+  if (!parent) {
+    root_ = pivot;
+  } else if (parent->color == kRED) {
+    balancingTree(pivot);
+  }
+
+  if (root_->color == kRED) {
+    root_->color = kBLACK;
+    ++height;
+  }
+
+  rightmost_ = nullptr;
+
+  return {root_, height};
+}
+
+/**
+ * @brief Joins two detached subtrees into one tree.
+ *
+ * @details
+ * The smallest node of right is unlinked from it and used as the pivot of
+ * the three-way join, so the cost is O(log n).
+ *
+ * The joined tree becomes root_; the element count size_ is left to the
+ * caller.
+ *
+ * @param[in] left The lower subtree, may be empty.
+ * @param[in] right The upper subtree, may be empty.
+ * @return Subtree - the joined tree.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::join(Subtree left, Subtree right) noexcept
+    -> Subtree {
+  if (!left.root || !right.root) {
+    Subtree sub = (left.root) ? left : right;
+    root_ = sub.root;
+    rightmost_ = nullptr;
+
+    if (root_) {
+      root_->parent = nullptr;
+
+      if (root_->color == kRED) {
+        root_->color = kBLACK;
+        ++sub.height;
+      }
+    }
+
+    return sub;
+  }
+
+  Node *pivot = findMin(right.root);
+
+  right.root->parent = nullptr;
+  right.root->color = kBLACK;
+  root_ = right.root;
+  rightmost_ = nullptr;
+
+  if (pivot == right.root && !pivot->right) {
+    root_ = nullptr;
+  } else {
+    extractNode(pivot);
+  }
+
+  return join(left, pivot, Subtree{root_, blackHeight(root_)});
+}
+
+/**
+ * @brief Splits a detached subtree by position.
+ *
+ * @details
+ * The subtree is cut along the path to the node at the given position, and
+ * the pieces hanging off that path are joined back together on either side.
+ * The black heights of the pieces are known on the way down, so the joins
+ * along the path cost O(log n) in total. root_ is used as scratch space and
+ * size_ is not changed.
+ *
+ * @param[in] sub The subtree, may be empty.
+ * @param[in] index The number of the smallest nodes that go to the first
+ * part.
+ * @return std::pair<Subtree, Subtree> - the two parts.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::split(const Subtree &sub,
+                                           size_type index) noexcept
+    -> std::pair<Subtree, Subtree> {
+  if (!sub.root) {
+    return {};
+  }
+
+  auto [left, right] = detachSons(sub);
+
+  if (index <= subtreeSize(left.root)) {
+    auto [low, high] = split(left, index);
+    return {low, join(high, sub.root, right)};
+  }
+
+  auto [low, high] = split(right, index - subtreeSize(left.root) - 1);
+
+  return {join(left, sub.root, low), high};
+}
+
+/**
+ * @brief Splits a detached subtree by key.
+ *
+ * @details
+ * Works like split(), but the path is chosen by comparing with the key.
+ * Nodes with keys less than the key go to the first part and nodes with
+ * greater keys to the second. Equivalent nodes go to the first part in a
+ * tree of non-unique elements, so elements merged later follow them. In a
+ * tree of unique elements the equivalent node is cut out and returned
+ * through match.
+ *
+ * @param[in] sub The subtree, may be empty.
+ * @param[in] key The key to split by.
+ * @param[out] match The node equivalent to the key in a unique tree, left
+ * unchanged if there is none.
+ * @return std::pair<Subtree, Subtree> - the two parts.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::splitKey(const Subtree &sub,
+                                              const key_type &key,
+                                              Node *&match) noexcept
+    -> std::pair<Subtree, Subtree> {
+  if (!sub.root) {
+    return {};
+  }
+
+  Node *node = sub.root;
+  auto [left, right] = detachSons(sub);
+
+  if (comp_(key, node->key())) {
+    auto [low, high] = splitKey(left, key, match);
+    return {low, join(high, node, right)};
+  }
+
+  if (type_ == kUNIQUE && !comp_(node->key(), key)) {
+    match = node;
+    return {left, right};
+  }
+
+  auto [low, high] = splitKey(right, key, match);
+
+  return {join(left, node, low), high};
+}
+
+/**
+ * @brief Unites two detached subtrees.
+ *
+ * @details
+ * The target is split by the key of the source root, the halves are united
+ * with the subtrees of the source recursively and joined back around the
+ * source root. Every level of the source costs a split and a join of the
+ * target pieces, which adds up to O(m log(n / m + 1)) for a source of m and
+ * a target of n nodes. No node is copied.
+ *
+ * In a tree of unique elements a source node whose key is already in the
+ * target is not moved; such nodes are joined into the second returned tree
+ * in their original order. root_ is used as scratch space and size_ is not
+ * changed.
+ *
+ * @param[in] target The subtree receiving the nodes.
+ * @param[in] source The subtree whose nodes are moved.
+ * @return std::pair<Subtree, Subtree> - the united tree and the rejected
+ * nodes.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::unite(const Subtree &target,
+                                           const Subtree &source) noexcept
+    -> std::pair<Subtree, Subtree> {
+  if (!source.root || !target.root) {
+    return {(target.root) ? target : source, Subtree{}};
+  }
+
+  Node *match{};
+  auto [left, right] = detachSons(source);
+  auto [low, high] = splitKey(target, source.root->key(), match);
+  auto [merged_low, rejected_low] = unite(low, left);
+  auto [merged_high, rejected_high] = unite(high, right);
+
+  if (match) {
+    Subtree merged = join(merged_low, match, merged_high);
+    return {merged, join(rejected_low, source.root, rejected_high)};
   }
+
+  Subtree merged = join(merged_low, source.root, merged_high);
+
+  return {merged, join(rejected_low, rejected_high)};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                 SET ALGEBRA                                //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Combines rank ranges of two trees by a set operation.
+ *
+ * @details
+ * While forks is not zero and the ranges hold at least 2 * kForkGrain nodes,
+ * the median key of the longer range splits both ranges at its lower bound,
+ * so a run of equivalent keys is never cut. The lower halves are combined on
+ * another thread and the upper ones on the current thread, and the two lists
+ * are concatenated. Smaller ranges are merged by mergeRanges().
+ *
+ * If a copy throws, every node copied so far is freed.
+ *
+ * @param[in] first The first operand.
+ * @param[in] second The second operand.
+ * @param[in] first_ranks The range [begin, end) of ranks in first.
+ * @param[in] second_ranks The range [begin, end) of ranks in second.
+ * @param[in] op The set operation.
+ * @param[in] forks The number of threads that may still be started.
+ * @return NodeList - the copies of the selected elements in order.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::combineRanges(const tree &first,
+                                                   const tree &second,
+                                                   Ranks first_ranks,
+                                                   Ranks second_ranks,
+                                                   SetOperation op,
+                                                   size_type forks)
+    -> NodeList {
+  auto [first_begin, first_end] = first_ranks;
+  auto [second_begin, second_end] = second_ranks;
+  size_type first_count = first_end - first_begin;
+  size_type second_count = second_end - second_begin;
+
+  if (!forks || first_count + second_count < 2 * kForkGrain) {
+    return mergeRanges(first, second, first_ranks, second_ranks, op);
+  }
+
+  const tree &longer = (first_count < second_count) ? second : first;
+  const Ranks &longer_ranks =
+      (first_count < second_count) ? second_ranks : first_ranks;
+  size_type median = longer_ranks.first +
+                     (longer_ranks.second - longer_ranks.first) / 2;
+  const key_type &key = selectNode(longer.root_, median)->key();
+  size_type first_split = first.boundRank(key);
+  size_type second_split = second.boundRank(key);
+  size_type low_forks = (forks - 1) / 2;
+  NodeList low, high;
+
+  try {
+    forkJoin(
+        true,
+        [&](tree &workspace) {
+          low = workspace.combineRanges(first, second,
+                                        {first_begin, first_split},
+                                        {second_begin, second_split}, op,
+                                        low_forks);
+        },
+        [&](tree &workspace) {
+          high = workspace.combineRanges(
+              first, second, {first_split, first_end},
+              {second_split, second_end}, op, forks - 1 - low_forks);
+        });
+  } catch (...) {
+    deleteList(low);
+    deleteList(high);
+    throw;
+  }
+
+  if (!low.head) {
+    return high;
+  }
+
+  low.tail->right = high.head;
+  low.tail = (high.tail) ? high.tail : low.tail;
+  low.count += high.count;
+
+  return low;
+}
+
+/**
+ * @brief Merges rank ranges of two trees by a set operation.
+ *
+ * @details
+ * Both ranges are walked once in order, as by the std set algorithms, and
+ * the selected elements are copied into a list of new nodes:
+ * - the union takes every element of first, and the elements of second that
+ *   are not matched by an equivalent element of first;
+ * - the intersection takes the elements of first matched by second;
+ * - the difference takes the elements of first not matched by second.
+ * Each element of second matches at most one element of first, so for
+ * multisets the union keeps max(m, n), the intersection min(m, n) and the
+ * difference max(m - n, 0) of m and n equivalent elements. The walk costs
+ * O(n + m) comparisons and allocates only the nodes of the result.
+ *
+ * @param[in] first The first operand.
+ * @param[in] second The second operand.
+ * @param[in] first_ranks The range [begin, end) of ranks in first.
+ * @param[in] second_ranks The range [begin, end) of ranks in second.
+ * @param[in] op The set operation.
+ * @return NodeList - the copies of the selected elements in order.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::mergeRanges(const tree &first,
+                                                 const tree &second,
+                                                 Ranks first_ranks,
+                                                 Ranks second_ranks,
+                                                 SetOperation op)
+    -> NodeList {
+  size_type first_left = first_ranks.second - first_ranks.first;
+  size_type second_left = second_ranks.second - second_ranks.first;
+  const Node *first_node = selectNode(first.root_, first_ranks.first);
+  const Node *second_node = selectNode(second.root_, second_ranks.first);
+  NodeList list;
+
+  auto take = [&](const Node *node) {
+    Node *copy = newNode(node->value);
+
+    if (list.tail) {
+      list.tail->right = copy;
+    } else {
+      list.head = copy;
+    }
+
+    list.tail = copy;
+    ++list.count;
+  };
+
+  try {
+    while (first_left && second_left) {
+      if (comp_(first_node->key(), second_node->key())) {
+        if (op != kINTERSECTION) {
+          take(first_node);
+        }
+
+        first_node = successor(first_node);
+        --first_left;
+      } else if (comp_(second_node->key(), first_node->key())) {
+        if (op == kUNION) {
+          take(second_node);
+        }
+
+        second_node = successor(second_node);
+        --second_left;
+      } else {
+        if (op != kDIFFERENCE) {
+          take(first_node);
+        }
+
+        first_node = successor(first_node);
+        second_node = successor(second_node);
+        --first_left;
+        --second_left;
+      }
+    }
+
+    for (; first_left && op != kINTERSECTION; --first_left) {
+      take(first_node);
+      first_node = successor(first_node);
+    }
+
+    for (; second_left && op == kUNION; --second_left) {
+      take(second_node);
+      second_node = successor(second_node);
+    }
+  } catch (...) {
+    deleteList(list);
+    throw;
+  }
+
+  return list;
+}
+
+/**
+ * @brief Finds the rank of the lower bound of a key.
+ *
+ * @param[in] key The key to search for.
+ * @return size_type - the rank of the first node not less than key, or the
+ * size of the tree if there is none.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::boundRank(const key_type &key) const
+    noexcept -> size_type {
+  Node *bound = lowerBound(key);
+
+  return (bound) ? rankOf(bound) : size_;
 }
 
 /**
- * @brief Finds the node with the maximum key in the tree.
+ * @brief Deletes the nodes of a list and leaves it empty.
  *
- * @param[in] node The root node of the tree.
- * @return Node* - the node with the maximum key.
+ * @param[in,out] list The list of nodes chained through their right pointers.
  */
-template <typename K, typename M>
-auto tree<K, M>::findMax(Node *node) noexcept -> Node * {
-  while (node && node->right) {
-    node = node->right;
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::deleteList(NodeList &list) noexcept {
+  while (list.head) {
+    deleteNode(std::exchange(list.head, list.head->right));
   }
 
-  return node;
+  list = NodeList{};
 }
 
 /**
- * @brief Finds the node with the minimum key in the tree.
+ * @brief Runs two tasks, the first of them on another thread if allowed.
  *
- * @param[in] node The node from which to start searching for the minimum key.
- * @return Node* - the node with the minimum key.
+ * @details
+ * Each task is called with the tree whose comparator and allocator it
+ * uses: the current tree, or a workspace copy of them for the task on the
+ * other thread. If no thread can be started,
+ * both tasks run in order on the current thread. An exception thrown by the
+ * first task is rethrown after both tasks have finished.
+ *
+ * @tparam First The type of the first task.
+ * @tparam Second The type of the second task.
+ * @param[in] parallel Whether the first task may run on another thread.
+ * @param[in] first The first task.
+ * @param[in] second The second task.
  */
-template <typename K, typename M>
-auto tree<K, M>::findMin(Node *node) noexcept -> Node * {
-  while (node && node->left) {
-    node = node->left;
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename First, typename Second>
+void tree<K, M, Compare, Allocator>::forkJoin(bool parallel, First &&first,
+                                              Second &&second) {
+  std::exception_ptr error;
+  std::thread thread;
+
+  if (parallel) {
+    try {
+      thread = std::thread{[&] {
+        try {
+          tree workspace{comp_, get_allocator(), type_};
+
+          first(workspace);
+        } catch (...) {
+          error = std::current_exception();
+        }
+      }};
+    } catch (const std::system_error &) {
+      parallel = false;
+    }
   }
 
-  return node;
+  if (!parallel) {
+    first(*this);
+  }
+
+  try {
+    second(*this);
+  } catch (...) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+
+    throw;
+  }
+
+  if (thread.joinable()) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1173,265 +3455,163 @@ auto tree<K, M>::findMin(Node *node) noexcept -> Node * {
  *
  * @details
  * This method handles the deletion of a node that has two children. It finds
- * the in-order successor or predecessor of the node to be deleted, swaps the
- * values, and then deletes the successor or predecessor node. The method
- * handles different cases based on the color of the node and the number of its
- * children.
+ * the in-order predecessor or successor of the node to be deleted, swaps the
+ * positions of the two nodes in the tree, and then unlinks the node from its
+ * new position, which has at most one child. The values are never copied, so
+ * iterators to other elements stay valid and the removed node is the one that
+ * was requested.
  *
  * @param[in,out] node The node to delete. It must have two children.
- * @return Node* - a pointer to the node that was actually deleted.
+ * @return Node* - a pointer to the unlinked node.
  */
-template <typename K, typename M>
-auto tree<K, M>::deleteTwoChild(Node *&node) noexcept -> Node * {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::deleteTwoChild(Node *&node) noexcept
+    -> Node * {
   Node *swap = findMax(node->left);
-  Node *to_del{swap};
 
   if (!(swap && !(swap->left && swap->right))) {
     swap = findMin(node->right);
   }
 
-  value_type swap_copy{*swap->pair};
-
-  delete swap->pair;
-  swap->pair = new value_type{*node->pair};
-  delete node->pair;
-  node->pair = new value_type{swap_copy};
+  swapNodes(node, swap);
 
-  if (!swap->left && !swap->right) {
-    if (swap->color == kRED) {
-      removeConnect(swap);
+  if (!node->left && !node->right) {
+    if (node->color == kRED) {
+      removeConnect(node);
     } else {
-      deleteBlackNoChild(swap);
+      deleteBlackNoChild(node);
     }
-  } else if (!swap->left && swap->right) {
-    to_del = deleteOneChild(swap, swap->right);
-  } else if (swap->left && !swap->right) {
-    to_del = deleteOneChild(swap, swap->left);
+  } else if (!node->left && node->right) {
+    deleteOneChild(node, node->right);
+  } else if (node->left && !node->right) {
+    deleteOneChild(node, node->left);
   }
 
-  return to_del;
+  return node;
 }
 
 /**
  * @brief Deletes a node with one child from the red-black tree.
  *
  * @details
- * This method handles the deletion of a node that has exactly one child. It
- * swaps the values of the node to be deleted with its child, and then removes
- * the child node. This ensures that the tree properties are maintained.
+ * This method handles the deletion of a black node that has exactly one (red)
+ * child. The child is moved up into the position of the node and takes over
+ * its color, which keeps the black height of the path unchanged.
  *
  * @param[in,out] node The node to delete. It must have exactly one child.
  * @param[in,out] child The child of the node to delete.
- * @return Node* - a pointer to the node that was actually deleted.
- */
-template <typename K, typename M>
-auto tree<K, M>::deleteOneChild(Node *&node, Node *&child) noexcept -> Node * {
-  Node *ch = child;
-
-  value_type node_copy{*node->pair};
-
-  delete node->pair;
-  node->pair = new value_type{*child->pair};
-  delete child->pair;
-  child->pair = new value_type{node_copy};
-
-  child = nullptr;
-
-  return ch;
-}
-
-/**
- * @brief Deletes a black node with no children.
- *
- * @param[in,out] node The node to delete.
+ * @return Node* - a pointer to the unlinked node.
  */
-template <typename K, typename M>
-void tree<K, M>::deleteBlackNoChild(Node *&node) noexcept {
-  if (!node->parent) {
-    return;
-  }
-
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::deleteOneChild(Node *node,
+                                                    Node *child) noexcept
+    -> Node * {
   Node *parent = node->parent;
-  Node *brother = (parent->left == node) ? parent->right : parent->left;
-  bool is_left = (parent->left == node) ? true : false;
 
-  if (brother && parent->color == kRED && brother->color == kBLACK) {
-    if (!brother->left && !brother->right) {
-      std::swap(brother->color, parent->color);
-      removeConnect(node);
-    } else if ((is_left && brother->right && brother->right->color == kRED) ||
-               (!is_left && brother->left && brother->left->color == kRED)) {
-      redParBlackSonRedLeft(node);
-    } else if ((is_left && brother->left && brother->left->color == kRED) ||
-               (!is_left && brother->right && brother->right->color == kRED)) {
-      redParBlackSonRedRight(node);
-    }
-  } else if (brother && parent->color == kBLACK && brother->color == kBLACK) {
-    if (!brother->left && !brother->right) {
-      blackParBlackBrosBlackAll(node);
-    } else if ((is_left && !brother->right && brother->left) ||
-               (!is_left && !brother->left && brother->right)) {
-      blackParBlackBrosRedRightGran(node);
-    } else {
-      blackParBlackBrosRedLeftOrAllGran(node);
-    }
-  } else if (brother && node->parent->color == kBLACK &&
-             brother->color == kRED) {
-    if ((is_left && brother->left && brother->left->color == kBLACK) ||
-        (!is_left && brother->right && brother->right->color == kBLACK)) {
-      Node *grgrson = (is_left) ? brother->left->right : brother->right->left;
-      if (grgrson && grgrson->color == kRED) {
-        blackParRedBrosBlackRightRedLeft(node);
-      } else {
-        blackParRedSonBlackRight(node);
-      }
-    }
+  if (!parent) {
+    root_ = child;
+  } else if (parent->left == node) {
+    parent->left = child;
+  } else {
+    parent->right = child;
   }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//                     kBLACK NO CHILD NODE REMOVAL CASES //
-////////////////////////////////////////////////////////////////////////////////
-
-/**
- * @brief Handles the case where the node to delete has a red parent and a black
- * brother with a red left child.
- *
- * @param[in,out] node The node to delete.
- */
-template <typename K, typename M>
-void tree<K, M>::redParBlackSonRedLeft(Node *&node) noexcept {
-  Node *parent = node->parent;
-  Node *brother = (parent->left == node) ? parent->right : parent->left;
-  bool is_left = (parent->left == node) ? true : false;
-
-  removeConnect(node);
-  (is_left) ? rotateLeft(brother->parent) : rotateRight(brother->parent);
-  swapColors(brother);
-}
 
-/**
- * @brief Handles the case where the node to delete has a red parent and a black
- * brother with a red right child.
- *
- * @param[in,out] node The node to delete.
- */
-template <typename K, typename M>
-void tree<K, M>::redParBlackSonRedRight(Node *&node) noexcept {
-  Node *parent = node->parent;
-  Node *brother = (parent->left == node) ? parent->right : parent->left;
-  bool is_left = (parent->left == node) ? true : false;
+  child->parent = parent;
+  child->color = node->color;
+  node->parent = node->left = node->right = nullptr;
+  shrinkPath(parent);
 
-  removeConnect(node);
-  (is_left) ? rotateRight(brother) : rotateLeft(brother);
-  std::swap(brother->color, brother->parent->color);
-  (is_left) ? rotateLeft(parent) : rotateRight(parent);
-  swapColors(parent->parent);
+  return node;
 }
 
 /**
- * @brief Handles the case where the node to delete has a black parent and a red
- * brother with a black right child.
+ * @brief Exchanges the positions of two nodes in the tree.
  *
- * @param[in,out] node The node to delete.
- */
-template <typename K, typename M>
-void tree<K, M>::blackParRedSonBlackRight(Node *&node) noexcept {
-  Node *parent = node->parent;
-  bool is_left = (parent->left == node) ? true : false;
-  Node *brother = (parent->left == node) ? parent->right : parent->left;
-  Node *grandson = (is_left) ? brother->left : brother->right;
-
-  std::swap(brother->color, grandson->color);
-  removeConnect(node);
-  (is_left) ? rotateLeft(parent) : rotateRight(parent);
-}
-
-/**
- * @brief Handles the case where the node to delete has a black parent and a red
- * brother with a black right child and a red left child.
+ * @details
+ * All links of the two nodes (parent, children and the root pointer) are
+ * rewired, including the case where one node is a direct child of the other.
+ * Colors and subtree sizes belong to the positions in the tree, so they are
+ * exchanged as well.
+ * The stored values stay in their nodes.
  *
- * @param[in,out] node The node to delete.
+ * @param[in,out] first The first node.
+ * @param[in,out] second The second node.
  */
-template <typename K, typename M>
-void tree<K, M>::blackParRedBrosBlackRightRedLeft(Node *&node) noexcept {
-  Node *parent = node->parent;
-  Node *brother = (parent->left == node) ? parent->right : parent->left;
-
-  removeConnect(node);
-  rotateLeft(brother->parent);
-  std::swap(brother->color, parent->color);
-  rotateLeft(parent);
-  swapColors(parent->parent);
-}
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::swapNodes(Node *first,
+                                               Node *second) noexcept {
+  if (first->parent == second) {
+    std::swap(first, second);
+  }
 
-/**
- * @brief Handles the case where the node to delete has a black parent and a
- * black brother with no children.
- *
- * @param[in,out] node The node to delete.
- */
-template <typename K, typename M>
-void tree<K, M>::blackParBlackBrosBlackAll(Node *&node) noexcept {
-  Node *parent = node->parent;
-  Node *brother = (parent->left == node) ? parent->right : parent->left;
+  Node *first_parent = first->parent;
+  Node *first_left = first->left;
+  Node *first_right = first->right;
+  Node *second_parent = second->parent;
+  Node *second_left = second->left;
+  Node *second_right = second->right;
+
+  Node **first_link = (!first_parent) ? &root_
+                      : (first_parent->left == first) ? &first_parent->left
+                                                      : &first_parent->right;
+  Node **second_link = (!second_parent) ? &root_
+                       : (second_parent->left == second)
+                           ? &second_parent->left
+                           : &second_parent->right;
+
+  if (second_parent == first) {
+    *first_link = second;
+    second->parent = first_parent;
+    second->left = (first_left == second) ? first : first_left;
+    second->right = (first_right == second) ? first : first_right;
+    first->parent = second;
+  } else {
+    *first_link = second;
+    *second_link = first;
+    second->parent = first_parent;
+    second->left = first_left;
+    second->right = first_right;
+    first->parent = second_parent;
+  }
 
-  brother->color = kRED;
-  removeConnect(node);
+  first->left = second_left;
+  first->right = second_right;
 
-  if (parent->color == kBLACK) {
-    fixDoubleBlack(parent);
-  } else {
-    parent->color = kBLACK;
+  for (Node *child : {first->left, first->right}) {
+    if (child) {
+      child->parent = first;
+    }
   }
-}
 
-/**
- * @brief Handles the case where the node to delete has a black parent and a
- * black brother with a red right grandchild.
- *
- * @param[in,out] node The node to delete.
- */
-template <typename K, typename M>
-void tree<K, M>::blackParBlackBrosRedRightGran(Node *&node) noexcept {
-  Node *parent = node->parent;
-  Node *brother = (parent->left == node) ? parent->right : parent->left;
-  bool is_left = (parent->left == node) ? true : false;
+  for (Node *child : {second->left, second->right}) {
+    if (child && child != first) {
+      child->parent = second;
+    }
+  }
 
-  removeConnect(node);
-  (is_left) ? rotateRight(brother) : rotateLeft(brother);
-  std::swap(brother->color, brother->parent->color);
-  (is_left) ? rotateLeft(parent) : rotateRight(parent);
-  brother->color = kBLACK;
+  std::swap(first->color, second->color);
+  std::swap(first->size, second->size);
 }
 
 /**
- * @brief Handles the case where the node to delete has a black parent and a
- * black brother with a red left child or all grandchildren.
+ * @brief Deletes a black node with no children.
+ *
+ * @details
+ * Removing the node would shorten the black height of its path, so the node
+ * is first treated as carrying an extra black and fixDoubleBlack() restores
+ * the balance while the node is still in place. The node stays a leaf during
+ * the fix-up and is unlinked afterwards.
  *
  * @param[in,out] node The node to delete.
  */
-template <typename K, typename M>
-void tree<K, M>::blackParBlackBrosRedLeftOrAllGran(Node *&node) noexcept {
-  Node *parent = node->parent;
-  bool is_left = (parent->left == node) ? true : false;
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::deleteBlackNoChild(Node *&node) noexcept {
+  if (!node->parent) {
+    return;
+  }
 
+  fixDoubleBlack(node);
   removeConnect(node);
-  if (is_left) {
-    rotateLeft(parent);
-    if (parent->parent && parent->parent->right) {
-      parent->parent->right->color = kBLACK;
-    } else if (root_ == parent) {
-      root_->right->color = kBLACK;
-    }
-  } else {
-    rotateRight(parent);
-    if (parent->parent && parent->parent->left) {
-      parent->parent->left->color = kBLACK;
-    } else if (root_ == parent) {
-      root_->left->color = kBLACK;
-    }
-  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1446,9 +3626,9 @@ void tree<K, M>::blackParBlackBrosRedLeftOrAllGran(Node *&node) noexcept {
  * @param[in] last Whether the node is the last child of its parent.
  * @return std::string - a string representation of the tree structure.
  */
-template <typename K, typename M>
-std::string tree<K, M>::printNodes(const Node *node, int indent,
-                                   bool last) const noexcept {
+template <typename K, typename M, typename Compare, typename Allocator>
+std::string tree<K, M, Compare, Allocator>::printNodes(
+    const Node *node, int indent, bool last) const noexcept {
   std::string str{};
 
   if (node) {
@@ -1463,7 +3643,7 @@ std::string tree<K, M>::printNodes(const Node *node, int indent,
     int reserve = 50;
     char *char_str = new char[reserve]{};
 
-    std::snprintf(char_str, reserve, "%d", node->pair->first);
+    std::snprintf(char_str, reserve, "%d", node->key());
     str += std::string(char_str);
     str += "}\n";
 
@@ -1489,9 +3669,9 @@ std::string tree<K, M>::printNodes(const Node *node, int indent,
  * @param[in] root The root node of the tree.
  * @param[in] sentinel The sentinel node of the tree.
  */
-template <typename K, typename M>
-tree<K, M>::iterator::TreeIterator(Node *node, Node *root,
-                                   Node *sentinel) noexcept
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::iterator::TreeIterator(Node *node, Node *root,
+                                                       Node *sentinel) noexcept
     : ptr_{node}, first_{root}, last_{sentinel} {}
 
 /**
@@ -1499,8 +3679,9 @@ tree<K, M>::iterator::TreeIterator(Node *node, Node *root,
  *
  * @param[in] other The iterator to copy from.
  */
-template <typename K, typename M>
-tree<K, M>::iterator::TreeIterator(const iterator &other) noexcept
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::iterator::TreeIterator(
+    const iterator &other) noexcept
     : ptr_{other.ptr_}, first_{other.first_}, last_{other.last_} {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1513,9 +3694,9 @@ tree<K, M>::iterator::TreeIterator(const iterator &other) noexcept
  * @param[in] other The iterator to assign from.
  * @return iterator& - reference to the assigned iterator.
  */
-template <typename K, typename M>
-auto tree<K, M>::iterator::operator=(const iterator &other) noexcept
-    -> iterator & {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::iterator::operator=(
+    const iterator &other) noexcept -> iterator & {
   ptr_ = other.ptr_;
   first_ = other.first_;
   last_ = other.last_;
@@ -1528,8 +3709,9 @@ auto tree<K, M>::iterator::operator=(const iterator &other) noexcept
  *
  * @return iterator& - reference to the decremented iterator.
  */
-template <typename K, typename M>
-auto tree<K, M>::iterator::operator--() noexcept -> iterator & {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::iterator::operator--() noexcept
+    -> iterator & {
   Node *max_node = findMax(first_);
 
   if (last_ == max_node) {
@@ -1559,8 +3741,9 @@ auto tree<K, M>::iterator::operator--() noexcept -> iterator & {
  *
  * @return iterator& - reference to the incremented iterator.
  */
-template <typename K, typename M>
-auto tree<K, M>::iterator::operator++() noexcept -> iterator & {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::iterator::operator++() noexcept
+    -> iterator & {
   Node *max_node = findMax(first_);
 
   if (ptr_ == max_node) {
@@ -1589,8 +3772,9 @@ auto tree<K, M>::iterator::operator++() noexcept -> iterator & {
  * @return An `iterator` representing the original position of the iterator
  * before the increment.
  */
-template <typename K, typename M>
-auto tree<K, M>::iterator::operator++(int) noexcept -> iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::iterator::operator++(int) noexcept
+    -> iterator {
   iterator copy{*this};
 
   ++*this;
@@ -1609,8 +3793,9 @@ auto tree<K, M>::iterator::operator++(int) noexcept -> iterator {
  * @return An `iterator` representing the original position of the iterator
  * before the decrement.
  */
-template <typename K, typename M>
-auto tree<K, M>::iterator::operator--(int) noexcept -> iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::iterator::operator--(int) noexcept
+    -> iterator {
   iterator copy{*this};
 
   --*this;
@@ -1624,14 +3809,12 @@ auto tree<K, M>::iterator::operator--(int) noexcept -> iterator {
  * @param[in] shift The number of positions to shift.
  * @return iterator - the shifted iterator.
  */
-template <typename K, typename M>
-auto tree<K, M>::iterator::operator+(size_type shift) const noexcept
-    -> iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::iterator::operator+(
+    size_type shift) const noexcept -> iterator {
   iterator copy{*this};
 
-  for (size_type i = 0; i < shift; i++) {
-    ++copy;
-  }
+  copy += shift;
 
   return copy;
 }
@@ -1642,14 +3825,12 @@ auto tree<K, M>::iterator::operator+(size_type shift) const noexcept
  * @param[in] shift The number of positions to shift.
  * @return iterator - the shifted iterator.
  */
-template <typename K, typename M>
-auto tree<K, M>::iterator::operator-(size_type shift) const noexcept
-    -> iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::iterator::operator-(
+    size_type shift) const noexcept -> iterator {
   iterator copy{*this};
 
-  for (size_type i = 0; i < shift; i++) {
-    --copy;
-  }
+  copy -= shift;
 
   return copy;
 }
@@ -1657,25 +3838,55 @@ auto tree<K, M>::iterator::operator-(size_type shift) const noexcept
 /**
  * @brief Advances the iterator by a specified number of positions.
  *
+ * @details
+ * The jump costs O(log n) whatever the shift: the position of the element is
+ * computed from the subtree sizes and the target is selected from the root.
+ * Shifting past the last element gives end().
+ *
  * @param[in] shift The number of positions to advance the iterator.
  */
-template <typename K, typename M>
-void tree<K, M>::iterator::operator+=(size_type shift) noexcept {
-  for (size_type i = 0; i < shift; i++) {
-    ++*this;
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::iterator::operator+=(
+    size_type shift) noexcept {
+  if (!shift || !ptr_ || last_ == findMax(first_)) {
+    return;
+  }
+
+  size_type index = rankOf(ptr_) + shift;
+
+  if (index < subtreeSize(first_)) {
+    ptr_ = selectNode(first_, index);
+  } else {
+    ptr_ = std::exchange(last_, findMax(first_));
   }
 }
 
 /**
  * @brief Moves the iterator back by a specified number of positions.
  *
+ * @details
+ * Like operator+=, the jump costs O(log n). Shifting before the first element
+ * stops at the first element.
+ *
  * @param[in] shift The number of positions to move the iterator backward.
  */
-template <typename K, typename M>
-void tree<K, M>::iterator::operator-=(size_type shift) noexcept {
-  for (size_type i = 0; i < shift; i++) {
-    --*this;
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::iterator::operator-=(
+    size_type shift) noexcept {
+  if (!shift || !ptr_) {
+    return;
+  }
+
+  Node *max_node = findMax(first_);
+  size_type index = subtreeSize(first_);
+
+  if (last_ == max_node) {
+    std::swap(ptr_, last_);
+  } else {
+    index = rankOf(ptr_);
   }
+
+  ptr_ = selectNode(first_, (shift < index) ? index - shift : 0);
 }
 
 /**
@@ -1684,8 +3895,9 @@ void tree<K, M>::iterator::operator-=(size_type shift) noexcept {
  * @param[in] other The iterator to compare with.
  * @return true if the iterators are equal, false otherwise.
  */
-template <typename K, typename M>
-bool tree<K, M>::iterator::operator==(iterator other) const noexcept {
+template <typename K, typename M, typename Compare, typename Allocator>
+bool tree<K, M, Compare, Allocator>::iterator::operator==(
+    iterator other) const noexcept {
   return (ptr_ == other.ptr_ && first_ == other.first_ && last_ == other.last_)
              ? true
              : false;
@@ -1697,8 +3909,9 @@ bool tree<K, M>::iterator::operator==(iterator other) const noexcept {
  * @param[in] other The iterator to compare with.
  * @return true if the iterators are not equal, false otherwise.
  */
-template <typename K, typename M>
-bool tree<K, M>::iterator::operator!=(iterator other) const noexcept {
+template <typename K, typename M, typename Compare, typename Allocator>
+bool tree<K, M, Compare, Allocator>::iterator::operator!=(
+    iterator other) const noexcept {
   return (ptr_ != other.ptr_ || first_ != other.first_ || last_ != other.last_)
              ? true
              : false;
@@ -1709,9 +3922,11 @@ bool tree<K, M>::iterator::operator!=(iterator other) const noexcept {
  *
  * @return value_type & - reference to pair in current node.
  */
-template <typename K, typename M>
-std::pair<const K, M &> tree<K, M>::iterator::operator*() noexcept {
-  return std::pair<const K, M &>{ptr_->pair->first, ptr_->pair->second};
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::iterator::operator*() noexcept
+    -> std::pair<const key_type, mapped_type &> {
+  return std::pair<const key_type, mapped_type &>{ptr_->key(),
+                                                  ptr_->mapped()};
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1725,9 +3940,9 @@ std::pair<const K, M &> tree<K, M>::iterator::operator*() noexcept {
  * @param[in] root The root node of the tree.
  * @param[in] sentinel The sentinel node of the tree.
  */
-template <typename K, typename M>
-tree<K, M>::const_iterator::TreeConstIterator(Node *node, Node *root,
-                                              Node *sentinel) noexcept
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::const_iterator::TreeConstIterator(
+    Node *node, Node *root, Node *sentinel) noexcept
     : ptr_{node}, first_{root}, last_{sentinel} {}
 
 /**
@@ -1735,8 +3950,8 @@ tree<K, M>::const_iterator::TreeConstIterator(Node *node, Node *root,
  *
  * @param[in] other The const_iterator to copy from.
  */
-template <typename K, typename M>
-tree<K, M>::const_iterator::TreeConstIterator(
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::const_iterator::TreeConstIterator(
     const const_iterator &other) noexcept
     : ptr_{other.ptr_}, first_{other.first_}, last_{other.last_} {}
 
@@ -1752,8 +3967,9 @@ tree<K, M>::const_iterator::TreeConstIterator(
  * @return iterator - A regular iterator initialized with the same position and
  * range as the constant iterator.
  */
-template <typename K, typename M>
-auto tree<K, M>::const_iterator::toIterator() const noexcept -> iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::const_iterator::toIterator() const noexcept
+    -> iterator {
   return iterator{ptr_, first_, last_};
 }
 
@@ -1767,9 +3983,9 @@ auto tree<K, M>::const_iterator::toIterator() const noexcept -> iterator {
  * @param[in] other The const_iterator to assign from.
  * @return const_iterator& - reference to the assigned const_iterator.
  */
-template <typename K, typename M>
-auto tree<K, M>::const_iterator::operator=(const const_iterator &other) noexcept
-    -> const_iterator & {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::const_iterator::operator=(
+    const const_iterator &other) noexcept -> const_iterator & {
   ptr_ = other.ptr_;
   first_ = other.first_;
   last_ = other.last_;
@@ -1782,8 +3998,9 @@ auto tree<K, M>::const_iterator::operator=(const const_iterator &other) noexcept
  *
  * @return const_iterator& - reference to the decremented const_iterator.
  */
-template <typename K, typename M>
-auto tree<K, M>::const_iterator::operator--() noexcept -> const_iterator & {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::const_iterator::operator--() noexcept
+    -> const_iterator & {
   Node *max_node = findMax(first_);
 
   if (last_ == max_node) {
@@ -1813,8 +4030,9 @@ auto tree<K, M>::const_iterator::operator--() noexcept -> const_iterator & {
  *
  * @return const_iterator& - reference to the incremented const_iterator.
  */
-template <typename K, typename M>
-auto tree<K, M>::const_iterator::operator++() noexcept -> const_iterator & {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::const_iterator::operator++() noexcept
+    -> const_iterator & {
   Node *max_node = findMax(first_);
 
   if (ptr_ == max_node) {
@@ -1843,8 +4061,9 @@ auto tree<K, M>::const_iterator::operator++() noexcept -> const_iterator & {
  * @return A `const_iterator` representing the original position of the
  * iterator before the increment.
  */
-template <typename K, typename M>
-auto tree<K, M>::const_iterator::operator++(int) noexcept -> const_iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::const_iterator::operator++(int) noexcept
+    -> const_iterator {
   const_iterator copy{*this};
 
   ++*this;
@@ -1852,8 +4071,9 @@ auto tree<K, M>::const_iterator::operator++(int) noexcept -> const_iterator {
   return copy;
 }
 
-template <typename K, typename M>
-auto tree<K, M>::const_iterator::operator--(int) noexcept -> const_iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::const_iterator::operator--(int) noexcept
+    -> const_iterator {
   const_iterator copy{*this};
 
   --*this;
@@ -1867,14 +4087,12 @@ auto tree<K, M>::const_iterator::operator--(int) noexcept -> const_iterator {
  * @return A `const_iterator` representing the original position of the
  * iterator before the decrement.
  */
-template <typename K, typename M>
-auto tree<K, M>::const_iterator::operator+(size_type shift) const noexcept
-    -> const_iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::const_iterator::operator+(
+    size_type shift) const noexcept -> const_iterator {
   const_iterator copy{*this};
 
-  for (size_type i = 0; i < shift; i++) {
-    ++copy;
-  }
+  copy += shift;
 
   return copy;
 }
@@ -1885,40 +4103,68 @@ auto tree<K, M>::const_iterator::operator+(size_type shift) const noexcept
  * @param[in] shift The number of positions to shift.
  * @return const_iterator - the shifted const_iterator.
  */
-template <typename K, typename M>
-auto tree<K, M>::const_iterator::operator-(size_type shift) const noexcept
-    -> const_iterator {
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::const_iterator::operator-(
+    size_type shift) const noexcept -> const_iterator {
   const_iterator copy{*this};
 
-  for (size_type i = 0; i < shift; i++) {
-    --copy;
-  }
+  copy -= shift;
 
   return copy;
 }
 
 /**
- * @brief Moves the const_iterator back by a specified number of positions.
+ * @brief Advances the const_iterator by a specified number of positions.
  *
- * @param[in] shift The number of positions to move the const_iterator backward.
+ * @details
+ * The jump costs O(log n) whatever the shift: the position of the element is
+ * computed from the subtree sizes and the target is selected from the root.
+ * Shifting past the last element gives cend().
+ *
+ * @param[in] shift The number of positions to advance the const_iterator.
  */
-template <typename K, typename M>
-void tree<K, M>::const_iterator::operator+=(size_type shift) noexcept {
-  for (size_type i = 0; i < shift; i++) {
-    ++*this;
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::const_iterator::operator+=(
+    size_type shift) noexcept {
+  if (!shift || !ptr_ || last_ == findMax(first_)) {
+    return;
+  }
+
+  size_type index = rankOf(ptr_) + shift;
+
+  if (index < subtreeSize(first_)) {
+    ptr_ = selectNode(first_, index);
+  } else {
+    ptr_ = std::exchange(last_, findMax(first_));
   }
 }
 
 /**
- * @brief Advances the const_iterator by a specified number of positions.
+ * @brief Moves the const_iterator back by a specified number of positions.
  *
- * @param[in] shift The number of positions to advance the const_iterator.
+ * @details
+ * Like operator+=, the jump costs O(log n). Shifting before the first element
+ * stops at the first element.
+ *
+ * @param[in] shift The number of positions to move the const_iterator backward.
  */
-template <typename K, typename M>
-void tree<K, M>::const_iterator::operator-=(size_type shift) noexcept {
-  for (size_type i = 0; i < shift; i++) {
-    --*this;
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::const_iterator::operator-=(
+    size_type shift) noexcept {
+  if (!shift || !ptr_) {
+    return;
+  }
+
+  Node *max_node = findMax(first_);
+  size_type index = subtreeSize(first_);
+
+  if (last_ == max_node) {
+    std::swap(ptr_, last_);
+  } else {
+    index = rankOf(ptr_);
   }
+
+  ptr_ = selectNode(first_, (shift < index) ? index - shift : 0);
 }
 
 /**
@@ -1927,8 +4173,8 @@ void tree<K, M>::const_iterator::operator-=(size_type shift) noexcept {
  * @param[in] other The const_iterator to compare with.
  * @return true if the const_iterators are equal, false otherwise.
  */
-template <typename K, typename M>
-bool tree<K, M>::const_iterator::operator==(
+template <typename K, typename M, typename Compare, typename Allocator>
+bool tree<K, M, Compare, Allocator>::const_iterator::operator==(
     const_iterator other) const noexcept {
   return (ptr_ == other.ptr_ && first_ == other.first_ && last_ == other.last_)
              ? true
@@ -1941,8 +4187,8 @@ bool tree<K, M>::const_iterator::operator==(
  * @param[in] other The const_iterator to compare with.
  * @return true if the const_iterators are not equal, false otherwise.
  */
-template <typename K, typename M>
-bool tree<K, M>::const_iterator::operator!=(
+template <typename K, typename M, typename Compare, typename Allocator>
+bool tree<K, M, Compare, Allocator>::const_iterator::operator!=(
     const_iterator other) const noexcept {
   return (ptr_ != other.ptr_ || first_ != other.first_ || last_ != other.last_)
              ? true
@@ -1954,10 +4200,174 @@ bool tree<K, M>::const_iterator::operator!=(
  *
  * @return value_type & - reference to pair in current node.
  */
-template <typename K, typename M>
-auto tree<K, M>::const_iterator::operator*() const noexcept
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::const_iterator::operator*() const noexcept
     -> const value_type {
-  return *ptr_->pair;
+  return value_type{ptr_->key(), ptr_->mapped()};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                              TREE NODE HANDLE                              //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Constructs a handle owning the given node.
+ *
+ * @param[in] node The extracted node.
+ * @param[in] alloc The allocator the node was taken from.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::NodeHandle::NodeHandle(
+    Node *node, const node_allocator &alloc) noexcept
+    : node_{node}, alloc_{alloc} {}
+
+/**
+ * @brief Move constructor for the node handle.
+ *
+ * @param[in,out] other The handle to take the node from, left empty.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::NodeHandle::NodeHandle(
+    NodeHandle &&other) noexcept
+    : node_{std::exchange(other.node_, nullptr)},
+      alloc_{std::move(other.alloc_)} {
+  other.alloc_.reset();
+}
+
+/**
+ * @brief Move assignment operator for the node handle.
+ *
+ * @details
+ * The node owned before the assignment, if any, is destroyed.
+ *
+ * @param[in,out] other The handle to take the node from, left empty.
+ * @return NodeHandle& - reference to the handle.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::NodeHandle::operator=(
+    NodeHandle &&other) noexcept -> NodeHandle & {
+  if (this != &other) {
+    reset();
+    node_ = std::exchange(other.node_, nullptr);
+    alloc_ = std::move(other.alloc_);
+    other.alloc_.reset();
+  }
+
+  return *this;
+}
+
+/**
+ * @brief Destructor, destroys and frees the owned node.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::NodeHandle::~NodeHandle() {
+  reset();
+}
+
+/**
+ * @brief Checks whether the handle owns no node.
+ *
+ * @return true if the handle is empty.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+bool tree<K, M, Compare, Allocator>::NodeHandle::empty() const noexcept {
+  return !node_;
+}
+
+/**
+ * @brief Checks whether the handle owns a node.
+ *
+ * @return true if the handle is not empty.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+tree<K, M, Compare, Allocator>::NodeHandle::operator bool() const noexcept {
+  return node_;
+}
+
+/**
+ * @brief Returns the allocator of the owned node.
+ *
+ * @return allocator_type - a copy of the allocator; the handle must not be
+ * empty.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::NodeHandle::get_allocator() const
+    -> allocator_type {
+  return allocator_type{*alloc_};
+}
+
+/**
+ * @brief Accesses the key of the owned node.
+ *
+ * @return key_type& - reference to the key; the handle must not be empty.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::NodeHandle::key() const noexcept
+    -> key_type & {
+  return node_->key();
+}
+
+/**
+ * @brief Accesses the value of the owned map node.
+ *
+ * @return mapped_type& - reference to the value; the handle must not be
+ * empty.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::NodeHandle::mapped() const noexcept
+    -> mapped_type & {
+  return node_->mapped();
+}
+
+/**
+ * @brief Accesses the element of the owned set node, which is its key.
+ *
+ * @return key_type& - reference to the element; the handle must not be
+ * empty.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+template <typename T, typename>
+auto tree<K, M, Compare, Allocator>::NodeHandle::value() const noexcept
+    -> key_type & {
+  return node_->key();
+}
+
+/**
+ * @brief Exchanges the nodes and allocators of two handles.
+ *
+ * @param[in,out] other The handle to exchange with.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::NodeHandle::swap(
+    NodeHandle &other) noexcept {
+  std::swap(node_, other.node_);
+  std::swap(alloc_, other.alloc_);
+}
+
+/**
+ * @brief Gives up the ownership of the node, leaving the handle empty.
+ *
+ * @return Node* - the node that was owned.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+auto tree<K, M, Compare, Allocator>::NodeHandle::release() noexcept
+    -> Node * {
+  alloc_.reset();
+
+  return std::exchange(node_, nullptr);
+}
+
+/**
+ * @brief Destroys and frees the owned node, leaving the handle empty.
+ */
+template <typename K, typename M, typename Compare, typename Allocator>
+void tree<K, M, Compare, Allocator>::NodeHandle::reset() noexcept {
+  if (node_) {
+    node_traits::destroy(*alloc_, node_);
+    node_traits::deallocate(*alloc_, node_, 1);
+    node_ = nullptr;
+    alloc_.reset();
+  }
 }
 
 }  // namespace s21
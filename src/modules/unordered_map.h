@@ -0,0 +1,154 @@
+/**
+ * @file unordered_map.h
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Header for the open addressing hash map container.
+ * @version 1.0
+ * @date 2024-08-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_CONTAINERS_UNORDERED_MAP_H_
+#define SRC_CONTAINERS_UNORDERED_MAP_H_
+
+#include <stdexcept>  // for out_of_range
+#include <utility>    // for pair
+
+#include "./hash_table.h"
+
+/// @brief Namespace for working with containers
+namespace s21 {
+
+/**
+ * @brief An open addressing hash map container template class.
+ *
+ * @details
+ * This template class unordered_map provides the interface of map without
+ * the ordering of the keys. Its elements are stored in place in a
+ * hash_table, so a lookup usually costs one probe of 16 control bytes and
+ * one key comparison. Growing the table invalidates the iterators.
+ *
+ * @tparam K The type of keys stored in the map.
+ * @tparam M The type of values stored in the map.
+ * @tparam Hash The hasher of the keys.
+ * @tparam KeyEqual The equality of the keys.
+ * @tparam Allocator The allocator type used for the slots of the map.
+ */
+template <typename K, typename M, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>,
+          typename Allocator = std::allocator<std::pair<K, M>>>
+class unordered_map : public hash_table<K, std::pair<K, M>, select_first,
+                                        Hash, KeyEqual, Allocator> {
+  using base = hash_table<K, std::pair<K, M>, select_first, Hash, KeyEqual,
+                          Allocator>;  ///< Underlying hash table
+
+ public:
+  // Type aliases
+
+  using mapped_type = M;                          ///< Type of values
+  using key_type = typename base::key_type;       ///< Type of keys
+  using iterator = typename base::iterator;       ///< For read/write elements
+  using iterator_bool = std::pair<iterator, bool>;  ///< Pair iterator-bool
+
+  // Constructors
+
+  using base::base;
+  unordered_map() = default;
+
+  // Element access
+
+  mapped_type &at(const key_type &key) const;
+  mapped_type &operator[](const key_type &key);
+
+  // Modifiers
+
+  using base::insert;
+  iterator_bool insert(const key_type &key, const mapped_type &obj);
+  iterator_bool insert_or_assign(const key_type &key, const mapped_type &obj);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//                        UNORDERED MAP ELEMENT ACCESS                        //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Accesses the value associated with a given key.
+ *
+ * @param[in] key The key to search for.
+ * @return mapped_type& - reference to the value associated with the key.
+ * @throws std::out_of_range if the key is not found.
+ */
+template <typename K, typename M, typename Hash, typename KeyEqual,
+          typename Allocator>
+auto unordered_map<K, M, Hash, KeyEqual, Allocator>::at(
+    const key_type &key) const -> mapped_type & {
+  auto it = this->find(key);
+
+  if (it == this->end()) {
+    throw std::out_of_range("unordered_map::at() - missing element");
+  }
+
+  return (*it).second;
+}
+
+/**
+ * @brief Accesses or inserts a value associated with a given key.
+ *
+ * @details
+ * The key is hashed and probed once for both the search and the insertion;
+ * the value is only default-constructed when the element is new.
+ *
+ * @param[in] key The key to search for.
+ * @return mapped_type& - reference to the value associated with the key.
+ */
+template <typename K, typename M, typename Hash, typename KeyEqual,
+          typename Allocator>
+auto unordered_map<K, M, Hash, KeyEqual, Allocator>::operator[](
+    const key_type &key) -> mapped_type & {
+  return (*this->emplaceKey(key, key, mapped_type{}).first).second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                          UNORDERED MAP MODIFIERS                           //
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Inserts an element with the given key and value.
+ *
+ * @param[in] key The key of the element to insert.
+ * @param[in] obj The value of the element to insert.
+ * @return iterator_bool - an iterator to the element with the key and whether
+ * the insertion took place.
+ */
+template <typename K, typename M, typename Hash, typename KeyEqual,
+          typename Allocator>
+auto unordered_map<K, M, Hash, KeyEqual, Allocator>::insert(
+    const key_type &key, const mapped_type &obj) -> iterator_bool {
+  return this->emplaceKey(key, key, obj);
+}
+
+/**
+ * @brief Inserts an element or assigns the value of an existing one.
+ *
+ * @param[in] key The key of the element to insert or assign.
+ * @param[in] obj The value of the element to insert or assign.
+ * @return iterator_bool - an iterator to the element with the key and whether
+ * the insertion took place.
+ */
+template <typename K, typename M, typename Hash, typename KeyEqual,
+          typename Allocator>
+auto unordered_map<K, M, Hash, KeyEqual, Allocator>::insert_or_assign(
+    const key_type &key, const mapped_type &obj) -> iterator_bool {
+  iterator_bool result = this->emplaceKey(key, key, obj);
+
+  if (!result.second) {
+    (*result.first).second = obj;
+  }
+
+  return result;
+}
+
+}  // namespace s21
+
+#endif  // SRC_CONTAINERS_UNORDERED_MAP_H_
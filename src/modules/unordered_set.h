@@ -0,0 +1,50 @@
+/**
+ * @file unordered_set.h
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Header for the open addressing hash set container.
+ * @version 1.0
+ * @date 2024-08-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_CONTAINERS_UNORDERED_SET_H_
+#define SRC_CONTAINERS_UNORDERED_SET_H_
+
+#include "./hash_table.h"
+
+/// @brief Namespace for working with containers
+namespace s21 {
+
+/**
+ * @brief An open addressing hash set container template class.
+ *
+ * @details
+ * This template class unordered_set provides the interface of set without
+ * the ordering of the keys, keeping its unique keys in place in a
+ * hash_table. The elements are read-only through every iterator.
+ *
+ * @tparam K The type of keys stored in the set.
+ * @tparam Hash The hasher of the keys.
+ * @tparam KeyEqual The equality of the keys.
+ * @tparam Allocator The allocator type used for the slots of the set.
+ */
+template <typename K, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>,
+          typename Allocator = std::allocator<K>>
+class unordered_set
+    : public hash_table<K, const K, select_self, Hash, KeyEqual, Allocator> {
+  using base = hash_table<K, const K, select_self, Hash, KeyEqual,
+                          Allocator>;  ///< Underlying hash table
+
+ public:
+  // Constructors
+
+  using base::base;
+  unordered_set() = default;
+};
+
+}  // namespace s21
+
+#endif  // SRC_CONTAINERS_UNORDERED_SET_H_
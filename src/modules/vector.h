@@ -12,13 +12,61 @@
 #ifndef SRC_CONTAINERS_VECTOR_H_
 #define SRC_CONTAINERS_VECTOR_H_
 
-#include <algorithm>         // for exchange(), fill(), copy()
+#include <algorithm>         // for copy(), fill(), move(), rotate()
+#include <cstring>           // for memcpy(), memmove()
 #include <initializer_list>  // for init_list type
+#include <iterator>          // for distance(), make_move_iterator()
 #include <limits>            // for max()
+#include <memory>            // for allocator_traits
+#include <memory_resource>   // for pmr::polymorphic_allocator
+#include <stdexcept>         // for length_error, out_of_range
+#include <type_traits>       // for is_nothrow_move_constructible
+#include <utility>           // for exchange(), forward(), move()
 
 /// @brief Namespace for working with containers
 namespace s21 {
 
+/**
+ * @brief Tells whether an object can be moved to other storage by copying its
+ * bytes, the original being then treated as destroyed.
+ *
+ * @details
+ * This holds for every trivially copyable type and for most types that only
+ * own resources through pointers, such as std::unique_ptr, but not for types
+ * that point into themselves. A type can opt in by specializing the trait, for
+ * example a record of plain fields and a std::unique_ptr. The vector then
+ * moves such elements with memcpy() and memmove() when it grows, inserts and
+ * erases, and never calls their move constructors or destructors for it.
+ *
+ * @tparam T The type to check.
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+/// @brief The value of is_trivially_relocatable.
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+/// @brief Enables an overload taking a range only for input iterators, so that
+/// a count and a value of an integral type keep their own overloads.
+template <typename InputIt>
+using input_iterator_t = std::enable_if_t<
+    std::is_convertible_v<
+        typename std::iterator_traits<InputIt>::iterator_category,
+        std::input_iterator_tag>,
+    InputIt>;
+
+/// @brief Tells whether the iterators can pass over their range more than
+/// once, so that its length can be measured before it is copied.
+template <typename It>
+inline constexpr bool is_forward_iterator_v = std::is_convertible_v<
+    typename std::iterator_traits<It>::iterator_category,
+    std::forward_iterator_tag>;
+
 /**
  * @brief A dynamic array container template class.
  *
@@ -28,9 +76,16 @@ namespace s21 {
  * elements of type V, supporting various operations including
  * iteration, element access, and size management.
  *
+ * The storage is obtained raw from the allocator and only [0, size()) holds
+ * live elements; the rest of the capacity is never constructed. Growing the
+ * storage relocates the elements by moving them when their move constructor
+ * can not throw, and by copying them otherwise. Elements of trivially
+ * relocatable types (see is_trivially_relocatable) are moved as bytes instead.
+ *
  * @tparam V The type of elements stored in the vector.
+ * @tparam Allocator The allocator used to obtain the storage of the elements.
  */
-template <typename V>
+template <typename V, typename Allocator = std::allocator<V>>
 class vector {
  public:
   // Container types
@@ -47,18 +102,25 @@ class vector {
   using size_type = std::size_t;               ///< Containers size type
   using iterator = VectorIterator;             ///< For read/write elements
   using const_iterator = VectorConstIterator;  ///< For read elements
+  using allocator_type = Allocator;            ///< Allocator of elements
 
   // Constructors/assignment operators/destructor
 
   vector() noexcept = default;
-  explicit vector(size_type n, const_reference value = value_type{});
-  vector(const std::initializer_list<value_type> &items);
+  explicit vector(const allocator_type &alloc) noexcept;
+  explicit vector(size_type n, const_reference value = value_type{},
+                  const allocator_type &alloc = allocator_type{});
+  vector(const std::initializer_list<value_type> &items,
+         const allocator_type &alloc = allocator_type{});
   vector(const vector &v);
+  vector(const vector &v, const allocator_type &alloc);
   vector(vector &&v) noexcept;
   ~vector() noexcept;
   vector &operator=(vector &&v);
   vector &operator=(const vector &v);
 
+  allocator_type get_allocator() const noexcept;
+
   // Vector Iterators
 
   iterator begin() const noexcept;
@@ -88,10 +150,23 @@ class vector {
   void clear() noexcept;
   iterator insert(const_iterator pos, const_reference value,
                   size_type count = 1);
+  iterator insert(const_iterator pos, value_type &&value);
+  template <typename InputIt, typename = input_iterator_t<InputIt>>
+  iterator insert(const_iterator pos, InputIt first, InputIt last);
+  iterator insert(const_iterator pos, std::initializer_list<value_type> items);
+  template <typename InputIt, typename = input_iterator_t<InputIt>>
+  void assign(InputIt first, InputIt last);
+  void assign(std::initializer_list<value_type> items);
+  template <typename Range>
+  void append_range(Range &&range);
   iterator erase(const_iterator pos,
                  const_iterator last_pos = const_iterator{});
   void push_back(const_reference value);
+  void push_back(value_type &&value);
   void pop_back() noexcept;
+  void resize(size_type count);
+  void resize(size_type count, const_reference value);
+  void resize_uninitialized(size_type count);
   void swap(vector &other) noexcept;
 
   template <typename... Args>
@@ -100,16 +175,48 @@ class vector {
   iterator emplace(const_iterator pos, Args &&...args);
 
  private:
+  // Type aliases
+
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  // Constants
+
+  static constexpr bool kRelocatable =
+      is_trivially_relocatable_v<V>;  ///< Elements move as bytes
+
   // Fields
 
-  size_type size_{};      ///< Size of vector
-  size_type capacity_{};  ///< Current capacity of vector
-  value_type *arr_{};     ///< Array of elements
+  allocator_type alloc_{};  ///< Allocator of the array
+  size_type size_{};        ///< Size of vector
+  size_type capacity_{};    ///< Current capacity of vector
+  value_type *arr_{};       ///< Array of elements
 
   // Allocating/deallocating memory
 
-  pointer allocateMemory(size_type size, size_type capacity);
+  pointer allocateArray(size_type capacity);
+  void freeArray(pointer arr, size_type size, size_type capacity) noexcept;
   void freeMemory() noexcept;
+  void reallocate(size_type capacity);
+  template <typename Construct>
+  void resizeWith(size_type count, Construct construct);
+  template <typename Construct>
+  pointer reallocateWithGap(size_type pos, size_type count, size_type capacity,
+                            Construct construct);
+
+  // Constructing/destroying elements
+
+  template <typename InputIt>
+  void assignRange(InputIt first, InputIt last, size_type capacity);
+  template <typename ForwardIt>
+  void insertInPlace(pointer pos, ForwardIt first, ForwardIt last,
+                     size_type count);
+  template <typename InputIt>
+  pointer constructRange(InputIt first, InputIt last, pointer dest);
+  void constructFill(pointer dest, size_type count, const_reference value);
+  void constructDefault(pointer dest, size_type count);
+  pointer relocate(pointer first, pointer last, pointer dest);
+  static void moveBytes(pointer first, pointer last, pointer dest) noexcept;
+  void destroyRange(pointer first, pointer last) noexcept;
 };
 
 /**
@@ -122,37 +229,62 @@ class vector {
  *
  * @tparam V The type of elements stored in the vector.
  */
-template <typename V>
-class vector<V>::VectorConstIterator {
+template <typename V, typename Allocator>
+class vector<V, Allocator>::VectorConstIterator {
  public:
+  // Type aliases
+
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = V;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const V *;
+  using reference = const V &;
+
   // Constructors
 
   VectorConstIterator() noexcept = default;
-  explicit VectorConstIterator(const pointer ptr);
+  explicit VectorConstIterator(value_type *const ptr);
   VectorConstIterator(const const_iterator &other);
 
   // Operators
 
-  pointer base() const noexcept;
+  value_type *base() const noexcept;
   const_iterator &operator=(const const_iterator &other) noexcept;
-  const_iterator &operator=(const pointer ptr) noexcept;
+  const_iterator &operator=(value_type *const ptr) noexcept;
   const_iterator &operator--() noexcept;
   const_iterator &operator++() noexcept;
   const_iterator operator--(int) noexcept;
   const_iterator operator++(int) noexcept;
-  const_iterator operator+(const int shift) const noexcept;
-  const_iterator operator-(const int shift) const noexcept;
-  size_type operator-(const const_iterator &other) const noexcept;
-  void operator-=(const int shift) noexcept;
-  void operator+=(const int shift) noexcept;
+  const_iterator operator+(difference_type shift) const noexcept;
+  const_iterator operator-(difference_type shift) const noexcept;
+  difference_type operator-(const const_iterator &other) const noexcept;
+  const_iterator &operator-=(difference_type shift) noexcept;
+  const_iterator &operator+=(difference_type shift) noexcept;
   bool operator==(const_iterator other) const noexcept;
   bool operator!=(const_iterator other) const noexcept;
+  bool operator<(const_iterator other) const noexcept;
+  bool operator>(const_iterator other) const noexcept;
+  bool operator<=(const_iterator other) const noexcept;
+  bool operator>=(const_iterator other) const noexcept;
   const_reference operator*() const;
+  const_reference operator[](difference_type shift) const;
+
+  /**
+   * @brief Shifts the const_iterator by the given number of positions.
+   *
+   * @param[in] shift Number of positions to shift.
+   * @param[in] it The const_iterator to shift.
+   * @return const_iterator - it + shift.
+   */
+  friend const_iterator operator+(difference_type shift,
+                                  const const_iterator &it) noexcept {
+    return it + shift;
+  }
 
  private:
   // Fields
 
-  pointer ptr_{};  ///< Pointer to the current element
+  value_type *ptr_{};  ///< Pointer to the current element
 };
 
 /**
@@ -165,9 +297,17 @@ class vector<V>::VectorConstIterator {
  *
  * @tparam V The type of elements stored in the vector.
  */
-template <typename V>
-class vector<V>::VectorIterator {
+template <typename V, typename Allocator>
+class vector<V, Allocator>::VectorIterator {
  public:
+  // Type aliases
+
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = V;
+  using difference_type = std::ptrdiff_t;
+  using pointer = V *;
+  using reference = V &;
+
   // Constructors
 
   VectorIterator() noexcept = default;
@@ -183,14 +323,31 @@ class vector<V>::VectorIterator {
   iterator &operator++() noexcept;
   iterator operator--(int) noexcept;
   iterator operator++(int) noexcept;
-  iterator operator+(const int shift) const noexcept;
-  iterator operator-(const int shift) const noexcept;
-  size_type operator-(const iterator &other) const noexcept;
-  void operator-=(const int shift) noexcept;
-  void operator+=(const int shift) noexcept;
+  iterator operator+(difference_type shift) const noexcept;
+  iterator operator-(difference_type shift) const noexcept;
+  difference_type operator-(const iterator &other) const noexcept;
+  iterator &operator-=(difference_type shift) noexcept;
+  iterator &operator+=(difference_type shift) noexcept;
   bool operator==(iterator other) const noexcept;
   bool operator!=(iterator other) const noexcept;
-  reference operator*();
+  bool operator<(iterator other) const noexcept;
+  bool operator>(iterator other) const noexcept;
+  bool operator<=(iterator other) const noexcept;
+  bool operator>=(iterator other) const noexcept;
+  reference operator*() const;
+  reference operator[](difference_type shift) const;
+
+  /**
+   * @brief Shifts the iterator by the given number of positions.
+   *
+   * @param[in] shift Number of positions to shift.
+   * @param[in] it The iterator to shift.
+   * @return iterator - it + shift.
+   */
+  friend iterator operator+(difference_type shift,
+                            const iterator &it) noexcept {
+    return it + shift;
+  }
 
   /**
    * @brief Converts the iterator to a const_iterator.
@@ -216,6 +373,15 @@ class vector<V>::VectorIterator {
 //                            VECTOR CONSTRUCTORS                             //
 ////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * @brief Constructs an empty vector that uses the given allocator.
+ *
+ * @param[in] alloc The allocator to obtain memory from.
+ */
+template <typename V, typename Allocator>
+vector<V, Allocator>::vector(
+    const allocator_type &alloc) noexcept : alloc_{alloc} {}
+
 /**
  * @brief Constructs a vector with a specified number of elements, each
  * initialized to a given value.
@@ -228,13 +394,23 @@ class vector<V>::VectorIterator {
  * @param[in] n The number of elements to be created in the vector.
  * @param[in] value The value to initialize the elements with. Defaults to a
  * default-constructed value_type if not provided.
- */
-template <typename V>
-vector<V>::vector(size_type n, const_reference value)
-    : arr_{allocateMemory(n, n)} {
-  if (size_) {
-    std::uninitialized_fill(arr_, arr_ + size_, value);
+ * @param[in] alloc The allocator to obtain memory from.
+ */
+template <typename V, typename Allocator>
+vector<V, Allocator>::vector(size_type n, const_reference value,
+                             const allocator_type &alloc)
+    : alloc_{alloc} {
+  arr_ = allocateArray(n);
+  capacity_ = n;
+
+  try {
+    constructFill(arr_, n, value);
+  } catch (...) {
+    freeMemory();
+    throw;
   }
+
+  size_ = n;
 }
 
 /**
@@ -244,25 +420,39 @@ vector<V>::vector(size_type n, const_reference value)
  * Initializes the vector with the elements from the initializer list.
  *
  * @param[in] items The initializer list containing elements.
+ * @param[in] alloc The allocator to obtain memory from.
  */
-template <typename V>
-vector<V>::vector(const std::initializer_list<value_type> &items)
-    : arr_{allocateMemory(items.size(), items.size())} {
-  std::uninitialized_copy(items.begin(), items.begin() + size_, arr_);
+template <typename V, typename Allocator>
+vector<V, Allocator>::vector(const std::initializer_list<value_type> &items,
+                             const allocator_type &alloc)
+    : alloc_{alloc} {
+  assignRange(items.begin(), items.end(), items.size());
 }
 
 /**
  * @brief Copy constructor.
  *
  * @details
- * Constructs a vector by copying another vector.
+ * Constructs a vector by copying another vector. The allocator is obtained
+ * through select_on_container_copy_construction().
  *
  * @param[in] v The vector to copy.
  */
-template <typename V>
-vector<V>::vector(const vector &v)
-    : arr_{allocateMemory(v.size_, v.capacity_)} {
-  std::uninitialized_copy(v.arr_, v.arr_ + v.size_, arr_);
+template <typename V, typename Allocator>
+vector<V, Allocator>::vector(const vector &v)
+    : vector{v,
+             alloc_traits::select_on_container_copy_construction(v.alloc_)} {}
+
+/**
+ * @brief Copy constructor with an explicit allocator.
+ *
+ * @param[in] v The vector to copy.
+ * @param[in] alloc The allocator to obtain memory from.
+ */
+template <typename V, typename Allocator>
+vector<V, Allocator>::vector(const vector &v, const allocator_type &alloc)
+    : alloc_{alloc} {
+  assignRange(v.arr_, v.arr_ + v.size_, v.capacity_);
 }
 
 /**
@@ -273,9 +463,10 @@ vector<V>::vector(const vector &v)
  *
  * @param[out] v The vector to move.
  */
-template <typename V>
-vector<V>::vector(vector &&v) noexcept
-    : size_{std::exchange(v.size_, 0)},
+template <typename V, typename Allocator>
+vector<V, Allocator>::vector(vector &&v) noexcept
+    : alloc_{v.alloc_},
+      size_{std::exchange(v.size_, 0)},
       capacity_{std::exchange(v.capacity_, 0)},
       arr_{std::exchange(v.arr_, nullptr)} {}
 
@@ -286,8 +477,8 @@ vector<V>::vector(vector &&v) noexcept
  * Destroys the vector and frees allocated memory.
  *
  */
-template <typename V>
-vector<V>::~vector() noexcept {
+template <typename V, typename Allocator>
+vector<V, Allocator>::~vector() noexcept {
   freeMemory();
 }
 
@@ -296,30 +487,69 @@ vector<V>::~vector() noexcept {
  *
  * @details
  * Assigns the contents of another vector to this vector using move semantics.
+ * If the allocator does not propagate on move assignment and the allocators
+ * differ, the storage of v can not be adopted, so the elements are moved one
+ * by one and v is cleared. That branch is compiled only for allocators that
+ * neither propagate nor always compare equal, so move-only elements work
+ * with std::allocator.
  *
  * @param[out] v The vector to move.
  * @return vector& - reference to the assigned vector.
  */
-template <typename V>
-auto vector<V>::operator=(vector &&v) -> vector & {
-  if (this != &v) {
-    freeMemory();
-    new (this) vector{std::move(v)};
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::operator=(vector &&v) -> vector & {
+  if (this == &v) {
+    return *this;
+  }
+
+  if constexpr (!alloc_traits::propagate_on_container_move_assignment::value &&
+                !alloc_traits::is_always_equal::value) {
+    if (alloc_ != v.alloc_) {
+      assign(std::make_move_iterator(v.arr_),
+             std::make_move_iterator(v.arr_ + v.size_));
+      v.clear();
+
+      return *this;
+    }
   }
 
+  this->~vector();
+  new (this) vector{std::move(v)};
+
   return *this;
 }
 
-template <typename V>
-auto vector<V>::operator=(const vector &v) -> vector & {
+/**
+ * @brief Copy assignment operator.
+ *
+ * @details
+ * Assigns a copy of the contents of another vector to this vector. The
+ * allocator of this vector is kept. The current storage is reused when it
+ * can hold the elements of v (see assign()); otherwise the copies are built
+ * in a new storage of v.size() elements before the old one is freed.
+ *
+ * @param[in] v The vector to copy.
+ * @return vector& - reference to the assigned vector.
+ */
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::operator=(const vector &v) -> vector & {
   if (this != &v) {
-    freeMemory();
-    new (this) vector{v};
+    assign(v.arr_, v.arr_ + v.size_);
   }
 
   return *this;
 }
 
+/**
+ * @brief Returns a copy of the allocator of the vector.
+ *
+ * @return allocator_type - the allocator.
+ */
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::get_allocator() const noexcept -> allocator_type {
+  return alloc_;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                              VECTOR ITERATORS                              //
 ////////////////////////////////////////////////////////////////////////////////
@@ -329,8 +559,8 @@ auto vector<V>::operator=(const vector &v) -> vector & {
  *
  * @return iterator - an iterator to the beginning of the vector.
  */
-template <typename V>
-auto vector<V>::begin() const noexcept -> iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::begin() const noexcept -> iterator {
   return iterator{arr_};
 }
 
@@ -339,8 +569,8 @@ auto vector<V>::begin() const noexcept -> iterator {
  *
  * @return iterator - an iterator to the end of the vector.
  */
-template <typename V>
-auto vector<V>::end() const noexcept -> iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::end() const noexcept -> iterator {
   return iterator{arr_ + size_};
 }
 
@@ -349,8 +579,8 @@ auto vector<V>::end() const noexcept -> iterator {
  *
  * @return const_iterator - const_iterator to the beginning of the vector.
  */
-template <typename V>
-auto vector<V>::cbegin() const noexcept -> const_iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::cbegin() const noexcept -> const_iterator {
   return const_iterator{arr_};
 }
 
@@ -359,8 +589,8 @@ auto vector<V>::cbegin() const noexcept -> const_iterator {
  *
  * @return const_iterator - const_iterator to the end of the vector.
  */
-template <typename V>
-auto vector<V>::cend() const noexcept -> const_iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::cend() const noexcept -> const_iterator {
   return const_iterator{arr_ + size_};
 }
 
@@ -373,8 +603,8 @@ auto vector<V>::cend() const noexcept -> const_iterator {
  *
  * @return true if the vector is empty, false otherwise.
  */
-template <typename V>
-bool vector<V>::empty() const noexcept {
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::empty() const noexcept {
   return (size_) ? false : true;
 }
 
@@ -383,8 +613,8 @@ bool vector<V>::empty() const noexcept {
  *
  * @return size_type - the number of elements in the vector.
  */
-template <typename V>
-auto vector<V>::size() const noexcept -> size_type {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::size() const noexcept -> size_type {
   return size_;
 }
 
@@ -393,29 +623,29 @@ auto vector<V>::size() const noexcept -> size_type {
  *
  * @return size_type - the maximum number of elements.
  */
-template <typename V>
-auto vector<V>::max_size() const noexcept -> size_type {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::max_size() const noexcept -> size_type {
   return std::numeric_limits<size_type>::max() / sizeof(value_type) / 2;
 }
 
 /**
  * @brief Reserves memory for the specified number of elements.
  *
+ * @details
+ * The elements are relocated into the new storage (see relocate()); no
+ * element is constructed for the added capacity.
+ *
  * @param[in] size The number of elements to reserve memory for.
  * @throw std::length_error - if the reserve size greater than max_size().
  */
-template <typename V>
-void vector<V>::reserve(size_type size) {
+template <typename V, typename Allocator>
+void vector<V, Allocator>::reserve(size_type size) {
   if (size > max_size()) {
     throw std::length_error("vector::reserve() - size greater than max_size()");
   }
 
   if (size > capacity_) {
-    capacity_ = size;
-    pointer new_arr = new value_type[size]{};
-    std::uninitialized_copy(arr_, arr_ + size_, new_arr);
-    delete[] arr_;
-    arr_ = (capacity_) ? new_arr : nullptr;
+    reallocate(size);
   }
 }
 
@@ -424,8 +654,8 @@ void vector<V>::reserve(size_type size) {
  *
  * @return size_type - the current capacity.
  */
-template <typename V>
-auto vector<V>::capacity() const noexcept -> size_type {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::capacity() const noexcept -> size_type {
   return capacity_;
 }
 
@@ -433,14 +663,10 @@ auto vector<V>::capacity() const noexcept -> size_type {
  * @brief Reduces the capacity of the vector to fit its size.
  *
  */
-template <typename V>
-void vector<V>::shrink_to_fit() {
+template <typename V, typename Allocator>
+void vector<V, Allocator>::shrink_to_fit() {
   if (size_ != capacity_) {
-    capacity_ = size_;
-    pointer new_arr = new value_type[size_]{};
-    std::copy(arr_, arr_ + size_, new_arr);
-    delete[] arr_;
-    arr_ = (capacity_) ? new_arr : nullptr;
+    reallocate(size_);
   }
 }
 
@@ -455,8 +681,8 @@ void vector<V>::shrink_to_fit() {
  * @return reference - a reference to the element at the specified position.
  * @throw std::out_of_range - if element position out of vector range.
  */
-template <typename V>
-auto vector<V>::at(size_type pos) const -> value_type & {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::at(size_type pos) const -> value_type & {
   if (pos >= size_) {
     throw std::out_of_range("vector::at() - pos out of vector range");
   }
@@ -470,8 +696,9 @@ auto vector<V>::at(size_type pos) const -> value_type & {
  * @param[in] pos The position of the element.
  * @return reference - a reference to the element at the specified position.
  */
-template <typename V>
-auto vector<V>::operator[](size_type pos) const noexcept -> value_type & {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::operator[](size_type pos) const noexcept
+    -> value_type & {
   return *(arr_ + pos);
 }
 
@@ -480,8 +707,8 @@ auto vector<V>::operator[](size_type pos) const noexcept -> value_type & {
  *
  * @return const_reference - a reference to the first element.
  */
-template <typename V>
-auto vector<V>::front() const noexcept -> const_reference {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::front() const noexcept -> const_reference {
   return *arr_;
 }
 
@@ -490,8 +717,8 @@ auto vector<V>::front() const noexcept -> const_reference {
  *
  * @return const_reference - a reference to the last element.
  */
-template <typename V>
-auto vector<V>::back() const noexcept -> const_reference {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::back() const noexcept -> const_reference {
   return *(arr_ + size_ - 1);
 }
 
@@ -500,8 +727,8 @@ auto vector<V>::back() const noexcept -> const_reference {
  *
  * @return pointer - a pointer to the first element.
  */
-template <typename V>
-auto vector<V>::data() const noexcept -> pointer {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::data() const noexcept -> pointer {
   return arr_;
 }
 
@@ -513,13 +740,14 @@ auto vector<V>::data() const noexcept -> pointer {
  * @brief Removes all elements from the vector and sets its size to 0.
  *
  * @details
- * This method sets the vector's size to 0. The vector's capacity remains
- * unchanged, and the memory allocated for the elements is still available for
- * reuse.
+ * This method destroys the elements and sets the vector's size to 0. The
+ * vector's capacity remains unchanged, and the memory allocated for the
+ * elements is still available for reuse.
  *
  */
-template <typename V>
-void vector<V>::clear() noexcept {
+template <typename V, typename Allocator>
+void vector<V, Allocator>::clear() noexcept {
+  destroyRange(arr_, arr_ + size_);
   size_ = 0;
 }
 
@@ -541,9 +769,9 @@ void vector<V>::clear() noexcept {
  * elements.
  * @throw std::out_of_range - if pos is not a valid iterator within the vector.
  */
-template <typename V>
-auto vector<V>::insert(const_iterator pos, const_reference value,
-                       size_type count) -> iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::insert(const_iterator pos, const_reference value,
+                                  size_type count) -> iterator {
   if (pos.base() < arr_ || pos.base() > arr_ + size_) {
     throw std::out_of_range("vector::insert() - pos is not at vectors range");
   }
@@ -552,17 +780,218 @@ auto vector<V>::insert(const_iterator pos, const_reference value,
   size_type new_size = size_ + count;
 
   if (capacity_ < new_size) {
-    reserve((capacity_ * 2 >= new_size) ? capacity_ * 2 : new_size);
+    return iterator{reallocateWithGap(
+        ins_pos, count, (capacity_ * 2 >= new_size) ? capacity_ * 2 : new_size,
+        [&](pointer dest) { constructFill(dest, count, value); })};
+  }
+
+  if (count) {
+    value_type copy(value);
+    pointer first = arr_ + ins_pos;
+    pointer last = arr_ + size_;
+    size_type after = size_ - ins_pos;
+
+    if constexpr (kRelocatable) {
+      moveBytes(first, last, first + count);
+
+      try {
+        constructFill(first, count, copy);
+      } catch (...) {
+        moveBytes(first + count, last + count, first);
+        throw;
+      }
+
+      size_ += count;
+    } else if (after > count) {
+      relocate(last - count, last, last);
+      size_ += count;
+      std::move_backward(first, last - count, last);
+      std::fill(first, first + count, copy);
+    } else {
+      constructFill(last, count - after, copy);
+      size_ += count - after;
+      relocate(first, last, arr_ + size_);
+      size_ += after;
+      std::fill(first, last, copy);
+    }
+  }
+
+  return begin() + ins_pos;
+}
+
+/**
+ * @brief Moves a value into a new element at the specified position.
+ *
+ * @details
+ * Works like inserting a single copy, but the value is moved into the vector,
+ * so the resources of a heavy object are taken over instead of copied.
+ *
+ * @param[in] pos Iterator position at which to insert the new element.
+ * @param[in] value The value to move.
+ * @return iterator - an iterator pointing to the inserted element.
+ * @throw std::out_of_range - if pos is not a valid iterator within the vector.
+ */
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::insert(const_iterator pos, value_type &&value)
+    -> iterator {
+  if (pos.base() < arr_ || pos.base() > arr_ + size_) {
+    throw std::out_of_range("vector::insert() - pos is not at vectors range");
+  }
+
+  return emplace(pos, std::move(value));
+}
+
+/**
+ * @brief Inserts the elements of a range at the specified position.
+ *
+ * @details
+ * For forward iterators the length of the range is measured first, so the
+ * storage grows at most once, to twice its capacity or the new size, whichever
+ * is larger, and every element is copied straight to its place. Input
+ * iterators can pass over the range only once, so their elements are appended
+ * and then rotated to the position. The range must not refer to the vector.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] pos Iterator position at which to insert the new elements.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ * @return iterator - an iterator pointing to the first of the newly inserted
+ * elements, or to pos if the range is empty.
+ * @throw std::out_of_range - if pos is not a valid iterator within the vector.
+ */
+template <typename V, typename Allocator>
+template <typename InputIt, typename>
+auto vector<V, Allocator>::insert(const_iterator pos, InputIt first,
+                                  InputIt last) -> iterator {
+  if (pos.base() < arr_ || pos.base() > arr_ + size_) {
+    throw std::out_of_range("vector::insert() - pos is not at vectors range");
   }
 
-  std::move_backward(arr_ + ins_pos, arr_ + size_, arr_ + size_ + count);
-  std::uninitialized_fill(arr_ + ins_pos, arr_ + ins_pos + count, value);
+  size_type ins_pos = pos - cbegin();
 
-  size_ = new_size;
+  if constexpr (is_forward_iterator_v<InputIt>) {
+    size_type count = static_cast<size_type>(std::distance(first, last));
+    size_type new_size = size_ + count;
+
+    if (capacity_ < new_size) {
+      return iterator{reallocateWithGap(
+          ins_pos, count,
+          (capacity_ * 2 >= new_size) ? capacity_ * 2 : new_size,
+          [&](pointer dest) { constructRange(first, last, dest); })};
+    }
+
+    if (count) {
+      insertInPlace(arr_ + ins_pos, first, last, count);
+    }
+  } else {
+    size_type old_size = size_;
+
+    try {
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+    } catch (...) {
+      destroyRange(arr_ + old_size, arr_ + size_);
+      size_ = old_size;
+      throw;
+    }
+
+    std::rotate(arr_ + ins_pos, arr_ + old_size, arr_ + size_);
+  }
 
   return begin() + ins_pos;
 }
 
+/**
+ * @brief Inserts the elements of an initializer list at the specified
+ * position.
+ *
+ * @param[in] pos Iterator position at which to insert the new elements.
+ * @param[in] items The initializer list containing the elements.
+ * @return iterator - an iterator pointing to the first of the newly inserted
+ * elements, or to pos if the list is empty.
+ * @throw std::out_of_range - if pos is not a valid iterator within the vector.
+ */
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::insert(const_iterator pos,
+                                  std::initializer_list<value_type> items)
+    -> iterator {
+  return insert(pos, items.begin(), items.end());
+}
+
+/**
+ * @brief Replaces the elements with the elements of a range.
+ *
+ * @details
+ * For forward iterators the length of the range is measured first. A range
+ * that fits into the capacity is assigned over the existing elements, and a
+ * longer one is copied into a single new storage of exactly its length. The
+ * elements of input iterators are assigned over the existing elements and
+ * then appended. The range must not refer to the vector.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename V, typename Allocator>
+template <typename InputIt, typename>
+void vector<V, Allocator>::assign(InputIt first, InputIt last) {
+  if constexpr (is_forward_iterator_v<InputIt>) {
+    size_type count = static_cast<size_type>(std::distance(first, last));
+
+    if (count > capacity_) {
+      assignRange(first, last, count);
+    } else if (count <= size_) {
+      pointer end = std::copy(first, last, arr_);
+      destroyRange(end, arr_ + size_);
+      size_ = count;
+    } else {
+      InputIt mid = std::next(first, size_);
+      std::copy(first, mid, arr_);
+      size_ = constructRange(mid, last, arr_ + size_) - arr_;
+    }
+  } else {
+    pointer current = arr_;
+
+    for (; first != last && current != arr_ + size_; ++first, ++current) {
+      *current = *first;
+    }
+
+    destroyRange(current, arr_ + size_);
+    size_ = current - arr_;
+
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+}
+
+/**
+ * @brief Replaces the elements with the elements of an initializer list.
+ *
+ * @param[in] items The initializer list containing the elements.
+ */
+template <typename V, typename Allocator>
+void vector<V, Allocator>::assign(std::initializer_list<value_type> items) {
+  assign(items.begin(), items.end());
+}
+
+/**
+ * @brief Appends the elements of a range to the end of the vector.
+ *
+ * @details
+ * The range is anything std::begin() and std::end() accept, such as another
+ * container or an array. See the range insert() for how the storage grows.
+ *
+ * @tparam Range The type of the range.
+ * @param[in] range The range whose elements are copied.
+ */
+template <typename V, typename Allocator>
+template <typename Range>
+void vector<V, Allocator>::append_range(Range &&range) {
+  insert(cend(), std::begin(range), std::end(range));
+}
+
 /**
  * @brief Removes elements from the vector within the specified range.
  *
@@ -574,25 +1003,39 @@ auto vector<V>::insert(const_iterator pos, const_reference value,
  * @param[in] last_pos An iterator pointing to one past the last element to be
  * removed. Defaults to nullptr.
  *
- * @throw std::range_error - if pos or last_pos are out of the bounds of the
- * vector or if last_pos is before pos.
+ * @throw std::range_error - if pos or last_pos are out of [begin(), end()],
+ * if last_pos is before pos, or if pos is end() and last_pos is not given.
  */
-template <typename V>
-auto vector<V>::erase(const_iterator pos, const_iterator last_pos) -> iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::erase(const_iterator pos, const_iterator last_pos)
+    -> iterator {
+  pointer end = arr_ + size_;
+
   if (last_pos.base() == nullptr) {
+    if (pos.base() < arr_ || pos.base() >= end) {
+      throw std::range_error("vector::erase() - pos is not an element");
+    }
+
     last_pos = pos + 1;
   }
 
-  if (pos.base() < arr_ || pos.base() > arr_ + capacity_ ||
-      last_pos.base() < arr_ || last_pos.base() > arr_ + capacity_ ||
-      last_pos.base() < pos.base()) {
+  if (pos.base() < arr_ || pos.base() > end || last_pos.base() < pos.base() ||
+      last_pos.base() > end) {
     throw std::range_error("vector::erase() - invalid vector range");
   }
 
   size_type range = last_pos - pos;
 
   if (range) {
-    std::copy(pos.base() + range, arr_ + size_, pos.base());
+    pointer first = pos.base();
+
+    if constexpr (kRelocatable) {
+      destroyRange(first, first + range);
+      moveBytes(first + range, arr_ + size_, first);
+    } else {
+      destroyRange(std::move(first + range, arr_ + size_, first), arr_ + size_);
+    }
+
     size_ -= range;
   }
 
@@ -604,36 +1047,99 @@ auto vector<V>::erase(const_iterator pos, const_iterator last_pos) -> iterator {
  *
  * @details
  * This method adds a new element to the end of the vector. If the current
- * size of the vector equals its capacity, the method will first reserve
- * additional space to accommodate the new element. The new element is
- * constructed in place using placement new, avoiding the use of the
- * assignment operator.
+ * size of the vector equals its capacity, the storage is doubled first. The
+ * new element is copy-constructed in place, so value may refer to an element
+ * of the vector itself.
  *
  * @param[in] value The value to be added to the end of the vector.
  */
-template <typename V>
-void vector<V>::push_back(const_reference value) {
-  if (size_ == capacity_) {
-    reserve((capacity_) ? capacity_ * 2 : 1);
-  }
+template <typename V, typename Allocator>
+void vector<V, Allocator>::push_back(const_reference value) {
+  emplace_back(value);
+}
 
-  arr_[size_++] = value;
+/**
+ * @brief Moves a value into a new element at the end of the vector.
+ *
+ * @param[in] value The value to move to the end of the vector.
+ */
+template <typename V, typename Allocator>
+void vector<V, Allocator>::push_back(value_type &&value) {
+  emplace_back(std::move(value));
 }
 
 /**
  * @brief Removes the last element from the vector.
  *
  * @details
- * This function decreases the size of the vector by one. If the vector is
- * empty, the function does nothing. This method does not free the memory
- * allocated for the elements,it only decreases the size of the vector. The
- * capacity remains unchanged.
+ * This function destroys the last element and decreases the size of the
+ * vector by one. If the vector is empty, the function does nothing. This
+ * method does not free the memory allocated for the elements. The capacity
+ * remains unchanged.
  *
  */
-template <typename V>
-void vector<V>::pop_back() noexcept {
+template <typename V, typename Allocator>
+void vector<V, Allocator>::pop_back() noexcept {
   if (size_) {
-    size_--;
+    alloc_traits::destroy(alloc_, arr_ + --size_);
+  }
+}
+
+/**
+ * @brief Changes the number of elements to count.
+ *
+ * @details
+ * Extra elements are destroyed, and missing ones are value-initialized, so
+ * the new elements of arithmetic types are zero. If count exceeds the
+ * capacity, the storage grows once, to twice its capacity or count,
+ * whichever is larger.
+ *
+ * @param[in] count The new size of the vector.
+ * @throw std::length_error - if count is greater than max_size().
+ */
+template <typename V, typename Allocator>
+void vector<V, Allocator>::resize(size_type count) {
+  resizeWith(count,
+             [&](pointer dest) { constructDefault(dest, count - size_); });
+}
+
+/**
+ * @brief Changes the number of elements to count, appending copies of value.
+ *
+ * @details
+ * Works like resize(count), but the missing elements are copies of value,
+ * which may refer to an element of the vector itself.
+ *
+ * @param[in] count The new size of the vector.
+ * @param[in] value The value to copy into the new elements.
+ * @throw std::length_error - if count is greater than max_size().
+ */
+template <typename V, typename Allocator>
+void vector<V, Allocator>::resize(size_type count, const_reference value) {
+  resizeWith(count, [&](pointer dest) {
+    constructFill(dest, count - size_, value);
+  });
+}
+
+/**
+ * @brief Changes the number of elements to count without initializing the
+ * new ones.
+ *
+ * @details
+ * Meant for buffers that are overwritten right away, such as the target of a
+ * read(): for trivially default constructible types the new elements are
+ * left as the allocator returned the memory, which is neither written nor
+ * touched. Elements of other types are value-initialized like by resize().
+ *
+ * @param[in] count The new size of the vector.
+ * @throw std::length_error - if count is greater than max_size().
+ */
+template <typename V, typename Allocator>
+void vector<V, Allocator>::resize_uninitialized(size_type count) {
+  if constexpr (std::is_trivially_default_constructible_v<value_type>) {
+    resizeWith(count, [](pointer) {});
+  } else {
+    resize(count);
   }
 }
 
@@ -642,12 +1148,18 @@ void vector<V>::pop_back() noexcept {
  *
  * This function swaps the contents of the current vector with the given vector
  * other. It performs the swap by exchanging the internal pointers and metadata,
- * making the operation very efficient.
+ * making the operation very efficient. The allocators are exchanged too if
+ * they propagate on swap, so each storage stays with the allocator it came
+ * from.
  *
  * @param[out] other The vector to swap contents with.
  */
-template <typename V>
-void vector<V>::swap(vector &other) noexcept {
+template <typename V, typename Allocator>
+void vector<V, Allocator>::swap(vector &other) noexcept {
+  if constexpr (alloc_traits::propagate_on_container_swap::value) {
+    std::swap(alloc_, other.alloc_);
+  }
+
   std::swap(other.size_, size_);
   std::swap(other.capacity_, capacity_);
   std::swap(other.arr_, arr_);
@@ -659,26 +1171,29 @@ void vector<V>::swap(vector &other) noexcept {
  * @details
  * This method constructs a new element in place at the end of the vector using
  * the provided arguments. If the current size of the vector equals its
- * capacity, the method will first reserve additional space to accommodate the
- * new element. The new element is constructed in place using placement new,
- * avoiding the use of the assignment operator.
+ * capacity, the element is constructed in a storage of twice the capacity
+ * before the old elements are relocated next to it, so args may refer to
+ * elements of the vector.
  *
  * @tparam Args The types of the arguments to forward to the constructor of the
  * element.
  * @param args The arguments to forward to the constructor of the new element.
  * @return reference - a reference to the newly inserted element.
  */
-template <typename V>
+template <typename V, typename Allocator>
 template <typename... Args>
-auto vector<V>::emplace_back(Args &&...args) -> reference {
+auto vector<V, Allocator>::emplace_back(Args &&...args) -> reference {
   if (size_ == capacity_) {
-    reserve((capacity_) ? capacity_ * 2 : 1);
+    return *reallocateWithGap(size_, 1, (capacity_) ? capacity_ * 2 : 1,
+                              [&](pointer dest) {
+                                alloc_traits::construct(
+                                    alloc_, dest, std::forward<Args>(args)...);
+                              });
   }
 
-  new (arr_ + size_) value_type{std::forward<Args>(args)...};
-  ++size_;
+  alloc_traits::construct(alloc_, arr_ + size_, std::forward<Args>(args)...);
 
-  return *(arr_ + size_ - 1);
+  return *(arr_ + size_++);
 }
 
 /**
@@ -700,18 +1215,42 @@ auto vector<V>::emplace_back(Args &&...args) -> reference {
  * @return iterator - an iterator pointing to the newly inserted element.
  * @throw std::length_error - if the reserve size greater than max_size().
  */
-template <typename V>
+template <typename V, typename Allocator>
 template <typename... Args>
-auto vector<V>::emplace(const_iterator pos, Args &&...args) -> iterator {
+auto vector<V, Allocator>::emplace(const_iterator pos, Args &&...args)
+    -> iterator {
   size_type ins_pos = pos - cbegin();
 
   if (size_ == capacity_) {
-    reserve((capacity_) ? capacity_ * 2 : 1);
+    return iterator{reallocateWithGap(
+        ins_pos, 1, (capacity_) ? capacity_ * 2 : 1, [&](pointer dest) {
+          alloc_traits::construct(alloc_, dest, std::forward<Args>(args)...);
+        })};
   }
 
-  std::move_backward(arr_ + ins_pos, arr_ + size_, arr_ + size_ + 1);
+  if (ins_pos == size_) {
+    alloc_traits::construct(alloc_, arr_ + size_, std::forward<Args>(args)...);
+  } else {
+    value_type value(std::forward<Args>(args)...);
+    pointer first = arr_ + ins_pos;
+
+    if constexpr (kRelocatable) {
+      moveBytes(first, arr_ + size_, first + 1);
+
+      try {
+        alloc_traits::construct(alloc_, first, std::move(value));
+      } catch (...) {
+        moveBytes(first + 1, arr_ + size_ + 1, first);
+        throw;
+      }
+    } else {
+      alloc_traits::construct(alloc_, arr_ + size_,
+                              std::move(arr_[size_ - 1]));
+      std::move_backward(first, arr_ + size_ - 1, arr_ + size_);
+      *first = std::move(value);
+    }
+  }
 
-  new (arr_ + ins_pos) value_type(std::forward<Args>(args)...);
   ++size_;
 
   return iterator{arr_ + ins_pos};
@@ -722,32 +1261,394 @@ auto vector<V>::emplace(const_iterator pos, Args &&...args) -> iterator {
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
- * @brief Allocates memory for the vector.
+ * @brief Allocates raw storage for the given number of elements.
  *
- * @return pointer A pointer to the allocated memory.
+ * @details
+ * No element is constructed; the elements are constructed one by one as the
+ * vector grows.
+ *
+ * @param[in] capacity The number of elements the storage can hold.
+ * @return pointer - the storage, or nullptr if capacity is zero.
  * @throw std::bad_alloc - if the allocation failed.
  */
-template <typename V>
-typename vector<V>::pointer vector<V>::allocateMemory(size_type size,
-                                                      size_type capacity) {
-  size_ = size;
-  capacity_ = capacity;
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::allocateArray(size_type capacity) -> pointer {
+  return (capacity) ? alloc_traits::allocate(alloc_, capacity) : nullptr;
+}
 
-  return new value_type[capacity_]{};
+/**
+ * @brief Destroys the elements of an array and returns it to the allocator.
+ *
+ * @param[in] arr The array obtained from allocateArray(), may be nullptr.
+ * @param[in] size The number of constructed elements at the front of arr.
+ * @param[in] capacity The number of elements the array can hold.
+ */
+template <typename V, typename Allocator>
+void vector<V, Allocator>::freeArray(pointer arr, size_type size,
+                                     size_type capacity) noexcept {
+  if (arr) {
+    destroyRange(arr, arr + size);
+    alloc_traits::deallocate(alloc_, arr, capacity);
+  }
 }
 
 /**
  * @brief Frees the memory allocated for the vector.
  *
  */
-template <typename V>
-void vector<V>::freeMemory() noexcept {
-  if (arr_ != nullptr) {
-    delete[] arr_;
-    arr_ = nullptr;
+template <typename V, typename Allocator>
+void vector<V, Allocator>::freeMemory() noexcept {
+  freeArray(arr_, size_, capacity_);
+  arr_ = nullptr;
+  size_ = capacity_ = 0;
+}
+
+/**
+ * @brief Moves the elements to a new storage of the given capacity.
+ *
+ * @details
+ * If relocating an element throws, the new storage is released and the
+ * vector is left unchanged.
+ *
+ * @param[in] capacity The capacity of the new storage, not less than size().
+ * @throw std::bad_alloc - if the allocation failed.
+ */
+template <typename V, typename Allocator>
+void vector<V, Allocator>::reallocate(size_type capacity) {
+  pointer arr = allocateArray(capacity);
+
+  if constexpr (kRelocatable) {
+    moveBytes(arr_, arr_ + size_, arr);
+    freeArray(arr_, 0, capacity_);
+  } else {
+    try {
+      relocate(arr_, arr_ + size_, arr);
+    } catch (...) {
+      freeArray(arr, 0, capacity);
+      throw;
+    }
+
+    freeArray(arr_, size_, capacity_);
   }
 
-  size_ = capacity_ = 0;
+  arr_ = arr;
+  capacity_ = capacity;
+}
+
+/**
+ * @brief Changes the number of elements to count.
+ *
+ * @details
+ * Extra elements are destroyed. The missing ones are constructed by
+ * construct at the end of the elements, in a storage of twice the capacity
+ * or count, whichever is larger, if they do not fit.
+ *
+ * @tparam Construct The type of the callable constructing the new elements.
+ * @param[in] count The new size of the vector.
+ * @param[in] construct The callable constructing count - size() elements at
+ * the pointer it receives, destroying them again if it throws.
+ */
+template <typename V, typename Allocator>
+template <typename Construct>
+void vector<V, Allocator>::resizeWith(size_type count, Construct construct) {
+  if (count <= size_) {
+    destroyRange(arr_ + count, arr_ + size_);
+    size_ = count;
+  } else if (count > capacity_) {
+    reallocateWithGap(size_, count - size_,
+                      (capacity_ * 2 >= count) ? capacity_ * 2 : count,
+                      construct);
+  } else {
+    construct(arr_ + size_);
+    size_ = count;
+  }
+}
+
+/**
+ * @brief Moves the elements to a new storage, leaving a gap of new elements.
+ *
+ * @details
+ * The new elements are constructed by construct before the old ones are
+ * relocated around them, so the arguments of the new elements may refer to
+ * the old ones. If anything throws, the new storage is released and the
+ * vector is left unchanged.
+ *
+ * @tparam Construct The type of the callable constructing the new elements.
+ * @param[in] pos The index of the first new element.
+ * @param[in] count The number of new elements.
+ * @param[in] capacity The capacity of the new storage.
+ * @param[in] construct The callable constructing count elements at the
+ * pointer it receives, destroying them again if it throws.
+ * @return pointer - the first new element.
+ */
+template <typename V, typename Allocator>
+template <typename Construct>
+auto vector<V, Allocator>::reallocateWithGap(size_type pos, size_type count,
+                                             size_type capacity,
+                                             Construct construct) -> pointer {
+  if (capacity > max_size()) {
+    throw std::length_error("vector - size greater than max_size()");
+  }
+
+  pointer arr = allocateArray(capacity);
+  pointer gap = arr + pos;
+
+  try {
+    construct(gap);
+  } catch (...) {
+    freeArray(arr, 0, capacity);
+    throw;
+  }
+
+  if constexpr (kRelocatable) {
+    moveBytes(arr_, arr_ + pos, arr);
+
+    if (pos != size_) {
+      moveBytes(arr_ + pos, arr_ + size_, gap + count);
+    }
+
+    freeArray(arr_, 0, capacity_);
+  } else {
+    pointer head = arr;
+
+    try {
+      head = relocate(arr_, arr_ + pos, arr);
+      relocate(arr_ + pos, arr_ + size_, gap + count);
+    } catch (...) {
+      destroyRange(arr, head);
+      destroyRange(gap, gap + count);
+      freeArray(arr, 0, capacity);
+      throw;
+    }
+
+    freeArray(arr_, size_, capacity_);
+  }
+
+  arr_ = arr;
+  size_ += count;
+  capacity_ = capacity;
+
+  return gap;
+}
+
+/**
+ * @brief Replaces the elements with copies of a range in a new storage.
+ *
+ * @details
+ * The copies are built in the new storage before the old one is freed, so
+ * the vector is left unchanged if a copy throws.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ * @param[in] capacity The capacity of the new storage, not less than the
+ * length of the range.
+ */
+template <typename V, typename Allocator>
+template <typename InputIt>
+void vector<V, Allocator>::assignRange(InputIt first, InputIt last,
+                                       size_type capacity) {
+  pointer arr = allocateArray(capacity);
+  size_type size{};
+
+  try {
+    size = constructRange(first, last, arr) - arr;
+  } catch (...) {
+    freeArray(arr, 0, capacity);
+    throw;
+  }
+
+  freeMemory();
+  arr_ = arr;
+  size_ = size;
+  capacity_ = capacity;
+}
+
+/**
+ * @brief Inserts the elements of a range before pos without reallocating.
+ *
+ * @details
+ * The elements after pos are shifted by count places first. Trivially
+ * relocatable elements are shifted as bytes and shifted back if a copy
+ * throws; the others are moved, with the part of the range that lands past
+ * the old end constructed and the rest assigned.
+ *
+ * @tparam ForwardIt The type of the forward iterators.
+ * @param[in] pos The place of the first new element.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ * @param[in] count The length of the range, which fits into the capacity.
+ */
+template <typename V, typename Allocator>
+template <typename ForwardIt>
+void vector<V, Allocator>::insertInPlace(pointer pos, ForwardIt first,
+                                         ForwardIt last, size_type count) {
+  pointer end = arr_ + size_;
+  size_type after = static_cast<size_type>(end - pos);
+
+  if constexpr (kRelocatable) {
+    moveBytes(pos, end, pos + count);
+
+    try {
+      constructRange(first, last, pos);
+    } catch (...) {
+      moveBytes(pos + count, end + count, pos);
+      throw;
+    }
+
+    size_ += count;
+  } else if (after > count) {
+    relocate(end - count, end, end);
+    size_ += count;
+    std::move_backward(pos, end - count, end);
+    std::copy(first, last, pos);
+  } else {
+    ForwardIt mid = std::next(first, after);
+
+    constructRange(mid, last, end);
+    size_ += count - after;
+    relocate(pos, end, arr_ + size_);
+    size_ += after;
+    std::copy(first, mid, pos);
+  }
+}
+
+/**
+ * @brief Constructs copies of a range in uninitialized storage.
+ *
+ * @details
+ * If a constructor throws, the elements constructed so far are destroyed.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ * @param[in] dest The uninitialized storage to construct the elements in.
+ * @return pointer - the end of the constructed elements.
+ */
+template <typename V, typename Allocator>
+template <typename InputIt>
+auto vector<V, Allocator>::constructRange(InputIt first, InputIt last,
+                                          pointer dest) -> pointer {
+  pointer current = dest;
+
+  try {
+    for (; first != last; ++first, ++current) {
+      alloc_traits::construct(alloc_, current, *first);
+    }
+  } catch (...) {
+    destroyRange(dest, current);
+    throw;
+  }
+
+  return current;
+}
+
+/**
+ * @brief Constructs copies of a value in uninitialized storage.
+ *
+ * @details
+ * If a constructor throws, the elements constructed so far are destroyed.
+ *
+ * @param[in] dest The uninitialized storage to construct the elements in.
+ * @param[in] count The number of copies.
+ * @param[in] value The value to copy.
+ */
+template <typename V, typename Allocator>
+void vector<V, Allocator>::constructFill(pointer dest, size_type count,
+                                         const_reference value) {
+  size_type constructed{};
+
+  try {
+    for (; constructed < count; ++constructed) {
+      alloc_traits::construct(alloc_, dest + constructed, value);
+    }
+  } catch (...) {
+    destroyRange(dest, dest + constructed);
+    throw;
+  }
+}
+
+/**
+ * @brief Constructs value-initialized elements in uninitialized storage.
+ *
+ * @details
+ * If a constructor throws, the elements constructed so far are destroyed.
+ *
+ * @param[in] dest The uninitialized storage to construct the elements in.
+ * @param[in] count The number of elements.
+ */
+template <typename V, typename Allocator>
+void vector<V, Allocator>::constructDefault(pointer dest, size_type count) {
+  size_type constructed{};
+
+  try {
+    for (; constructed < count; ++constructed) {
+      alloc_traits::construct(alloc_, dest + constructed);
+    }
+  } catch (...) {
+    destroyRange(dest, dest + constructed);
+    throw;
+  }
+}
+
+/**
+ * @brief Constructs the elements of a range in uninitialized storage by
+ * moving them if that can not throw, and by copying them otherwise.
+ *
+ * @details
+ * This is the rule of std::move_if_noexcept: a throwing move could leave both
+ * the source and the destination incomplete, while a throwing copy leaves the
+ * source intact. Types that can not be copied are moved anyway. The source
+ * elements are not destroyed.
+ *
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ * @param[in] dest The uninitialized storage to construct the elements in.
+ * @return pointer - the end of the constructed elements.
+ */
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::relocate(pointer first, pointer last, pointer dest)
+    -> pointer {
+  if constexpr (std::is_nothrow_move_constructible_v<value_type> ||
+                !std::is_copy_constructible_v<value_type>) {
+    return constructRange(std::make_move_iterator(first),
+                          std::make_move_iterator(last), dest);
+  } else {
+    return constructRange(first, last, dest);
+  }
+}
+
+/**
+ * @brief Moves trivially relocatable elements to other storage as bytes.
+ *
+ * @details
+ * The ranges may overlap. The elements at dest take over the lifetime of the
+ * source elements, which must be neither used nor destroyed afterwards.
+ *
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ * @param[in] dest The storage to move the elements to.
+ */
+template <typename V, typename Allocator>
+void vector<V, Allocator>::moveBytes(pointer first, pointer last,
+                                     pointer dest) noexcept {
+  if (first != last) {
+    std::memmove(static_cast<void *>(dest), static_cast<const void *>(first),
+                 static_cast<size_type>(last - first) * sizeof(value_type));
+  }
+}
+
+/**
+ * @brief Destroys the elements of a range.
+ *
+ * @param[in] first The beginning of the range.
+ * @param[in] last The end of the range.
+ */
+template <typename V, typename Allocator>
+void vector<V, Allocator>::destroyRange(pointer first, pointer last) noexcept {
+  for (; first != last; ++first) {
+    alloc_traits::destroy(alloc_, first);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -763,16 +1664,19 @@ void vector<V>::freeMemory() noexcept {
  *
  * @param[in] ptr Pointer to the element.
  */
-template <typename V>
-vector<V>::const_iterator::VectorConstIterator(const pointer ptr) : ptr_{ptr} {}
+template <typename V, typename Allocator>
+vector<V, Allocator>::const_iterator::VectorConstIterator(
+    value_type *const ptr)
+    : ptr_{ptr} {}
 
 /**
  * @brief Copy constructor from other const_iterator.
  *
  * @param[in] other The const_iterator to copy from.
  */
-template <typename V>
-vector<V>::const_iterator::VectorConstIterator(const const_iterator &other)
+template <typename V, typename Allocator>
+vector<V, Allocator>::const_iterator::VectorConstIterator(
+    const const_iterator &other)
     : ptr_{other.ptr_} {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -790,8 +1694,9 @@ vector<V>::const_iterator::VectorConstIterator(const const_iterator &other)
  * @return pointer - a raw pointer to the underlying element of type value_type
  * that the const_iterator points to.
  */
-template <typename V>
-auto vector<V>::const_iterator::base() const noexcept -> pointer {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::base() const noexcept
+    -> value_type * {
   return ptr_;
 }
 
@@ -802,8 +1707,9 @@ auto vector<V>::const_iterator::base() const noexcept -> pointer {
  * const_iterator.
  * @throw std::invalid_argument - if the const_iterator is empty.
  */
-template <typename V>
-auto vector<V>::const_iterator::operator*() const -> const_reference {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator*() const
+    -> const_reference {
   if (!ptr_) {
     throw std::invalid_argument(
         "const_iterator::operator* - try to dereference an empty iterator");
@@ -818,8 +1724,9 @@ auto vector<V>::const_iterator::operator*() const -> const_reference {
  * @param[in] other The const_iterator to assign from.
  * @return const_iterator - reference to the updated const_iterator.
  */
-template <typename V>
-auto vector<V>::const_iterator::operator=(const const_iterator &other) noexcept
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator=(
+    const const_iterator &other) noexcept
     -> const_iterator & {
   ptr_ = other.ptr_;
 
@@ -832,9 +1739,9 @@ auto vector<V>::const_iterator::operator=(const const_iterator &other) noexcept
  * @param[in] ptr Pointer to the element.
  * @return const_iterator - reference to the updated const_iterator.
  */
-template <typename V>
-auto vector<V>::const_iterator::operator=(const pointer ptr) noexcept
-    -> const_iterator & {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator=(
+    value_type *const ptr) noexcept -> const_iterator & {
   ptr_ = ptr;
 
   return *this;
@@ -845,8 +1752,9 @@ auto vector<V>::const_iterator::operator=(const pointer ptr) noexcept
  *
  * @return reference - reference to the updated const_iterator.
  */
-template <typename V>
-auto vector<V>::const_iterator::operator--() noexcept -> const_iterator & {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator--() noexcept
+    -> const_iterator & {
   ptr_--;
 
   return *this;
@@ -857,8 +1765,9 @@ auto vector<V>::const_iterator::operator--() noexcept -> const_iterator & {
  *
  * @return const_iterator - copy of the const_iterator before the decrement.
  */
-template <typename V>
-auto vector<V>::const_iterator::operator--(int) noexcept -> const_iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator--(int) noexcept
+    -> const_iterator {
   const_iterator copy{*this};
   ptr_--;
 
@@ -870,8 +1779,9 @@ auto vector<V>::const_iterator::operator--(int) noexcept -> const_iterator {
  *
  * @return reference - reference to the updated const_iterator.
  */
-template <typename V>
-auto vector<V>::const_iterator::operator++() noexcept -> const_iterator & {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator++() noexcept
+    -> const_iterator & {
   ++ptr_;
 
   return *this;
@@ -882,8 +1792,9 @@ auto vector<V>::const_iterator::operator++() noexcept -> const_iterator & {
  *
  * @return const_iterator - copy of the const_iterator before the increment.
  */
-template <typename V>
-auto vector<V>::const_iterator::operator++(int) noexcept -> const_iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator++(int) noexcept
+    -> const_iterator {
   const_iterator copy{*this};
   ++ptr_;
 
@@ -898,9 +1809,9 @@ auto vector<V>::const_iterator::operator++(int) noexcept -> const_iterator {
  * @return const_iterator - new const_iterator shifted by the specified
  * positions.
  */
-template <typename V>
-auto vector<V>::const_iterator::operator-(const int shift) const noexcept
-    -> const_iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator-(
+    difference_type shift) const noexcept -> const_iterator {
   const_iterator copy{*this};
   copy.ptr_ -= shift;
 
@@ -911,12 +1822,13 @@ auto vector<V>::const_iterator::operator-(const int shift) const noexcept
  * @brief Difference operator to calculate the distance between two iterators.
  *
  * @param[in] other The other const_iterator to calculate the distance from.
- * @return size_type - distance between the iterators.
+ * @return difference_type - the number of positions from other to this
+ * const_iterator, negative if other comes after it.
  */
-template <typename V>
-auto vector<V>::const_iterator::operator-(
-    const const_iterator &other) const noexcept -> size_type {
-  return (ptr_ > other.ptr_) ? ptr_ - other.ptr_ : other.ptr_ - ptr_;
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator-(
+    const const_iterator &other) const noexcept -> difference_type {
+  return ptr_ - other.ptr_;
 }
 
 /**
@@ -927,9 +1839,9 @@ auto vector<V>::const_iterator::operator-(
  * @return const_iterator - new const_iterator shifted by the specified
  * positions.
  */
-template <typename V>
-auto vector<V>::const_iterator::operator+(const int shift) const noexcept
-    -> const_iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator+(
+    difference_type shift) const noexcept -> const_iterator {
   const_iterator copy{*this};
   copy.ptr_ += shift;
 
@@ -941,10 +1853,14 @@ auto vector<V>::const_iterator::operator+(const int shift) const noexcept
  * number of positions.
  *
  * @param[in] shift Number of positions to shift.
+ * @return const_iterator& - reference to the updated const_iterator.
  */
-template <typename V>
-void vector<V>::const_iterator::operator-=(const int shift) noexcept {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator-=(
+    difference_type shift) noexcept -> const_iterator & {
   ptr_ -= shift;
+
+  return *this;
 }
 
 /**
@@ -952,10 +1868,14 @@ void vector<V>::const_iterator::operator-=(const int shift) noexcept {
  * number of positions.
  *
  * @param[in] shift Number of positions to shift.
+ * @return const_iterator& - reference to the updated const_iterator.
  */
-template <typename V>
-void vector<V>::const_iterator::operator+=(const int shift) noexcept {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator+=(
+    difference_type shift) noexcept -> const_iterator & {
   ptr_ += shift;
+
+  return *this;
 }
 
 /**
@@ -965,8 +1885,8 @@ void vector<V>::const_iterator::operator+=(const int shift) noexcept {
  * @return true - if the iterators are equal.
  * @return false - if the iterators are not equal.
  */
-template <typename V>
-bool vector<V>::const_iterator::operator==(
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::const_iterator::operator==(
     const_iterator other) const noexcept {
   return ptr_ == other.ptr_;
 }
@@ -978,12 +1898,77 @@ bool vector<V>::const_iterator::operator==(
  * @return true - if the iterators are not equal.
  * @return false - if the iterators are equal.
  */
-template <typename V>
-bool vector<V>::const_iterator::operator!=(
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::const_iterator::operator!=(
     const_iterator other) const noexcept {
   return ptr_ != other.ptr_;
 }
 
+/**
+ * @brief Ordering comparison operator.
+ *
+ * @param[in] other The other const_iterator to compare with.
+ * @return true - if the const_iterator points before other.
+ * @return false - otherwise.
+ */
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::const_iterator::operator<(
+    const_iterator other) const noexcept {
+  return ptr_ < other.ptr_;
+}
+
+/**
+ * @brief Ordering comparison operator.
+ *
+ * @param[in] other The other const_iterator to compare with.
+ * @return true - if the const_iterator points after other.
+ * @return false - otherwise.
+ */
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::const_iterator::operator>(
+    const_iterator other) const noexcept {
+  return ptr_ > other.ptr_;
+}
+
+/**
+ * @brief Ordering comparison operator.
+ *
+ * @param[in] other The other const_iterator to compare with.
+ * @return true - if the const_iterator points before or at other.
+ * @return false - otherwise.
+ */
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::const_iterator::operator<=(
+    const_iterator other) const noexcept {
+  return ptr_ <= other.ptr_;
+}
+
+/**
+ * @brief Ordering comparison operator.
+ *
+ * @param[in] other The other const_iterator to compare with.
+ * @return true - if the const_iterator points after or at other.
+ * @return false - otherwise.
+ */
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::const_iterator::operator>=(
+    const_iterator other) const noexcept {
+  return ptr_ >= other.ptr_;
+}
+
+/**
+ * @brief Subscript operator, the element shift positions away.
+ *
+ * @param[in] shift Number of positions to shift.
+ * @return const_reference - reference to the element at *this + shift.
+ * @throw std::invalid_argument - if the const_iterator is empty.
+ */
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::const_iterator::operator[](
+    difference_type shift) const -> const_reference {
+  return *(*this + shift);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                            ITERATOR CONSTRUCTORS                           //
 ////////////////////////////////////////////////////////////////////////////////
@@ -997,16 +1982,17 @@ bool vector<V>::const_iterator::operator!=(
  *
  * @param[in] ptr Pointer to the element.
  */
-template <typename V>
-vector<V>::iterator::VectorIterator(const pointer ptr) : ptr_{ptr} {}
+template <typename V, typename Allocator>
+vector<V, Allocator>::iterator::VectorIterator(const pointer ptr) : ptr_{ptr} {}
 
 /**
  * @brief Copy constructor from other iterator.
  *
  * @param[in] other The iterator to copy from.
  */
-template <typename V>
-vector<V>::iterator::VectorIterator(const iterator &other) : ptr_{other.ptr_} {}
+template <typename V, typename Allocator>
+vector<V, Allocator>::iterator::VectorIterator(const iterator &other)
+    : ptr_{other.ptr_} {}
 
 ////////////////////////////////////////////////////////////////////////////////
 //                             ITERATOR OPERATORS                             //
@@ -1023,8 +2009,8 @@ vector<V>::iterator::VectorIterator(const iterator &other) : ptr_{other.ptr_} {}
  * @return pointer - a raw pointer to the underlying element of type value_type
  * that the iterator points to.
  */
-template <typename V>
-auto vector<V>::iterator::base() const noexcept -> pointer {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::base() const noexcept -> pointer {
   return ptr_;
 }
 
@@ -1034,8 +2020,8 @@ auto vector<V>::iterator::base() const noexcept -> pointer {
  * @param[in] other The iterator to assign from.
  * @return iterator - reference to the updated iterator.
  */
-template <typename V>
-auto vector<V>::iterator::operator=(const iterator &other) noexcept
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator=(const iterator &other) noexcept
     -> iterator & {
   ptr_ = other.ptr_;
 
@@ -1048,8 +2034,9 @@ auto vector<V>::iterator::operator=(const iterator &other) noexcept
  * @param[in] ptr Pointer to the element.
  * @return iterator - reference to the updated iterator.
  */
-template <typename V>
-auto vector<V>::iterator::operator=(const pointer ptr) noexcept -> iterator & {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator=(const pointer ptr) noexcept
+    -> iterator & {
   ptr_ = ptr;
 
   return *this;
@@ -1060,8 +2047,8 @@ auto vector<V>::iterator::operator=(const pointer ptr) noexcept -> iterator & {
  *
  * @return reference - reference to the updated iterator.
  */
-template <typename V>
-auto vector<V>::iterator::operator--() noexcept -> iterator & {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator--() noexcept -> iterator & {
   ptr_--;
 
   return *this;
@@ -1072,8 +2059,8 @@ auto vector<V>::iterator::operator--() noexcept -> iterator & {
  *
  * @return iterator - copy of the iterator before the decrement.
  */
-template <typename V>
-auto vector<V>::iterator::operator--(int) noexcept -> iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator--(int) noexcept -> iterator {
   iterator copy{*this};
   ptr_--;
 
@@ -1085,8 +2072,8 @@ auto vector<V>::iterator::operator--(int) noexcept -> iterator {
  *
  * @return reference - reference to the updated iterator.
  */
-template <typename V>
-auto vector<V>::iterator::operator++() noexcept -> iterator & {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator++() noexcept -> iterator & {
   ++ptr_;
 
   return *this;
@@ -1097,8 +2084,8 @@ auto vector<V>::iterator::operator++() noexcept -> iterator & {
  *
  * @return iterator - copy of the iterator before the increment.
  */
-template <typename V>
-auto vector<V>::iterator::operator++(int) noexcept -> iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator++(int) noexcept -> iterator {
   iterator copy{*this};
   ++ptr_;
 
@@ -1113,9 +2100,9 @@ auto vector<V>::iterator::operator++(int) noexcept -> iterator {
  * @return iterator - new iterator shifted by the specified
  * positions.
  */
-template <typename V>
-auto vector<V>::iterator::operator-(const int shift) const noexcept
-    -> iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator-(
+    difference_type shift) const noexcept -> iterator {
   iterator copy{*this};
   copy.ptr_ -= shift;
 
@@ -1126,12 +2113,13 @@ auto vector<V>::iterator::operator-(const int shift) const noexcept
  * @brief Difference operator to calculate the distance between two iterators.
  *
  * @param[in] other The other iterator to calculate the distance from.
- * @return size_type - distance between the iterators.
+ * @return difference_type - the number of positions from other to this
+ * iterator, negative if other comes after it.
  */
-template <typename V>
-auto vector<V>::iterator::operator-(const iterator &other) const noexcept
-    -> size_type {
-  return (ptr_ > other.ptr_) ? ptr_ - other.ptr_ : other.ptr_ - ptr_;
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator-(
+    const iterator &other) const noexcept -> difference_type {
+  return ptr_ - other.ptr_;
 }
 
 /**
@@ -1142,9 +2130,9 @@ auto vector<V>::iterator::operator-(const iterator &other) const noexcept
  * @return iterator - new iterator shifted by the specified
  * positions.
  */
-template <typename V>
-auto vector<V>::iterator::operator+(const int shift) const noexcept
-    -> iterator {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator+(
+    difference_type shift) const noexcept -> iterator {
   iterator copy{*this};
   copy.ptr_ += shift;
 
@@ -1156,10 +2144,14 @@ auto vector<V>::iterator::operator+(const int shift) const noexcept
  * number of positions.
  *
  * @param[in] shift Number of positions to shift.
+ * @return iterator& - reference to the updated iterator.
  */
-template <typename V>
-void vector<V>::iterator::operator-=(const int shift) noexcept {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator-=(difference_type shift) noexcept
+    -> iterator & {
   ptr_ -= shift;
+
+  return *this;
 }
 
 /**
@@ -1167,10 +2159,14 @@ void vector<V>::iterator::operator-=(const int shift) noexcept {
  * number of positions.
  *
  * @param[in] shift Number of positions to shift.
+ * @return iterator& - reference to the updated iterator.
  */
-template <typename V>
-void vector<V>::iterator::operator+=(const int shift) noexcept {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator+=(difference_type shift) noexcept
+    -> iterator & {
   ptr_ += shift;
+
+  return *this;
 }
 
 /**
@@ -1180,8 +2176,8 @@ void vector<V>::iterator::operator+=(const int shift) noexcept {
  * @return true - if the iterators are equal.
  * @return false - if the iterators are not equal.
  */
-template <typename V>
-bool vector<V>::iterator::operator==(iterator other) const noexcept {
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::iterator::operator==(iterator other) const noexcept {
   return ptr_ == other.ptr_;
 }
 
@@ -1192,19 +2188,80 @@ bool vector<V>::iterator::operator==(iterator other) const noexcept {
  * @return true - if the iterators are not equal.
  * @return false - if the iterators are equal.
  */
-template <typename V>
-bool vector<V>::iterator::operator!=(iterator other) const noexcept {
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::iterator::operator!=(iterator other) const noexcept {
   return ptr_ != other.ptr_;
 }
 
+/**
+ * @brief Ordering comparison operator.
+ *
+ * @param[in] other The other iterator to compare with.
+ * @return true - if the iterator points before other.
+ * @return false - otherwise.
+ */
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::iterator::operator<(iterator other) const noexcept {
+  return ptr_ < other.ptr_;
+}
+
+/**
+ * @brief Ordering comparison operator.
+ *
+ * @param[in] other The other iterator to compare with.
+ * @return true - if the iterator points after other.
+ * @return false - otherwise.
+ */
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::iterator::operator>(iterator other) const noexcept {
+  return ptr_ > other.ptr_;
+}
+
+/**
+ * @brief Ordering comparison operator.
+ *
+ * @param[in] other The other iterator to compare with.
+ * @return true - if the iterator points before or at other.
+ * @return false - otherwise.
+ */
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::iterator::operator<=(iterator other) const noexcept {
+  return ptr_ <= other.ptr_;
+}
+
+/**
+ * @brief Ordering comparison operator.
+ *
+ * @param[in] other The other iterator to compare with.
+ * @return true - if the iterator points after or at other.
+ * @return false - otherwise.
+ */
+template <typename V, typename Allocator>
+bool vector<V, Allocator>::iterator::operator>=(iterator other) const noexcept {
+  return ptr_ >= other.ptr_;
+}
+
+/**
+ * @brief Subscript operator, the element shift positions away.
+ *
+ * @param[in] shift Number of positions to shift.
+ * @return reference - reference to the element at *this + shift.
+ * @throw std::invalid_argument - if the iterator is empty.
+ */
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator[](
+    difference_type shift) const -> reference {
+  return *(*this + shift);
+}
+
 /**
  * @brief Dereference operator for non-constant access.
  *
  * @return reference - reference to the value pointed by the iterator.
  * @throw std::invalid_argument - if the iterator is empty.
  */
-template <typename V>
-auto vector<V>::iterator::operator*() -> reference {
+template <typename V, typename Allocator>
+auto vector<V, Allocator>::iterator::operator*() const -> reference {
   if (!ptr_) {
     throw std::invalid_argument(
         "iterator::operator* - try to dereference an empty iterator");
@@ -1213,6 +2270,18 @@ auto vector<V>::iterator::operator*() -> reference {
   return *ptr_;
 }
 
+namespace pmr {
+
+/**
+ * @brief Vector whose storage is taken from a std::pmr::memory_resource.
+ *
+ * @tparam V The type of the elements.
+ */
+template <typename V>
+using vector = s21::vector<V, std::pmr::polymorphic_allocator<V>>;
+
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif  // SRC_CONTAINERS_VECTOR_H_
@@ -21,5 +21,14 @@
 #include "./modules/vector.h"
 #include "./modules/array.h"
 #include "./modules/multiset.h"
+#include "./modules/pool_allocator.h"
+#include "./modules/btree_map.h"
+#include "./modules/btree_set.h"
+#include "./modules/btree_multiset.h"
+#include "./modules/flat_map.h"
+#include "./modules/flat_set.h"
+#include "./modules/flat_multiset.h"
+#include "./modules/unordered_map.h"
+#include "./modules/unordered_set.h"
 
 #endif  // _S21_CONTAINERS_H_
@@ -0,0 +1,225 @@
+/**
+ * @file btree_test.cc
+ * @author kossadda (https://github.com/kossadda)
+ * @brief B-tree containers testing module
+ * @version 1.0
+ * @date 2024-08-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "./../main_test.h"
+
+template <typename S21, typename STD>
+void compareBTree(const S21 &s21_c, const STD &std_c) {
+  ASSERT_EQ(s21_c.size(), std_c.size());
+  ASSERT_EQ(static_cast<std::size_t>(std::distance(s21_c.begin(), s21_c.end())),
+            std_c.size());
+
+  auto std_it = std_c.begin();
+
+  for (auto it = s21_c.begin(); it != s21_c.end(); ++it, ++std_it) {
+    ASSERT_TRUE(*it == *std_it);
+  }
+
+  auto std_rit = std_c.rbegin();
+
+  for (auto it = s21_c.end(); it != s21_c.begin(); ++std_rit) {
+    --it;
+    ASSERT_TRUE(*it == *std_rit);
+  }
+}
+
+TEST(btree, mapRandomInsertErase) {
+  s21::btree_map<const int, int> s21_m;
+  std::map<int, int> std_m;
+  std::mt19937 gen{7};
+
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(gen() % 5000);
+
+    if (gen() % 3) {
+      auto s21_res = s21_m.insert({key, i});
+      auto std_res = std_m.insert({key, i});
+      EXPECT_EQ(s21_res.second, std_res.second);
+      EXPECT_EQ((*s21_res.first).second, std_res.first->second);
+    } else {
+      EXPECT_EQ(s21_m.erase(key), std_m.erase(key));
+    }
+  }
+
+  compareBTree(s21_m, std_m);
+
+  for (int key = -1; key <= 5001; ++key) {
+    auto lower = s21_m.lower_bound(key);
+    auto upper = s21_m.upper_bound(key);
+    auto std_lower = std_m.lower_bound(key);
+    auto std_upper = std_m.upper_bound(key);
+
+    EXPECT_EQ(lower == s21_m.end(), std_lower == std_m.end());
+    EXPECT_EQ(upper == s21_m.end(), std_upper == std_m.end());
+    if (lower != s21_m.end()) {
+      EXPECT_EQ((*lower).first, std_lower->first);
+    }
+    if (upper != s21_m.end()) {
+      EXPECT_EQ((*upper).first, std_upper->first);
+    }
+    EXPECT_EQ(s21_m.contains(key), std_m.count(key) == 1);
+  }
+}
+
+TEST(btree, mapEraseByIteratorReturnsNext) {
+  s21::btree_map<const int, int> s21_m;
+  std::map<int, int> std_m;
+
+  for (int i = 0; i < 3000; ++i) {
+    s21_m.insert({i, i});
+    std_m.insert({i, i});
+  }
+
+  auto it = s21_m.begin();
+  auto std_it = std_m.begin();
+
+  while (it != s21_m.end()) {
+    if ((*it).first % 3) {
+      it = s21_m.erase(it);
+      std_it = std_m.erase(std_it);
+    } else {
+      ++it;
+      ++std_it;
+    }
+
+    if (it != s21_m.end()) {
+      ASSERT_EQ((*it).first, std_it->first);
+    }
+  }
+
+  compareBTree(s21_m, std_m);
+
+  it = s21_m.erase(s21_m.find(300), s21_m.find(2700));
+  std_m.erase(std_m.find(300), std_m.find(2700));
+
+  EXPECT_EQ((*it).first, 2700);
+  compareBTree(s21_m, std_m);
+
+  s21_m.erase(s21_m.begin(), s21_m.end());
+  EXPECT_TRUE(s21_m.empty());
+  EXPECT_TRUE(s21_m.begin() == s21_m.end());
+}
+
+TEST(btree, mapElementAccess) {
+  s21::btree_map<std::string, int> s21_m;
+
+  for (int i = 0; i < 500; ++i) s21_m[std::to_string(i)] += i;
+  for (int i = 0; i < 500; ++i) s21_m[std::to_string(i)] += i;
+
+  EXPECT_EQ(s21_m.size(), 500U);
+  EXPECT_EQ(s21_m.at("42"), 84);
+  EXPECT_THROW(s21_m.at("500"), std::out_of_range);
+  EXPECT_FALSE(s21_m.insert("42", 0).second);
+  EXPECT_TRUE(s21_m.insert_or_assign("600", 6).second);
+  EXPECT_FALSE(s21_m.insert_or_assign("42", 1).second);
+  EXPECT_EQ(s21_m.at("42"), 1);
+  EXPECT_EQ(s21_m.at("600"), 6);
+}
+
+/// @brief A mapped value that counts how often it is default-constructed.
+struct default_counted {
+  default_counted() { ++constructed; }
+
+  int value{};
+  static inline int constructed{};
+};
+
+TEST(btree, mapSubscriptConstructsOnlyOnMiss) {
+  s21::btree_map<int, default_counted> s21_m;
+
+  for (int i = 0; i < 100; ++i) s21_m[i].value = i;
+  EXPECT_EQ(default_counted::constructed, 100);
+
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(s21_m[i].value, i);
+  EXPECT_EQ(default_counted::constructed, 100);
+  EXPECT_EQ(s21_m.size(), 100U);
+}
+
+TEST(btree, setCopyMoveAndMerge) {
+  s21::btree_set<int> s1;
+  s21::btree_set<int> s2;
+  std::set<int> std_s1;
+  std::set<int> std_s2;
+
+  for (int i = 0; i < 4000; ++i) {
+    s1.insert(i * 3);
+    s2.insert(i * 2);
+    std_s1.insert(i * 3);
+    std_s2.insert(i * 2);
+  }
+
+  s21::btree_set<int> copy{s1};
+  compareBTree(copy, std_s1);
+
+  s1.merge(s2);
+  std_s1.merge(std_s2);
+  compareBTree(s1, std_s1);
+  compareBTree(s2, std_s2);
+
+  s21::btree_set<int> moved{std::move(s1)};
+  EXPECT_TRUE(s1.empty());
+  compareBTree(moved, std_s1);
+
+  copy = moved;
+  compareBTree(copy, std_s1);
+  s1 = std::move(copy);
+  compareBTree(s1, std_s1);
+
+  s1.swap(s2);
+  compareBTree(s2, std_s1);
+}
+
+TEST(btree, multisetKeepsDuplicates) {
+  s21::btree_multiset<std::string> s21_ms;
+  std::multiset<std::string> std_ms;
+  std::mt19937 gen{11};
+
+  for (int i = 0; i < 6000; ++i) {
+    std::string key(1 + gen() % 3, static_cast<char>('a' + gen() % 26));
+
+    if (gen() % 4) {
+      s21_ms.insert(key);
+      std_ms.insert(key);
+    } else {
+      EXPECT_EQ(s21_ms.erase(key), std_ms.erase(key));
+    }
+  }
+
+  compareBTree(s21_ms, std_ms);
+
+  for (char c = 'a'; c <= 'z'; ++c) {
+    std::string key(2, c);
+    auto range = s21_ms.equal_range(key);
+    auto length = std::distance(range.first, range.second);
+
+    EXPECT_EQ(s21_ms.count(key), std_ms.count(key));
+    EXPECT_EQ(static_cast<std::size_t>(length), std_ms.count(key));
+  }
+}
+
+TEST(btree, initializerListAndEmptyTree) {
+  s21::btree_multiset<int> ms{3, 1, 2, 3, 1};
+  std::multiset<int> std_ms{3, 1, 2, 3, 1};
+  s21::btree_set<int> empty;
+
+  compareBTree(ms, std_ms);
+  EXPECT_TRUE(empty.begin() == empty.end());
+  EXPECT_TRUE(empty.find(1) == empty.end());
+  EXPECT_EQ(empty.erase(1), 0U);
+  EXPECT_EQ(empty.size(), 0U);
+}
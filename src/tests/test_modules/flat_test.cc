@@ -0,0 +1,141 @@
+/**
+ * @file flat_test.cc
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Sorted vector containers testing module
+ * @version 1.0
+ * @date 2024-08-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "./../main_test.h"
+
+template <typename S21, typename STD>
+void compareFlat(const S21 &s21_c, const STD &std_c) {
+  ASSERT_EQ(s21_c.size(), std_c.size());
+
+  auto std_it = std_c.begin();
+
+  for (auto it = s21_c.begin(); it != s21_c.end(); ++it, ++std_it) {
+    ASSERT_TRUE(*it == typename S21::value_type(*std_it));
+  }
+}
+
+TEST(flat, mapRandomInsertErase) {
+  s21::flat_map<int, int> s21_m;
+  std::map<int, int> std_m;
+  std::mt19937 gen{5};
+
+  for (int i = 0; i < 6000; ++i) {
+    int key = static_cast<int>(gen() % 2000);
+
+    if (gen() % 3) {
+      auto s21_res = s21_m.insert({key, i});
+      auto std_res = std_m.insert({key, i});
+      EXPECT_EQ(s21_res.second, std_res.second);
+      EXPECT_EQ(s21_res.first->second, std_res.first->second);
+    } else {
+      EXPECT_EQ(s21_m.erase(key), std_m.erase(key));
+    }
+  }
+
+  compareFlat(s21_m, std_m);
+
+  for (int key = -1; key <= 2001; ++key) {
+    auto lower = s21_m.lower_bound(key);
+    auto std_lower = std_m.lower_bound(key);
+
+    EXPECT_EQ(lower == s21_m.end(), std_lower == std_m.end());
+    if (lower != s21_m.end()) {
+      EXPECT_EQ(lower->first, std_lower->first);
+    }
+    EXPECT_EQ(s21_m.contains(key), std_m.count(key) == 1);
+  }
+}
+
+TEST(flat, mapBulkInsertKeepsFirstValue) {
+  s21::flat_map<int, int> s21_m{{5, 0}, {1, 0}};
+  std::map<int, int> std_m{{5, 0}, {1, 0}};
+  std::vector<std::pair<int, int>> items;
+
+  for (int i = 0; i < 1000; ++i) items.push_back({(i * 37) % 400, i});
+
+  s21_m.insert(items.begin(), items.end());
+  std_m.insert(items.begin(), items.end());
+
+  compareFlat(s21_m, std_m);
+  EXPECT_EQ(s21_m.at(5), 0);
+  EXPECT_EQ(s21_m.at(37), std_m.at(37));
+  EXPECT_THROW(s21_m.at(400), std::out_of_range);
+}
+
+TEST(flat, mapElementAccess) {
+  s21::flat_map<std::string, int> s21_m;
+
+  for (int i = 0; i < 300; ++i) s21_m[std::to_string(i % 150)] += i;
+
+  EXPECT_EQ(s21_m.size(), 150U);
+  EXPECT_EQ(s21_m.at("42"), 42 + 192);
+  EXPECT_FALSE(s21_m.insert("42", 0).second);
+  EXPECT_TRUE(s21_m.insert_or_assign("a", 6).second);
+  EXPECT_FALSE(s21_m.insert_or_assign("42", 1).second);
+  EXPECT_EQ(s21_m.at("42"), 1);
+
+  auto next = s21_m.erase(s21_m.find("a"));
+  EXPECT_EQ(next, s21_m.end());
+}
+
+TEST(flat, setMergeLeavesDuplicates) {
+  s21::flat_set<int> s1{1, 3, 5, 7, 9};
+  s21::flat_set<int> s2{2, 3, 4, 7, 8, 10};
+  std::set<int> std_s1{1, 3, 5, 7, 9};
+  std::set<int> std_s2{2, 3, 4, 7, 8, 10};
+
+  s1.merge(s2);
+  std_s1.merge(std_s2);
+
+  compareFlat(s1, std_s1);
+  compareFlat(s2, std_s2);
+
+  s21::flat_set<int> copy{s1};
+  s1.clear();
+  EXPECT_TRUE(s1.empty());
+  compareFlat(copy, std_s1);
+
+  auto next = copy.erase(copy.begin() + 2, copy.begin() + 5);
+  EXPECT_EQ(*next, 7);
+  EXPECT_EQ(copy.size(), std_s1.size() - 3);
+}
+
+TEST(flat, multisetStringsAndMerge) {
+  s21::flat_multiset<std::string> s21_ms;
+  s21::flat_multiset<std::string> other;
+  std::multiset<std::string> std_ms;
+  std::vector<std::string> items;
+
+  for (int i = 0; i < 500; ++i) {
+    std::string key(1 + i % 3, static_cast<char>('a' + i % 7));
+
+    s21_ms.insert(key);
+    std_ms.insert(key);
+    items.push_back(key + "x");
+  }
+
+  other.insert(items.begin(), items.end());
+  s21_ms.merge(other);
+  std_ms.insert(items.begin(), items.end());
+
+  EXPECT_TRUE(other.empty());
+  compareFlat(s21_ms, std_ms);
+  EXPECT_EQ(s21_ms.count("aa"), std_ms.count("aa"));
+  EXPECT_EQ(s21_ms.erase("bx"), std_ms.erase("bx"));
+  compareFlat(s21_ms, std_ms);
+}
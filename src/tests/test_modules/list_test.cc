@@ -9,7 +9,12 @@
  *
  */
 
+#include <iterator>
 #include <list>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
 
 #include "../../s21_containers.h"
 #include "../main_test.h"
@@ -610,3 +615,193 @@ TEST(ListTest, EmplaseBack) {
   EXPECT_TRUE(compare_lists(std_l, s21_l, true));
   EXPECT_EQ(std_l.size(), s21_l.size());
 }
+
+TEST(ListTest, PmrMonotonicResource) {
+  char buffer[4096];
+  std::pmr::monotonic_buffer_resource resource{
+      buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+  std::list<int> std_l;
+  s21::pmr::list<int> s21_l{&resource};
+
+  for (int i = 0; i < 20; ++i) {
+    std_l.push_front(i);
+    s21_l.push_front(i);
+  }
+
+  EXPECT_EQ(s21_l.get_allocator().resource(), &resource);
+  EXPECT_TRUE(std::equal(std_l.begin(), std_l.end(), s21_l.begin()));
+
+  s21::pmr::list<int> copy{s21_l};
+
+  EXPECT_EQ(copy.get_allocator().resource(),
+            std::pmr::get_default_resource());
+  EXPECT_TRUE(copy == s21_l);
+}
+
+TEST(ListTest, PmrMoveAssignDifferentResources) {
+  std::pmr::monotonic_buffer_resource first_resource;
+  std::pmr::monotonic_buffer_resource second_resource;
+  s21::pmr::list<int> first({1, 2, 3}, &first_resource);
+  s21::pmr::list<int> second({4, 5}, &second_resource);
+
+  second = std::move(first);
+
+  EXPECT_EQ(second.get_allocator().resource(), &second_resource);
+  EXPECT_EQ(second.size(), 3U);
+  EXPECT_EQ(second.back(), 3);
+  EXPECT_TRUE(first.empty());
+}
+
+TEST(ListTest, MoveAssignMoveOnly) {
+  s21::list<std::unique_ptr<int>> first;
+  s21::list<std::unique_ptr<int>> second;
+  first.push_back(std::make_unique<int>(1));
+  second.push_back(std::make_unique<int>(2));
+
+  second = std::move(first);
+
+  ASSERT_EQ(second.size(), 1U);
+  EXPECT_EQ(*second.front(), 1);
+
+  std::pmr::monotonic_buffer_resource first_resource;
+  std::pmr::monotonic_buffer_resource second_resource;
+  s21::pmr::list<std::unique_ptr<int>> pmr_first{&first_resource};
+  s21::pmr::list<std::unique_ptr<int>> pmr_second{&second_resource};
+
+  for (int i = 0; i < 3; ++i) pmr_first.push_back(std::make_unique<int>(i));
+  pmr_second.push_back(std::make_unique<int>(10));
+
+  pmr_second = std::move(pmr_first);
+
+  EXPECT_EQ(pmr_second.get_allocator().resource(), &second_resource);
+  ASSERT_EQ(pmr_second.size(), 3U);
+  EXPECT_EQ(*pmr_second.back(), 2);
+  EXPECT_TRUE(pmr_first.empty());
+}
+
+TEST(ListTest, PoolAllocatorMoveAssign) {
+  s21::list<int, s21::pool_allocator<int>> first{1, 2, 3};
+  s21::list<int, s21::pool_allocator<int>> second{4, 5};
+  auto alloc = first.get_allocator();
+
+  second = std::move(first);
+
+  EXPECT_TRUE(second.get_allocator() == alloc);
+  EXPECT_EQ(second.size(), 3U);
+  EXPECT_EQ(second.front(), 1);
+}
+
+TEST(ListTest, InsertRange) {
+  std::list<std::string> std_list{"a", "b", "c"};
+  s21::list<std::string> s21_list{"a", "b", "c"};
+  std::string items[] = {"x", "y", "z"};
+
+  auto it = s21_list.insert(++s21_list.cbegin(), std::begin(items),
+                            std::end(items));
+  std_list.insert(++std_list.cbegin(), std::begin(items), std::end(items));
+
+  EXPECT_EQ(*it, "x");
+  EXPECT_TRUE(compare_lists(std_list, s21_list, true));
+
+  s21_list.insert(s21_list.cbegin(), {"p", "q"});
+  std_list.insert(std_list.cbegin(), {"p", "q"});
+  s21_list.insert(s21_list.cend(), {"r"});
+  std_list.insert(std_list.cend(), {"r"});
+  it = s21_list.insert(s21_list.cend(), std::begin(items), std::begin(items));
+
+  EXPECT_TRUE(it == s21_list.end());
+  EXPECT_EQ(s21_list.front(), "p");
+  EXPECT_EQ(s21_list.back(), "r");
+  EXPECT_TRUE(compare_lists(std_list, s21_list, true));
+
+  s21::list<std::string> empty;
+  empty.insert(empty.cbegin(), std::begin(items), std::end(items));
+  EXPECT_EQ(empty.front(), "x");
+  EXPECT_EQ(empty.back(), "z");
+  EXPECT_EQ(empty.size(), 3U);
+}
+
+TEST(ListTest, AssignRange) {
+  std::list<int> std_list{1, 2, 3, 4, 5};
+  s21::list<int> s21_list{1, 2, 3, 4, 5};
+  std::vector<int> items{7, 8};
+
+  s21_list.assign(items.begin(), items.end());
+  std_list.assign(items.begin(), items.end());
+  EXPECT_TRUE(compare_lists(std_list, s21_list, true));
+
+  s21_list.assign({9, 10, 11, 12});
+  std_list.assign({9, 10, 11, 12});
+  EXPECT_TRUE(compare_lists(std_list, s21_list, true));
+  EXPECT_EQ(s21_list.back(), 12);
+
+  s21_list.assign(items.end(), items.end());
+  EXPECT_TRUE(s21_list.empty());
+}
+
+TEST(ListTest, AppendRange) {
+  std::list<int> std_list{1, 2};
+  s21::list<int> s21_list{1, 2};
+  s21::vector<int> numbers{3, 4, 5};
+  s21::list<int> more{6, 7};
+
+  s21_list.append_range(numbers);
+  s21_list.append_range(more);
+  std_list.insert(std_list.end(), {3, 4, 5, 6, 7});
+  EXPECT_TRUE(compare_lists(std_list, s21_list, true));
+
+  s21::vector<int> back;
+  back.append_range(s21_list);
+  EXPECT_EQ(back.size(), 7U);
+  EXPECT_EQ(back.capacity(), 7U);
+  EXPECT_EQ(back[6], 7);
+}
+
+/// @brief A value built from two numbers that counts its copies.
+struct copy_counter {
+  copy_counter(int first = 0, int second = 0) : value{first * 10 + second} {}
+  copy_counter(const copy_counter &other) : value{other.value} { ++copies; }
+  copy_counter(copy_counter &&other) noexcept : value{other.value} {}
+
+  int value;
+  static inline int copies{};
+};
+
+TEST(ListTest, RvaluesAreMovedIn) {
+  s21::list<std::unique_ptr<int>> s21_l;
+  auto last = std::make_unique<int>(3);
+
+  s21_l.push_back(std::make_unique<int>(2));
+  s21_l.push_front(std::make_unique<int>(1));
+  s21_l.insert(s21_l.cend(), std::move(last));
+  s21_l.emplace(s21_l.cbegin(), new int{0});
+
+  int expected = 0;
+
+  for (auto it = s21_l.cbegin(); it != s21_l.cend(); ++it) {
+    EXPECT_EQ(**it, expected++);
+  }
+
+  EXPECT_EQ(s21_l.size(), 4U);
+  EXPECT_FALSE(last);
+}
+
+TEST(ListTest, EmplaceConstructsInPlace) {
+  s21::list<copy_counter> s21_l;
+
+  s21_l.emplace_back(1, 2);
+  s21_l.emplace_front(3, 4);
+  s21_l.emplace(++s21_l.cbegin(), 5, 6);
+  s21_l.push_back(copy_counter{7, 8});
+  s21_l.insert(s21_l.cbegin(), copy_counter{9, 0});
+
+  EXPECT_EQ(copy_counter::copies, 0);
+
+  s21_l.push_back(s21_l.front());
+
+  EXPECT_EQ(copy_counter::copies, 1);
+  EXPECT_EQ(s21_l.front().value, 90);
+  EXPECT_EQ(s21_l.back().value, 90);
+  EXPECT_EQ((*++s21_l.cbegin()).value, 34);
+  EXPECT_EQ(s21_l.size(), 6U);
+}
@@ -9,7 +9,16 @@
  *
  */
 
+#include <algorithm>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "./../main_test.h"
 
@@ -327,6 +336,50 @@ TEST(map, clear) {
   compare(s21_m, std_m);
 }
 
+TEST(map, eraseRangesOfLargeMap) {
+  s21_map s21_m;
+  std_map std_m;
+
+  for (int i = 0; i < 3000; ++i) {
+    s21_m.insert({(i * 7919) % 3000, i});
+    std_m.insert({(i * 7919) % 3000, i});
+  }
+
+  for (int round = 0; round < 40; ++round) {
+    int from = (round * 389) % 3000;
+    int to = from + 1 + round * 3;
+
+    auto s21_it = s21_m.erase(s21_m.lower_bound(from), s21_m.lower_bound(to));
+    auto std_it = std_m.erase(std_m.lower_bound(from), std_m.lower_bound(to));
+
+    ASSERT_EQ(s21_it == s21_m.end(), std_it == std_m.end());
+    if (std_it != std_m.end()) {
+      EXPECT_EQ((*s21_it).first, std_it->first);
+    }
+
+    s21_m.insert({from, round});
+    std_m.insert({from, round});
+  }
+
+  compare(s21_m, std_m);
+
+  for (int i = 0; i < 3000; ++i) {
+    s21_m.erase(i);
+    std_m.erase(i);
+  }
+
+  EXPECT_TRUE(s21_m.empty());
+}
+
+TEST(map, eraseInvalidRange) {
+  s21_map s21_m = {{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
+  s21_map other = {{1, 1}, {2, 2}};
+
+  EXPECT_THROW(s21_m.erase(s21_m.find(4), s21_m.find(2)), std::range_error);
+  EXPECT_THROW(s21_m.erase(other.begin(), s21_m.end()), std::range_error);
+  EXPECT_EQ(s21_m.size(), 5U);
+}
+
 TEST(map, contains) {
   s21_map s21_m = {{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
   std_map std_m = {{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
@@ -335,6 +388,24 @@ TEST(map, contains) {
   EXPECT_FALSE(s21_m.conatains(6));
 }
 
+TEST(map, bounds) {
+  s21_map s21_m = {{10, 1}, {20, 2}, {30, 3}, {40, 4}, {50, 5}};
+  std_map std_m = {{10, 1}, {20, 2}, {30, 3}, {40, 4}, {50, 5}};
+
+  for (int key : {5, 10, 25, 45}) {
+    EXPECT_EQ((*s21_m.lower_bound(key)).first, (*std_m.lower_bound(key)).first);
+    EXPECT_EQ((*s21_m.upper_bound(key)).first, (*std_m.upper_bound(key)).first);
+    EXPECT_EQ(s21_m.count(key), std_m.count(key));
+  }
+
+  EXPECT_EQ(s21_m.lower_bound(55), s21_m.end());
+  EXPECT_EQ(s21_m.upper_bound(50), s21_m.end());
+
+  auto range = s21_m.equal_range(30);
+  EXPECT_EQ((*range.first).second, 3);
+  EXPECT_EQ((*range.second).second, 4);
+}
+
 TEST(map, at) {
   s21_map s21_m = {{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
   std_map std_m = {{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
@@ -399,3 +470,367 @@ TEST(map, merge_2) {
   compare(s21_m1, std_m1);
   compare(s21_m2, std_m2);
 }
+
+TEST(map, mergeLargeOverlapping) {
+  for (int step : {1, 3, 97}) {
+    s21_map s21_m1;
+    s21_map s21_m2;
+    std_map std_m1;
+    std_map std_m2;
+
+    for (int i = 0; i < 5000; ++i) {
+      s21_m1.insert({i * 2, i});
+      std_m1.insert({i * 2, i});
+    }
+
+    for (int i = 0; i < 5000; i += step) {
+      s21_m2.insert({i * 3, -i});
+      std_m2.insert({i * 3, -i});
+    }
+
+    s21_m1.merge(s21_m2);
+    std_m1.merge(std_m2);
+
+    compare(s21_m1, std_m1);
+    compare(s21_m2, std_m2);
+
+    for (int i = 0; i < 15000; i += 5) {
+      s21_m1.erase(i);
+      std_m1.erase(i);
+      s21_m2.insert({i, i});
+      std_m2.insert({i, i});
+    }
+
+    compare(s21_m1, std_m1);
+    compare(s21_m2, std_m2);
+  }
+}
+
+TEST(map, pmrResource) {
+  std::pmr::monotonic_buffer_resource resource;
+  s21::pmr::map<const int, int> s21_m{&resource};
+  std_map std_m;
+
+  for (int i = 0; i < 200; ++i) {
+    s21_m.insert({(i * 37) % 200, i});
+    std_m.insert({(i * 37) % 200, i});
+  }
+
+  for (int i = 0; i < 200; i += 2) {
+    s21_m.erase(i);
+    std_m.erase(i);
+  }
+
+  EXPECT_EQ(s21_m.get_allocator().resource(), &resource);
+  EXPECT_EQ(s21_m.size(), std_m.size());
+
+  for (auto &[key, value] : std_m) {
+    EXPECT_EQ(s21_m.at(key), value);
+  }
+}
+
+TEST(map, transparentLookup) {
+  s21::map<std::string, int, std::less<>> s21_m{
+      {"alpha", 1}, {"beta", 2}, {"delta", 4}, {"gamma", 3}};
+  std::map<std::string, int, std::less<>> std_m{
+      {"alpha", 1}, {"beta", 2}, {"delta", 4}, {"gamma", 3}};
+
+  for (std::string_view key : {"alpha", "beta", "c", "delta", "zeta"}) {
+    EXPECT_EQ(s21_m.contains(key), std_m.count(key) != 0);
+    EXPECT_EQ(s21_m.count(key), std_m.count(key));
+    EXPECT_EQ(s21_m.find(key) == s21_m.end(), std_m.find(key) == std_m.end());
+
+    auto s21_lower = s21_m.lower_bound(key);
+    auto std_lower = std_m.lower_bound(key);
+    ASSERT_EQ(s21_lower == s21_m.end(), std_lower == std_m.end());
+    if (std_lower != std_m.end()) {
+      EXPECT_EQ((*s21_lower).first, std_lower->first);
+    }
+
+    auto s21_upper = s21_m.upper_bound(key);
+    auto std_upper = std_m.upper_bound(key);
+    ASSERT_EQ(s21_upper == s21_m.end(), std_upper == std_m.end());
+    if (std_upper != std_m.end()) {
+      EXPECT_EQ((*s21_upper).first, std_upper->first);
+    }
+  }
+
+  EXPECT_EQ((*s21_m.find("delta")).second, 4);
+}
+
+TEST(map, customComparator) {
+  s21::map<int, int, std::greater<int>> s21_m{{1, 1}, {5, 5}, {3, 3}};
+  std::map<int, int, std::greater<int>> std_m{{1, 1}, {5, 5}, {3, 3}};
+
+  auto std_it = std_m.begin();
+
+  for (auto it = s21_m.begin(); it != s21_m.end(); ++it, ++std_it) {
+    EXPECT_EQ((*it).first, std_it->first);
+  }
+
+  EXPECT_TRUE(s21_m.key_comp()(5, 3));
+  EXPECT_EQ((*s21_m.lower_bound(4)).first, std_m.lower_bound(4)->first);
+}
+
+TEST(map, fromSorted) {
+  std::vector<std::pair<const int, int>> items;
+  std_map std_m;
+
+  for (int i = 0; i < 1000; ++i) {
+    items.push_back({i * 3, i});
+    std_m.insert({i * 3, i});
+  }
+
+  auto s21_m = s21_map::from_sorted(items.begin(), items.end());
+
+  compare(s21_m, std_m);
+  EXPECT_EQ((*s21_m.nth(500)).first, 1500);
+  EXPECT_EQ(s21_m.rank(1500), 500U);
+
+  for (int i = 0; i < 3000; i += 7) {
+    s21_m.insert({i, -i});
+    std_m.insert({i, -i});
+    s21_m.erase(i + 3);
+    std_m.erase(i + 3);
+  }
+
+  compare(s21_m, std_m);
+
+  s21_m.assign_sorted(items.begin(), items.begin());
+  EXPECT_TRUE(s21_m.empty());
+}
+
+TEST(map, assignSortedChecked) {
+  std::vector<std::pair<const int, int>> sorted{{1, 1}, {2, 2}, {4, 4}};
+  std::vector<std::pair<const int, int>> unsorted{
+      {5, 1}, {2, 2}, {5, 3}, {9, 4}, {1, 5}, {2, 6}};
+  s21_map s21_m{{7, 7}};
+
+  s21_m.assign_sorted_checked(sorted.begin(), sorted.end());
+  compare(s21_m, std_map(sorted.begin(), sorted.end()));
+
+  s21_m.assign_sorted_checked(unsorted.begin(), unsorted.end());
+  compare(s21_m, std_map(unsorted.begin(), unsorted.end()));
+  EXPECT_EQ(s21_m.at(5), 1);
+}
+
+TEST(map, setAlgebraKeepsValuesOfFirst) {
+  s21_map s21_m1;
+  s21_map s21_m2;
+  std_map std_m1;
+  std_map std_m2;
+
+  for (int i = 0; i < 20000; ++i) {
+    s21_m1.insert({i * 2, i});
+    std_m1.insert({i * 2, i});
+    s21_m2.insert({i * 3, -i});
+    std_m2.insert({i * 3, -i});
+  }
+
+  auto by_key = [](const std_map::value_type &a, const std_map::value_type &b) {
+    return a.first < b.first;
+  };
+  std_map std_union;
+  std_map std_intersection;
+  std_map std_difference;
+
+  std::set_union(std_m1.begin(), std_m1.end(), std_m2.begin(), std_m2.end(),
+                 std::inserter(std_union, std_union.end()), by_key);
+  std::set_intersection(
+      std_m1.begin(), std_m1.end(), std_m2.begin(), std_m2.end(),
+      std::inserter(std_intersection, std_intersection.end()), by_key);
+  std::set_difference(std_m1.begin(), std_m1.end(), std_m2.begin(),
+                      std_m2.end(),
+                      std::inserter(std_difference, std_difference.end()),
+                      by_key);
+
+  compare(s21::set_union(s21_m1, s21_m2), std_union);
+  compare(s21::set_intersection(s21_m1, s21_m2), std_intersection);
+  compare(s21::set_difference(s21_m1, s21_m2), std_difference);
+  compare(s21_m2, std_m2);
+}
+
+TEST(map, extractAndInsertNodeHandles) {
+  s21::map<int, std::string> s21_m1{{1, "one"}, {2, "two"}, {3, "three"}};
+  s21::map<int, std::string> s21_m2{{3, "drei"}};
+  std::map<int, std::string> std_m1{{1, "one"}, {2, "two"}, {3, "three"}};
+  std::map<int, std::string> std_m2{{3, "drei"}};
+  const std::string *address = &(*s21_m1.find(2)).second;
+
+  auto node = s21_m1.extract(2);
+  auto std_node = std_m1.extract(2);
+  ASSERT_FALSE(node.empty());
+  EXPECT_EQ(node.key(), 2);
+  EXPECT_EQ(node.mapped(), "two");
+
+  node.key() = 20;
+  std_node.key() = 20;
+  auto result = s21_m2.insert(std::move(node));
+  auto std_result = std_m2.insert(std::move(std_node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_TRUE(node.empty());
+  EXPECT_EQ((*result.position).first, std_result.position->first);
+  EXPECT_EQ(&(*result.position).second, address);
+
+  result = s21_m2.insert(s21_m1.extract(s21_m1.find(3)));
+  std_result = std_m2.insert(std_m1.extract(std_m1.find(3)));
+  EXPECT_FALSE(result.inserted);
+  ASSERT_TRUE(static_cast<bool>(result.node));
+  EXPECT_EQ(result.node.mapped(), std_result.node.mapped());
+  EXPECT_EQ((*result.position).second, "drei");
+
+  EXPECT_TRUE(s21_m1.extract(42).empty());
+  EXPECT_TRUE(s21_m1.extract(s21_m1.end()).empty());
+  EXPECT_FALSE(s21_m1.insert(std::move(node)).inserted);
+  EXPECT_EQ(s21_m1.size(), std_m1.size());
+  EXPECT_EQ(s21_m2.size(), std_m2.size());
+  EXPECT_EQ(s21_m2.at(20), "two");
+
+  auto last = s21_m1.extract(1);
+  EXPECT_TRUE(s21_m1.empty());
+  EXPECT_TRUE(s21_m1.begin() == s21_m1.end());
+  EXPECT_TRUE(s21_m1.insert(std::move(last)).inserted);
+  EXPECT_EQ(s21_m1.at(1), "one");
+}
+
+/// @brief A value that counts its constructions from an int or a copy.
+struct counted {
+  counted() = default;
+  explicit counted(int value_) : value{value_} { ++constructed; }
+  counted(const counted &other) : value{other.value} { ++constructed; }
+
+  int value{};
+  static inline int constructed{};
+};
+
+TEST(map, tryEmplaceConstructsOnlyOnMiss) {
+  s21::map<std::string, counted> s21_m;
+  std::string key{"key"};
+
+  auto [it, inserted] = s21_m.try_emplace(key, 1);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(counted::constructed, 1);
+
+  auto [same, again] = s21_m.try_emplace(std::move(key), 2);
+  EXPECT_FALSE(again);
+  EXPECT_TRUE(same == it);
+  EXPECT_EQ(key, "key");
+  EXPECT_EQ((*same).second.value, 1);
+  EXPECT_EQ(counted::constructed, 1);
+
+  EXPECT_TRUE(s21_m.try_emplace(std::string{"other"}, 3).second);
+  EXPECT_EQ(counted::constructed, 2);
+  EXPECT_EQ(s21_m.size(), 2U);
+}
+
+TEST(map, emplaceMoveOnlyMapped) {
+  s21::map<int, std::unique_ptr<int>> s21_m;
+
+  auto [it, inserted] = s21_m.emplace(1, std::make_unique<int>(10));
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*(*it).second, 10);
+
+  auto [same, again] = s21_m.emplace(1, std::make_unique<int>(20));
+  EXPECT_FALSE(again);
+  EXPECT_TRUE(same == it);
+  EXPECT_EQ(*(*same).second, 10);
+
+  auto owned = std::make_unique<int>(30);
+  int *raw = owned.get();
+  EXPECT_TRUE(s21_m.try_emplace(2, std::move(owned)).second);
+  EXPECT_EQ(s21_m.at(2).get(), raw);
+
+  auto hinted = s21_m.emplace_hint(s21_m.end(), 3, std::make_unique<int>(40));
+  EXPECT_EQ(*(*hinted).second, 40);
+  EXPECT_EQ(s21_m.size(), 3U);
+}
+
+TEST(map, subscriptCountsWords) {
+  s21::map<std::string, int> s21_m;
+  std::map<std::string, int> std_m;
+
+  for (int i = 0; i < 20000; ++i) {
+    std::string word = std::to_string(i % 997);
+    ++s21_m[word];
+    ++std_m[word];
+  }
+
+  ++s21_m[std::string{"moved"}];
+  ++std_m[std::string{"moved"}];
+
+  ASSERT_EQ(s21_m.size(), std_m.size());
+
+  auto std_it = std_m.begin();
+
+  for (auto it = s21_m.begin(); it != s21_m.end(); ++it, ++std_it) {
+    EXPECT_EQ((*it).first, std_it->first);
+    EXPECT_EQ((*it).second, std_it->second);
+  }
+}
+
+TEST(map, insertWithHint) {
+  s21_map s21_m;
+  std_map std_m;
+  std::mt19937 gen{11};
+
+  for (int i = 0; i < 3000; ++i) {
+    auto it = s21_m.insert(s21_m.end(), {i * 2, i});
+    std_m.insert(std_m.end(), {i * 2, i});
+    ASSERT_EQ((*it).first, i * 2);
+  }
+
+  for (int i = 0; i < 3000; ++i) {
+    int key = static_cast<int>(gen() % 7000);
+    auto hint = s21_m.find(static_cast<int>(gen() % 7000));
+    auto it = s21_m.emplace_hint(hint, key, i);
+    std_m.emplace_hint(std_m.end(), key, i);
+    ASSERT_EQ((*it).first, key);
+    ASSERT_EQ((*it).second, std_m.at(key));
+  }
+
+  compare(s21_m, std_m);
+
+  auto same = s21_m.insert(s21_m.find(10), {10, -1});
+  EXPECT_EQ((*same).second, std_m.at(10));
+  EXPECT_EQ(s21_m.size(), std_m.size());
+
+  s21_m.erase(s21_m.find(6000), s21_m.end());
+  std_m.erase(std_m.find(6000), std_m.end());
+
+  for (int i = 7000; i < 7100; ++i) {
+    s21_m.emplace_hint(s21_m.end(), i, i);
+    std_m.emplace_hint(std_m.end(), i, i);
+  }
+
+  compare(s21_m, std_m);
+}
+
+TEST(map, findManyMatchesFind) {
+  s21_map s21_m;
+  std::vector<int> keys;
+  std::vector<s21_map::iterator> found(3);
+
+  EXPECT_TRUE(s21_m.find_many(keys.begin(), keys.end(), found.begin()) ==
+              found.begin());
+
+  keys = {1, 2, 3};
+  s21_m.find_many(keys.begin(), keys.end(), found.begin());
+
+  for (auto it : found) {
+    EXPECT_TRUE(it == s21_m.end());
+  }
+
+  for (int i = 0; i < 5000; ++i) s21_m.insert({i * 3, i});
+
+  keys.clear();
+
+  for (int i = -10; i < 15010; i += 7) keys.push_back(i);
+
+  found.clear();
+  s21_m.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+  ASSERT_EQ(found.size(), keys.size());
+
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_TRUE(found[i] == s21_m.find(keys[i]));
+  }
+}
@@ -9,7 +9,11 @@
  *
  */
 
+#include <algorithm>
+#include <iterator>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "./../main_test.h"
 
@@ -296,3 +300,185 @@ TEST(multiset, upper_bound) {
   EXPECT_EQ(*ms1.upper_bound(5), 0);
   EXPECT_EQ(*ms1.upper_bound(6), 0);
 }
+
+TEST(multiset, boundsLarge) {
+  s21_multiset ms1;
+  std_multiset ms_std;
+
+  for (int i = 0; i < 1000; i++) {
+    ms1.insert(i % 100);
+    ms_std.insert(i % 100);
+  }
+
+  for (int key : {-1, 0, 42, 99, 100}) {
+    EXPECT_EQ(ms1.count(key), ms_std.count(key));
+
+    auto ms1_range = ms1.equal_range(key);
+    auto ms_std_range = ms_std.equal_range(key);
+    EXPECT_EQ(ms1_range.first == ms1.end(), ms_std_range.first == ms_std.end());
+    EXPECT_EQ(ms1_range.second == ms1.end(),
+              ms_std_range.second == ms_std.end());
+
+    if (ms1_range.first != ms1.end()) {
+      EXPECT_EQ(*ms1_range.first, *ms_std_range.first);
+    }
+    if (ms1_range.second != ms1.end()) {
+      EXPECT_EQ(*ms1_range.second, *ms_std_range.second);
+    }
+  }
+}
+
+TEST(multiset, countAndEqualRangeAfterErase) {
+  s21_multiset ms1;
+  std_multiset ms_std;
+
+  for (int i = 0; i < 2000; i++) {
+    ms1.insert(i % 37);
+    ms_std.insert(i % 37);
+  }
+
+  for (int key = 0; key < 37; key += 3) {
+    ms1.erase(ms1.find(key));
+    ms_std.erase(ms_std.find(key));
+  }
+
+  for (int key = -1; key <= 37; key++) {
+    EXPECT_EQ(ms1.count(key), ms_std.count(key));
+
+    auto ms1_range = ms1.equal_range(key);
+    EXPECT_TRUE(ms1_range.first == ms1.lower_bound(key));
+    EXPECT_TRUE(ms1_range.second == ms1.upper_bound(key));
+  }
+}
+
+TEST(multiset, transparentCountAndEqualRange) {
+  s21::multiset<std::string, std::less<>> ms1{"b", "a", "b", "c", "b"};
+  std::multiset<std::string, std::less<>> ms2{"b", "a", "b", "c", "b"};
+
+  for (const char *key : {"a", "b", "c", "d"}) {
+    EXPECT_EQ(ms1.count(key), ms2.count(key));
+
+    auto range = ms1.equal_range(key);
+    std::size_t length = 0;
+
+    for (auto it = range.first; it != range.second; ++it) {
+      EXPECT_EQ(*it, key);
+      ++length;
+    }
+
+    EXPECT_EQ(length, ms2.count(key));
+  }
+}
+
+TEST(multiset, assignSortedWithDuplicates) {
+  std::vector<int> keys{1, 1, 2, 3, 3, 3, 8, 8, 9};
+  std::vector<int> unsorted{4, 1, 4, 0, 9, 1};
+  s21_multiset s21_ms{5, 6};
+
+  s21_ms.assign_sorted(keys.begin(), keys.end());
+  compare(s21_ms, std_multiset(keys.begin(), keys.end()));
+  EXPECT_EQ(s21_ms.count(3), 3U);
+
+  s21_ms.assign_sorted_checked(unsorted.begin(), unsorted.end());
+  compare(s21_ms, std_multiset(unsorted.begin(), unsorted.end()));
+
+  auto copy = s21_multiset::from_sorted(keys.begin(), keys.end());
+  EXPECT_EQ(copy.count(8), 2U);
+}
+
+TEST(multiset, setAlgebraCountsDuplicates) {
+  s21_multiset ms1;
+  s21_multiset ms2;
+  std_multiset ms_std1;
+  std_multiset ms_std2;
+
+  for (int i = 0; i < 30000; ++i) {
+    ms1.insert(i % 700);
+    ms_std1.insert(i % 700);
+    ms2.insert((i * 3) % 1100);
+    ms_std2.insert((i * 3) % 1100);
+  }
+
+  std_multiset std_union;
+  std_multiset std_intersection;
+  std_multiset std_difference;
+
+  std::set_union(ms_std1.begin(), ms_std1.end(), ms_std2.begin(),
+                 ms_std2.end(), std::inserter(std_union, std_union.end()));
+  std::set_intersection(
+      ms_std1.begin(), ms_std1.end(), ms_std2.begin(), ms_std2.end(),
+      std::inserter(std_intersection, std_intersection.end()));
+  std::set_difference(
+      ms_std1.begin(), ms_std1.end(), ms_std2.begin(), ms_std2.end(),
+      std::inserter(std_difference, std_difference.end()));
+
+  compare(s21::set_union(ms1, ms2), std_union);
+  compare(s21::set_intersection(ms1, ms2), std_intersection);
+  compare(s21::set_difference(ms1, ms2), std_difference);
+  compare(s21::set_difference(ms2, ms1), [&] {
+    std_multiset result;
+    std::set_difference(ms_std2.begin(), ms_std2.end(), ms_std1.begin(),
+                        ms_std1.end(), std::inserter(result, result.end()));
+    return result;
+  }());
+}
+
+TEST(multiset, extractAndInsertNodeHandles) {
+  s21_multiset ms1{5, 1, 5, 3, 5};
+  s21_multiset ms2{5, 2};
+  std_multiset std_ms1{5, 1, 5, 3, 5};
+  std_multiset std_ms2{5, 2};
+
+  while (ms1.contains(5)) {
+    auto node = ms1.extract(5);
+    EXPECT_EQ(node.value(), 5);
+    EXPECT_EQ(*ms2.insert(std::move(node)), 5);
+    std_ms2.insert(std_ms1.extract(5));
+  }
+
+  compare(ms1, std_ms1);
+  compare(ms2, std_ms2);
+  EXPECT_EQ(ms2.count(5), 4U);
+  EXPECT_TRUE(ms1.extract(5).empty());
+  EXPECT_TRUE(ms1.insert(s21_multiset::node_type{}) == ms1.end());
+
+  s21::set<int> unique{7};
+  ms1.insert(unique.extract(7));
+  EXPECT_TRUE(unique.empty());
+  EXPECT_EQ(ms1.count(7), 1U);
+}
+
+TEST(multiset, insertWithHint) {
+  s21_multiset s21_ms;
+  std_multiset std_ms;
+
+  for (int i = 0; i < 2000; ++i) {
+    EXPECT_EQ(*s21_ms.insert(s21_ms.end(), i / 3), i / 3);
+    std_ms.insert(std_ms.end(), i / 3);
+  }
+
+  for (int i = 0; i < 700; i += 5) {
+    auto it = s21_ms.emplace_hint(s21_ms.find(i), i);
+    EXPECT_EQ(*it, i);
+    std_ms.emplace_hint(std_ms.find(i), i);
+  }
+
+  s21_ms.insert(s21_ms.begin(), 1000);
+  std_ms.insert(std_ms.begin(), 1000);
+  compare(s21_ms, std_ms);
+}
+
+TEST(multiset, findManyFindsFirstEquivalent) {
+  s21_multiset s21_ms{4, 2, 4, 8, 4, 6};
+  std::vector<int> keys{4, 5, 8, 1, 4};
+  std::vector<s21_multiset::iterator> found(keys.size());
+
+  s21_ms.find_many(keys.begin(), keys.end(), found.begin());
+
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_TRUE(found[i] == s21_ms.find(keys[i]));
+  }
+
+  EXPECT_TRUE(found[0] == s21_ms.lower_bound(4));
+  EXPECT_TRUE(found[1] == s21_ms.end());
+}
@@ -0,0 +1,218 @@
+/**
+ * @file pool_allocator_test.cc
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Pool allocator and pool-backed containers testing module
+ * @version 1.0
+ * @date 2024-08-14
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "./../main_test.h"
+
+using pool_map = s21::map<const int, int, std::less<int>,
+                          s21::pool_allocator<std::pair<const int, int>>>;
+using pool_set = s21::set<int, std::less<int>, s21::pool_allocator<int>>;
+using pool_multiset = s21::multiset<std::string, std::less<std::string>,
+                                    s21::pool_allocator<std::string>>;
+
+template <typename S21, typename STD>
+void comparePool(const S21 &s21_c, const STD &std_c) {
+  auto std_it = std_c.begin();
+
+  for (auto it = s21_c.begin(); it != s21_c.end(); ++it, ++std_it) {
+    EXPECT_EQ(*it, *std_it);
+  }
+
+  EXPECT_EQ(s21_c.size(), std_c.size());
+}
+
+TEST(poolAllocator, reusesFreedBlocks) {
+  s21::pool_allocator<long> alloc;
+
+  long *first = alloc.allocate(1);
+  alloc.deallocate(first, 1);
+  long *second = alloc.allocate(1);
+
+  EXPECT_EQ(first, second);
+  alloc.deallocate(second, 1);
+}
+
+TEST(poolAllocator, arrayAllocation) {
+  s21::pool_allocator<int> alloc;
+
+  int *arr = alloc.allocate(100);
+
+  for (int i = 0; i < 100; ++i) arr[i] = i;
+
+  EXPECT_EQ(arr[99], 99);
+  alloc.deallocate(arr, 100);
+}
+
+TEST(poolAllocator, reserveServesContiguousBlocks) {
+  s21::pool_allocator<long> alloc;
+
+  alloc.reserve(1000);
+  long *first = alloc.allocate(1);
+  long *prev = first;
+
+  for (int i = 1; i < 1000; ++i) {
+    long *next = alloc.allocate(1);
+    EXPECT_GT(next, prev);
+    prev = next;
+  }
+
+  EXPECT_LT(reinterpret_cast<char *>(prev) - reinterpret_cast<char *>(first),
+            1000 * 64);
+}
+
+TEST(poolAllocator, rebindSharesArena) {
+  s21::pool_allocator<int> alloc;
+  s21::pool_allocator<double> rebound{alloc};
+  s21::pool_allocator<int> other;
+
+  EXPECT_TRUE(alloc == rebound);
+  EXPECT_FALSE(alloc == other);
+  EXPECT_FALSE(alloc.unique());
+  EXPECT_TRUE(other.unique());
+}
+
+TEST(poolAllocator, copyConstructionSelectsNewArena) {
+  s21::pool_allocator<int> alloc;
+  auto copy = std::allocator_traits<
+      s21::pool_allocator<int>>::select_on_container_copy_construction(alloc);
+
+  EXPECT_TRUE(alloc != copy);
+}
+
+TEST(poolAllocator, mapInsertEraseClear) {
+  pool_map s21_m;
+  std::map<const int, int> std_m;
+
+  for (int i = 0; i < 5000; ++i) {
+    int key = (i * 7919) % 5000;
+    s21_m.insert({key, i});
+    std_m.insert({key, i});
+  }
+
+  for (int i = 0; i < 5000; i += 3) {
+    s21_m.erase(i);
+    std_m.erase(i);
+  }
+
+  auto std_it = std_m.begin();
+
+  for (auto it = s21_m.begin(); it != s21_m.end(); ++it, ++std_it) {
+    EXPECT_EQ((*it).first, std_it->first);
+    EXPECT_EQ((*it).second, std_it->second);
+  }
+
+  EXPECT_EQ(s21_m.size(), std_m.size());
+
+  s21_m.clear();
+  EXPECT_EQ(s21_m.size(), 0U);
+
+  for (int i = 0; i < 100; ++i) s21_m.insert({i, -i});
+
+  EXPECT_EQ(s21_m.size(), 100U);
+  EXPECT_EQ(s21_m.at(42), -42);
+}
+
+TEST(poolAllocator, mapCopyAndMove) {
+  pool_map s21_m{{1, 10}, {2, 20}, {3, 30}};
+  pool_map copy{s21_m};
+
+  copy.erase(2);
+  EXPECT_EQ(s21_m.size(), 3U);
+  EXPECT_EQ(copy.size(), 2U);
+
+  pool_map moved{std::move(s21_m)};
+  EXPECT_EQ(moved.size(), 3U);
+  EXPECT_EQ(s21_m.size(), 0U);
+
+  s21_m.insert({5, 50});
+  EXPECT_EQ(s21_m.at(5), 50);
+
+  copy = moved;
+  EXPECT_EQ(copy.size(), 3U);
+  EXPECT_EQ(copy.at(2), 20);
+}
+
+TEST(poolAllocator, setMergeDifferentArenas) {
+  pool_set s1{1, 3, 5, 7};
+  pool_set s2{2, 3, 4, 7, 8};
+  std::set<int> std_s1{1, 3, 5, 7};
+  std::set<int> std_s2{2, 3, 4, 7, 8};
+
+  s1.merge(s2);
+  std_s1.merge(std_s2);
+
+  comparePool(s1, std_s1);
+  comparePool(s2, std_s2);
+}
+
+TEST(poolAllocator, multisetMergeDifferentArenas) {
+  pool_multiset s1{"a", "c", "c", "e"};
+  pool_multiset s2{"b", "c", "e", "e", "f"};
+  std::multiset<std::string> std_s1{"a", "c", "c", "e"};
+  std::multiset<std::string> std_s2{"b", "c", "e", "e", "f"};
+
+  s1.merge(s2);
+  std_s1.merge(std_s2);
+
+  comparePool(s1, std_s1);
+  comparePool(s2, std_s2);
+  EXPECT_EQ(s1.count("e"), 3U);
+}
+
+TEST(poolAllocator, vectorSwapDifferentArenas) {
+  using pool_vector = s21::vector<int, s21::pool_allocator<int>>;
+  using pool_flat_set =
+      s21::flat_set<int, std::less<int>, s21::pool_allocator<int>>;
+
+  auto first = std::make_unique<pool_vector>(pool_vector{1, 2, 3});
+  pool_vector second{4, 5};
+  auto first_alloc = first->get_allocator();
+
+  first->swap(second);
+  first.reset();
+
+  EXPECT_TRUE(second.get_allocator() == first_alloc);
+  ASSERT_EQ(second.size(), 3U);
+  EXPECT_EQ(second[2], 3);
+  second.push_back(6);
+  EXPECT_EQ(second.back(), 6);
+
+  auto set = std::make_unique<pool_flat_set>(pool_flat_set{1, 2, 3});
+  pool_flat_set other{4, 5};
+
+  set->swap(other);
+  set.reset();
+
+  EXPECT_EQ(other.size(), 3U);
+  EXPECT_TRUE(other.contains(2));
+  other.insert(7);
+  EXPECT_TRUE(other.contains(7));
+}
+
+TEST(poolAllocator, multisetStrings) {
+  pool_multiset s21_ms;
+  std::multiset<std::string> std_ms;
+
+  for (int i = 0; i < 300; ++i) {
+    std::string value(static_cast<std::size_t>(i % 40), 'a' + i % 26);
+    s21_ms.insert(value);
+    std_ms.insert(value);
+  }
+
+  comparePool(s21_ms, std_ms);
+
+  s21_ms.clear();
+  EXPECT_TRUE(s21_ms.empty());
+}
@@ -10,6 +10,7 @@
  */
 
 #include <list>
+#include <memory>
 #include <queue>
 
 #include "../../s21_containers.h"
@@ -225,3 +226,35 @@ TEST(QueueTest, Emplace) {
 
   EXPECT_TRUE(compare_queues(std_q, s21_q));
 }
+
+TEST(QueueTest, MoveOnlyElements) {
+  s21::queue<std::unique_ptr<int>> s21_q;
+  auto first = std::make_unique<int>(1);
+
+  s21_q.push(std::move(first));
+  s21_q.push(std::make_unique<int>(2));
+  s21_q.emplace(new int{3});
+
+  EXPECT_FALSE(first);
+  EXPECT_EQ(s21_q.size(), 3U);
+  EXPECT_EQ(*s21_q.front(), 1);
+  EXPECT_EQ(*s21_q.back(), 3);
+
+  s21_q.pop();
+  EXPECT_EQ(*s21_q.front(), 2);
+}
+
+TEST(QueueTest, MoveAssignMoveOnly) {
+  s21::queue<std::unique_ptr<int>> first;
+  s21::queue<std::unique_ptr<int>> second;
+
+  first.push(std::make_unique<int>(1));
+  first.push(std::make_unique<int>(2));
+  second.push(std::make_unique<int>(3));
+
+  second = std::move(first);
+
+  EXPECT_EQ(second.size(), 2U);
+  EXPECT_EQ(*second.front(), 1);
+  EXPECT_EQ(*second.back(), 2);
+}
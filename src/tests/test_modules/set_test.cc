@@ -9,7 +9,10 @@
  *
  */
 
+#include <algorithm>
+#include <iterator>
 #include <set>
+#include <vector>
 
 #include "./../main_test.h"
 
@@ -306,6 +309,24 @@ TEST(set, contains) {
   EXPECT_FALSE(s21_s.conatains(6));
 }
 
+TEST(set, bounds) {
+  s21_set s21_s = {10, 20, 30, 40, 50};
+  std_set std_s = {10, 20, 30, 40, 50};
+
+  for (int key : {5, 10, 25, 45}) {
+    EXPECT_EQ(*s21_s.lower_bound(key), *std_s.lower_bound(key));
+    EXPECT_EQ(*s21_s.upper_bound(key), *std_s.upper_bound(key));
+    EXPECT_EQ(s21_s.count(key), std_s.count(key));
+  }
+
+  EXPECT_EQ(s21_s.lower_bound(55), s21_s.end());
+  EXPECT_EQ(s21_s.upper_bound(50), s21_s.end());
+
+  auto range = s21_s.equal_range(30);
+  EXPECT_EQ(*range.first, 30);
+  EXPECT_EQ(*range.second, 40);
+}
+
 TEST(set, swap) {
   s21_set s21_s1 = {1, 2, 3};
   s21_set s21_s2 = {4, 5, 6};
@@ -408,3 +429,260 @@ TEST(setIterator, checkOperators) {
   EXPECT_EQ(*s.cbegin(), *(s.cend() - 5));
   EXPECT_EQ(*(s.cbegin() + 5), *s.cend());
 }
+
+struct Id {
+  int value;
+};
+
+struct IdLess {
+  using is_transparent = void;
+
+  bool operator()(const Id &a, const Id &b) const { return a.value < b.value; }
+  bool operator()(const Id &a, int b) const { return a.value < b; }
+  bool operator()(int a, const Id &b) const { return a < b.value; }
+};
+
+TEST(set, customComparator) {
+  s21::set<int, std::greater<int>> s21_s{4, 1, 8, 3, 8, 6};
+  std::set<int, std::greater<int>> std_s{4, 1, 8, 3, 8, 6};
+
+  auto std_it = std_s.begin();
+
+  for (auto it = s21_s.begin(); it != s21_s.end(); ++it, ++std_it) {
+    EXPECT_EQ(*it, *std_it);
+  }
+
+  EXPECT_EQ(s21_s.size(), std_s.size());
+  EXPECT_EQ(*s21_s.upper_bound(4), *std_s.upper_bound(4));
+}
+
+TEST(set, heterogeneousLookupWithoutKeyConstruction) {
+  s21::set<Id, IdLess> s21_s{IdLess{}};
+
+  for (int i = 0; i < 10; i += 2) s21_s.insert(Id{i});
+
+  EXPECT_TRUE(s21_s.contains(4));
+  EXPECT_FALSE(s21_s.contains(5));
+  EXPECT_EQ((*s21_s.find(6)).value, 6);
+  EXPECT_TRUE(s21_s.find(7) == s21_s.end());
+  EXPECT_EQ((*s21_s.lower_bound(3)).value, 4);
+  EXPECT_EQ((*s21_s.upper_bound(4)).value, 6);
+  EXPECT_EQ(s21_s.count(8), 1U);
+}
+
+TEST(set, rankAndNth) {
+  s21_set s;
+  std_set ss;
+
+  for (int i = 0; i < 1000; ++i) {
+    s.insert((i * 37) % 1000);
+    ss.insert((i * 37) % 1000);
+  }
+
+  for (int i = 0; i < 1000; i += 2) {
+    s.erase(s.find(i));
+    ss.erase(i);
+  }
+
+  auto std_it = ss.begin();
+
+  for (std::size_t i = 0; i < ss.size(); ++i, ++std_it) {
+    EXPECT_EQ(*s.nth(i), *std_it);
+    EXPECT_EQ(s.rank(*std_it), i);
+  }
+
+  EXPECT_EQ(*(s.begin() + 250), *std::next(ss.begin(), 250));
+  EXPECT_EQ(*(s.cend() - 1), *ss.rbegin());
+  EXPECT_TRUE(s.nth(ss.size()) == s.end());
+}
+
+TEST(set, mixedInsertEraseStress) {
+  s21_set s;
+  std_set ss;
+  unsigned state = 1;
+
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1103515245U + 12345U;
+    int key = static_cast<int>((state >> 16) % 200);
+
+    if (state & 0x100) {
+      s.insert(key);
+      ss.insert(key);
+    } else if (s.contains(key)) {
+      s.erase(s.find(key));
+      ss.erase(key);
+    }
+  }
+
+  compare(s, ss);
+}
+
+TEST(set, fromSortedEverySize) {
+  for (int count = 0; count < 70; ++count) {
+    std::vector<int> keys;
+
+    for (int i = 0; i < count; ++i) keys.push_back(i * 2);
+
+    auto s = s21_set::from_sorted(keys.begin(), keys.end());
+    std_set ss(keys.begin(), keys.end());
+
+    ASSERT_EQ(s.size(), ss.size());
+
+    for (int i = 0; i < count; ++i) {
+      EXPECT_EQ(*s.nth(i), keys[i]);
+      EXPECT_EQ(s.rank(keys[i]), static_cast<std::size_t>(i));
+    }
+
+    for (int i = 0; i < count; i += 3) {
+      s.erase(s.find(i * 2));
+      ss.erase(i * 2);
+      s.insert(i * 2 + 1);
+      ss.insert(i * 2 + 1);
+    }
+
+    compare(s, ss);
+  }
+}
+
+TEST(set, setAlgebraMatchesStd) {
+  for (int size : {0, 10, 40000}) {
+    s21_set s1;
+    s21_set s2;
+    std_set ss1;
+    std_set ss2;
+
+    for (int i = 0; i < size; ++i) {
+      s1.insert((i * 7) % (size * 2));
+      ss1.insert((i * 7) % (size * 2));
+      s2.insert((i * 5) % (size * 3));
+      ss2.insert((i * 5) % (size * 3));
+    }
+
+    std_set std_union;
+    std_set std_intersection;
+    std_set std_difference;
+
+    std::set_union(ss1.begin(), ss1.end(), ss2.begin(), ss2.end(),
+                   std::inserter(std_union, std_union.end()));
+    std::set_intersection(ss1.begin(), ss1.end(), ss2.begin(), ss2.end(),
+                          std::inserter(std_intersection,
+                                        std_intersection.end()));
+    std::set_difference(ss1.begin(), ss1.end(), ss2.begin(), ss2.end(),
+                        std::inserter(std_difference, std_difference.end()));
+
+    compare(s21::set_union(s1, s2), std_union);
+    compare(s21::set_intersection(s1, s2), std_intersection);
+    compare(s21::set_difference(s1, s2), std_difference);
+    compare(s1, ss1);
+    compare(s2, ss2);
+
+    s21_set disjoint = s21::set_difference(s1, s1);
+    EXPECT_TRUE(disjoint.begin() == disjoint.end());
+
+    s21_set joined = set_union(s1, s2);
+
+    for (std::size_t i = 0; i < joined.size(); i += 97) {
+      EXPECT_EQ(joined.rank(*joined.nth(i)), i);
+    }
+  }
+}
+
+TEST(set, extractAndInsertNodeHandles) {
+  s21_set s1;
+  s21_set s2;
+  std_set ss1;
+  std_set ss2;
+
+  for (int i = 0; i < 2000; ++i) {
+    s1.insert(i);
+    ss1.insert(i);
+  }
+
+  for (int i = 0; i < 2000; i += 3) {
+    auto node = s1.extract(i);
+    ASSERT_EQ(node.value(), i);
+    EXPECT_TRUE(s2.insert(std::move(node)).inserted);
+    ss2.insert(ss1.extract(i));
+  }
+
+  compare(s1, ss1);
+  compare(s2, ss2);
+
+  s1.insert(0);
+  auto result = s1.insert(s2.extract(s2.begin()));
+  EXPECT_FALSE(result.inserted);
+  EXPECT_EQ(*result.position, 0);
+  EXPECT_EQ(result.node.value(), 0);
+  EXPECT_TRUE(s2.insert(std::move(result.node)).inserted);
+  compare(s2, ss2);
+}
+
+TEST(set, insertWithHint) {
+  s21_set s21_s;
+  std_set std_s;
+
+  for (int i = 0; i < 2000; ++i) {
+    EXPECT_EQ(*s21_s.insert(s21_s.end(), i), i);
+    std_s.insert(std_s.end(), i);
+  }
+
+  for (int i = -500; i < 2500; i += 7) {
+    EXPECT_EQ(*s21_s.emplace_hint(s21_s.begin(), i), i);
+    std_s.emplace_hint(std_s.begin(), i);
+  }
+
+  EXPECT_EQ(*s21_s.insert(s21_s.find(41), 42), 42);
+  compare(s21_s, std_s);
+}
+
+TEST(set, containsManyMatchesContains) {
+  s21_set s21_s;
+  std::vector<int> keys;
+  std::vector<bool> found;
+
+  for (int i = 0; i < 3000; ++i) s21_s.insert(i * 2);
+  for (int i = 6001; i > -3; i -= 3) keys.push_back(i);
+
+  s21_s.contains_many(keys.begin(), keys.end(), std::back_inserter(found));
+  ASSERT_EQ(found.size(), keys.size());
+
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(found[i], s21_s.contains(keys[i]));
+  }
+}
+
+/// @brief A key that counts its copies.
+struct copied_key {
+  copied_key() = default;
+  explicit copied_key(int value_) : value{value_} {}
+  copied_key(const copied_key &other) : value{other.value} { ++copies; }
+
+  bool operator<(const copied_key &other) const { return value < other.value; }
+
+  int value{};
+  static inline int copies{};
+};
+
+TEST(set, nodesHoldOneKey) {
+  s21::set<copied_key> s21_s;
+
+  for (int i = 0; i < 100; ++i) s21_s.insert(copied_key{i});
+
+  EXPECT_EQ(copied_key::copies, 100);
+  EXPECT_FALSE(s21_s.insert(copied_key{7}).second);
+  EXPECT_EQ(copied_key::copies, 100);
+
+  s21::set<copied_key> copy{s21_s};
+  EXPECT_EQ(copied_key::copies, 200);
+
+  int sum{};
+
+  for (auto it = copy.begin(); it != copy.end(); ++it) sum += (*it).value;
+
+  EXPECT_EQ(sum, 4950);
+  EXPECT_EQ(copied_key::copies, 200);
+
+  copy.emplace_hint(copy.end(), 100);
+  EXPECT_EQ(copied_key::copies, 200);
+  EXPECT_EQ(copy.size(), 101U);
+}
@@ -10,6 +10,8 @@
  */
 
 #include <list>
+#include <memory>
+#include <memory_resource>
 #include <stack>
 
 #include "../../s21_containers.h"
@@ -250,4 +252,59 @@ TEST(StackTest, Emplace) {
   EXPECT_TRUE(std_l.empty());
 
   EXPECT_TRUE(compare_stacks(std_stack, s21_stack));
-}
\ No newline at end of file
+}
+
+TEST(StackTest, PmrResource) {
+  std::pmr::monotonic_buffer_resource resource;
+  s21::pmr::stack<int> s21_stack{&resource};
+
+  for (int i = 0; i < 10; ++i) {
+    s21_stack.push(i);
+  }
+
+  EXPECT_EQ(s21_stack.size(), 10U);
+  EXPECT_EQ(s21_stack.top(), 9);
+  EXPECT_TRUE((std::uses_allocator_v<s21::pmr::stack<int>,
+                                     std::pmr::polymorphic_allocator<int>>));
+}
+
+TEST(StackTest, MoveOnlyElements) {
+  s21::stack<std::unique_ptr<int>> s21_stack;
+  s21::stack<std::unique_ptr<int>, s21::vector<std::unique_ptr<int>>>
+      s21_vector_stack;
+  auto first = std::make_unique<int>(1);
+
+  s21_stack.push(std::move(first));
+  s21_stack.emplace(new int{2});
+  s21_vector_stack.push(std::make_unique<int>(3));
+  s21_vector_stack.emplace(new int{4});
+
+  EXPECT_FALSE(first);
+  EXPECT_EQ(*s21_stack.top(), 2);
+  EXPECT_EQ(*s21_vector_stack.top(), 4);
+
+  s21_stack.pop();
+  s21_vector_stack.pop();
+  EXPECT_EQ(*s21_stack.top(), 1);
+  EXPECT_EQ(*s21_vector_stack.top(), 3);
+}
+
+TEST(StackTest, MoveAssignMoveOnly) {
+  s21::stack<std::unique_ptr<int>> first;
+  s21::stack<std::unique_ptr<int>> second;
+  s21::stack<std::unique_ptr<int>, s21::vector<std::unique_ptr<int>>>
+      vector_first;
+  s21::stack<std::unique_ptr<int>, s21::vector<std::unique_ptr<int>>>
+      vector_second;
+
+  first.push(std::make_unique<int>(1));
+  second.push(std::make_unique<int>(2));
+  vector_first.push(std::make_unique<int>(3));
+
+  second = std::move(first);
+  vector_second = std::move(vector_first);
+
+  EXPECT_EQ(second.size(), 1U);
+  EXPECT_EQ(*second.top(), 1);
+  EXPECT_EQ(*vector_second.top(), 3);
+}
@@ -9,6 +9,10 @@
  *
  */
 
+#include <algorithm>
+#include <map>
+#include <vector>
+
 #include "./../main_test.h"
 
 using tree = s21::tree<const int, const int>;
@@ -653,6 +657,35 @@ TEST(tree, find) {
   EXPECT_EQ((*(it + 1)).first, 100);
 }
 
+TEST(tree, bounds) {
+  tree t1{{15, 15}, {9, 9},   {13, 13}, {1, 1}, {7, 7}, {42, 42},  {21, 21},
+          {31, 31}, {22, 22}, {45, 45}, {3, 3}, {4, 4}, {100, 100}};
+
+  EXPECT_EQ((*t1.lower_bound(13)).first, 13);
+  EXPECT_EQ((*t1.lower_bound(14)).first, 15);
+  EXPECT_EQ((*t1.upper_bound(13)).first, 15);
+  EXPECT_EQ((*t1.lower_bound(0)).first, 1);
+  EXPECT_EQ(t1.lower_bound(101), t1.end());
+  EXPECT_EQ(t1.upper_bound(100), t1.end());
+  EXPECT_EQ(t1.count(42), 1);
+  EXPECT_EQ(t1.count(43), 0);
+}
+
+TEST(tree, boundsNonunique) {
+  tree t1{tree::kNON_UNIQUE};
+  init_list list = {5, 3, 5, 1, 5, 3, 8, 5};
+
+  for (auto key : list) t1.insert({key, key});
+
+  auto range = t1.equal_range(5);
+  EXPECT_EQ((*range.first).first, 5);
+  EXPECT_EQ((*--range.first).first, 3);
+  EXPECT_EQ((*range.second).first, 8);
+  EXPECT_EQ(t1.count(5), 4);
+  EXPECT_EQ(t1.count(3), 2);
+  EXPECT_EQ(t1.count(4), 0);
+}
+
 TEST(tree, eraseByKey) {
   tree t1{{15, 15}, {9, 9},   {13, 13}, {1, 1}, {7, 7}, {42, 42},  {21, 21},
           {31, 31}, {22, 22}, {45, 45}, {3, 3}, {4, 4}, {100, 100}};
@@ -1029,3 +1062,137 @@ TEST(treeIterator, treeIterateCheck_19) {
   it1 = it1 - 1;
   EXPECT_EQ(it1, it2);
 }
+
+TEST(tree, eraseKeepsOtherIterators) {
+  init_list list = {50, 20, 70, 10, 30, 60, 80, 25, 35, 65};
+  tree t;
+
+  for (auto key : list) t.insert({key, key * 2});
+
+  auto it_25 = t.find(25);
+  auto it_65 = t.find(65);
+
+  auto next = t.erase(t.find(20));
+  EXPECT_EQ((*next).first, 25);
+  t.erase(t.find(50));
+  t.erase(t.find(30));
+
+  EXPECT_EQ((*it_25).first, 25);
+  EXPECT_EQ((*it_25).second, 50);
+  EXPECT_EQ((*it_65).first, 65);
+  EXPECT_EQ((*it_65).second, 130);
+  EXPECT_EQ(t.size(), 7U);
+}
+
+TEST(tree, eraseExactNonunique) {
+  tree t{tree::kNON_UNIQUE};
+
+  for (int i = 0; i < 5; ++i) t.insert({7, i});
+  t.insert({3, 0});
+  t.insert({9, 0});
+
+  auto it = t.lower_bound(7);
+  ++it;
+  ++it;
+  auto next = t.erase(it);
+
+  EXPECT_EQ(t.count(7), 4U);
+  EXPECT_EQ((*next).first, 7);
+  EXPECT_EQ((*next).second, 3);
+
+  int expected[] = {0, 1, 3, 4};
+  int i = 0;
+
+  for (auto pos = t.lower_bound(7); pos != t.upper_bound(7); ++pos) {
+    EXPECT_EQ((*pos).second, expected[i++]);
+  }
+}
+
+TEST(tree, orderStatisticsAfterInsertAndErase) {
+  tree t{tree::kNON_UNIQUE};
+  std::vector<int> keys;
+
+  for (int i = 0; i < 2000; ++i) {
+    int key = (i * 7919) % 600;
+    t.insert({key, i});
+    keys.push_back(key);
+  }
+
+  for (int i = 0; i < 2000; i += 3) {
+    auto it = t.lower_bound((i * 31) % 600);
+
+    if (it != t.end()) {
+      keys.erase(std::find(keys.begin(), keys.end(), (*it).first));
+      t.erase(it);
+    }
+  }
+
+  std::sort(keys.begin(), keys.end());
+  ASSERT_EQ(t.size(), keys.size());
+
+  for (std::size_t i = 0; i < keys.size(); i += 7) {
+    EXPECT_EQ((*t.nth(i)).first, keys[i]);
+    EXPECT_EQ((*(t.begin() + i)).first, keys[i]);
+    EXPECT_EQ((*(t.end() - (keys.size() - i))).first, keys[i]);
+  }
+
+  for (int key = -1; key <= 600; key += 13) {
+    auto bound = std::lower_bound(keys.begin(), keys.end(), key);
+    EXPECT_EQ(t.rank(key), static_cast<std::size_t>(bound - keys.begin()));
+  }
+
+  EXPECT_TRUE(t.nth(keys.size()) == t.end());
+  EXPECT_TRUE(t.begin() + keys.size() == t.end());
+  EXPECT_TRUE(t.begin() + (keys.size() + 5) == t.end());
+  EXPECT_TRUE(t.end() - (keys.size() + 5) == t.begin());
+}
+
+TEST(tree, copyKeepsShapeAndOrderStatistics) {
+  tree t1;
+
+  for (int i = 0; i < 500; ++i) t1.insert({(i * 37) % 500, i});
+  for (int i = 0; i < 500; i += 4) t1.erase((i * 37) % 500);
+
+  tree t2{t1};
+  tree t3;
+  t3 = t1;
+
+  EXPECT_EQ(t2.structure(), t1.structure());
+  EXPECT_EQ(t3.structure(), t1.structure());
+  EXPECT_EQ(t2.size(), t1.size());
+
+  for (std::size_t i = 0; i < t1.size(); i += 9) {
+    EXPECT_EQ((*t2.nth(i)).first, (*t1.nth(i)).first);
+  }
+
+  t2.insert({1000, 0});
+  EXPECT_EQ(t2.size(), t1.size() + 1);
+  EXPECT_EQ((*(t2.end() - 1)).first, 1000);
+}
+
+TEST(tree, mergeNonUniqueKeepsEquivalentOrder) {
+  tree t1{tree::kNON_UNIQUE};
+  tree t2{tree::kNON_UNIQUE};
+  std::multimap<const int, const int> std_m1;
+  std::multimap<const int, const int> std_m2;
+
+  for (int i = 0; i < 2000; ++i) {
+    t1.insert({(i * 37) % 500, i});
+    std_m1.insert({(i * 37) % 500, i});
+    t2.insert({(i * 53) % 700, -i});
+    std_m2.insert({(i * 53) % 700, -i});
+  }
+
+  t1.merge(t2);
+  std_m1.merge(std_m2);
+
+  ASSERT_EQ(t1.size(), std_m1.size());
+  EXPECT_EQ(t2.size(), 0U);
+
+  std::size_t index = 0;
+
+  for (auto it = std_m1.begin(); it != std_m1.end(); ++it, ++index) {
+    EXPECT_EQ((*t1.nth(index)).first, it->first);
+    EXPECT_EQ((*t1.nth(index)).second, it->second);
+  }
+}
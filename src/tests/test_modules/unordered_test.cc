@@ -0,0 +1,196 @@
+/**
+ * @file unordered_test.cc
+ * @author kossadda (https://github.com/kossadda)
+ * @brief Hash containers testing module
+ * @version 1.0
+ * @date 2024-08-20
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "./../main_test.h"
+
+template <typename S21, typename STD>
+void compareUnordered(const S21 &s21_c, const STD &std_c) {
+  ASSERT_EQ(s21_c.size(), std_c.size());
+  ASSERT_EQ(static_cast<std::size_t>(std::distance(s21_c.begin(), s21_c.end())),
+            std_c.size());
+
+  for (const auto &item : std_c) {
+    ASSERT_TRUE(s21_c.contains(item.first));
+    ASSERT_EQ((*s21_c.find(item.first)).second, item.second);
+  }
+}
+
+/// @brief A hasher of strings that also hashes string views.
+struct string_hash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view key) const {
+    return std::hash<std::string_view>{}(key);
+  }
+};
+
+TEST(unordered, mapRandomInsertErase) {
+  s21::unordered_map<int, int> s21_m;
+  std::unordered_map<int, int> std_m;
+  std::mt19937 gen{5};
+
+  for (int i = 0; i < 50000; ++i) {
+    int key = static_cast<int>(gen() % 8000);
+
+    if (gen() % 3) {
+      auto s21_res = s21_m.insert({key, i});
+      auto std_res = std_m.insert({key, i});
+      EXPECT_EQ(s21_res.second, std_res.second);
+      EXPECT_EQ((*s21_res.first).second, std_res.first->second);
+    } else {
+      EXPECT_EQ(s21_m.erase(key), std_m.erase(key));
+    }
+  }
+
+  compareUnordered(s21_m, std_m);
+
+  for (int key = -1; key <= 8001; ++key) {
+    EXPECT_EQ(s21_m.count(key), std_m.count(key));
+  }
+
+  EXPECT_LE(s21_m.load_factor(), s21_m.max_load_factor());
+}
+
+TEST(unordered, mapEraseByIteratorReturnsNext) {
+  s21::unordered_map<int, int> s21_m;
+  std::unordered_map<int, int> std_m;
+
+  for (int i = 0; i < 3000; ++i) {
+    s21_m.insert({i, i});
+    std_m.insert({i, i});
+  }
+
+  for (auto it = s21_m.begin(); it != s21_m.end();) {
+    if ((*it).first % 3) {
+      std_m.erase((*it).first);
+      it = s21_m.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  compareUnordered(s21_m, std_m);
+
+  s21_m.erase(s21_m.begin(), s21_m.end());
+  EXPECT_TRUE(s21_m.empty());
+  EXPECT_TRUE(s21_m.begin() == s21_m.end());
+  EXPECT_TRUE(s21_m.find(0) == s21_m.end());
+}
+
+TEST(unordered, mapElementAccess) {
+  s21::unordered_map<std::string, int> s21_m;
+
+  for (int i = 0; i < 500; ++i) s21_m[std::to_string(i)] += i;
+  for (int i = 0; i < 500; ++i) s21_m[std::to_string(i)] += i;
+
+  EXPECT_EQ(s21_m.size(), 500U);
+  EXPECT_EQ(s21_m.at("42"), 84);
+  EXPECT_THROW(s21_m.at("500"), std::out_of_range);
+  EXPECT_FALSE(s21_m.insert("42", 0).second);
+  EXPECT_TRUE(s21_m.insert_or_assign("600", 6).second);
+  EXPECT_FALSE(s21_m.insert_or_assign("42", 1).second);
+  EXPECT_EQ(s21_m.at("42"), 1);
+  EXPECT_EQ(s21_m.at("600"), 6);
+}
+
+TEST(unordered, heterogeneousLookup) {
+  s21::unordered_map<std::string, int, string_hash, std::equal_to<>> s21_m;
+
+  for (int i = 0; i < 100; ++i) s21_m.insert(std::to_string(i), i);
+
+  std::string_view view{"42"};
+  auto range = s21_m.equal_range(view);
+
+  EXPECT_TRUE(s21_m.contains(view));
+  EXPECT_EQ(s21_m.count(std::string_view{"100"}), 0U);
+  EXPECT_EQ((*s21_m.find(view)).second, 42);
+  EXPECT_EQ(std::distance(range.first, range.second), 1);
+}
+
+TEST(unordered, reserveAndLoadFactor) {
+  s21::unordered_set<int> s21_s;
+
+  EXPECT_EQ(s21_s.bucket_count(), 0U);
+  EXPECT_EQ(s21_s.load_factor(), 0.0f);
+
+  s21_s.reserve(1000);
+  std::size_t buckets = s21_s.bucket_count();
+
+  for (int i = 0; i < 1000; ++i) s21_s.insert(i);
+
+  EXPECT_EQ(s21_s.bucket_count(), buckets);
+  EXPECT_EQ(s21_s.size(), 1000U);
+
+  s21_s.max_load_factor(0.5f);
+  EXPECT_EQ(s21_s.max_load_factor(), 0.5f);
+  EXPECT_LE(s21_s.load_factor(), 0.5f);
+
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(s21_s.contains(i));
+  }
+
+  s21_s.clear();
+  s21_s.rehash(0);
+  EXPECT_EQ(s21_s.bucket_count(), 0U);
+  EXPECT_TRUE(s21_s.insert(7).second);
+  EXPECT_TRUE(s21_s.contains(7));
+}
+
+TEST(unordered, setCopyMoveAndMerge) {
+  s21::unordered_set<int> s1;
+  s21::unordered_set<int> s2;
+  std::unordered_set<int> std_s1;
+  std::unordered_set<int> std_s2;
+
+  for (int i = 0; i < 4000; ++i) {
+    s1.insert(i * 3);
+    s2.insert(i * 2);
+    std_s1.insert(i * 3);
+    std_s2.insert(i * 2);
+  }
+
+  s21::unordered_set<int> copy{s1};
+  EXPECT_EQ(copy.size(), std_s1.size());
+
+  s1.merge(s2);
+  std_s1.merge(std_s2);
+  EXPECT_EQ(s1.size(), std_s1.size());
+  EXPECT_EQ(s2.size(), std_s2.size());
+
+  for (int key : std_s1) {
+    ASSERT_TRUE(s1.contains(key));
+  }
+  for (int key : std_s2) {
+    ASSERT_TRUE(s2.contains(key));
+  }
+
+  s21::unordered_set<int> moved{std::move(s1)};
+  EXPECT_TRUE(s1.empty());
+  EXPECT_EQ(moved.size(), std_s1.size());
+
+  copy = moved;
+  s1 = std::move(copy);
+  s1.swap(s2);
+  EXPECT_EQ(s2.size(), std_s1.size());
+  EXPECT_EQ(s1.size(), std_s2.size());
+
+  s21::unordered_set<std::string> strings{"a", "b", "a", "c"};
+  EXPECT_EQ(strings.size(), 3U);
+  EXPECT_TRUE(strings.emplace(3, 'x').second);
+  EXPECT_FALSE(strings.emplace("xxx").second);
+}
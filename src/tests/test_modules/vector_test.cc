@@ -9,6 +9,13 @@
  *
  */
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "./../main_test.h"
@@ -326,6 +333,31 @@ TEST(vector, eraseThrows) {
   EXPECT_THROW(s21_v.erase(s21_v.cend(), s21_v.cbegin()), std::range_error);
 }
 
+TEST(vector, eraseBeyondSizeThrows) {
+  s21::vector<std::string> s21_v{"a", "b"};
+  s21_v.reserve(8);
+
+  EXPECT_THROW(s21_v.erase(s21_v.cbegin() + 3, s21_v.cbegin() + 4),
+               std::range_error);
+  EXPECT_THROW(s21_v.erase(s21_v.cbegin() + 1, s21_v.cbegin() + 3),
+               std::range_error);
+  EXPECT_EQ(s21_v.size(), 2U);
+  EXPECT_EQ(s21_v[1], "b");
+}
+
+TEST(vector, eraseEndThrows) {
+  s21::vector<std::string> s21_v{"a", "b"};
+  s21_vector s21_ints{11, 22};
+  s21_v.reserve(8);
+  s21_ints.reserve(8);
+
+  EXPECT_THROW(s21_v.erase(s21_v.cend()), std::range_error);
+  EXPECT_THROW(s21_ints.erase(s21_ints.cend()), std::range_error);
+  EXPECT_EQ(s21_v.size(), 2U);
+  EXPECT_EQ(s21_ints.size(), 2U);
+  EXPECT_EQ(s21_ints[1], 22);
+}
+
 TEST(vector, pushBackElement_1) {
   s21_vector s21_v{11, 22, 33, 44, 55};
   std_vector std_v{11, 22, 33, 44, 55};
@@ -592,7 +624,7 @@ TEST(vectorIterator, subDifferenceIterator) {
   s21_iterator end{v.begin() + 5};
 
   EXPECT_TRUE(end - begin == 5);
-  EXPECT_TRUE(begin - end == 5);
+  EXPECT_TRUE(begin - end == -5);
 }
 
 TEST(vectorIterator, iteratorEqual) {
@@ -610,3 +642,501 @@ TEST(vectorIterator, iteratorNotEqual) {
 
   EXPECT_FALSE(it != copy);
 }
+
+TEST(vectorAllocator, pmrMonotonicResource) {
+  char buffer[1024];
+  std::pmr::monotonic_buffer_resource resource{
+      buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+  s21::pmr::vector<int> s21_v{&resource};
+  std_vector std_v;
+
+  for (int i = 0; i < 50; ++i) {
+    s21_v.push_back(i * i);
+    std_v.push_back(i * i);
+  }
+
+  EXPECT_EQ(s21_v.get_allocator().resource(), &resource);
+
+  for (std::size_t i = 0; i < std_v.size(); ++i) {
+    EXPECT_EQ(s21_v[i], std_v[i]);
+  }
+
+  EXPECT_THROW(s21_v.reserve(1000), std::bad_alloc);
+}
+
+TEST(vectorAllocator, pmrMoveAssignDifferentResources) {
+  std::pmr::monotonic_buffer_resource first_resource;
+  std::pmr::monotonic_buffer_resource second_resource;
+  s21::pmr::vector<int> first({1, 2, 3}, &first_resource);
+  s21::pmr::vector<int> second(5, 7, &second_resource);
+
+  second = std::move(first);
+
+  EXPECT_EQ(second.get_allocator().resource(), &second_resource);
+  EXPECT_EQ(second.size(), 3U);
+  EXPECT_EQ(second[2], 3);
+  EXPECT_TRUE(first.empty());
+}
+
+TEST(vectorAllocator, moveAssignMoveOnly) {
+  s21::vector<std::unique_ptr<int>> first;
+  s21::vector<std::unique_ptr<int>> second;
+  first.push_back(std::make_unique<int>(1));
+  second.push_back(std::make_unique<int>(2));
+
+  second = std::move(first);
+
+  ASSERT_EQ(second.size(), 1U);
+  EXPECT_EQ(*second[0], 1);
+
+  std::pmr::monotonic_buffer_resource first_resource;
+  std::pmr::monotonic_buffer_resource second_resource;
+  s21::pmr::vector<std::unique_ptr<int>> pmr_first{&first_resource};
+  s21::pmr::vector<std::unique_ptr<int>> pmr_second{&second_resource};
+
+  for (int i = 0; i < 3; ++i) pmr_first.emplace_back(new int{i});
+  pmr_second.emplace_back(new int{10});
+
+  pmr_second = std::move(pmr_first);
+
+  EXPECT_EQ(pmr_second.get_allocator().resource(), &second_resource);
+  ASSERT_EQ(pmr_second.size(), 3U);
+  EXPECT_EQ(*pmr_second[2], 2);
+  EXPECT_TRUE(pmr_first.empty());
+}
+
+TEST(vectorAllocator, copyWithAllocator) {
+  s21::pool_allocator<int> alloc;
+  s21::vector<int, s21::pool_allocator<int>> s21_v({1, 2, 3, 4}, alloc);
+  s21::vector<int, s21::pool_allocator<int>> copy{s21_v};
+  s21::vector<int, s21::pool_allocator<int>> same{s21_v, alloc};
+
+  EXPECT_TRUE(s21_v.get_allocator() == alloc);
+  EXPECT_TRUE(copy.get_allocator() != alloc);
+  EXPECT_TRUE(same.get_allocator() == alloc);
+
+  for (std::size_t i = 0; i < s21_v.size(); ++i) {
+    EXPECT_EQ(copy[i], s21_v[i]);
+    EXPECT_EQ(same[i], s21_v[i]);
+  }
+}
+
+/// @brief An element that counts its live instances and its copies.
+struct tracked {
+  tracked() { ++alive; }
+  explicit tracked(int value_) : value{value_} { ++alive; }
+  tracked(const tracked &other) : value{other.value} { ++alive, ++copies; }
+  tracked(tracked &&other) noexcept : value{other.value} { ++alive; }
+  tracked &operator=(const tracked &other) = default;
+  tracked &operator=(tracked &&other) noexcept = default;
+  ~tracked() { --alive; }
+
+  int value{};
+  static inline int alive{};
+  static inline int copies{};
+};
+
+TEST(vectorStorage, onlySizeElementsAreAlive) {
+  {
+    s21::vector<tracked> s21_v;
+
+    s21_v.reserve(100);
+    EXPECT_EQ(tracked::alive, 0);
+
+    for (int i = 0; i < 1000; ++i) s21_v.emplace_back(i);
+
+    EXPECT_EQ(tracked::alive, 1000);
+    EXPECT_EQ(tracked::copies, 0);
+
+    s21_v.erase(s21_v.cbegin() + 10, s21_v.cbegin() + 20);
+    s21_v.pop_back();
+    EXPECT_EQ(tracked::alive, 989);
+
+    s21_v.shrink_to_fit();
+    EXPECT_EQ(tracked::alive, 989);
+    EXPECT_EQ(tracked::copies, 0);
+    EXPECT_EQ(s21_v[10].value, 20);
+    EXPECT_EQ(s21_v.back().value, 998);
+
+    s21_v.clear();
+    EXPECT_EQ(tracked::alive, 0);
+    s21_v.emplace_back(1);
+  }
+
+  EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(vectorStorage, stringsMatchStd) {
+  s21::vector<std::string> s21_v;
+  std::vector<std::string> std_v;
+
+  for (int i = 0; i < 200; ++i) {
+    std::string item = "element number " + std::to_string(i);
+    s21_v.push_back(item);
+    std_v.push_back(item);
+  }
+
+  s21_v.insert(s21_v.cbegin() + 5, s21_v[150], 3);
+  std_v.insert(std_v.cbegin() + 5, 3, std_v[150]);
+  s21_v.insert(s21_v.cend() - 2, "tail", 7);
+  std_v.insert(std_v.cend() - 2, 7, "tail");
+  s21_v.emplace(s21_v.cbegin(), s21_v.back());
+  std_v.emplace(std_v.cbegin(), std_v.back());
+  s21_v.push_back(s21_v.front());
+  std_v.push_back(std_v.front());
+  s21_v.erase(s21_v.cbegin() + 50, s21_v.cbegin() + 60);
+  std_v.erase(std_v.cbegin() + 50, std_v.cbegin() + 60);
+
+  ASSERT_EQ(s21_v.size(), std_v.size());
+
+  for (std::size_t i = 0; i < std_v.size(); ++i) {
+    ASSERT_EQ(s21_v[i], std_v[i]);
+  }
+}
+
+TEST(vectorStorage, moveOnlyElements) {
+  s21::vector<std::unique_ptr<int>> s21_v;
+
+  for (int i = 0; i < 100; ++i) s21_v.emplace_back(std::make_unique<int>(i));
+
+  s21_v.emplace(s21_v.cbegin() + 3, std::make_unique<int>(-1));
+  s21_v.erase(s21_v.cbegin());
+  s21_v.shrink_to_fit();
+
+  EXPECT_EQ(s21_v.size(), 100U);
+  EXPECT_EQ(*s21_v[2], -1);
+  EXPECT_EQ(*s21_v[3], 3);
+  EXPECT_EQ(*s21_v[99], 99);
+}
+
+/// @brief An element whose copy constructor throws once a budget runs out.
+struct fragile {
+  explicit fragile(int value_) : value{value_} {}
+  fragile(const fragile &other) : value{other.value} {
+    if (budget-- == 0) throw std::runtime_error("copy failed");
+  }
+  fragile &operator=(const fragile &other) = default;
+
+  int value;
+  static inline int budget{1000};
+};
+
+TEST(vectorStorage, copyAssignReusesStorage) {
+  s21::vector<std::string> s21_v{"a", "b", "c", "d"};
+  s21::vector<std::string> source{"x", "y"};
+  std::string *storage = s21_v.data();
+
+  s21_v = source;
+
+  EXPECT_EQ(s21_v.data(), storage);
+  EXPECT_EQ(s21_v.capacity(), 4U);
+  ASSERT_EQ(s21_v.size(), 2U);
+  EXPECT_EQ(s21_v[1], "y");
+
+  source.reserve(100);
+  s21_v = source;
+  EXPECT_EQ(s21_v.data(), storage);
+  EXPECT_EQ(s21_v.capacity(), 4U);
+
+  for (int i = 0; i < 4; ++i) source.push_back("z");
+  s21_v = source;
+  EXPECT_EQ(s21_v.capacity(), 6U);
+  EXPECT_EQ(s21_v[5], "z");
+}
+
+TEST(vectorStorage, throwingCopyAssignKeepsContents) {
+  s21::vector<fragile> s21_v;
+  s21::vector<fragile> source;
+
+  for (int i = 0; i < 2; ++i) s21_v.emplace_back(i);
+  for (int i = 0; i < 8; ++i) source.emplace_back(10 + i);
+
+  fragile::budget = 3;
+  EXPECT_THROW(s21_v = source, std::runtime_error);
+  fragile::budget = 1000;
+
+  ASSERT_EQ(s21_v.size(), 2U);
+  EXPECT_EQ(s21_v[0].value, 0);
+  EXPECT_EQ(s21_v[1].value, 1);
+}
+
+/// @brief A record that opts in to relocation by bytes.
+struct record {
+  explicit record(int id_) : id{id_}, payload{std::make_unique<int>(id_)} {
+    ++alive;
+  }
+  record(record &&other) noexcept
+      : id{other.id}, payload{std::move(other.payload)} {
+    ++alive, ++moves;
+  }
+  record &operator=(record &&other) noexcept = default;
+  ~record() { --alive; }
+
+  int id;
+  std::unique_ptr<int> payload;
+  static inline int alive{};
+  static inline int moves{};
+};
+
+template <>
+struct s21::is_trivially_relocatable<record> : std::true_type {};
+
+TEST(vectorStorage, relocatableRecordsMoveAsBytes) {
+  {
+    s21::vector<record> s21_v;
+    std_vector ids;
+
+    for (int i = 0; i < 1000; ++i) {
+      s21_v.emplace_back(i);
+      ids.push_back(i);
+    }
+
+    s21_v.emplace(s21_v.cbegin() + 500, -1);
+    ids.emplace(ids.cbegin() + 500, -1);
+    s21_v.erase(s21_v.cbegin() + 10, s21_v.cbegin() + 20);
+    ids.erase(ids.cbegin() + 10, ids.cbegin() + 20);
+    s21_v.shrink_to_fit();
+
+    EXPECT_EQ(record::moves, 1);
+    EXPECT_EQ(record::alive, 991);
+    ASSERT_EQ(s21_v.size(), ids.size());
+
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      ASSERT_EQ(s21_v[i].id, ids[i]);
+      ASSERT_EQ(*s21_v[i].payload, ids[i]);
+    }
+  }
+
+  EXPECT_EQ(record::alive, 0);
+}
+
+TEST(vectorRange, insertRangeMatchesStd) {
+  s21::vector<std::string> s21_v{"a", "b", "c"};
+  std::vector<std::string> std_v{"a", "b", "c"};
+  s21::list<std::string> items{"x", "y"};
+  std::string words[] = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"};
+
+  s21_v.reserve(40);
+  s21_v.insert(s21_v.cbegin() + 1, items.cbegin(), items.cend());
+  std_v.insert(std_v.cbegin() + 1, items.cbegin(), items.cend());
+  s21_v.insert(s21_v.cbegin() + 4, std::begin(words), std::end(words));
+  std_v.insert(std_v.cbegin() + 4, std::begin(words), std::end(words));
+  s21_v.insert(s21_v.cbegin(), {"p", "q", "r"});
+  std_v.insert(std_v.cbegin(), {"p", "q", "r"});
+  s21_v.append_range(words);
+  std_v.insert(std_v.cend(), std::begin(words), std::end(words));
+  EXPECT_EQ(s21_v.capacity(), 40U);
+
+  std::vector<std::string> copy{std_v};
+  auto it = s21_v.insert(s21_v.cbegin() + 2, copy.begin(), copy.end());
+  std_v.insert(std_v.cbegin() + 2, copy.begin(), copy.end());
+
+  EXPECT_EQ(*it, "p");
+  ASSERT_EQ(s21_v.size(), std_v.size());
+
+  for (std::size_t i = 0; i < std_v.size(); ++i) {
+    ASSERT_EQ(s21_v[i], std_v[i]);
+  }
+}
+
+TEST(vectorRange, insertInputRangeMatchesStd) {
+  s21_vector s21_v{1, 2, 3, 4};
+  std_vector std_v{1, 2, 3, 4};
+  std::istringstream s21_in{"5 6 7 8 9"};
+  std::istringstream std_in{"5 6 7 8 9"};
+  std::istream_iterator<int> none;
+
+  auto it = s21_v.insert(s21_v.cbegin() + 1,
+                         std::istream_iterator<int>{s21_in}, none);
+  std_v.insert(std_v.cbegin() + 1, std::istream_iterator<int>{std_in}, none);
+
+  EXPECT_EQ(*it, 5);
+  EXPECT_TRUE(s21_v.insert(s21_v.cend(), none, none) == s21_v.end());
+  ASSERT_EQ(s21_v.size(), std_v.size());
+
+  for (std::size_t i = 0; i < std_v.size(); ++i) {
+    ASSERT_EQ(s21_v[i], std_v[i]);
+  }
+}
+
+TEST(vectorRange, appendRangeCopiesOnce) {
+  {
+    std::vector<tracked> items(1000);
+    s21::vector<tracked> s21_v;
+
+    tracked::copies = 0;
+    s21_v.emplace_back(-1);
+    s21_v.append_range(items);
+
+    EXPECT_EQ(s21_v.size(), 1001U);
+    EXPECT_EQ(s21_v.capacity(), 1001U);
+    EXPECT_EQ(tracked::copies, 1000);
+
+    s21_v.insert(s21_v.cbegin() + 1, items.begin(), items.begin() + 10);
+    EXPECT_EQ(s21_v.capacity(), 2002U);
+    EXPECT_EQ(tracked::copies, 1010);
+    EXPECT_EQ(s21_v.front().value, -1);
+  }
+
+  EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(vectorRange, assignMatchesStd) {
+  s21::vector<std::string> s21_v;
+  std::vector<std::string> std_v;
+  std::vector<std::string> items;
+
+  for (int i = 0; i < 50; ++i) items.push_back(std::to_string(i * i));
+
+  s21_v.assign(items.begin(), items.end());
+  EXPECT_EQ(s21_v.capacity(), 50U);
+  s21_v.assign(items.begin() + 10, items.begin() + 20);
+  std_v.assign(items.begin() + 10, items.begin() + 20);
+  EXPECT_EQ(s21_v.capacity(), 50U);
+  ASSERT_EQ(s21_v.size(), std_v.size());
+
+  for (std::size_t i = 0; i < std_v.size(); ++i) {
+    ASSERT_EQ(s21_v[i], std_v[i]);
+  }
+
+  s21_v.assign(items.begin(), items.begin() + 30);
+  std_v.assign(items.begin(), items.begin() + 30);
+  ASSERT_EQ(s21_v.size(), std_v.size());
+
+  for (std::size_t i = 0; i < std_v.size(); ++i) {
+    ASSERT_EQ(s21_v[i], std_v[i]);
+  }
+
+  s21_vector s21_nums{1, 2, 3};
+  std::istringstream in{"4 5 6 7"};
+
+  s21_nums.assign(std::istream_iterator<int>{in},
+                  std::istream_iterator<int>{});
+  ASSERT_EQ(s21_nums.size(), 4U);
+  EXPECT_EQ(s21_nums[0], 4);
+  EXPECT_EQ(s21_nums[3], 7);
+
+  s21_nums.assign({8, 9});
+  ASSERT_EQ(s21_nums.size(), 2U);
+  EXPECT_EQ(s21_nums[1], 9);
+}
+
+TEST(vectorStorage, rvaluesAreMovedIn) {
+  {
+    s21::vector<tracked> s21_v;
+    int copies = tracked::copies;
+
+    for (int i = 0; i < 100; ++i) s21_v.push_back(tracked{i});
+
+    s21_v.insert(s21_v.cbegin() + 50, tracked{-1});
+    s21_v.insert(s21_v.cend(), tracked{-2});
+
+    EXPECT_EQ(tracked::copies, copies);
+    EXPECT_EQ(s21_v.size(), 102U);
+    EXPECT_EQ(s21_v[50].value, -1);
+    EXPECT_EQ(s21_v[51].value, 50);
+    EXPECT_EQ(s21_v.back().value, -2);
+  }
+
+  s21::vector<std::unique_ptr<int>> s21_ptrs;
+  auto ptr = std::make_unique<int>(1);
+
+  s21_ptrs.push_back(std::move(ptr));
+  s21_ptrs.insert(s21_ptrs.cbegin(), std::make_unique<int>(0));
+
+  EXPECT_FALSE(ptr);
+  EXPECT_EQ(*s21_ptrs[0], 0);
+  EXPECT_EQ(*s21_ptrs[1], 1);
+  EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(vectorResize, resizeMatchesStd) {
+  s21::vector<std::string> s21_v{"a", "b", "c"};
+  std::vector<std::string> std_v{"a", "b", "c"};
+
+  s21_v.resize(10);
+  std_v.resize(10);
+  s21_v.resize(20, s21_v[1]);
+  std_v.resize(20, std_v[1]);
+  EXPECT_EQ(s21_v.capacity(), 20U);
+  s21_v.resize(5);
+  std_v.resize(5);
+  s21_v.resize(8, "x");
+  std_v.resize(8, "x");
+  EXPECT_EQ(s21_v.capacity(), 20U);
+  ASSERT_EQ(s21_v.size(), std_v.size());
+
+  for (std::size_t i = 0; i < std_v.size(); ++i) {
+    ASSERT_EQ(s21_v[i], std_v[i]);
+  }
+
+  s21_vector s21_nums{1, 2};
+
+  s21_nums.resize(1000);
+  EXPECT_EQ(s21_nums[1], 2);
+  EXPECT_EQ(s21_nums[999], 0);
+  EXPECT_EQ(s21_nums.capacity(), 1000U);
+  s21_nums.resize(0);
+  EXPECT_TRUE(s21_nums.empty());
+  EXPECT_THROW(s21_nums.resize(s21_nums.max_size() + 1), std::length_error);
+}
+
+TEST(vectorResize, resizeUninitialized) {
+  s21::vector<unsigned char> buffer{1, 2, 3};
+
+  buffer.resize_uninitialized(1 << 20);
+  EXPECT_EQ(buffer.size(), 1U << 20);
+  EXPECT_EQ(buffer.capacity(), 1U << 20);
+  EXPECT_EQ(buffer[2], 3);
+
+  buffer[(1 << 20) - 1] = 7;
+  buffer.resize_uninitialized(4);
+  EXPECT_EQ(buffer.size(), 4U);
+  EXPECT_EQ(buffer[0], 1);
+
+  {
+    s21::vector<tracked> s21_v;
+
+    s21_v.emplace_back(5);
+    s21_v.resize_uninitialized(10);
+    EXPECT_EQ(tracked::alive, 10);
+    EXPECT_EQ(s21_v[0].value, 5);
+    EXPECT_EQ(s21_v[9].value, 0);
+
+    s21_v.resize(3);
+    EXPECT_EQ(tracked::alive, 3);
+  }
+
+  EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(vectorIterator, randomAccessAlgorithms) {
+  s21_vector s21_v{5, 3, 9, 1, 7, 2};
+  std_vector std_v{5, 3, 9, 1, 7, 2};
+
+  std::sort(s21_v.begin(), s21_v.end());
+  std::sort(std_v.begin(), std_v.end());
+
+  for (std::size_t i = 0; i < std_v.size(); ++i) {
+    ASSERT_EQ(s21_v[i], std_v[i]);
+  }
+
+  auto first = s21_v.begin();
+  auto last = s21_v.end();
+  s21_iterator cfirst = s21_v.cbegin();
+
+  EXPECT_EQ(first - last, -6);
+  EXPECT_EQ(last - first, 6);
+  EXPECT_TRUE(first < last && last > first && first <= first);
+  EXPECT_TRUE(last >= last && !(last < first));
+  EXPECT_TRUE(cfirst < s21_v.cend());
+  EXPECT_EQ(first[2], 3);
+  EXPECT_EQ(cfirst[5], 9);
+  EXPECT_EQ(*(2 + first), 3);
+  EXPECT_EQ(*(1 + cfirst), 2);
+  EXPECT_EQ(*(first += 4), 7);
+  EXPECT_EQ(*(first -= 1), 5);
+  EXPECT_TRUE(std::binary_search(s21_v.cbegin(), s21_v.cend(), 7));
+  EXPECT_EQ(*std::make_reverse_iterator(last), 9);
+  EXPECT_EQ(std::distance(s21_v.cbegin(), s21_v.cend()), 6);
+}